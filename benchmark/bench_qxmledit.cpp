@@ -0,0 +1,698 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#include "bench_qxmledit.h"
+#include <QtTest/QtTest>
+#include <QBuffer>
+#include <QTemporaryFile>
+#include <QTemporaryDir>
+#include <QDirIterator>
+#include <QCryptographicHash>
+#include <QXmlStreamReader>
+#include "regola.h"
+#include "utils.h"
+#include "findtextparams.h"
+#include "modules/xml/xmlloadcontext.h"
+#include "modules/xml/xmlstreamscanner.h"
+#include "modules/compare/compareengine.h"
+#include "modules/anonymize/anoncontext.h"
+#include "modules/anonymize/anonoperationbatch.h"
+#include "modules/anonymize/anonymizeparameters.h"
+#include "modules/services/systemservices.h"
+#include "extraction/extractionoperation.h"
+#include "extraction/scripting/model/extractionscriptfiltermodel.h"
+#include "xsdeditor/xschema.h"
+#include "xsdeditor/xsdloadcontext.h"
+#include "visualization/visdatasax.h"
+#include "visualization/vismapgrid.h"
+#include "modules/graph/nodessax.h"
+#include "modules/xslt/saxnamesscan.h"
+#include "scansax.h"
+#include "xsaxhandler.h"
+#include <QXmlSimpleReader>
+#include <QXmlDefaultHandler>
+#include "sessions/data_access/sqllitedataaccess.h"
+#include "services/loghandler.h"
+
+const char *APP_TITLE = QT_TR_NOOP("QXmlEditBenchmark");
+
+#define DEFAULT_OUTPUT_FILE "qxmledit_benchmark.json"
+#define DEFAULT_TOLERANCE   (20.0)
+#ifndef DEFAULT_BASELINE_FILE
+#define DEFAULT_BASELINE_FILE "baseline.json"
+#endif
+
+BenchQXmlEdit::BenchQXmlEdit()
+{
+    _scale = 1 ;
+    qputenv("QTEST_FUNCTION_TIMEOUT", QString("9000000").toLatin1());
+}
+
+BenchQXmlEdit::~BenchQXmlEdit()
+{
+}
+
+void BenchQXmlEdit::initTestCase()
+{
+    Utils::setBatch(true);
+    bool isOk = false;
+    const int scale = QString::fromLocal8Bit(qgetenv("QXMLEDIT_BENCH_SCALE")).toInt(&isOk);
+    _scale = (isOk && (scale > 0)) ? scale : 1 ;
+}
+
+void BenchQXmlEdit::cleanupTestCase()
+{
+    QString outputFile = QString::fromLocal8Bit(qgetenv("QXMLEDIT_BENCH_OUTPUT"));
+    if(outputFile.isEmpty()) {
+        outputFile = DEFAULT_OUTPUT_FILE ;
+    }
+    QVERIFY2(_results.writeJson(outputFile, _scale), QString("unable to write the results to '%1'").arg(outputFile).toLatin1().data());
+    QString baselineFile = QString::fromLocal8Bit(qgetenv("QXMLEDIT_BENCH_BASELINE"));
+    if(baselineFile.isEmpty()) {
+        // the tracked baseline is used only at its own scale
+        if(!QFile::exists(DEFAULT_BASELINE_FILE) || (1 != _scale)) {
+            return ;
+        }
+        baselineFile = DEFAULT_BASELINE_FILE ;
+    }
+    bool isOk = false;
+    double tolerance = QString::fromLocal8Bit(qgetenv("QXMLEDIT_BENCH_TOLERANCE")).toDouble(&isOk);
+    if(!isOk || (tolerance < 0)) {
+        tolerance = DEFAULT_TOLERANCE ;
+    }
+    QStringList regressions;
+    QStringList missing;
+    QString errorMessage;
+    QVERIFY2(_results.compareWithBaseline(baselineFile, _scale, tolerance, regressions, missing, errorMessage), errorMessage.toLatin1().data());
+    if(!missing.isEmpty()) {
+        QWARN(QString("Not in the baseline '%1':\n%2").arg(baselineFile).arg(missing.join("\n")).toLatin1().data());
+    }
+    QVERIFY2(regressions.isEmpty(), QString("Regressions:\n%1").arg(regressions.join("\n")).toLatin1().data());
+}
+
+QByteArray BenchQXmlEdit::document(const int shape)
+{
+    if(!_documents.contains(shape)) {
+        _documents.insert(shape, _generator.generate(static_cast<BenchDocumentGenerator::EShape>(shape), RecordsPerScale * _scale));
+    }
+    return _documents.value(shape);
+}
+
+QByteArray BenchQXmlEdit::variant(const int shape)
+{
+    if(!_variants.contains(shape)) {
+        _variants.insert(shape, _generator.generate(static_cast<BenchDocumentGenerator::EShape>(shape), RecordsPerScale * _scale, true));
+    }
+    return _variants.value(shape);
+}
+
+Regola *BenchQXmlEdit::loadRegola(const QByteArray &data)
+{
+    QByteArray source = data ;
+    QBuffer buffer(&source);
+    if(!buffer.open(QIODevice::ReadOnly)) {
+        return NULL ;
+    }
+    QXmlStreamReader xmlReader;
+    xmlReader.setDevice(&buffer);
+    XMLLoadContext context;
+    Regola *regola = new Regola("");
+    if(!regola->readFromStream(&context, &xmlReader)) {
+        delete regola ;
+        regola = NULL ;
+    }
+    buffer.close();
+    return regola ;
+}
+
+void BenchQXmlEdit::addShapes()
+{
+    QTest::addColumn<int>("shape");
+    for(int shape = 0 ; shape < BenchDocumentGenerator::ShapeCount ; shape ++) {
+        QTest::newRow(BenchDocumentGenerator::shapeName(static_cast<BenchDocumentGenerator::EShape>(shape)).toLatin1().data()) << shape ;
+    }
+}
+
+void BenchQXmlEdit::addResult(const QString &name, const qint64 bytes, const BenchTimer &timer)
+{
+    _results.add(name, QTest::currentDataTag(), bytes, timer);
+}
+
+//-------------------------------------------------------------------
+
+void BenchQXmlEdit::benchLoad_data()
+{
+    addShapes();
+}
+
+void BenchQXmlEdit::benchLoad()
+{
+    QFETCH(int, shape);
+    const QByteArray data = document(shape);
+    BenchTimer timer;
+    QBENCHMARK {
+        timer.start();
+        QScopedPointer<Regola> regola(loadRegola(data));
+        timer.stop();
+        QVERIFY(!regola.isNull());
+    }
+    addResult("load", data.size(), timer);
+}
+
+void BenchQXmlEdit::benchSave_data()
+{
+    addShapes();
+}
+
+void BenchQXmlEdit::benchSave()
+{
+    QFETCH(int, shape);
+    const QByteArray data = document(shape);
+    QScopedPointer<Regola> regola(loadRegola(data));
+    QVERIFY(!regola.isNull());
+    BenchTimer timer;
+    QBENCHMARK {
+        QByteArray saved;
+        QBuffer buffer(&saved);
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+        timer.start();
+        const bool isOk = regola->writeStream(&buffer, false);
+        timer.stop();
+        QVERIFY(isOk);
+    }
+    addResult("save", data.size(), timer);
+}
+
+void BenchQXmlEdit::benchFind_data()
+{
+    addShapes();
+}
+
+void BenchQXmlEdit::benchFind()
+{
+    QFETCH(int, shape);
+    const QByteArray data = document(shape);
+    QScopedPointer<Regola> regola(loadRegola(data));
+    QVERIFY(!regola.isNull());
+    BenchTimer timer;
+    QBENCHMARK {
+        FindTextParams findArgs(FindTextParams::FindAllOccurrences, BenchDocumentGenerator::searchTerm(), true, false, false, false,
+                                FindTextParams::FIND_ALL, false, false, false, "", false, false);
+        timer.start();
+        regola->findText(findArgs, NULL);
+        timer.stop();
+        QVERIFY(findArgs.getOccurrences() > 0);
+    }
+    addResult("find", data.size(), timer);
+}
+
+void BenchQXmlEdit::benchCompare_data()
+{
+    addShapes();
+}
+
+void BenchQXmlEdit::benchCompare()
+{
+    QFETCH(int, shape);
+    const QByteArray data = document(shape);
+    QScopedPointer<Regola> reference(loadRegola(data));
+    QScopedPointer<Regola> compare(loadRegola(variant(shape)));
+    QVERIFY(!reference.isNull() && !compare.isNull());
+    BenchTimer timer;
+    QBENCHMARK {
+        OperationResult results;
+        DiffNodesChangeList changeList;
+        CompareOptions options;
+        CompareEngine engine;
+        timer.start();
+        engine.doCompare(&results, reference.data(), compare.data(), &changeList, options);
+        timer.stop();
+        QVERIFY(!results.isError());
+    }
+    addResult("compare", data.size(), timer);
+}
+
+void BenchQXmlEdit::benchAnonymize_data()
+{
+    addShapes();
+}
+
+void BenchQXmlEdit::benchAnonymize()
+{
+    QFETCH(int, shape);
+    QByteArray data = document(shape);
+    AnonymizeParameters params(AnonymizeParameters::AllText, false);
+    AnonContext context(NULL, "");
+    context.setAlg(&params);
+    BenchTimer timer;
+    QBENCHMARK {
+        QBuffer input(&data);
+        QByteArray anonymized;
+        QBuffer output(&anonymized);
+        QVERIFY(input.open(QIODevice::ReadOnly));
+        QVERIFY(output.open(QIODevice::WriteOnly));
+        AnonOperationBatch operation;
+        timer.start();
+        const AnonOperationResult *result = operation.execute(&input, &output, &context);
+        timer.stop();
+        QVERIFY((NULL != result) && !result->isError());
+    }
+    addResult("anonymize", data.size(), timer);
+}
+
+void BenchQXmlEdit::benchSplit_data()
+{
+    addShapes();
+}
+
+/*!
+ * \brief BenchQXmlEdit::benchSplit counts the fragments only, writing them would measure the disk
+ */
+void BenchQXmlEdit::benchSplit()
+{
+    QFETCH(int, shape);
+    const QByteArray data = document(shape);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QVERIFY(file.write(data) == data.size());
+    file.close();
+    BenchTimer timer;
+    QBENCHMARK {
+        ExtractResults results;
+        ExtractionOperation operation(&results);
+        operation.setInputFile(file.fileName());
+        operation.setSplitPath(BenchDocumentGenerator::splitPath(static_cast<BenchDocumentGenerator::EShape>(shape)));
+        operation.setExtractAllDocuments();
+        operation.setExtractDocuments(false);
+        operation.setExtractFolder(SystemServices::tempLocation());
+        timer.start();
+        operation.performExtraction();
+        timer.stop();
+        QVERIFY2(!operation.isError(), operation.errorMessage().toLatin1().data());
+        QVERIFY(results.numFragments() > 0);
+    }
+    addResult("split", data.size(), timer);
+}
+
+static ExtractionScriptEventModel *newScriptEvent(const EExtractionEventType eventType, const QString &handlerName, const QString &code)
+{
+    ExtractionScriptEventModel *event = new ExtractionScriptEventModel();
+    event->setEnabled(true);
+    event->setEventType(eventType);
+    event->setHandlerName(handlerName);
+    event->setCode(code);
+    return event ;
+}
+
+/*!
+ * \brief a filter that reads every text and the first attribute of every element, changing nothing
+ */
+static ExtractionScriptFilterModel *newBenchScriptFilter()
+{
+    ExtractionScriptFilterModel *filter = new ExtractionScriptFilterModel();
+    filter->setEnabled(true);
+    filter->addEventModel(newScriptEvent(ExtractionEventText, "benchText",
+                                         "function benchText(context, event) { if(event.text.length < 0) { event.ignored = true; } }"));
+    filter->addEventModel(newScriptEvent(ExtractionEventElement, "benchElement",
+                                         "function benchElement(context, event) { if(event.attributesCount > 0) { event.attributeValueByIndex(0); } }"));
+    return filter ;
+}
+
+/*!
+ * \brief a filter that keeps a counter and an object in its globals, they are reset
+ * at each fragment and at each run of tokens between the fragments
+ */
+static ExtractionScriptFilterModel *newBenchGlobalsScriptFilter()
+{
+    ExtractionScriptFilterModel *filter = new ExtractionScriptFilterModel();
+    filter->setEnabled(true);
+    filter->addEventModel(newScriptEvent(ExtractionEventText, "benchText",
+                                         "var counter = 0;\n"
+                                         "var seen = {};\n"
+                                         "function benchText(context, event) { counter++; if(!event.isWhitespace) { event.text = event.text + counter; } }"));
+    filter->addEventModel(newScriptEvent(ExtractionEventElement, "benchElement",
+                                         "function benchElement(context, event) { counter++; seen[event.localName] = counter; }"));
+    return filter ;
+}
+
+/*!
+ * \brief the digest of the names and of the contents of the files in a folder
+ */
+static QByteArray folderDigest(const QString &folderPath)
+{
+    QStringList paths;
+    QDirIterator iterator(folderPath, QDir::Files, QDirIterator::Subdirectories);
+    while(iterator.hasNext()) {
+        paths.append(iterator.next());
+    }
+    paths.sort();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    foreach(const QString &path, paths) {
+        QFile file(path);
+        if(file.open(QIODevice::ReadOnly)) {
+            hash.addData(path.mid(folderPath.length()).toUtf8());
+            hash.addData(file.readAll());
+        }
+    }
+    return hash.result();
+}
+
+void BenchQXmlEdit::benchScriptFilter_data()
+{
+    addShapes();
+}
+
+/*!
+ * \brief BenchQXmlEdit::benchScriptFilter filters the whole document calling a script for each text and element
+ */
+void BenchQXmlEdit::benchScriptFilter()
+{
+    scriptFilter(1, "scriptFilter");
+}
+
+void BenchQXmlEdit::benchScriptFilterParallel_data()
+{
+    addShapes();
+}
+
+/*!
+ * \brief BenchQXmlEdit::benchScriptFilterParallel the same filter, an engine for each core
+ */
+void BenchQXmlEdit::benchScriptFilterParallel()
+{
+    scriptFilter(0, "scriptFilterParallel");
+}
+
+void BenchQXmlEdit::benchScriptGlobals_data()
+{
+    addShapes();
+}
+
+/*!
+ * \brief BenchQXmlEdit::benchScriptGlobals the sequential path with a script that uses its globals
+ */
+void BenchQXmlEdit::benchScriptGlobals()
+{
+    scriptFilter(1, "scriptGlobals", true);
+}
+
+void BenchQXmlEdit::benchScriptGlobalsParallel_data()
+{
+    addShapes();
+}
+
+/*!
+ * \brief BenchQXmlEdit::benchScriptGlobalsParallel the same script, an engine for each core;
+ * the output must be the one of the sequential path
+ */
+void BenchQXmlEdit::benchScriptGlobalsParallel()
+{
+    scriptFilter(0, "scriptGlobalsParallel", true);
+}
+
+void BenchQXmlEdit::scriptFilter(const int threads, const QString &resultName, const bool isGlobals)
+{
+    QFETCH(int, shape);
+    const QByteArray data = document(shape);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QVERIFY(file.write(data) == data.size());
+    file.close();
+    QTemporaryDir outputDir;
+    QVERIFY(outputDir.isValid());
+    BenchTimer timer;
+    QBENCHMARK {
+        ExtractResults results;
+        ExtractionOperation operation(&results);
+        operation.setInputFile(file.fileName());
+        operation.setOperationType(ExtractionOperation::OperationFilter);
+        operation.setSplitDepth(1);
+        operation.setSplitType(ExtractionOperation::SplitUsingDepth);
+        operation.setExtractDocuments(true);
+        operation.setExtractAllDocuments();
+        operation.setExtractFolder(outputDir.path());
+        operation.setFilesNamePattern(QStringList() << "bench" << "%counter%");
+        operation.addScriptingFilter(isGlobals ? newBenchGlobalsScriptFilter() : newBenchScriptFilter());
+        operation.setScriptingThreads(threads);
+        timer.start();
+        operation.performExtraction();
+        timer.stop();
+        QVERIFY2(!operation.isError(), operation.errorMessage().toLatin1().data());
+        QVERIFY(operation.scriptManager()->eventsCount() > 0);
+    }
+    addResult(resultName, data.size(), timer);
+    if(isGlobals) {
+        const QByteArray output = folderDigest(outputDir.path());
+        if(_scriptOutputs.contains(shape)) {
+            QVERIFY2(_scriptOutputs.value(shape) == output, "the output differs from the one of the sequential path");
+        } else {
+            _scriptOutputs.insert(shape, output);
+        }
+    }
+}
+
+void BenchQXmlEdit::benchXsdLoad_data()
+{
+    QTest::addColumn<int>("types");
+    QTest::newRow("small") << (SchemaTypesPerScale / 10) ;
+    QTest::newRow("large") << SchemaTypesPerScale ;
+}
+
+void BenchQXmlEdit::benchXsdLoad()
+{
+    QFETCH(int, types);
+    const QString schemaText = _generator.generateSchema(types * _scale);
+    BenchTimer timer;
+    QBENCHMARK {
+        XSDSchema schema(NULL);
+        XSDLoadContext loadContext;
+        timer.start();
+        const bool isOk = schema.readFromString(&loadContext, schemaText);
+        timer.stop();
+        QVERIFY(isOk);
+    }
+    addResult("xsdLoad", schemaText.toUtf8().size(), timer);
+}
+
+void BenchQXmlEdit::benchVisScan_data()
+{
+    addShapes();
+}
+
+void BenchQXmlEdit::benchVisScan()
+{
+    QFETCH(int, shape);
+    QByteArray data = document(shape);
+    BenchTimer timer;
+    QBENCHMARK {
+        QHash<QString, TagNode*> tagNodes;
+        AttributesSummaryData attributesSummaryData;
+        VisDataSax handler(&tagNodes, &attributesSummaryData);
+        XmlStreamScanner scanner;
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        timer.start();
+        const bool isOk = scanner.scan(&buffer, &handler);
+        timer.stop();
+        delete handler.root;
+        foreach(TagNode * node, tagNodes) {
+            delete node;
+        }
+        QVERIFY(isOk && !handler.hasError());
+    }
+    addResult("visScan", data.size(), timer);
+}
+
+enum EScanAnalysis {
+    ScanSaxReader,
+    ScanNoHandler,
+    ScanSearchInFiles,
+    ScanVisTree,
+    ScanVisGrid,
+    ScanTagGraph,
+    ScanXsltNames,
+    ScanExplore
+};
+
+void BenchQXmlEdit::benchScanner_data()
+{
+    QTest::addColumn<int>("analysis");
+    QTest::newRow("saxNoHandler") << static_cast<int>(ScanSaxReader) ;
+    QTest::newRow("scannerNoHandler") << static_cast<int>(ScanNoHandler) ;
+    QTest::newRow("searchInFiles") << static_cast<int>(ScanSearchInFiles) ;
+    QTest::newRow("visTree") << static_cast<int>(ScanVisTree) ;
+    QTest::newRow("visGrid") << static_cast<int>(ScanVisGrid) ;
+    QTest::newRow("tagGraph") << static_cast<int>(ScanTagGraph) ;
+    QTest::newRow("xsltNames") << static_cast<int>(ScanXsltNames) ;
+    QTest::newRow("explore") << static_cast<int>(ScanExplore) ;
+}
+
+static bool scanWithHandler(QIODevice *device, XmlScanHandler *handler, BenchTimer &timer)
+{
+    XmlStreamScanner scanner;
+    timer.start();
+    const bool isOk = scanner.scan(device, handler);
+    timer.stop();
+    return isOk ;
+}
+
+/*!
+ * \brief scanAnalysis runs one of the analyses based on the stream scanner. The SAX reader without handler
+ * is the lower bound of the cost of the analyses before the scanner.
+ */
+static bool scanAnalysis(const int analysis, QIODevice *device, const QString &path, BenchTimer &timer)
+{
+    switch(analysis) {
+    default:
+        return false;
+    case ScanSaxReader: {
+        QXmlDefaultHandler handler;
+        QXmlSimpleReader reader;
+        reader.setFeature("http://xml.org/sax/features/namespaces", false);
+        reader.setFeature("http://xml.org/sax/features/namespace-prefixes", true);
+        reader.setContentHandler(&handler);
+        reader.setErrorHandler(&handler);
+        timer.start();
+        QXmlInputSource xmlInput(device);
+        const bool isOk = reader.parse(xmlInput);
+        timer.stop();
+        return isOk ;
+    }
+    case ScanNoHandler: {
+        XmlScanHandler handler;
+        return scanWithHandler(device, &handler, timer);
+    }
+    case ScanSearchInFiles: {
+        XmlScanInfo info;
+        info.init(path, true);
+        ScanSax handler(info);
+        return scanWithHandler(device, &handler, timer);
+    }
+    case ScanVisTree: {
+        QHash<QString, TagNode*> tagNodes;
+        AttributesSummaryData attributesSummaryData;
+        VisDataSax handler(&tagNodes, &attributesSummaryData);
+        const bool isOk = scanWithHandler(device, &handler, timer);
+        delete handler.root;
+        foreach(TagNode * node, tagNodes) {
+            delete node;
+        }
+        return isOk ;
+    }
+    case ScanVisGrid: {
+        VisMapGrid grid;
+        VisDataSax handler(NULL, NULL);
+        handler.setGrid(&grid);
+        return scanWithHandler(device, &handler, timer);
+    }
+    case ScanTagGraph: {
+        QHash<QString, TagNode*> tagNodes;
+        AttributesSummaryData attributesSummaryData;
+        NodesSax handler(&tagNodes, &attributesSummaryData);
+        const bool isOk = scanWithHandler(device, &handler, timer);
+        foreach(TagNode * node, tagNodes) {
+            delete node;
+        }
+        return isOk ;
+    }
+    case ScanXsltNames: {
+        XsltHelper helper(NULL);
+        SaxNamesScan handler(&helper);
+        return scanWithHandler(device, &handler, timer);
+    }
+    case ScanExplore: {
+        Regola regola;
+        XSaxHandler handler(&regola);
+        return scanWithHandler(device, &handler, timer);
+    }
+    }
+}
+
+/*!
+ * \brief BenchQXmlEdit::benchScanner measures the analyses that share the stream scanner on the namespaced document
+ */
+void BenchQXmlEdit::benchScanner()
+{
+    QFETCH(int, analysis);
+    const BenchDocumentGenerator::EShape shape = BenchDocumentGenerator::ShapeNamespaces ;
+    QByteArray data = document(shape);
+    const QString path = BenchDocumentGenerator::splitPath(shape);
+    BenchTimer timer;
+    QBENCHMARK {
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QVERIFY(scanAnalysis(analysis, &buffer, path, timer));
+    }
+    addResult("scanner", data.size(), timer);
+}
+
+void BenchQXmlEdit::benchSessionEnroll_data()
+{
+    QTest::addColumn<bool>("isWriteBehind");
+    QTest::newRow("writeBehind") << true ;
+    QTest::newRow("synchronous") << false ;
+}
+
+/*!
+ * \brief enrollSessionFiles enrolls the files in a new session of a new database, the time includes the flush of the queue
+ */
+static bool enrollSessionFiles(const QString &dbFilePath, const bool isWriteBehind, const int filesCount, BenchTimer &timer)
+{
+    LogHandler logHandler;
+    logHandler.setEnabled(false);
+    SQLLiteDataAccess *access = new SQLLiteDataAccess();
+    access->setLogger(&logHandler);
+    access->setWriteBehindEnabled(isWriteBehind);
+    bool isOk = access->init(dbFilePath);
+    SessionOperationStatus context;
+    SessionModel sessionModel;
+    sessionModel.name = "bench";
+    isOk = isOk && access->newSession(context, &sessionModel);
+    if(isOk) {
+        timer.start();
+        for(int i = 0 ; isOk && (i < filesCount) ; i ++) {
+            isOk = access->enrollFile(context, &sessionModel, QString("/bench/dir%1/file%2.xml").arg(i % 100).arg(i));
+        }
+        isOk = isOk && access->flushPendingWrites();
+        timer.stop();
+        isOk = isOk && (access->countFiles(context) == filesCount);
+    }
+    access->closeAndDispose();
+    return isOk;
+}
+
+void BenchQXmlEdit::benchSessionEnroll()
+{
+    QFETCH(bool, isWriteBehind);
+    const int filesCount = RecordsPerScale * _scale ;
+    BenchTimer timer;
+    QBENCHMARK {
+        QTemporaryFile dbFile;
+        QVERIFY(dbFile.open());
+        QVERIFY(enrollSessionFiles(dbFile.fileName(), isWriteBehind, filesCount, timer));
+    }
+    addResult("sessionEnroll", 0, timer);
+}
+
+QTEST_MAIN(BenchQXmlEdit)
@@ -0,0 +1,105 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef BENCH_QXMLEDIT_H
+#define BENCH_QXMLEDIT_H
+
+#include <QObject>
+#include <QHash>
+#include <QByteArray>
+#include "benchdocumentgenerator.h"
+#include "benchresults.h"
+
+class Regola;
+
+/*!
+ * \brief The BenchQXmlEdit class measures the core engines on synthetic documents.
+ * Settings are read from the environment, because QTest owns the command line:
+ * QXMLEDIT_BENCH_SCALE multiplies the size of the documents (default 1),
+ * QXMLEDIT_BENCH_OUTPUT is the JSON results file (default qxmledit_benchmark.json),
+ * QXMLEDIT_BENCH_BASELINE is a previous results file to compare with (default baseline.json at scale 1,
+ * a baseline without results fails the run),
+ * QXMLEDIT_BENCH_TOLERANCE is the percent of slowdown accepted (default 20).
+ */
+class BenchQXmlEdit : public QObject
+{
+    Q_OBJECT
+
+    static const int RecordsPerScale = 10000 ;
+    static const int SchemaTypesPerScale = 1000 ;
+
+    int _scale;
+    BenchDocumentGenerator _generator;
+    BenchResults _results;
+    QHash<int, QByteArray> _documents;
+    QHash<int, QByteArray> _variants;
+    // the output of the filter with script globals, by shape
+    QHash<int, QByteArray> _scriptOutputs;
+
+    QByteArray document(const int shape);
+    QByteArray variant(const int shape);
+    Regola *loadRegola(const QByteArray &data);
+    void addShapes();
+    void addResult(const QString &name, const qint64 bytes, const BenchTimer &timer);
+    void scriptFilter(const int threads, const QString &resultName, const bool isGlobals = false);
+
+public:
+    BenchQXmlEdit();
+    ~BenchQXmlEdit();
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchLoad_data();
+    void benchLoad();
+    void benchSave_data();
+    void benchSave();
+    void benchFind_data();
+    void benchFind();
+    void benchCompare_data();
+    void benchCompare();
+    void benchAnonymize_data();
+    void benchAnonymize();
+    void benchSplit_data();
+    void benchSplit();
+    void benchScriptFilter_data();
+    void benchScriptFilter();
+    void benchScriptFilterParallel_data();
+    void benchScriptFilterParallel();
+    void benchScriptGlobals_data();
+    void benchScriptGlobals();
+    void benchScriptGlobalsParallel_data();
+    void benchScriptGlobalsParallel();
+    void benchXsdLoad_data();
+    void benchXsdLoad();
+    void benchVisScan_data();
+    void benchVisScan();
+    void benchScanner_data();
+    void benchScanner();
+    void benchSessionEnroll_data();
+    void benchSessionEnroll();
+};
+
+#endif // BENCH_QXMLEDIT_H
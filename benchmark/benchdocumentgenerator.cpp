@@ -0,0 +1,220 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#include "benchdocumentgenerator.h"
+#include <QBuffer>
+
+#define SEARCH_TERM "needle"
+#define NS_FIRST    "urn:qxmledit:bench:first"
+#define NS_SECOND   "urn:qxmledit:bench:second"
+
+BenchDocumentGenerator::BenchDocumentGenerator()
+{
+}
+
+BenchDocumentGenerator::~BenchDocumentGenerator()
+{
+}
+
+QString BenchDocumentGenerator::shapeName(const EShape shape)
+{
+    switch(shape) {
+    case ShapeWide:
+        return "wide";
+    case ShapeDeep:
+        return "deep";
+    case ShapeAttributes:
+        return "attributes";
+    case ShapeText:
+        return "text";
+    case ShapeNamespaces:
+        return "namespaces";
+    default:
+        return "unknown";
+    }
+}
+
+QString BenchDocumentGenerator::splitPath(const EShape shape)
+{
+    switch(shape) {
+    case ShapeDeep:
+        return "/root/level";
+    case ShapeText:
+        return "/root/para";
+    case ShapeNamespaces:
+        return "/root/a:item";
+    default:
+        return "/root/item";
+    }
+}
+
+QString BenchDocumentGenerator::searchTerm()
+{
+    return SEARCH_TERM ;
+}
+
+/*!
+ * \brief BenchDocumentGenerator::value the variant differs every 50 records, to give the compare some work
+ */
+QString BenchDocumentGenerator::value(const int record, const bool isVariant)
+{
+    if(isVariant && (0 == (record % 50))) {
+        return QString("changed %1").arg(record);
+    }
+    if(0 == (record % 10)) {
+        return QString("value %1 " SEARCH_TERM).arg(record);
+    }
+    return QString("value %1").arg(record);
+}
+
+QByteArray BenchDocumentGenerator::generate(const EShape shape, const int records, const bool isVariant)
+{
+    QByteArray result;
+    QBuffer buffer(&result);
+    buffer.open(QIODevice::WriteOnly);
+    QTextStream stream(&buffer);
+    stream.setCodec("UTF-8");
+    stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    switch(shape) {
+    default:
+    case ShapeWide:
+        writeWide(stream, records, isVariant);
+        break;
+    case ShapeDeep:
+        writeDeep(stream, records, isVariant);
+        break;
+    case ShapeAttributes:
+        writeAttributes(stream, records, isVariant);
+        break;
+    case ShapeText:
+        writeText(stream, records, isVariant);
+        break;
+    case ShapeNamespaces:
+        writeNamespaces(stream, records, isVariant);
+        break;
+    }
+    stream.flush();
+    buffer.close();
+    return result;
+}
+
+void BenchDocumentGenerator::writeWide(QTextStream &stream, const int records, const bool isVariant)
+{
+    stream << "<root>\n";
+    for(int i = 0 ; i < records ; i ++) {
+        stream << " <item id=\"" << i << "\" code=\"c-" << i << "\">\n";
+        stream << "  <name>Item " << i << "</name>\n";
+        stream << "  <value>" << value(i, isVariant) << "</value>\n";
+        stream << " </item>\n";
+    }
+    stream << "</root>\n";
+}
+
+/*!
+ * \brief BenchDocumentGenerator::writeDeep each record is a chain of DeepLevels nested elements
+ */
+void BenchDocumentGenerator::writeDeep(QTextStream &stream, const int records, const bool isVariant)
+{
+    stream << "<root>\n";
+    const int chains = qMax(1, records / DeepLevels);
+    for(int i = 0 ; i < chains ; i ++) {
+        for(int level = 0 ; level < DeepLevels ; level ++) {
+            stream << "<level n=\"" << level << "\">";
+        }
+        stream << value(i, isVariant);
+        for(int level = 0 ; level < DeepLevels ; level ++) {
+            stream << "</level>";
+        }
+        stream << "\n";
+    }
+    stream << "</root>\n";
+}
+
+void BenchDocumentGenerator::writeAttributes(QTextStream &stream, const int records, const bool isVariant)
+{
+    stream << "<root>\n";
+    for(int i = 0 ; i < records ; i ++) {
+        stream << " <item id=\"" << i << "\"";
+        for(int attribute = 0 ; attribute < 20 ; attribute ++) {
+            stream << " a" << attribute << "=\"v" << attribute << "-" << i << "\"";
+        }
+        stream << " value=\"" << value(i, isVariant) << "\"/>\n";
+    }
+    stream << "</root>\n";
+}
+
+void BenchDocumentGenerator::writeText(QTextStream &stream, const int records, const bool isVariant)
+{
+    const QString filler = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt &amp; labore. ";
+    QString paragraph ;
+    while(paragraph.length() < TextParagraphSize) {
+        paragraph.append(filler);
+    }
+    stream << "<root>\n";
+    for(int i = 0 ; i < records ; i ++) {
+        stream << " <para id=\"" << i << "\">" << paragraph << value(i, isVariant) << "</para>\n";
+    }
+    stream << "</root>\n";
+}
+
+void BenchDocumentGenerator::writeNamespaces(QTextStream &stream, const int records, const bool isVariant)
+{
+    stream << "<root xmlns:a=\"" NS_FIRST "\" xmlns:b=\"" NS_SECOND "\">\n";
+    for(int i = 0 ; i < records ; i ++) {
+        stream << " <a:item xmlns:c=\"urn:qxmledit:bench:" << (i % 10) << "\" b:id=\"" << i << "\">\n";
+        stream << "  <b:name>Item " << i << "</b:name>\n";
+        stream << "  <c:value c:unit=\"kg\">" << value(i, isVariant) << "</c:value>\n";
+        stream << " </a:item>\n";
+    }
+    stream << "</root>\n";
+}
+
+/*!
+ * \brief BenchDocumentGenerator::generateSchema a schema with global complex types that reference each other
+ */
+QString BenchDocumentGenerator::generateSchema(const int types)
+{
+    QString result;
+    QTextStream stream(&result);
+    stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    stream << "<xs:schema xmlns:xs=\"http://www.w3.org/2001/XMLSchema\">\n";
+    stream << " <xs:element name=\"root\" type=\"T0\"/>\n";
+    for(int i = 0 ; i < types ; i ++) {
+        stream << " <xs:complexType name=\"T" << i << "\">\n";
+        stream << "  <xs:annotation><xs:documentation>Type " << i << "</xs:documentation></xs:annotation>\n";
+        stream << "  <xs:sequence>\n";
+        stream << "   <xs:element name=\"name\" type=\"xs:string\"/>\n";
+        stream << "   <xs:element name=\"code\"><xs:simpleType><xs:restriction base=\"xs:string\">"
+               "<xs:maxLength value=\"" << (10 + (i % 20)) << "\"/></xs:restriction></xs:simpleType></xs:element>\n";
+        if(i + 1 < types) {
+            stream << "   <xs:element name=\"next\" type=\"T" << (i + 1) << "\" minOccurs=\"0\"/>\n";
+        }
+        stream << "  </xs:sequence>\n";
+        stream << "  <xs:attribute name=\"id\" type=\"xs:int\" use=\"required\"/>\n";
+        stream << " </xs:complexType>\n";
+    }
+    stream << "</xs:schema>\n";
+    stream.flush();
+    return result;
+}
@@ -0,0 +1,71 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef BENCHDOCUMENTGENERATOR_H
+#define BENCHDOCUMENTGENERATOR_H
+
+#include <QString>
+#include <QByteArray>
+#include <QTextStream>
+
+/*!
+ * \brief The BenchDocumentGenerator class builds synthetic documents of a given shape and size.
+ * The content depends only on the arguments, so the runs are comparable.
+ */
+class BenchDocumentGenerator
+{
+public:
+    enum EShape {
+        ShapeWide,
+        ShapeDeep,
+        ShapeAttributes,
+        ShapeText,
+        ShapeNamespaces,
+        ShapeCount
+    };
+
+    static const int DeepLevels = 16 ;
+    static const int TextParagraphSize = 1024 ;
+
+private:
+    void writeWide(QTextStream &stream, const int records, const bool isVariant);
+    void writeDeep(QTextStream &stream, const int records, const bool isVariant);
+    void writeAttributes(QTextStream &stream, const int records, const bool isVariant);
+    void writeText(QTextStream &stream, const int records, const bool isVariant);
+    void writeNamespaces(QTextStream &stream, const int records, const bool isVariant);
+    static QString value(const int record, const bool isVariant);
+
+public:
+    BenchDocumentGenerator();
+    ~BenchDocumentGenerator();
+
+    QByteArray generate(const EShape shape, const int records, const bool isVariant = false);
+    QString generateSchema(const int types);
+
+    static QString shapeName(const EShape shape);
+    static QString splitPath(const EShape shape);
+    static QString searchTerm();
+};
+
+#endif // BENCHDOCUMENTGENERATOR_H
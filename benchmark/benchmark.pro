@@ -0,0 +1,93 @@
+#/**************************************************************************
+# *  This file is part of QXmlEdit                                         *
+# *  Copyright (C) 2019 by Luca Bellonda and individual contributors  *
+# *    as indicated in the AUTHORS file                                    *
+# *  lbellonda _at_ gmail.com                                              *
+# *                                                                        *
+# * This library is free software; you can redistribute it and/or          *
+# * modify it under the terms of the GNU Library General Public            *
+# * License as published by the Free Software Foundation; either           *
+# * version 2 of the License, or (at your option) any later version.       *
+# *                                                                        *
+# * This library is distributed in the hope that it will be useful,        *
+# * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+# * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+# * Library General Public License for more details.                       *
+# *                                                                        *
+# * You should have received a copy of the GNU Library General Public      *
+# * License along with this library; if not, write to the                  *
+# * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+# * Boston, MA  02110-1301  USA                                            *
+# **************************************************************************/
+
+#
+# Benchmarks of the core engines
+#
+#-------------------------------------------------
+
+###########################################
+include("../src/cconfig.pri")
+
+include(../src/coptions.pri)
+
+##############################################3
+
+# This is necessary to build the benchmark executable as an app
+DEFINES += LIBQXMLEDIT_LIBRARY_STATIC
+DEFINES += QXMLEDITSESSIONS_LIBRARY_STATIC
+DEFINES += QXMLEDIT_NOMAIN
+
+QT       += gui xml xmlpatterns svg testlib network sql
+
+macx: {
+    QT       += macextras
+}
+
+greaterThan(QT_MAJOR_VERSION, 4) {
+    QT       += printsupport widgets core
+    QT       += qml
+}
+
+isEqual(ENABLE_SCXML, "Y") {
+    QT       += scxml
+}
+
+greaterThan(QT_MAJOR_VERSION, 4) {
+win32 {
+    QT += winextras
+    DEFINES += "_NO_W32_PSEUDO_MODIFIERS"
+    DEFINES += "NOGDI"
+}
+}
+
+TARGET = qxmleditbenchmark
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+DESTDIR = ../build
+
+SOURCES += \
+    bench_qxmledit.cpp \
+    benchdocumentgenerator.cpp \
+    benchresults.cpp
+
+# object files
+OBJECTS_DIR = ../build/benchmark/obj
+MOC_DIR = ../build/benchmark/moc
+UI_DIR = ../build/benchmark/ui
+UI_HEADERS_DIR = ../build/benchmark/ui/include
+UI_SOURCES_DIR = ../build/benchmark/ui/src
+RCC_DIR = ../build/benchmark/rcc
+
+INCLUDEPATH += ../src
+
+# the tracked baseline, used when QXMLEDIT_BENCH_BASELINE is not set
+DEFINES += DEFAULT_BASELINE_FILE=\\\"$$PWD/baseline.json\\\"
+
+include("../src/allsources.pri")
+
+HEADERS += \
+    bench_qxmledit.h \
+    benchdocumentgenerator.h \
+    benchresults.h
@@ -0,0 +1,227 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#include "benchresults.h"
+#include <QFile>
+#include <QTextStream>
+#include <QHash>
+#if QT_VERSION >= QT_VERSION_CHECK(5,0,0)
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#endif
+
+BenchTimer::BenchTimer()
+{
+    _totalNs = 0 ;
+    _iterations = 0 ;
+}
+
+BenchTimer::~BenchTimer()
+{
+}
+
+void BenchTimer::start()
+{
+    _timer.start();
+}
+
+void BenchTimer::stop()
+{
+    _totalNs += _timer.nsecsElapsed();
+    _iterations ++ ;
+}
+
+int BenchTimer::iterations() const
+{
+    return _iterations ;
+}
+
+qint64 BenchTimer::nsPerIteration() const
+{
+    if(0 == _iterations) {
+        return 0 ;
+    }
+    return _totalNs / _iterations ;
+}
+
+//-------------------------------------------------------------------
+
+BenchResult::BenchResult()
+{
+    bytes = 0 ;
+    iterations = 0 ;
+    nsPerIteration = 0 ;
+}
+
+BenchResult::~BenchResult()
+{
+}
+
+QString BenchResult::key() const
+{
+    return QString("%1/%2").arg(name).arg(tag);
+}
+
+double BenchResult::megabytesPerSecond() const
+{
+    if((0 == nsPerIteration) || (0 == bytes)) {
+        return 0 ;
+    }
+    return (bytes / (1024.0 * 1024.0)) / (nsPerIteration / 1e9);
+}
+
+//-------------------------------------------------------------------
+
+BenchResults::BenchResults()
+{
+}
+
+BenchResults::~BenchResults()
+{
+}
+
+void BenchResults::add(const QString &name, const QString &tag, const qint64 bytes, const BenchTimer &timer)
+{
+    BenchResult result;
+    result.name = name ;
+    result.tag = tag ;
+    result.bytes = bytes ;
+    result.iterations = timer.iterations();
+    result.nsPerIteration = timer.nsPerIteration();
+    _results.append(result);
+}
+
+QList<BenchResult> BenchResults::results() const
+{
+    return _results ;
+}
+
+QString BenchResults::quote(const QString &text)
+{
+    QString result = text ;
+    result.replace("\\", "\\\\");
+    result.replace("\"", "\\\"");
+    return QString("\"%1\"").arg(result);
+}
+
+QString BenchResults::toJson(const int scale)
+{
+    QString json;
+    QTextStream stream(&json);
+    stream << "{\n";
+    stream << "  \"qtVersion\": " << quote(qVersion()) << ",\n";
+    stream << "  \"scale\": " << scale << ",\n";
+    stream << "  \"results\": [";
+    bool isFirst = true ;
+    foreach(const BenchResult &result, _results) {
+        stream << (isFirst ? "\n" : ",\n");
+        isFirst = false;
+        stream << "    { \"name\": " << quote(result.name)
+               << ", \"tag\": " << quote(result.tag)
+               << ", \"bytes\": " << result.bytes
+               << ", \"iterations\": " << result.iterations
+               << ", \"nsPerIteration\": " << result.nsPerIteration
+               << ", \"mbPerSecond\": " << QString::number(result.megabytesPerSecond(), 'f', 2)
+               << " }";
+    }
+    stream << "\n  ]\n}\n";
+    stream.flush();
+    return json;
+}
+
+bool BenchResults::writeJson(const QString &filePath, const int scale)
+{
+    QFile file(filePath);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const QByteArray data = toJson(scale).toUtf8();
+    const bool isOk = (file.write(data) == data.size());
+    file.close();
+    return isOk && (QFile::NoError == file.error());
+}
+
+/*!
+ * \brief BenchResults::compareWithBaseline a result slower than the baseline by more than the tolerance is a regression.
+ * The baseline must be measured at the same scale; the results that are not in the baseline are listed as missing.
+ * A baseline without results, or without any of the results of this run, is an error: it could never find a regression.
+ */
+bool BenchResults::compareWithBaseline(const QString &filePath, const int scale, const double tolerancePercent, QStringList &regressions, QStringList &missing, QString &errorMessage)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5,0,0)
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly)) {
+        errorMessage = QString("unable to open the baseline '%1'").arg(filePath);
+        return false;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    file.close();
+    if(QJsonParseError::NoError != parseError.error) {
+        errorMessage = QString("unable to parse the baseline '%1': %2").arg(filePath).arg(parseError.errorString());
+        return false;
+    }
+    const int baselineScale = document.object().value("scale").toInt();
+    if(baselineScale != scale) {
+        errorMessage = QString("the baseline '%1' is measured at scale %2, this run at scale %3").arg(filePath).arg(baselineScale).arg(scale);
+        return false;
+    }
+    QHash<QString, qint64> baseline;
+    foreach(const QJsonValue &value, document.object().value("results").toArray()) {
+        const QJsonObject object = value.toObject();
+        const QString key = QString("%1/%2").arg(object.value("name").toString()).arg(object.value("tag").toString());
+        baseline.insert(key, static_cast<qint64>(object.value("nsPerIteration").toDouble()));
+    }
+    if(baseline.isEmpty()) {
+        errorMessage = QString("the baseline '%1' has no results, record one with QXMLEDIT_BENCH_OUTPUT").arg(filePath);
+        return false;
+    }
+    foreach(const BenchResult &result, _results) {
+        const qint64 reference = baseline.value(result.key(), 0);
+        if(reference <= 0) {
+            missing.append(result.key());
+            continue;
+        }
+        const double change = 100.0 * (result.nsPerIteration - reference) / reference ;
+        if(change > tolerancePercent) {
+            regressions.append(QString("%1: %2 ns, baseline %3 ns (+%4%)")
+                               .arg(result.key()).arg(result.nsPerIteration).arg(reference).arg(change, 0, 'f', 1));
+        }
+    }
+    if(!_results.isEmpty() && (missing.size() == _results.size())) {
+        errorMessage = QString("none of the results is in the baseline '%1'").arg(filePath);
+        return false;
+    }
+    return true;
+#else
+    Q_UNUSED(filePath);
+    Q_UNUSED(scale);
+    Q_UNUSED(tolerancePercent);
+    Q_UNUSED(regressions);
+    Q_UNUSED(missing);
+    errorMessage = "the baseline comparison requires Qt 5";
+    return false;
+#endif
+}
@@ -0,0 +1,88 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef BENCHRESULTS_H
+#define BENCHRESULTS_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QElapsedTimer>
+
+/*!
+ * \brief The BenchTimer class sums only the measured section of each benchmark iteration.
+ */
+class BenchTimer
+{
+    QElapsedTimer _timer;
+    qint64 _totalNs;
+    int _iterations;
+public:
+    BenchTimer();
+    ~BenchTimer();
+
+    void start();
+    void stop();
+    int iterations() const;
+    qint64 nsPerIteration() const;
+};
+
+class BenchResult
+{
+public:
+    QString name;
+    QString tag;
+    qint64 bytes;
+    int iterations;
+    qint64 nsPerIteration;
+
+    BenchResult();
+    ~BenchResult();
+
+    QString key() const;
+    double megabytesPerSecond() const;
+};
+
+/*!
+ * \brief The BenchResults class collects the measures and writes them as JSON,
+ * a previous run can be used as a baseline to find regressions.
+ */
+class BenchResults
+{
+    QList<BenchResult> _results;
+
+    static QString quote(const QString &text);
+
+public:
+    BenchResults();
+    ~BenchResults();
+
+    void add(const QString &name, const QString &tag, const qint64 bytes, const BenchTimer &timer);
+    QList<BenchResult> results() const;
+    QString toJson(const int scale);
+    bool writeJson(const QString &filePath, const int scale);
+    bool compareWithBaseline(const QString &filePath, const int scale, const double tolerancePercent, QStringList &regressions, QStringList &missing, QString &errorMessage);
+};
+
+#endif // BENCHRESULTS_H
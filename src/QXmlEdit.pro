@@ -183,6 +183,7 @@ HEADERS = precompiled_app.h \
     infodialog.h \
    visualization/elementbase.h \
     visualization/visdatamap.h \
+    visualization/visdatatables.h \
     visualization/vismapdialog.h \
     visualization/visdatarow.h \
     visualization/datavisualization.h \
@@ -195,6 +196,8 @@ HEADERS = precompiled_app.h \
     visualization/choosecolormap.h \
     visualization/cmapitemdelegate.h \
     visualization/graycolormap.h \
+    visualization/vismapgrid.h \
+    visualization/vismapanalysis.h \
     modules/replica/replicaclonedialog.h \
     modules/export/exportoptionsdialog.h \
     modules/anonymize/anonymizebatch.h \
@@ -218,12 +221,15 @@ HEADERS = precompiled_app.h \
     modules/utils/comboutils.h \
     modules/xslt/showxslerrorsdialog.h \
     modules/help/shortcutsdialog.h \
+    modules/help/perftracedialog.h \
     modules/style/infoonkeyboardshortcutsdialog.h \
     modules/style/editingtypesdialog.h \
     modules/help/firstaccessdialog.h \
     modules/help/guidedoperationsdialog.h \
     modules/help/guidedvalidationdialog.h \
     modules/services/startactionsengine.h \
+    modules/services/batchjob.h \
+    modules/services/batchrunner.h \
     modules/xml/configuregeneralindentation.h \
     modules/uiutil/defaultuidelegate.h \
     widgets/infoonkeyboardshoertcuts.h \
@@ -284,6 +290,7 @@ SOURCES = \
     modules/anonymize/anonsettingwidget.cpp \
     visualization/elementbase.cpp \
     visualization/visdatamap.cpp \
+    visualization/visdatatables.cpp \
     visualization/vismapdialog.cpp \
     visualization/visdatarow.cpp \
     visualization/datavisualization.cpp \
@@ -296,6 +303,8 @@ SOURCES = \
     visualization/choosecolormap.cpp \
     visualization/cmapitemdelegate.cpp \
     visualization/graycolormap.cpp \
+    visualization/vismapgrid.cpp \
+    visualization/vismapanalysis.cpp \
     infodialog.cpp \
     mainwindowio.cpp \
     modules/replica/replicaclonedialog.cpp \
@@ -323,6 +332,7 @@ SOURCES = \
     modules/xslt/showxslerrorsdialog.cpp \
     startparams.cpp \
     modules/help/shortcutsdialog.cpp \
+    modules/help/perftracedialog.cpp \
     modules/style/infoonkeyboardshortcutsdialog.cpp \
     modules/style/editingtypesdialog.cpp \
     modules/help/firstaccessdialog.cpp \
@@ -330,6 +340,8 @@ SOURCES = \
     modules/help/guidedvalidationdialog.cpp \
     qxmleditapplicationcommands.cpp \
     modules/services/startactionsengine.cpp \
+    modules/services/batchjob.cpp \
+    modules/services/batchrunner.cpp \
     startactionsapplication.cpp \
     modules/xml/configuregeneralindentation.cpp \
     modules/uiutil/defaultuidelegate.cpp \
@@ -395,6 +407,7 @@ FORMS = MainWindow.ui \
     modules/xslt/xsltexecdialog.ui \
     modules/xslt/showxslerrorsdialog.ui \
     modules/help/shortcutsdialog.ui \
+    modules/help/perftracedialog.ui \
     modules/style/infoonkeyboardshortcutsdialog.ui \
     modules/style/editingtypesdialog.ui \
     modules/help/firstaccessdialog.ui \
@@ -220,6 +220,7 @@ SOURCES += xmleditwidget.cpp \
     modules/graph/tagmarker.cpp \
     modules/graph/tagspring.cpp \
     modules/graph/nodesrelationscontroller.cpp \
+    modules/graph/tagforces.cpp \
     extraction/extractfragmentsdialog.cpp \
     extraction/extractionfrontend.cpp \
     extraction/extractionoperation.cpp \
@@ -250,6 +251,7 @@ SOURCES += xmleditwidget.cpp \
     modules/binaryviewer/binaryviewerdialog.cpp \
     modules/binaryviewer/binaryviewermodel.cpp \
     modules/binaryviewer/binaryblock.cpp \
+    modules/binaryviewer/binarysearch.cpp \
     modules/search/searchletdialog.cpp \
     modules/search/searchletmanager.cpp \
     modules/search/editsearchletdialog.cpp \
@@ -316,11 +318,13 @@ SOURCES += xmleditwidget.cpp \
     modules/anonymize/anonseqproducer.cpp \
     modules/anonymize/anonattr.cpp \
     modules/anonymize/anonoperationbatch.cpp \
+    modules/anonymize/anonfolderbatch.cpp \
     modules/anonymize/anonnullalg.cpp \
     modules/xml/elementPath.cpp \
     modules/xml/elmpath.cpp \
     modules/anonymize/xmlanonutils.cpp \
     modules/search/elmfindtext.cpp \
+    modules/search/textsearchindex.cpp \
     modules/xsd/xsdsinglecommentdialog.cpp \
     modules/xsd/xsdfullannotationsdialog.cpp \
     modules/xsd/xsddefaultannotationeditor.cpp \
@@ -335,6 +339,7 @@ SOURCES += xmleditwidget.cpp \
     modules/xsd/xsdschemainstance.cpp \
     modules/xsd/namespacemanager.cpp \
     modules/xml/elementNS.cpp \
+    modules/xml/namespacescope.cpp \
     modules/xsd/xsiinsertattributedialog.cpp \
     modules/namespace/usernamespace.cpp \
     modules/namespace/namespacemanagementdialog.cpp \
@@ -344,11 +349,15 @@ SOURCES += xmleditwidget.cpp \
     modules/namespace/nstableutils.cpp \
     modules/namespace/usernamespaceloader.cpp \
     modules/utils/base64utils.cpp \
+    modules/utils/perftrace.cpp \
     modules/xsd/schemareferencesdialog.cpp \
     modules/namespace/namespacereferenceentry.cpp \
     modules/xml/insertxsdreference.cpp \
     modules/xml/xmlio.cpp \
     modules/xml/xmlloadcontext.cpp \
+    modules/xml/xmlsourcemap.cpp \
+    modules/xml/xmlstreamscanner.cpp \
+    modules/xml/xmlbackgroundloader.cpp \
     undo/undodtd.cpp \
     modules/replica/replicacommand.cpp \
     modules/replica/replicamanager.cpp \
@@ -429,6 +438,7 @@ SOURCES += xmleditwidget.cpp \
     xsdeditor/choosexsdviewrootitemdialog.cpp \
     xsdeditor/items/xschemabaseitemlayout.cpp \
     visualization/attributessummarydata.cpp \
+    visualization/fileanalysiscache.cpp \
     xsdeditor/xsdprint.cpp \
     xsdeditor/xsdreport.cpp \
     xsdeditor/choosexsdreporttypedialog.cpp \
@@ -444,6 +454,7 @@ SOURCES += xmleditwidget.cpp \
     extraction/scripting/events/extractionscripttext.cpp \
     extraction/scripting/events/extractionscriptelement.cpp \
     extraction/scripting/extractionscriptmanager.cpp \
+    extraction/scripting/extractionscriptparallel.cpp \
     extraction/scripting/extractionscriptfilter.cpp \
     extraction/scripting/extractionscriptexecutor.cpp \
     extraction/scripting/extractionoperationscripting.cpp \
@@ -543,6 +554,7 @@ HEADERS += precompiled_lib.h \
     modules/graph/tagmarker.h \
     modules/graph/tagspring.h \
     modules/graph/nodesrelationscontroller.h \
+    modules/graph/tagforces.h \
     extraction/extractfragmentsdialog.h \
     extraction/extractionfrontend.h \
     extraction/extractionoperation.h \
@@ -575,10 +587,12 @@ HEADERS += precompiled_lib.h \
     modules/binaryviewer/binaryviewerdialog.h \
     modules/binaryviewer/binaryviewermodel.h \
     modules/binaryviewer/binaryblock.h \
+    modules/binaryviewer/binarysearch.h \
     globals/includes/data/DataInterface.h \
     globals/includes/data/GenericPersistentData.h \
     modules/search/searchletdialog.h \
     modules/search/searchletmanager.h \
+    modules/search/textsearchindex.h \
     modules/search/editsearchletdialog.h \
     modules/metadata/basecomplexvariable.h \
     modules/metadata/metadataparser.h \
@@ -628,8 +642,10 @@ HEADERS += precompiled_lib.h \
     modules/anonymize/anonseqproducer.h \
     modules/anonymize/anonattr.h \
     modules/anonymize/anonoperationbatch.h \
+    modules/anonymize/anonfolderbatch.h \
     modules/anonymize/anonnullalg.h \
     modules/xml/elmpath.h \
+    modules/xml/namespacescope.h \
     modules/anonymize/xmlanonutils.h \
     modules/xsd/xsdsinglecommentdialog.h \
     modules/xsd/xsdfullannotationsdialog.h \
@@ -650,10 +666,14 @@ HEADERS += precompiled_lib.h \
     modules/namespace/nstableutils.h \
     modules/namespace/usernamespaceloader.h \
     modules/utils/base64utils.h \
+    modules/utils/perftrace.h \
     modules/namespace/namespaceresult.h \
     modules/xsd/schemareferencesdialog.h \
     modules/namespace/namespacereferenceentry.h \
     modules/xml/xmlloadcontext.h \
+    modules/xml/xmlsourcemap.h \
+    modules/xml/xmlstreamscanner.h \
+    modules/xml/xmlbackgroundloader.h \
     undo/undodtd.h \
     modules/replica/replicacommand.h \
     modules/replica/replicamanager.h \
@@ -722,12 +742,14 @@ HEADERS += precompiled_lib.h \
     xsdeditor/xschemaoutlineelement.h \
     xsdeditor/choosexsdviewrootitemdialog.h \
     visualization/attributessummarydata.h \
+    visualization/fileanalysiscache.h \
     xsdeditor/xsdreport.h \
     xsdeditor/choosexsdreporttypedialog.h \
     modules/xsd/xsdvalidationexecutor.h \
     timelapse.h \
     xsdeditor/infofacet.h \
     extraction/scripting/extractionscriptmanager.h \
+    extraction/scripting/extractionscriptparallel.h \
     extraction/scripting/extractionscriptfilter.h \
     extraction/scripting/extractionscriptexecutor.h \
     extraction/scripting/events/extractionscripttext.h \
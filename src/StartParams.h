@@ -36,7 +36,8 @@ public:
         OpenFile,
         VisFile,
         Anonymize,
-        XSLExec
+        XSLExec,
+        Batch
     };
 
     ESPType type;
@@ -49,11 +50,13 @@ public:
     QString xsl;
     QString outputFile;
     bool forceSaxon;
+    int threads;
 
     StartParams();
     ~StartParams();
 
     bool decodeCommandLine(QStringList args);
+    static bool isBatchCommandLine(int argc, char *argv[]);
 };
 
 #endif // STARTPARAMS_H
@@ -39,6 +39,8 @@
 #include "modules/anonymize/anonimyzebatchdialog.h"
 #include "modules/style/choosestyledialog.h"
 #include "mainwindow.h"
+#include "modules/utils/perftrace.h"
+#include <QTimer>
 
 #define HELP_FILE       "QXmlEdit_manual.pdf"
 
@@ -51,12 +53,13 @@ const char VERSION[] = { VERSION_STRING_PREFIXED };
 
 int ApplicationData::pluginCode = 0 ;
 
-ApplicationData::ApplicationData()
+ApplicationData::ApplicationData(const bool isHeadless) : QXmlEditData(isHeadless)
 {
     _keyInfoWidget = NULL ;
     _lastActivatedWindow = NULL;
     _shortcutPanelState = Config::getBool(Config::KEY_USERPROFILING_SHOWKEYBOARD_SHORTCUTS, false) ;
     _dbStarted = false ;
+    _sessionsStarted = false ;
     _dataInterface = NULL ;
     _sessionDataInterface = NULL ;
     _uiServices = NULL ;
@@ -78,9 +81,11 @@ ApplicationData::ApplicationData()
         _plugins.insert(QString(pluginCode), xsdPlugin);
     }
     configureXsdCache();
-    _uiServices = new UIServices() ;
-    if(NULL == _uiServices) {
-        Utils::error(tr("Unable to initialize the application.")) ;
+    if(!isHeadless) {
+        _uiServices = new UIServices() ;
+        if(NULL == _uiServices) {
+            Utils::error(tr("Unable to initialize the application.")) ;
+        }
     }
 }
 
@@ -106,11 +111,34 @@ ApplicationData::~ApplicationData()
 
 
 void ApplicationData::init()
+{
+    init(false);
+}
+
+/*!
+ * \brief if isSessionsDeferred the sessions database is opened
+ * from the event loop, after the first window is shown.
+ */
+void ApplicationData::init(const bool isSessionsDeferred)
 {
     // already done QXmlEditData::init();
     connect(&_sessionManager, SIGNAL(sessionActivated(const int)), this, SLOT(onSessionActivated(const int)));
     connect(&_sessionManager, SIGNAL(clearSession()), this, SLOT(onClearSession()));
     _sessionManager.setSessionDataFactory(this);
+    if(isSessionsDeferred) {
+        QTimer::singleShot(0, this, SLOT(startSessions()));
+    } else {
+        startSessions();
+    }
+}
+
+void ApplicationData::startSessions()
+{
+    if(_sessionsStarted) {
+        return ;
+    }
+    _sessionsStarted = true ;
+    QXMLEDIT_TRACE_ZONE("startup", "sessions");
     _sessionManager.init(sessionDBFilePath());
     if(!_sessionManager.isStarted()) {
         Utils::error(tr("Sessions not started"));
@@ -119,7 +147,13 @@ void ApplicationData::init()
     activateSessionIfEnabled();
     SessionDataInterface *dataInterface = sessionDataInterface("");
     _attributeFilterManagement.setDataAccess(dataInterface);
-    _namespaceManager->setDataInterface(storageManager());
+    // files opened before the sessions were ready
+    foreach(MainWindow * window, _windows) {
+        QString filePath = window->getRegola()->fileName();
+        if(!filePath.isEmpty()) {
+            _sessionManager.enrollFile(filePath);
+        }
+    }
 }
 
 /** hook for pre-delete
@@ -435,7 +469,7 @@ void ApplicationData::setupStorage()
 #if defined(BACKEND_SESSION_DB)
     SQLLiteDataAccess *dataAccess = new SQLLiteDataAccess();
     dataAccess->setLogger(_logger);
-    if(!dataAccess->init(_sessionDBPath)) {
+    if(!dataAccess->init(sessionDBFilePath())) {
         delete dataAccess ;
         return ;
     }
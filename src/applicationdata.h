@@ -54,6 +54,7 @@ class ApplicationData : public QXmlEditData, public SessionDataFactory
     AttributeFilterManagement _attributeFilterManagement;
     SessionDataInterface *_sessionDataInterface;
     bool _dbStarted;
+    bool _sessionsStarted;
     MainWindow *_lastActivatedWindow;
     QWidget *_keyInfoWidget;
 
@@ -62,10 +63,11 @@ private:
 
 
 public:
-    ApplicationData();
+    explicit ApplicationData(const bool isHeadless = false);
     virtual ~ApplicationData();
 
     virtual void init();
+    void init(const bool isSessionsDeferred);
     virtual void end();
 
     void addWindow(MainWindow* newWindow);
@@ -191,6 +193,8 @@ public:
     MainWindow *lastValidWindow();
 
     bool askForQuit();
+public slots:
+    void startSessions();
 private slots:
     void onSessionActivated(const int idSession);
     void onClearSession();
@@ -95,6 +95,7 @@ const QString Config::KEY_SEARCH_SEL2BOOKMARK("search/selToBoorkmark");
 const QString Config::KEY_SEARCH_FINDTARGET("search/findTarget");
 const QString Config::KEY_SEARCH_SHOWSIZE("search/showSize");
 const QString Config::KEY_SEARCH_USEXQUERY("search/useXQuery");
+const QString Config::KEY_SEARCH_USEINDEX("search/useIndex");
 const QString Config::KEY_SEARCH_ITEMS("search/items");
 const QString Config::KEY_SEARCH_SCOPES("search/scopes");
 const QString Config::KEY_SEARCH_WRAPAROUND("search/wrapAround");
@@ -143,6 +144,7 @@ const QString Config::KEY_FRAGMENTS_FILTERTEXT_PATH("extractFragments/pathForFil
 const QString Config::KEY_FRAGMENTS_OPERATION_TYPE("extractFragments/operationType");
 const QString Config::KEY_FRAGMENTS_USENAMESPACES("extractFragments/useNameSpaces");
 const QString Config::KEY_FRAGMENTS_FILTERSID("extractFragments/filtersId");
+const QString Config::KEY_FRAGMENTS_SCRIPTINGTHREADS("extractFragments/scriptingThreads");
 
 // welcome dialog and user profiling
 const QString Config::KEY_WELCOMEDIALOG_ENABLED("welcomeDialog/enabled");
@@ -237,6 +239,8 @@ const QString Config::KEY_COLOR_ANONATTRPREVIEW("colors/anonAttrPreview");
 
 // xml
 const QString Config::KEY_XML_SAVE_SORTATTRIBUTES("xml/sortAttributes");
+const QString Config::KEY_XML_SAVE_INCREMENTAL("xml/saveIncremental");
+const QString Config::KEY_XML_SAMPLE_STOPUNCHANGED("xml/sampleStopUnchanged");
 //deprecated: do not use
 const QString Config::deprecated_KEY_XML_LOAD_STREAM("xml/loadStream"); // deprecated
 const QString Config::deprecated_KEY_XML_SAVE_STREAM("xml/saveStream"); // deprecated
@@ -62,6 +62,7 @@ void ConfigureXMLManagementDialog::init(ApplicationData* data)
     calcEnableProlog();
     enableIndent();
     ui->chkSortAttributes->setChecked(Regola::isSaveSortAlphaAttribute());
+    ui->chkIncrementalSave->setChecked(Regola::isSaveIncremental());
     _attributeHelper.setUp(data->xmlIndentAttributesType(), data->xmlIndentAttributes());
     ui->cbProcessFormattingMetadata->setChecked(data->isFormattingInfoEnabled());
     ui->cbInsertFormattingMetadata->setChecked(data->isFormattingInfoInsertOnNew());
@@ -148,6 +149,13 @@ void ConfigureXMLManagementDialog::on_chkSortAttributes_stateChanged(int /*state
     }
 }
 
+void ConfigureXMLManagementDialog::on_chkIncrementalSave_stateChanged(int /*state*/)
+{
+    if(_started) {
+        Config::saveBool(Config::KEY_XML_SAVE_INCREMENTAL, ui->chkIncrementalSave->isChecked());
+    }
+}
+
 void ConfigureXMLManagementDialog::on_attrCharacters_valueChanged(int /*i*/)
 {
     // can ignore it, just update it on saving
@@ -62,6 +62,7 @@ private slots:
     void on_cmdIndentReset_clicked();
     void on_chkNoIndent_stateChanged(int /*state*/);
     void on_chkSortAttributes_stateChanged(int /*state*/);
+    void on_chkIncrementalSave_stateChanged(int /*state*/);
     void on_attrCharacters_valueChanged(int /*i*/);
     void on_attrNoIndendation_clicked(bool /*checked*/);
     void on_attrNewLineAt_clicked(bool /*checked*/);
@@ -32,6 +32,7 @@
 
 #include "undo/undopasteattributescommand.h"
 #include "modules/anonymize/anonbase.h"
+#include "modules/utils/base64utils.h"
 
 
 bool NamespacesInfo::isUsedPrefixForOtherNamespace(const QString &nsURI, const QString &prefix)
@@ -160,6 +161,20 @@ TextChunk *TextChunk::clone()
     return cloned;
 }
 
+/*!
+ * \brief TextChunk::decodedBase64Preview decodes only the part of the text that can be shown,
+ * caching it until the text changes
+ */
+QString TextChunk::decodedBase64Preview()
+{
+    if(_previewSource.isNull() || (_previewSource != text)) {
+        // the decoded text must exceed the display limit to be marked as truncated, max 4 bytes per char
+        _previewDecoded = Base64Utils::decodedTextPrefix(text, (Element::MAX_LIMIT_LARGE_TEXTLEN + 1) * 4);
+        _previewSource = text ;
+    }
+    return _previewDecoded ;
+}
+
 long  Element::instances = 0;
 
 Element::Element(const QString &newTag, const QString &itext, Regola *regola, Element *parent)
@@ -190,6 +205,9 @@ Element::~Element()
     }
     clearTextNodes();
     clearAttributes();
+    if(NULL != parentRule) {
+        parentRule->notifyElementRemoved(this);
+    }
     parentRule = NULL;
     parentElement = NULL ;
 }
@@ -207,6 +225,8 @@ void Element::houseWork(Regola *regola, Element *parent)
     ui = NULL;
     parentRule = regola ;
     parentElement = parent;
+    _namespaceScope = NULL ;
+    _namespaceScopeGeneration = 0 ;
     wasOpen = false;
     _isCData = false ;
     //_isEntityReference = false;
@@ -225,6 +245,7 @@ Element *Element::setParent(Element *newParent)
 {
     Element *currentParent = parent();
     parentElement = newParent ;
+    namespacesChanged();
     return currentParent ;
 }
 
@@ -364,7 +385,8 @@ VStyle *Element::calcStyle(PaintInfo *paintInfo)
     if(NULL != style) {
         QString ns = style->getNamespace();
         if(!ns.isEmpty()) {
-            QString prefix = parentRule->getCachedPrefixNS(ns);
+            QString prefix ;
+            findPrefixForNamespace(ns, prefix);
             if(! _tag.startsWith(prefix)) {
                 style = NULL ;
             }
@@ -1057,6 +1079,84 @@ bool Element::generateDom(QDomDocument &document, QDomNode &parent, ElementLoadI
     return result;
 }
 
+/*!
+ * \brief builds a namespace aware DOM, as the one a namespace processing parser
+ * would build: the namespace declarations are resolved and not added as attributes.
+ * \param namespaces the uri of each prefix in scope, the empty prefix is the default namespace
+ */
+bool Element::generateDomNS(QDomDocument &document, QDomNode &parent, ElementLoadInfoMap *dataMap, const QHash<QString, QString> &namespaces)
+{
+    bool result = true;
+    QString prevDMKey ;
+    if(NULL != dataMap) {
+        prevDMKey = dataMap->currentKey ;
+        handleMapEncodingPreInsert(parent, dataMap);
+    }
+    switch(type) {
+    default:
+    case ET_ELEMENT: {
+        // the copy is shared until a declaration modifies it
+        QHash<QString, QString> scope = namespaces ;
+        foreach(Attribute * attribute, attributes) {
+            QString nsPrefix ;
+            if(XmlUtils::getNsPrefix(attribute->name, nsPrefix)) {
+                scope.insert(nsPrefix, attribute->value);
+            }
+        }
+        QString prefix ;
+        QString localName ;
+        XmlUtils::decodeQualifiedName(tag(), prefix, localName);
+        QDomElement node = document.createElementNS(scope.value(prefix), tag());
+
+        foreach(TextChunk * tx, textNodes) {
+            if(tx->isCDATA) {
+                node.appendChild(document.createCDATASection(tx->text));
+            } else {
+                node.appendChild(document.createTextNode(tx->text));
+            }
+        }
+
+        foreach(Attribute * attribute, attributes) {
+            if(XmlUtils::isDeclaringNS(attribute->name)) {
+                continue;
+            }
+            XmlUtils::decodeQualifiedName(attribute->name, prefix, localName);
+            // unprefixed attributes have no namespace
+            node.setAttributeNS(prefix.isEmpty() ? QString("") : scope.value(prefix), attribute->name, attribute->value);
+        }
+
+        parent.appendChild(node);
+        foreach(Element * value, childItems) {
+            if(!value->generateDomNS(document, node, dataMap, scope)) {
+                result = false;
+                break;
+            }
+        }
+    }
+    break;
+
+    case ET_PROCESSING_INSTRUCTION:
+        parent.appendChild(document.createProcessingInstruction(getPITarget(), getPIData()));
+        break;
+
+    case ET_COMMENT:
+        parent.appendChild(document.createComment(getComment()));
+        break;
+
+    case ET_TEXT:
+        if(_isCData) {
+            parent.appendChild(document.createCDATASection(text));
+        } else {
+            parent.appendChild(document.createTextNode(text));
+        }
+        break;
+    }
+    if(NULL != dataMap) {
+        dataMap->currentKey = prevDMKey ;
+    }
+    return result;
+}
+
 bool Element::writeStream(XMLSaveContext *context, QXmlStreamWriter &writer, ElementLoadInfoMap *dataMap)
 {
     bool result = true;
@@ -1072,10 +1172,10 @@ bool Element::writeStream(XMLSaveContext *context, QXmlStreamWriter &writer, Ele
         writer.writeStartElement(tag());
         checkSaveAndSetIndent(context, writer);
 
-        int indentBase = context->indentBase(tag());
+        const int indentBase = context->isUsingDevicePosition() ? context->indentBase(_tag) : 0 ;
         context->startElement(writer);
 
-        if(context->isSortAttributesAlpha()) {
+        if(context->isSortAttributesAlpha() && (attributes.size() > 1)) {
             QList<Attribute*> attributesList = Element::sortAttributesList(attributes);
 
             foreach(Attribute * attr, attributesList) {
@@ -1093,12 +1193,13 @@ bool Element::writeStream(XMLSaveContext *context, QXmlStreamWriter &writer, Ele
             }
         }
         if(context->hasNamespaceDeclarations()) {
-            QHash<QString, QString> nss = context->namespaceDeclarations();
-            foreach(QString key, nss.keys()) {
+            const QHash<QString, QString> &nss = context->namespaceDeclarationsReference();
+            QHash<QString, QString>::const_iterator ns = nss.constBegin();
+            while(ns != nss.constEnd()) {
                 context->incAttributePos(writer, indentBase);
-                QString name = XmlUtils::makeNSDeclaration(key);
-                writer.writeAttribute(name, nss.value(key));
+                writer.writeAttribute(XmlUtils::makeNSDeclaration(ns.key()), ns.value());
                 context->afterAttributePos(writer);
+                ++ns;
             }
             context->clearNamespaceDeclarations();
         }
@@ -1121,6 +1222,9 @@ bool Element::writeStream(XMLSaveContext *context, QXmlStreamWriter &writer, Ele
         }
         context->decLevel();
         writer.writeEndElement();
+        if(!context->flushOutput(false)) {
+            result = false;
+        }
     }
     break;
 
@@ -1173,6 +1277,7 @@ bool Element::isEmpty() const
 void Element::clearAttributes()
 {
     EMPTYPTRLIST(attributes, Attribute);
+    namespacesChanged();
 }
 
 bool Element::addAttribute(const QString &name, const QString &value)
@@ -1193,6 +1298,9 @@ bool Element::addAttribute(const QString &name, const QString &value)
             //}
             attributes.append(attribute);
         }
+        if(XmlUtils::isDeclaringNS(name)) {
+            namespacesChanged();
+        }
         return true;
     }
     return false;
@@ -1221,6 +1329,7 @@ Element *Element::fromModelIndex(const QModelIndex & index)
 void Element::addChild(Element *newElement)
 {
     newElement->parentElement = this ;
+    namespacesChanged();
     childItems.append(newElement);
     addChildInfo(newElement);
 }
@@ -1228,6 +1337,7 @@ void Element::addChild(Element *newElement)
 void Element::addChildAt(Element *newElement, const int position)
 {
     newElement->parentElement = this ;
+    namespacesChanged();
     childItems.insert(position, newElement);
     addChildInfo(newElement);
 }
@@ -1236,6 +1346,7 @@ void Element::addChildAt(Element *newElement, const int position)
 int Element::addChildAfter(Element *newElement, Element *brotherElement)
 {
     newElement->parentElement = this ;
+    namespacesChanged();
     if(NULL == brotherElement) {
         childItems.append(newElement);
         return childItems.size() - 1;
@@ -1409,6 +1520,7 @@ void Element::autoDelete(const bool deleteMe, const bool holdSignal, const bool
     if(!dontRemoveUI) {
         deleteUI();
     }
+    parentRule->notifyElementRemoved(this);
     if(!holdSignal) {
         parentRule->setModified(true) ;
     }
@@ -1426,6 +1538,9 @@ void Element::autoDeleteRecursiveInner()
     // let the parent deal with this
     zeroUISelf(false);
     ui = NULL ;
+    if(NULL != parentRule) {
+        parentRule->notifyElementRemoved(this);
+    }
     parentRule = NULL;
 }
 
@@ -1451,6 +1566,7 @@ void Element::autoDeleteRecursive()
     } else {
         zeroUISelf(false);
     }
+    parentRule->notifyElementRemoved(this);
     parentRule->setModified(true) ;
     parentRule = NULL;
     delete this;
@@ -1535,6 +1651,14 @@ Element *Element::cutToClipboard()
 
 void Element::setRegola(Regola *newRegola, const bool isRecursive)
 {
+    if(newRegola != parentRule) {
+        if(NULL != parentRule) {
+            parentRule->notifyElementRemoved(this);
+        }
+        // the scope is owned by the table of the old document, the generations of different tables are not related
+        _namespaceScope = NULL ;
+        _namespaceScopeGeneration = 0 ;
+    }
     parentRule = newRegola ;
     if(isRecursive) {
         foreach(Element * child, childItems) {
@@ -2722,6 +2846,9 @@ bool Element::removeAttribute(const QString &name)
             if(index >= 0) {
                 delete attributes.at(index);
                 attributes.remove(index);
+                if(XmlUtils::isDeclaringNS(name)) {
+                    namespacesChanged();
+                }
                 return true;
             }
         }
@@ -48,6 +48,7 @@ QSet<QString> ExtractionAdavancedOptionsDialog::setOfScripts()
 void ExtractionAdavancedOptionsDialog::setup()
 {
     ui->cbUseNamespaces->setChecked(_operation->isUseNamespaces());
+    ui->sbScriptingThreads->setValue(_operation->scriptingThreads());
     setupScripts();
 }
 
@@ -98,6 +99,7 @@ QTableWidgetItem* ExtractionAdavancedOptionsDialog::newTableItem(const QString &
 void ExtractionAdavancedOptionsDialog::accept()
 {
     _operation->setUseNamespaces(ui->cbUseNamespaces->isChecked());
+    _operation->setScriptingThreads(ui->sbScriptingThreads->value());
     QStringList ids;
     const int rows = ui->scriptTable->rowCount();
     FORINT(row, rows) {
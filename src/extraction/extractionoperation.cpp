@@ -28,6 +28,7 @@
 #include <QDateTime>
 #include <QTextCodec>
 #include "qxmleditconfig.h"
+#include "scripting/extractionscriptparallel.h"
 
 const qint64 ExtractionOperation::InputFileBufferSize = 512000;
 
@@ -40,6 +41,7 @@ ExtractionOperation::ExtractionOperation(ExtractResults *results, QObject *paren
 
 ExtractionOperation::~ExtractionOperation()
 {
+    endParallelScripting();
 }
 
 void ExtractionOperation::init()
@@ -68,6 +70,9 @@ void ExtractionOperation::init()
     percent = 0 ;
     _size = 0 ;
     _useNamespaces = true ;
+    _scriptingThreads = 1 ;
+    _parallelScripting = NULL ;
+    _isScriptingByFragment = false;
 
     //---------------------
     _isError = false ;
@@ -96,6 +101,7 @@ void ExtractionOperation::performExtraction()
         } else {
             _results->_fileName = _inputFile ;
             execute(&inputFile);
+            endParallelScripting();
             inputFile.close();
         }
     }
@@ -174,6 +180,10 @@ void ExtractionOperation::execute(QFile *file)
             setError(EXML_InitScripting, tr("Scripting engine initialization failed: %1").arg(_scriptManager.errorMessage()));
             return ;
         }
+        if(!startParallelScripting()) {
+            setError(EXML_InitScripting, tr("Scripting engine initialization failed: %1").arg(_parallelScripting->errorMessage()));
+            return ;
+        }
     }
     /***************************************************************
     qint64 previousTokenLine = 0 ;
@@ -323,6 +333,12 @@ void ExtractionOperation::execute(QFile *file)
                         }
                     }
                     insideAFragment = true ;
+                    if(isScripting) {
+                        // the fragment starts a new chunk, evaluated by a single engine
+                        if(!setScriptingScope(info, true)) {
+                            return ;
+                        }
+                    }
                     if(registerDocument) {
                         if(isAnExportExtraction) {
                             if(!handleExportedElement(info, xmlReader)) {
@@ -331,7 +347,7 @@ void ExtractionOperation::execute(QFile *file)
                         } else {
                             isWriting = true ;
                             if(!isAFilteredExtraction) {
-                                if(!handleNewFile(info)) {
+                                if(!openFragmentFile(info)) {
                                     isError = true ;
                                 }
                             } // check new file iff it is not a filtered op.
@@ -379,7 +395,7 @@ void ExtractionOperation::execute(QFile *file)
                                 if(!writeAToken(false, true, info, xmlReader)) {
                                     return ;
                                 }
-                                if(!handleCloseOutputFile(info)) {
+                                if(!closeFragmentFile(info)) {
                                     return ;
                                 }
                             }
@@ -442,6 +458,18 @@ void ExtractionOperation::execute(QFile *file)
                 }
             }
         } // check for write
+        if(isScripting && !insideAFragment) {
+            if(isStillInFragment) {
+                // the fragment just ended
+                if(!setScriptingScope(info, false)) {
+                    return ;
+                }
+            } else if((NULL != _parallelScripting) && _parallelScripting->isChunkFull()) {
+                if(!flushScriptedChunks(info, false)) {
+                    return ;
+                }
+            }
+        }
         if(xmlReader.hasError() && (xmlReader.error() != QXmlStreamReader::PrematureEndOfDocumentError)) {
             handleError(xmlReader);
             return ;
@@ -464,6 +492,11 @@ void ExtractionOperation::execute(QFile *file)
             }
         }
     }// while at end
+    if(NULL != _parallelScripting) {
+        if(!flushScriptedChunks(info, true)) {
+            return ;
+        }
+    }
     handleCloseOutputFile(info);
     _isEnded = true ;
 }
@@ -489,6 +522,11 @@ bool ExtractionOperation::evaluateScriptingConditions(const bool isAFilteredExtr
 bool ExtractionOperation::writeAToken(const bool isAFilteredExtraction, const bool insideAFragment, ExtractInfo &info, QXmlStreamReader &reader)
 {
     if((insideAFragment && _isExtractDocuments) || isAFilteredExtraction) {
+        if(NULL != _parallelScripting) {
+            // written in document order after the scripts of the chunk
+            _parallelScripting->addToken(ExtractionScriptToken::fromReader(ExtractionScriptToken::ActionWrite, 0, "", reader));
+            return true ;
+        }
         info.xmlWriter.writeCurrentToken(reader);
         return checkWriteOperation(info);
     }
@@ -557,12 +595,20 @@ bool ExtractionOperation::makeASubFolderWithError(ExtractInfo &info, const int c
   */
 
 bool ExtractionOperation::handleNewFile(ExtractInfo &info)
+{
+    return handleNewFile(info, _results->numFragments());
+}
+
+/**
+  the fragments count is the one at the start of the fragment, the file can be opened later
+  */
+bool ExtractionOperation::handleNewFile(ExtractInfo &info, const int fragmentsCount)
 {
     if(_isMakeSubFolders) {
         if((0 == info.currentSubfolderDocument)
                 || ((info.currentSubfolderDocument + 1) > _subFoldersEachNFiles)) {
             _results->_numFoldersCreated ++ ;
-            if(!makeASubFolderWithError(info, _results->_numFoldersCreated, _results->numFragments())) {
+            if(!makeASubFolderWithError(info, _results->_numFoldersCreated, fragmentsCount)) {
                 return false;
             }
             info.currentSubfolderDocument = 0 ;
@@ -571,7 +617,7 @@ bool ExtractionOperation::handleNewFile(ExtractInfo &info)
     if(!handleCloseOutputFile(info)) {
         return false;
     }
-    if(!openFile(info)) {
+    if(!openFile(info, fragmentsCount)) {
         return false;
     }
     return true ;
@@ -599,7 +645,7 @@ bool ExtractionOperation::manageOpenCSV(ExtractInfo &info)
     return true ;
 }
 
-bool ExtractionOperation::openFile(ExtractInfo &info)
+bool ExtractionOperation::openFile(ExtractInfo &info, const int fragmentsCount)
 {
     if(info.outputFile.isOpen()) {
         info.outputFile.close();
@@ -609,7 +655,7 @@ bool ExtractionOperation::openFile(ExtractInfo &info)
     info.currentSubfolderDocument++;
     info.currentDocument++;
     _results->_numDocumentsCreated ++;
-    QString fileName = makeFileName(info.currentDocument, _results->numFragments());
+    QString fileName = makeFileName(info.currentDocument, fragmentsCount);
     QString filePath = info.currentFolderPath;
     filePath.append(QDir::separator());
     filePath.append(fileName);
@@ -885,6 +931,7 @@ void ExtractionOperation::loadSettings()
     //-------------------
     _useNamespaces = Config::getBool(Config::KEY_FRAGMENTS_USENAMESPACES, true);
     _filtersId = Config::getString(Config::KEY_FRAGMENTS_FILTERSID, "");
+    _scriptingThreads = Config::getInt(Config::KEY_FRAGMENTS_SCRIPTINGTHREADS, 1);
 }
 
 void ExtractionOperation::saveSettings()
@@ -918,6 +965,7 @@ void ExtractionOperation::saveSettings()
     //----------------
     Config::saveBool(Config::KEY_FRAGMENTS_USENAMESPACES, _useNamespaces);
     Config::saveString(Config::KEY_FRAGMENTS_FILTERSID, _filtersId);
+    Config::saveInt(Config::KEY_FRAGMENTS_SCRIPTINGTHREADS, _scriptingThreads);
 }
 
 void ExtractionOperation::saveSettingsForExtractionFragmentNumber(const QString &filePath, const int fragment, const int depth)
@@ -1114,6 +1162,16 @@ void ExtractionOperation::setFiltersId(const QString &value)
     _filtersId = value ;
 }
 
+int ExtractionOperation::scriptingThreads()
+{
+    return _scriptingThreads ;
+}
+
+void ExtractionOperation::setScriptingThreads(const int value)
+{
+    _scriptingThreads = value ;
+}
+
 void ExtractionOperation::setMinDoc(const unsigned int value)
 {
     _minDoc = value;
@@ -1437,6 +1495,23 @@ bool ExtractionOperation::writeElement(ExtractInfo &info, const QString &nameSpa
     return checkWriteOperation(info);
 }
 
+bool ExtractionOperation::writeElement(ExtractInfo &info, const QString &nameSpaceUri, const QString &localName, const QString &qualifiedName, const QXmlStreamAttributes &attributes)
+{
+    if(isUseNamespaces()) {
+        info.xmlWriter.writeStartElement(nameSpaceUri, localName);
+    } else {
+        info.xmlWriter.writeStartElement(qualifiedName);
+    }
+    foreach(const QXmlStreamAttribute &attribute, attributes) {
+        if(isUseNamespaces()) {
+            info.xmlWriter.writeAttribute(attribute.namespaceUri().toString(), attribute.name().toString(), attribute.value().toString());
+        } else {
+            info.xmlWriter.writeAttribute(attribute.name().toString(), attribute.value().toString());
+        }
+    }
+    return checkWriteOperation(info);
+}
+
 bool ExtractionOperation::checkWriteOperation(ExtractInfo &info)
 {
     if(info.outputFile.error() != QFile::NoError) {
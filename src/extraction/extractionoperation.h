@@ -42,6 +42,9 @@
   ****************/
 
 class ExtractionScriptFilterModel;
+class ExtractionScriptParallel;
+class ExtractionScriptChunk;
+class ExtractionScriptToken;
 
 class ExtractInfo
 {
@@ -150,8 +153,16 @@ private:
     QStringList _pathsForFilterText;
     EXTRTYPE _extrType;
     qint64 _size;
+    // the events are reused for each token, the engine keeps a single wrapper for them
+    ExtractionScriptTextEvent _scriptTextEvent;
+    ExtractionScriptElementEvent _scriptElementEvent;
     ExtractionScriptManager _scriptManager;
     QString _filtersId;
+    // the threads for the scripts, 1 to evaluate them while reading
+    int _scriptingThreads;
+    ExtractionScriptParallel *_parallelScripting;
+    // the globals of the scripts are reset at the fragments boundaries, whatever the threads
+    bool _isScriptingByFragment;
     //-------------------
     bool _isError ;
     bool _isEnded ; // if the operation ended
@@ -174,9 +185,10 @@ private:
     bool checkStatus();
 
     bool handleNewFile(ExtractInfo &info);
+    bool handleNewFile(ExtractInfo &info, const int fragmentsCount);
     void closeAllOperations(ExtractInfo &info);
     bool handleCloseOutputFile(ExtractInfo &info);
-    bool openFile(ExtractInfo &info);
+    bool openFile(ExtractInfo &info, const int fragmentsCount);
 
     QString makeFileName(const int currentFileIndex, const int docCounter);
     QString makeSubFolderName(const int currentDocumentIndex, const int docCounter);
@@ -200,17 +212,24 @@ private:
     bool checkWriteOperation(ExtractInfo &info);
     bool writeText(ExtractInfo &info, const bool isCDATA, const QString &text);
     bool writeElement(ExtractInfo &info, const QString &nameSpaceUri, const QString &localName, const QString &qualifiedName, QList<ExtractionScriptAttribute *> attributes);
+    bool writeElement(ExtractInfo &info, const QString &nameSpaceUri, const QString &localName, const QString &qualifiedName, const QXmlStreamAttributes &attributes);
     // ---startRegion(scripting)
     bool initScripting();
     bool manageText(ExtractInfo &info, const int level, const QString &path, QXmlStreamReader &xmlReader, bool &dontWrite);
     ExtractionScriptManager::EEventResult internalManageText(ExtractionScriptTextEvent &textEvent, const int level, const QString &path, const bool isWhitespace, const bool isCDATA, const QString &text);
     ExtractionScriptManager::EEventResult internalManageElement(ExtractionScriptElementEvent &elementEvent, const int level, const QString &path, const QString &name, const QString &nameSpace, const QString &localName, QXmlStreamAttributes attributes);
-    void prepareEventText(ExtractionScriptTextEvent &textEvent, const bool isWhitespace, const bool isCDATA, const QString &text);
-    void prepareEventElement(ExtractionScriptElementEvent &elementEvent, const QString &name, const QString &nameSpace, const QString &localName, QXmlStreamAttributes attributes);
     bool manageElement(ExtractInfo &info, const int level, const QString &path, QXmlStreamReader &xmlReader, bool &dontWrite);
     void prepareScripting();
     bool evaluateScriptingConditions(const bool isAFilteredExtraction, const bool insideAFragment,
                                      const bool isStillInFragment, const bool isWriting, const bool dontWrite);
+    bool startParallelScripting();
+    void endParallelScripting();
+    bool openFragmentFile(ExtractInfo &info);
+    bool closeFragmentFile(ExtractInfo &info);
+    bool flushScriptedChunks(ExtractInfo &info, const bool isWaitAll);
+    bool setScriptingScope(ExtractInfo &info, const bool isFragment);
+    bool writeScriptedChunk(ExtractInfo &info, ExtractionScriptChunk *chunk);
+    bool writeScriptedToken(ExtractInfo &info, const ExtractionScriptToken &token);
     // ----endRegion(scripting)
 
 public:
@@ -282,6 +301,8 @@ public:
     bool isUseNamespaces();
     QString filtersId();
     void setFiltersId(const QString &value);
+    int scriptingThreads();
+    void setScriptingThreads(const int value);
 
     QStringList filterListAsIdList();
 
@@ -322,6 +343,8 @@ public:
     bool isScriptingEnabled();
     void addScriptingFilter(ExtractionScriptFilterModel *newFilter);
     ExtractionScriptManager *scriptManager();
+    static void prepareEventText(ExtractionScriptTextEvent &textEvent, const bool isWhitespace, const bool isCDATA, const QString &text);
+    static void prepareEventElement(ExtractionScriptElementEvent &elementEvent, const QString &name, const QString &nameSpace, const QString &localName, QXmlStreamAttributes attributes);
     // ----endRegion(scripting)
 
 
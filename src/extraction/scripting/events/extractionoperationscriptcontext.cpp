@@ -23,17 +23,17 @@
 #include "extractionoperationscriptcontext.h"
 #include "utils.h"
 
-int ExtractionOperationScriptContext::instancesCount = 0 ;
+QAtomicInt ExtractionOperationScriptContext::instancesCount(0);
 
 ExtractionOperationScriptContext::ExtractionOperationScriptContext(QObject *parent) : QObject(parent)
 {
     _level = 0 ;
-    instancesCount++;
+    instancesCount.ref();
 }
 
 ExtractionOperationScriptContext::~ExtractionOperationScriptContext()
 {
-    instancesCount--;
+    instancesCount.deref();
 }
 
 bool ExtractionOperationScriptContext::compareTo(ExtractionOperationScriptContext &other)
@@ -24,6 +24,7 @@
 #define EXTRACTIONOPERATIONSCRIPTCONTEXT_H
 
 #include "xmlEdit.h"
+#include <QAtomicInt>
 
 class ExtractionOperationScriptContext : public QObject
 {
@@ -31,7 +32,7 @@ class ExtractionOperationScriptContext : public QObject
     int _level;
     QString _path;
 
-    static int instancesCount;
+    static QAtomicInt instancesCount;
 public:
     explicit ExtractionOperationScriptContext(QObject *parent = NULL);
     virtual ~ExtractionOperationScriptContext();
@@ -25,16 +25,16 @@
 #include "utils.h"
 
 //------------------------------------------------------------------------
-int ExtractionScriptAttribute::instances = 0;
+QAtomicInt ExtractionScriptAttribute::instances(0);
 
 ExtractionScriptAttribute::ExtractionScriptAttribute()
 {
-    instances ++ ;
+    instances.ref();
 }
 
 ExtractionScriptAttribute::~ExtractionScriptAttribute()
 {
-    instances -- ;
+    instances.deref();
 }
 
 bool ExtractionScriptAttribute::compareTo(ExtractionScriptAttribute *other)
@@ -60,6 +60,7 @@ ExtractionScriptElementEvent::ExtractionScriptElementEvent(QObject *parent) : QO
     _useNamespaces = true;
     _isModified = false ;
     _isError = false ;
+    _isAttributesLoaded = true ;
 }
 
 ExtractionScriptElementEvent::~ExtractionScriptElementEvent()
@@ -83,6 +84,8 @@ bool ExtractionScriptElementEvent::resetModifed()
 
 bool ExtractionScriptElementEvent::compareTo(ExtractionScriptElementEvent &other)
 {
+    loadAttributes();
+    other.loadAttributes();
     if(_isError != other._isError) {
         return false;
     }
@@ -125,23 +128,93 @@ bool ExtractionScriptElementEvent::compareTo(ExtractionScriptElementEvent &other
 
 void ExtractionScriptElementEvent::setAttribute(QXmlStreamAttribute* attribute)
 {
-    if(attribute->name().isEmpty()) {
+    loadAttributes();
+    iSetAttribute(*attribute);
+}
+
+void ExtractionScriptElementEvent::iSetAttribute(const QXmlStreamAttribute &attribute)
+{
+    if(attribute.name().isEmpty()) {
         triggerError(QString("setAttribute: %1").arg(tr("empty name")));
         return ;
     }
     checkInternalState();
     if(_useNamespaces) {
-        setAttributeValueByNameNS(attribute->namespaceUri().toString(), attribute->name().toString(), attribute->value().toString());
+        setAttributeValueByNameNS(attribute.namespaceUri().toString(), attribute.name().toString(), attribute.value().toString());
     } else {
-        setAttributeValueByName(attribute->qualifiedName().toString(), attribute->value().toString());
+        setAttributeValueByName(attribute.qualifiedName().toString(), attribute.value().toString());
     }
     checkInternalState();
 }
 
+/*!
+ * \brief sets the attributes as read, they are copied only if a script changes them
+ */
+void ExtractionScriptElementEvent::setAttributes(const QXmlStreamAttributes &attributes)
+{
+    EMPTYPTRLIST(_attributesSorted, ExtractionScriptAttribute)
+    _attributesByNamespaceAndName.clear();
+    _streamAttributes = attributes ;
+    _isAttributesLoaded = attributes.isEmpty();
+}
+
+/*!
+ * \brief clears the state left by a previous use of the event
+ */
+void ExtractionScriptElementEvent::reset()
+{
+    setAttributes(QXmlStreamAttributes());
+    _isModified = false ;
+    _isError = false ;
+    _errorMessage.clear();
+    _elementName.clear();
+    _localName.clear();
+    _nameSpace.clear();
+}
+
+void ExtractionScriptElementEvent::loadAttributes()
+{
+    if(_isAttributesLoaded) {
+        return ;
+    }
+    _isAttributesLoaded = true ;
+    // loading is not a change
+    const bool isModified = _isModified ;
+    foreach(const QXmlStreamAttribute &attribute, _streamAttributes) {
+        iSetAttribute(attribute);
+    }
+    _streamAttributes.clear();
+    _isModified = isModified ;
+}
+
+QString ExtractionScriptElementEvent::streamAttributeName(const QXmlStreamAttribute &attribute) const
+{
+    return _useNamespaces ? attribute.name().toString() : attribute.qualifiedName().toString() ;
+}
+
+const QXmlStreamAttribute *ExtractionScriptElementEvent::findStreamAttribute(const QString &attributeNameSpace, const QString &attributeName) const
+{
+    const int attributesCount = _streamAttributes.size();
+    FORINT(index, attributesCount) {
+        const QXmlStreamAttribute &attribute = _streamAttributes.at(index);
+        if(_useNamespaces) {
+            if((attribute.name() == attributeName) && (attribute.namespaceUri() == attributeNameSpace)) {
+                return &attribute ;
+            }
+        } else {
+            if(attributeNameSpace.isEmpty() && (attribute.qualifiedName() == attributeName)) {
+                return &attribute ;
+            }
+        }
+    }
+    return NULL ;
+}
+
 //-----
 
 int ExtractionScriptElementEvent::iRemoveAttributeByName(const QString &nameSpace, const QString &attributeName)
 {
+    loadAttributes();
     checkInternalState();
     ExtractionScriptAttribute *attribute = findAttribute(NULL_NS, attributeName);
     if(NULL != attribute) {
@@ -172,6 +245,7 @@ int ExtractionScriptElementEvent::removeAttributeByNameNS(const QString &nameSpa
 
 int ExtractionScriptElementEvent::removeAttributeByIndex(const int index)
 {
+    loadAttributes();
     checkInternalState();
     if((index >= 0) && (index < _attributesSorted.size())) {
         ExtractionScriptAttribute* attribute = _attributesSorted.at(index);
@@ -204,6 +278,7 @@ static bool sortLessThanByNsAndNameFunction(const ExtractionScriptAttribute *att
 
 void ExtractionScriptElementEvent::sortAttributesByName()
 {
+    loadAttributes();
     checkInternalState();
     qSort(_attributesSorted.begin(), _attributesSorted.end(), sortLessThanByNameFunction);
     _isModified = true ;
@@ -212,6 +287,7 @@ void ExtractionScriptElementEvent::sortAttributesByName()
 
 void ExtractionScriptElementEvent::sortAttributesByNamespaceAndName()
 {
+    loadAttributes();
     checkInternalState();
     qSort(_attributesSorted.begin(), _attributesSorted.end(), sortLessThanByNsAndNameFunction);
     _isModified = true ;
@@ -287,12 +363,22 @@ void ExtractionScriptElementEvent::setNameSpace(const QString &value)
 
 int ExtractionScriptElementEvent::attributesCount()
 {
+    if(!_isAttributesLoaded) {
+        return _streamAttributes.size();
+    }
     checkInternalState();
     return _attributesSorted.size();
 }
 
 QString ExtractionScriptElementEvent::iAttributeValueByNameNS(const QString &namespaceId, const QString &attributeName)
 {
+    if(!_isAttributesLoaded) {
+        const QXmlStreamAttribute *streamAttribute = findStreamAttribute(namespaceId, attributeName);
+        if(NULL != streamAttribute) {
+            return streamAttribute->value().toString();
+        }
+        return "" ;
+    }
     checkInternalState();
     ExtractionScriptAttribute * attribute = findAttribute(namespaceId, attributeName);
     if(NULL != attribute) {
@@ -317,6 +403,7 @@ QString ExtractionScriptElementEvent::attributeValueByNameNS(const QString &name
 
 void ExtractionScriptElementEvent::iSetAttributeValueByName(const QString &theNameSpace, const QString &theAttributeName, const QString &attributeValue)
 {
+    loadAttributes();
     checkInternalState();
     ExtractionScriptAttribute *attribute = findAttribute(theNameSpace, theAttributeName);
     if(NULL == attribute) {
@@ -347,6 +434,10 @@ void ExtractionScriptElementEvent::setAttributeValueByName(const QString &attrib
 
 QString ExtractionScriptElementEvent::attributeValueByIndex(const int index)
 {
+    if(!_isAttributesLoaded && (index >= 0) && (index < _streamAttributes.size())) {
+        return _streamAttributes.at(index).value().toString();
+    }
+    loadAttributes();
     checkInternalState();
     if(index < _attributesSorted.size()) {
         ExtractionScriptAttribute *attribute = _attributesSorted.at(index);
@@ -359,6 +450,7 @@ QString ExtractionScriptElementEvent::attributeValueByIndex(const int index)
 
 void ExtractionScriptElementEvent::setAttributeValueByIndex(const int index, const QString &attributeValue)
 {
+    loadAttributes();
     checkInternalState();
     if(index < _attributesSorted.size()) {
         ExtractionScriptAttribute *attribute = _attributesSorted.at(index);
@@ -374,6 +466,10 @@ void ExtractionScriptElementEvent::setAttributeValueByIndex(const int index, con
 
 QString ExtractionScriptElementEvent::attributeNameByIndex(const int index)
 {
+    if(!_isAttributesLoaded && (index >= 0) && (index < _streamAttributes.size())) {
+        return streamAttributeName(_streamAttributes.at(index));
+    }
+    loadAttributes();
     checkInternalState();
     if(index < _attributesSorted.size()) {
         return _attributesSorted.at(index)->name;
@@ -388,6 +484,10 @@ QString ExtractionScriptElementEvent::attributeNameSpaceByIndex(const int index)
     if(!useNamespaces()) {
         triggerError(QString("attributeNameSpaceByIndex: %1 %2").arg(tr("namespaces needed")).arg(index));
     }
+    if(!_isAttributesLoaded && (index >= 0) && (index < _streamAttributes.size())) {
+        return _useNamespaces ? _streamAttributes.at(index).namespaceUri().toString() : QString("") ;
+    }
+    loadAttributes();
     checkInternalState();
     if(index < _attributesSorted.size()) {
         return _attributesSorted.at(index)->nameSpace;
@@ -404,6 +504,7 @@ void ExtractionScriptElementEvent::setAttributeNameByIndex(const int index, cons
 
 void ExtractionScriptElementEvent::iSetAttributeNameByIndex(const int index, const QString &namespaceId, const QString &attributeName)
 {
+    loadAttributes();
     const int currentAttributesCount = _attributesSorted.size();
     if(index < currentAttributesCount) {
         ExtractionScriptAttribute *attribute = _attributesSorted.at(index);
@@ -466,6 +567,7 @@ bool ExtractionScriptElementEvent::iCheckInternalState()
 
 void ExtractionScriptElementEvent::dump()
 {
+    loadAttributes();
     int index = 0;
     printf("%s\n", QString("Tag: %1, name:%2, ns:%3, useNs:%4, error:%5")
            .arg(_elementName).arg(localName()).arg(nameSpace()).arg(useNamespaces()).arg(isError()).toLatin1().data());
@@ -478,6 +580,7 @@ void ExtractionScriptElementEvent::dump()
 
 QList<ExtractionScriptAttribute *> ExtractionScriptElementEvent::attributes()
 {
+    loadAttributes();
     return _attributesSorted ;
 }
 
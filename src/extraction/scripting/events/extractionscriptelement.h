@@ -25,10 +25,11 @@
 
 #include "xmlEdit.h"
 #include <QXmlStreamAttribute>
+#include <QAtomicInt>
 
 class ExtractionScriptAttribute
 {
-    static int instances;
+    static QAtomicInt instances;
 public:
     QString nameSpace;
     QString name;
@@ -52,6 +53,14 @@ protected:
 
     QList<ExtractionScriptAttribute*> _attributesSorted;
     QHash<QString, ExtractionScriptAttribute*> _attributesByNamespaceAndName;
+    // the attributes as read, copied in the lists above only when the script changes them
+    QXmlStreamAttributes _streamAttributes;
+    bool _isAttributesLoaded;
+
+    void loadAttributes();
+    void iSetAttribute(const QXmlStreamAttribute &attribute);
+    const QXmlStreamAttribute *findStreamAttribute(const QString &attributeNameSpace, const QString &attributeName) const;
+    QString streamAttributeName(const QXmlStreamAttribute &attribute) const;
 
     bool iCheckInternalState();
     void checkInternalState();
@@ -97,6 +106,8 @@ public:
     void resetError() ;
 
     void setAttribute(QXmlStreamAttribute* attribute);
+    void setAttributes(const QXmlStreamAttributes &attributes);
+    void reset();
 
     bool compareTo(ExtractionScriptElementEvent &other);
 
@@ -68,6 +68,20 @@ bool ExtractionScriptTextEvent::resetModifed()
     return result ;
 }
 
+/*!
+ * \brief clears the state left by a previous use of the event
+ */
+void ExtractionScriptTextEvent::reset()
+{
+    _isModified = false ;
+    _isCDATA = false;
+    _text.clear();
+    _isIgnored = false ;
+    _isWhitespace = false ;
+    _isError = false;
+    _errorMessage.clear();
+}
+
 bool ExtractionScriptTextEvent::compareTo(ExtractionScriptTextEvent &other)
 {
     if(_isModified != other._isModified) {
@@ -50,6 +50,7 @@ public:
     Q_PROPERTY(bool isError READ isError WRITE setError)
 
     bool compareTo(ExtractionScriptTextEvent &other);
+    void reset();
 
     bool isModified() const;
     bool resetModifed();
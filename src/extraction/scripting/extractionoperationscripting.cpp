@@ -27,6 +27,7 @@
 #include <QTextCodec>
 #include "qxmleditconfig.h"
 #include "extraction/extractionscriptingprovider.h"
+#include "extraction/scripting/extractionscriptparallel.h"
 
 // ---startRegion(scripting)
 bool ExtractionOperation::isScriptingEnabled()
@@ -61,7 +62,12 @@ ExtractionOperation::internalManageText(
 
 bool ExtractionOperation::manageText(ExtractInfo &info, const int level, const QString &path, QXmlStreamReader &xmlReader, bool &dontWrite)
 {
-    ExtractionScriptTextEvent textEvent;
+    if(NULL != _parallelScripting) {
+        _parallelScripting->addToken(ExtractionScriptToken::fromReader(ExtractionScriptToken::ActionScript, level, path, xmlReader));
+        dontWrite = true ;
+        return true ;
+    }
+    ExtractionScriptTextEvent &textEvent = _scriptTextEvent;
     const ExtractionScriptManager::EEventResult result = internalManageText(textEvent, level, path, xmlReader.isWhitespace(), xmlReader.isCDATA(), xmlReader.text().toString());
     if(_scriptManager.isError() || (result == ExtractionScriptManager::EventResult_Error)) {
         setError(EXML_Scripting, _scriptManager.errorMessage());
@@ -91,6 +97,7 @@ bool ExtractionOperation::manageText(ExtractInfo &info, const int level, const Q
 
 void ExtractionOperation::prepareEventText(ExtractionScriptTextEvent &textEvent, const bool isWhitespace, const bool isCDATA, const QString &text)
 {
+    textEvent.reset();
     textEvent.setCDATA(isCDATA);
     textEvent.setText(text);
     textEvent.setWhiteSpaceFlag(isWhitespace);
@@ -107,8 +114,12 @@ ExtractionScriptManager::EEventResult ExtractionOperation::internalManageElement
 
 bool ExtractionOperation::manageElement(ExtractInfo &info, const int level, const QString &path, QXmlStreamReader &xmlReader, bool &dontWrite)
 {
-    ExtractionScriptElementEvent elementEvent;
-
+    if(NULL != _parallelScripting) {
+        _parallelScripting->addToken(ExtractionScriptToken::fromReader(ExtractionScriptToken::ActionScript, level, path, xmlReader));
+        dontWrite = true ;
+        return true ;
+    }
+    ExtractionScriptElementEvent &elementEvent = _scriptElementEvent;
     const ExtractionScriptManager::EEventResult result = internalManageElement(elementEvent, level, path, xmlReader.qualifiedName().toString(), xmlReader.namespaceUri().toString(), xmlReader.name().toString(), xmlReader.attributes());
     if(_scriptManager.isError() || (result == ExtractionScriptManager::EventResult_Error)) {
         setError(EXML_Scripting, _scriptManager.errorMessage());
@@ -140,12 +151,11 @@ bool ExtractionOperation::manageElement(ExtractInfo &info, const int level, cons
 
 void ExtractionOperation::prepareEventElement(ExtractionScriptElementEvent &elementEvent, const QString &name, const QString &nameSpace, const QString &localName, QXmlStreamAttributes attributes)
 {
+    elementEvent.reset();
     elementEvent.setElementName(name);
     elementEvent.setNameSpace(nameSpace);
     elementEvent.setLocalName(localName);
-    foreach(QXmlStreamAttribute attribute, attributes) {
-        elementEvent.setAttribute(&attribute);
-    }
+    elementEvent.setAttributes(attributes);
     elementEvent.resetModifed();
 }
 
@@ -162,6 +172,148 @@ void ExtractionOperation::prepareScripting()
         }
     }
 }
+
+/*!
+ * \brief evaluates the scripts in worker threads when more than a thread is requested.
+ * Only split and filter operations write the scripted tokens.
+ */
+bool ExtractionOperation::startParallelScripting()
+{
+    endParallelScripting();
+    const int threads = ExtractionScriptParallel::threadsForScripting(_scriptingThreads);
+    const bool isSupported = _isExtractDocuments && ((OperationSplit == _operationType) || (OperationFilter == _operationType));
+    _isScriptingByFragment = isSupported ;
+    if((threads < 2) || !isSupported) {
+        return true ;
+    }
+    _parallelScripting = new ExtractionScriptParallel();
+    return _parallelScripting->start(threads, &_scriptManager);
+}
+
+void ExtractionOperation::endParallelScripting()
+{
+    if(NULL != _parallelScripting) {
+        delete _parallelScripting;
+        _parallelScripting = NULL ;
+    }
+}
+
+bool ExtractionOperation::openFragmentFile(ExtractInfo &info)
+{
+    if(NULL != _parallelScripting) {
+        _parallelScripting->addToken(ExtractionScriptToken::marker(ExtractionScriptToken::ActionOpenFile, _results->numFragments()));
+        return true ;
+    }
+    return handleNewFile(info);
+}
+
+bool ExtractionOperation::closeFragmentFile(ExtractInfo &info)
+{
+    if(NULL != _parallelScripting) {
+        _parallelScripting->addToken(ExtractionScriptToken::marker(ExtractionScriptToken::ActionCloseFile, _results->numFragments()));
+        return true ;
+    }
+    return handleCloseOutputFile(info);
+}
+
+/*!
+ * \brief sends the current chunk to the workers and writes the evaluated ones in document order
+ * \param isWaitAll waits for all the chunks, at the end of the input
+ */
+bool ExtractionOperation::flushScriptedChunks(ExtractInfo &info, const bool isWaitAll)
+{
+    _parallelScripting->submitChunk();
+    while(_parallelScripting->hasPending()) {
+        const bool isWait = isWaitAll || _parallelScripting->isTooManyPending();
+        ExtractionScriptChunk *chunk = _parallelScripting->takeCompleted(isWait);
+        if(NULL == chunk) {
+            break;
+        }
+        const bool isOk = writeScriptedChunk(info, chunk);
+        delete chunk;
+        if(!isOk) {
+            return false;
+        }
+    }
+    return true ;
+}
+
+/*!
+ * \brief a fragment starts or ends. For the operations that can use more threads, the scripts see
+ * their globals as after the initialization at the start of each fragment and of each run of tokens
+ * between two fragments, with one thread as with more; see ExtractionScriptParallel.
+ */
+bool ExtractionOperation::setScriptingScope(ExtractInfo &info, const bool isFragment)
+{
+    if(NULL != _parallelScripting) {
+        if(!flushScriptedChunks(info, false)) {
+            return false;
+        }
+        _parallelScripting->setInFragment(isFragment);
+        return true ;
+    }
+    if(_isScriptingByFragment && !_scriptManager.resetGlobals()) {
+        setError(EXML_Scripting, _scriptManager.errorMessage());
+        return false;
+    }
+    return true ;
+}
+
+bool ExtractionOperation::writeScriptedChunk(ExtractInfo &info, ExtractionScriptChunk *chunk)
+{
+    _scriptManager.addEventsCounts(chunk->textEventsCount, chunk->elementEventsCount);
+    if(chunk->isError) {
+        setError(EXML_Scripting, chunk->errorMessage);
+        return false;
+    }
+    foreach(const ExtractionScriptToken &token, chunk->tokens) {
+        switch(token.action) {
+        case ExtractionScriptToken::ActionOpenFile:
+            if(!handleNewFile(info, token.fragmentsCount)) {
+                handleCloseOutputFile(info);
+                return false;
+            }
+            break;
+        case ExtractionScriptToken::ActionCloseFile:
+            if(!handleCloseOutputFile(info)) {
+                return false;
+            }
+            break;
+        case ExtractionScriptToken::ActionWrite:
+            token.writeTo(info.xmlWriter);
+            if(!checkWriteOperation(info)) {
+                return false;
+            }
+            break;
+        case ExtractionScriptToken::ActionScript:
+            if(!writeScriptedToken(info, token)) {
+                return false;
+            }
+            break;
+        }
+    }
+    return true ;
+}
+
+bool ExtractionOperation::writeScriptedToken(ExtractInfo &info, const ExtractionScriptToken &token)
+{
+    switch(token.result) {
+    case ExtractionScriptManager::EventResult_IgnoreEvent:
+        break;
+    case ExtractionScriptManager::EventResult_WriteOriginalData:
+        token.writeTo(info.xmlWriter);
+        return checkWriteOperation(info);
+    case ExtractionScriptManager::EventResult_WriteModifiedData:
+        if(QXmlStreamReader::Characters == token.tokenType) {
+            return writeText(info, token.isCDATA, token.text);
+        }
+        return writeElement(info, token.nameSpace, token.localName, token.qualifiedName, token.attributes);
+    default:
+        // this should not happen
+        return false;
+    }
+    return true ;
+}
 // ----endRegion(scripting)
 
 
@@ -22,6 +22,10 @@
 
 #include "extractionscriptfilter.h"
 #include "utils.h"
+#ifdef QXMLEDIT_JS_SCRIPT
+#include <QQmlEngine>
+#include <QJSValueIterator>
+#endif
 
 //------------------------------------------------------------
 
@@ -61,19 +65,22 @@ const QString ExtractionScriptFilter::ContextName("context");
 const QString ExtractionScriptFilter::TestContextDouble("contextDouble");
 const QString ExtractionScriptFilter::EventName("event");
 
-int ExtractionScriptFilter::instancesCount = 0 ;
+QAtomicInt ExtractionScriptFilter::instancesCount(0);
 
 ExtractionScriptFilter::ExtractionScriptFilter()
 {
     _enabled = false;
+#ifdef  QXMLEDIT_JS_SCRIPT
+    _isInitialObject = false ;
+#endif
     QString _errorString;
-    instancesCount++;
+    instancesCount.ref();
 }
 
 ExtractionScriptFilter::~ExtractionScriptFilter()
 {
     reset();
-    instancesCount--;
+    instancesCount.deref();
 }
 
 void ExtractionScriptFilter::reset()
@@ -83,6 +90,13 @@ void ExtractionScriptFilter::reset()
         QJSValue nullProxy("NULL");
         _engine.globalObject().setProperty(name, nullProxy);
     }
+    _handlerFunctions.clear();
+    _contextValue = QJSValue();
+    _eventValues.clear();
+    _eventObject = NULL ;
+    _eventValue = QJSValue();
+    _initialGlobals.clear();
+    _isInitialObject = false ;
 #endif
     _events.clear();
     _registeredObjects.clear();
@@ -99,24 +113,43 @@ int ExtractionScriptFilter::eventsCount()
     return _eventsSet.size();
 }
 
+#ifdef QXMLEDIT_JS_SCRIPT
+
 void ExtractionScriptFilter::registerContext(ExtractionOperationScriptContext *context)
 {
-    registerObject(ExtractionScriptFilter::ContextName, context);
+    _contextValue = registerObject(ExtractionScriptFilter::ContextName, context);
 }
 
+/*!
+ * \brief the wrapper of an event is made once for each event object, the callers reuse the same objects
+ * for the text and the element events, alternating them
+ */
 void ExtractionScriptFilter::registerEvent(QObject *event)
 {
-    registerObject(ExtractionScriptFilter::EventName, event);
+    if((_eventObject.data() == event) && !_eventValue.isUndefined()) {
+        return ;
+    }
+    QHash<QObject*, QJSValue>::iterator cached = _eventValues.find(event);
+    // a wrapper of a deleted object does not refer to a new one at the same address
+    if((cached != _eventValues.end()) && (cached.value().toQObject() == event)) {
+        _eventValue = cached.value();
+        _engine.globalObject().setProperty(ExtractionScriptFilter::EventName, _eventValue);
+    } else {
+        _eventValue = registerObject(ExtractionScriptFilter::EventName, event);
+        _eventValues.insert(event, _eventValue);
+    }
+    _eventObject = event ;
 }
 
-#ifdef QXMLEDIT_JS_SCRIPT
-
-void ExtractionScriptFilter::registerObject(const QString &name, QObject *object)
+QJSValue ExtractionScriptFilter::registerObject(const QString &name, QObject *object)
 {
+    // the objects are owned by the operation, not by the engine
+    QQmlEngine::setObjectOwnership(object, QQmlEngine::CppOwnership);
     QJSValue proxy = _engine.newQObject(object);
     _engine.globalObject().setProperty(name, proxy);
     _registeredObjects.insert(name);
     Utils::TODO_NEXT_RELEASE("make read only");
+    return proxy ;
 }
 
 bool ExtractionScriptFilter::executeScript(ScriptError &errors, const QString &code)
@@ -140,7 +173,38 @@ bool ExtractionScriptFilter::handleError(ScriptError &errors, const QJSValue &va
     }
     return true ;
 }
+
+/*!
+ * \brief the variables of the scripts are the enumerable properties of the global object,
+ * the objects registered by the filter are not part of them
+ */
+void ExtractionScriptFilter::saveGlobals()
+{
+    _initialGlobals.clear();
+    _isInitialObject = false ;
+    QJSValueIterator iterator(_engine.globalObject());
+    while(iterator.hasNext()) {
+        iterator.next();
+        if(!_registeredObjects.contains(iterator.name())) {
+            const QJSValue value = iterator.value();
+            _initialGlobals.insert(iterator.name(), value);
+            if(value.isObject() && !value.isCallable()) {
+                _isInitialObject = true ;
+            }
+        }
+    }
+}
 #else
+void ExtractionScriptFilter::registerContext(ExtractionOperationScriptContext *context)
+{
+    registerObject(ExtractionScriptFilter::ContextName, context);
+}
+
+void ExtractionScriptFilter::registerEvent(QObject *event)
+{
+    registerObject(ExtractionScriptFilter::EventName, event);
+}
+
 bool ExtractionScriptFilter::executeScript(ScriptError &errors, const QString &code)
 {
     Q_UNUSED(errors)
@@ -163,6 +227,14 @@ bool ExtractionScriptFilter::evaluateEvent(ScriptError &errors, QObject *event,
         ExtractionScriptEventHandler* eventHandler = _events[eventType];
         if(NULL != eventHandler) {
             registerEvent(event);
+#ifdef QXMLEDIT_JS_SCRIPT
+            QHash<int, QJSValue>::iterator function = _handlerFunctions.find(eventType);
+            if(function != _handlerFunctions.end()) {
+                QJSValue result = function.value().call(QJSValueList() << _contextValue << _eventValue);
+                return handleError(errors, result);
+            }
+#endif
+            // the handler is not a function: the evaluation gives the error
             return executeScript(errors, eventHandler->handlerCall());
         }
     }
@@ -196,6 +268,51 @@ bool ExtractionScriptFilter::isEnabled()
 }
 
 bool ExtractionScriptFilter::initScripting(ScriptError &errors)
+{
+    if(!loadScripts(errors)) {
+        return false;
+    }
+#ifdef QXMLEDIT_JS_SCRIPT
+    saveGlobals();
+#endif
+    return true ;
+}
+
+/*!
+ * \brief restores the global variables of the scripts as initScripting left them: the variables
+ * assigned later are removed and the others take again their first value. A variable holding an
+ * object can have been modified in place, in that case the code of the scripts is evaluated again.
+ * Variables declared with let or const are not properties of the global object and are not restored.
+ */
+bool ExtractionScriptFilter::resetGlobals(ScriptError &errors)
+{
+    errors.reset();
+#ifdef QXMLEDIT_JS_SCRIPT
+    QJSValue global = _engine.globalObject();
+    QStringList added;
+    QJSValueIterator iterator(global);
+    while(iterator.hasNext()) {
+        iterator.next();
+        if(!_initialGlobals.contains(iterator.name()) && !_registeredObjects.contains(iterator.name())) {
+            added.append(iterator.name());
+        }
+    }
+    foreach(const QString &name, added) {
+        global.deleteProperty(name);
+    }
+    QHash<QString, QJSValue>::const_iterator initial;
+    for(initial = _initialGlobals.constBegin() ; initial != _initialGlobals.constEnd() ; ++initial) {
+        global.setProperty(initial.key(), initial.value());
+    }
+    if(_isInitialObject) {
+        _handlerFunctions.clear();
+        return loadScripts(errors);
+    }
+#endif
+    return true ;
+}
+
+bool ExtractionScriptFilter::loadScripts(ScriptError &errors)
 {
     errors.reset();
     foreach(ExtractionScriptEventHandler *handler, _events.values()) {
@@ -208,6 +325,10 @@ bool ExtractionScriptFilter::initScripting(ScriptError &errors)
         if(!handleError(errors, result)) {
             return false;
         }
+        QJSValue function = _engine.globalObject().property(handler->eventHandler());
+        if(function.isCallable()) {
+            _handlerFunctions.insert(handler->eventType(), function);
+        }
 #endif
     }
     return true ;
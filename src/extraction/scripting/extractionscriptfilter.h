@@ -24,6 +24,7 @@
 #define EXTRACTIONSCRIPTFILTER_H
 
 #include "xmlEdit.h"
+#include <QAtomicInt>
 #include "extraction/scripting/model/extractionscriptfiltermodel.h"
 #include "extraction/scripting/events/extractionscripteventhandler.h"
 #include "extraction/scripting/events/extractionoperationscriptcontext.h"
@@ -54,6 +55,16 @@ class ExtractionScriptFilter
 {
 #ifdef  QXMLEDIT_JS_SCRIPT
     QJSEngine _engine;
+    // the handlers compiled once, with the arguments of the calls
+    QHash<int, QJSValue> _handlerFunctions;
+    QJSValue _contextValue;
+    // one wrapper for each event object, the last one is the global event
+    QHash<QObject*, QJSValue> _eventValues;
+    QPointer<QObject> _eventObject;
+    QJSValue _eventValue;
+    // the global variables as the initialization of the scripts left them
+    QHash<QString, QJSValue> _initialGlobals;
+    bool _isInitialObject;
 #endif
     bool _enabled;
     QHash<int, ExtractionScriptEventHandler*> _events;
@@ -61,15 +72,19 @@ class ExtractionScriptFilter
     QSet<QString> _registeredObjects;
     //---- errors
     //----end errors
-    static int instancesCount;
+    static QAtomicInt instancesCount;
 
     void reset();
     bool executeScript(ScriptError &errors, const QString &code);
-    void registerObject(const QString &name, QObject *object);
 #ifdef QXMLEDIT_JS_SCRIPT
+    QJSValue registerObject(const QString &name, QObject *object);
     bool handleError(ScriptError &errors, const QJSValue &value);
+    void saveGlobals();
+#else
+    void registerObject(const QString &name, QObject *object);
 #endif
     bool evaluateEvent(ScriptError &errors, QObject *event, const EExtractionEventType eventType);
+    bool loadScripts(ScriptError &errors);
 public:
     ExtractionScriptFilter();
     ~ExtractionScriptFilter();
@@ -81,6 +96,7 @@ public:
     void registerContext(ExtractionOperationScriptContext *context);
     void registerEvent(QObject *event);
     bool initScripting(ScriptError &errors);
+    bool resetGlobals(ScriptError &errors);
     //----
     bool isTextEventEnabled();
     bool evaluateTextEvent(ScriptError &errors, ExtractionScriptTextEvent *textEvent);
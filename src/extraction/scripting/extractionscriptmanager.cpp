@@ -31,12 +31,14 @@ ExtractionScriptManager::ExtractionScriptManager()
     _eventsCount = 0 ;
     _textEventsCount = 0 ;
     _elementEventsCount = 0;
+    _eventsCountAtReset = 0 ;
     _context = new ExtractionOperationScriptContext();
 }
 
 ExtractionScriptManager::~ExtractionScriptManager()
 {
     EMPTYPTRLIST(_filters, ExtractionScriptFilter)
+    EMPTYPTRLIST(_filterModels, ExtractionScriptFilterModel)
     delete _context;
 }
 
@@ -81,6 +83,7 @@ bool ExtractionScriptManager::initScripting()
         _eventsCount = 0;
         _textEventsCount = 0;
         _elementEventsCount = 0 ;
+        _eventsCountAtReset = 0 ;
         _isInitedOk = _container.init();
         foreach(ExtractionScriptFilter* filter, _filters) {
             _isEnabled = true ;
@@ -103,6 +106,31 @@ bool ExtractionScriptManager::initScripting()
     return _isInitedOk ;
 }
 
+/*!
+ * \brief the scripts see again their globals as after the initialization, see ExtractionScriptFilter::resetGlobals;
+ * the engines are kept, a manager not yet initialized is simply initialized; without events
+ * since the last reset there is nothing to restore
+ */
+bool ExtractionScriptManager::resetGlobals()
+{
+    if(!_isReady) {
+        return initScripting();
+    }
+    if(!_isInitedOk) {
+        return false;
+    }
+    if(_eventsCount == _eventsCountAtReset) {
+        return true ;
+    }
+    _eventsCountAtReset = _eventsCount ;
+    foreach(ExtractionScriptFilter* filter, _filters) {
+        if(filter->isEnabled() && !filter->resetGlobals(_error)) {
+            return false;
+        }
+    }
+    return true ;
+}
+
 bool ExtractionScriptManager::isError()
 {
     return _error.isError;
@@ -110,12 +138,37 @@ bool ExtractionScriptManager::isError()
 
 void ExtractionScriptManager::addScriptingFilter(ExtractionScriptFilterModel *newFilter)
 {
+    if(NULL != newFilter) {
+        _filterModels.append(newFilter->clone());
+    }
     ExtractionScriptFilter* filter = new ExtractionScriptFilter();
     filter->setModel(newFilter);
     _filters.append(filter);
     _isReady = false ;
 }
 
+/*!
+ * \brief the filters added to this manager, the caller owns the copies
+ */
+QList<ExtractionScriptFilterModel*> ExtractionScriptManager::cloneFilterModels()
+{
+    QList<ExtractionScriptFilterModel*> result;
+    foreach(ExtractionScriptFilterModel* model, _filterModels) {
+        result.append(model->clone());
+    }
+    return result;
+}
+
+/*!
+ * \brief adds the events evaluated by another manager, i.e. a worker
+ */
+void ExtractionScriptManager::addEventsCounts(const int textEventsCount, const int elementEventsCount)
+{
+    _textEventsCount += textEventsCount ;
+    _elementEventsCount += elementEventsCount ;
+    _eventsCount += textEventsCount + elementEventsCount ;
+}
+
 //------- begin_region(events) ---
 
 void ExtractionScriptManager::initTextEvent(ExtractionScriptTextEvent *textEvent)
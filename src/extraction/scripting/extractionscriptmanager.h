@@ -35,6 +35,8 @@ class ExtractionScriptManager
     QPointer<ExtractionOperationScriptContext> _context;
     ExtractionScriptContainer _container;
     QList<ExtractionScriptFilter*> _filters;
+    // copies of the filters definitions, to prime other engines
+    QList<ExtractionScriptFilterModel*> _filterModels;
     ScriptError _error;
     bool _isReady ;
     bool _isEnabled;
@@ -42,6 +44,8 @@ class ExtractionScriptManager
     int _eventsCount;
     int _textEventsCount;
     int _elementEventsCount;
+    // the events evaluated when the globals were reset
+    int _eventsCountAtReset;
 
     void initTextEvent(ExtractionScriptTextEvent *textEvent);
 
@@ -59,6 +63,7 @@ public:
     bool isScriptingEnabled();
     // call this before using
     bool initScripting();
+    bool resetGlobals();
 
     QString errorMessage();
     QString errorMessageExtended();
@@ -70,6 +75,8 @@ public:
     bool isError();
 
     void addScriptingFilter(ExtractionScriptFilterModel *newFilter);
+    QList<ExtractionScriptFilterModel*> cloneFilterModels();
+    void addEventsCounts(const int textEventsCount, const int elementEventsCount);
 
     //------- events ---
     EEventResult textEvent(const int level, const QString &path, ExtractionScriptTextEvent *textEvent);
@@ -0,0 +1,436 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+#include "extractionscriptparallel.h"
+#include "extraction/extractionoperation.h"
+#include "utils.h"
+#include <QMutexLocker>
+
+ExtractionScriptToken::ExtractionScriptToken()
+{
+    action = ActionWrite ;
+    tokenType = QXmlStreamReader::NoToken ;
+    level = 0 ;
+    fragmentsCount = 0 ;
+    isCDATA = false;
+    isWhitespace = false;
+    result = ExtractionScriptManager::EventResult_WriteOriginalData;
+}
+
+ExtractionScriptToken::~ExtractionScriptToken()
+{
+}
+
+ExtractionScriptToken ExtractionScriptToken::fromReader(const EAction action, const int level, const QString &path, QXmlStreamReader &reader)
+{
+    ExtractionScriptToken token;
+    token.action = action ;
+    token.tokenType = reader.tokenType();
+    token.level = level ;
+    token.path = path ;
+    switch(token.tokenType) {
+    default:
+        break;
+    case QXmlStreamReader::StartElement:
+        token.nameSpace = reader.namespaceUri().toString();
+        token.localName = reader.name().toString();
+        token.qualifiedName = reader.qualifiedName().toString();
+        token.attributes = reader.attributes();
+        token.namespaceDeclarations = reader.namespaceDeclarations();
+        break;
+    case QXmlStreamReader::Characters:
+        token.text = reader.text().toString();
+        token.isCDATA = reader.isCDATA();
+        token.isWhitespace = reader.isWhitespace();
+        break;
+    case QXmlStreamReader::Comment:
+    case QXmlStreamReader::DTD:
+        token.text = reader.text().toString();
+        break;
+    case QXmlStreamReader::EntityReference:
+        token.localName = reader.name().toString();
+        break;
+    case QXmlStreamReader::ProcessingInstruction:
+        token.localName = reader.processingInstructionTarget().toString();
+        token.processingInstructionData = reader.processingInstructionData().toString();
+        break;
+    }
+    return token;
+}
+
+ExtractionScriptToken ExtractionScriptToken::marker(const EAction action, const int fragmentsCount)
+{
+    ExtractionScriptToken token;
+    token.action = action ;
+    token.fragmentsCount = fragmentsCount ;
+    return token;
+}
+
+/*!
+ * \brief the same output of QXmlStreamWriter::writeCurrentToken
+ */
+void ExtractionScriptToken::writeTo(QXmlStreamWriter &writer) const
+{
+    switch(tokenType) {
+    default:
+        // the start of the document is never written from here
+        break;
+    case QXmlStreamReader::EndDocument:
+        writer.writeEndDocument();
+        break;
+    case QXmlStreamReader::StartElement:
+        writer.writeStartElement(nameSpace, localName);
+        foreach(const QXmlStreamNamespaceDeclaration &declaration, namespaceDeclarations) {
+            writer.writeNamespace(declaration.namespaceUri().toString(), declaration.prefix().toString());
+        }
+        writer.writeAttributes(attributes);
+        break;
+    case QXmlStreamReader::EndElement:
+        writer.writeEndElement();
+        break;
+    case QXmlStreamReader::Characters:
+        if(isCDATA) {
+            writer.writeCDATA(text);
+        } else {
+            writer.writeCharacters(text);
+        }
+        break;
+    case QXmlStreamReader::Comment:
+        writer.writeComment(text);
+        break;
+    case QXmlStreamReader::DTD:
+        writer.writeDTD(text);
+        break;
+    case QXmlStreamReader::EntityReference:
+        writer.writeEntityReference(localName);
+        break;
+    case QXmlStreamReader::ProcessingInstruction:
+        writer.writeProcessingInstruction(localName, processingInstructionData);
+        break;
+    }
+}
+
+//------------------------------------------------------------------------
+
+ExtractionScriptChunk::ExtractionScriptChunk()
+{
+    isDone = false;
+    isError = false;
+    textEventsCount = 0 ;
+    elementEventsCount = 0 ;
+}
+
+ExtractionScriptChunk::~ExtractionScriptChunk()
+{
+}
+
+//------------------------------------------------------------------------
+
+ExtractionScriptWorker::ExtractionScriptWorker(ExtractionScriptParallel *pool, QList<ExtractionScriptFilterModel*> filterModels)
+{
+    _pool = pool ;
+    _filterModels = filterModels ;
+}
+
+ExtractionScriptWorker::~ExtractionScriptWorker()
+{
+    EMPTYPTRLIST(_filterModels, ExtractionScriptFilterModel)
+}
+
+/*!
+ * \brief new engines primed with the filters, the caller owns the manager
+ */
+ExtractionScriptManager *ExtractionScriptWorker::newManager()
+{
+    ExtractionScriptManager *manager = new ExtractionScriptManager();
+    foreach(ExtractionScriptFilterModel *model, _filterModels) {
+        manager->addScriptingFilter(model->clone());
+    }
+    return manager ;
+}
+
+/*!
+ * \brief the engines must live in the thread that uses them. A worker evaluates only
+ * fragments and keeps its engines, the globals of the scripts are reset before each
+ * fragment after the first one, since the fragments of a thread depend on the scheduling.
+ */
+void ExtractionScriptWorker::run()
+{
+    ExtractionScriptManager *manager = newManager();
+    const bool isOk = manager->initScripting();
+    _pool->setWorkerStarted(isOk, manager->errorMessage());
+    if(!isOk) {
+        delete manager;
+        return ;
+    }
+    ExtractionScriptTextEvent textEvent;
+    ExtractionScriptElementEvent elementEvent;
+    ExtractionScriptChunk *chunk = NULL ;
+    bool isManagerUsed = false;
+    while(NULL != (chunk = _pool->takeWork())) {
+        if(isManagerUsed && !manager->resetGlobals()) {
+            chunk->isError = true ;
+            chunk->errorMessage = manager->errorMessage();
+            _pool->setWorkDone(chunk);
+            continue;
+        }
+        ExtractionScriptParallel::evaluateChunk(*manager, textEvent, elementEvent, chunk);
+        isManagerUsed = true ;
+        _pool->setWorkDone(chunk);
+    }
+    delete manager;
+}
+
+//------------------------------------------------------------------------
+
+ExtractionScriptParallel::ExtractionScriptParallel()
+{
+    _currentChunk = NULL ;
+    _scriptManager = NULL ;
+    _isInFragment = false;
+    _isNewRun = false;
+    _maxPendingChunks = 0 ;
+    _startedWorkers = 0 ;
+    _isStopping = false;
+    _isInitError = false;
+}
+
+ExtractionScriptParallel::~ExtractionScriptParallel()
+{
+    stop();
+    if(NULL != _currentChunk) {
+        delete _currentChunk;
+    }
+    // the queue holds only chunks in this list
+    _queue.clear();
+    EMPTYPTRLIST(_chunks, ExtractionScriptChunk)
+}
+
+/*!
+ * \brief evaluates the scripts of the tokens of a chunk, in order, with the globals of the manager as they are
+ */
+void ExtractionScriptParallel::evaluateChunk(ExtractionScriptManager &manager, ExtractionScriptTextEvent &textEvent,
+        ExtractionScriptElementEvent &elementEvent, ExtractionScriptChunk *chunk)
+{
+    const int textEventsBefore = manager.textEventsCount();
+    const int elementEventsBefore = manager.elementEventsCount();
+    const int tokensCount = chunk->tokens.size();
+    FORINT(index, tokensCount) {
+        ExtractionScriptToken &token = chunk->tokens[index];
+        if(ExtractionScriptToken::ActionScript != token.action) {
+            continue;
+        }
+        if(QXmlStreamReader::Characters == token.tokenType) {
+            ExtractionOperation::prepareEventText(textEvent, token.isWhitespace, token.isCDATA, token.text);
+            token.result = manager.textEvent(token.level, token.path, &textEvent);
+            if(ExtractionScriptManager::EventResult_WriteModifiedData == token.result) {
+                token.isCDATA = textEvent.isCDATA();
+                token.text = textEvent.text();
+            }
+        } else if(QXmlStreamReader::StartElement == token.tokenType) {
+            ExtractionOperation::prepareEventElement(elementEvent, token.qualifiedName, token.nameSpace, token.localName, token.attributes);
+            token.result = manager.elementEvent(token.level, token.path, &elementEvent);
+            if(ExtractionScriptManager::EventResult_WriteModifiedData == token.result) {
+                token.nameSpace = elementEvent.nameSpace();
+                token.localName = elementEvent.localName();
+                token.qualifiedName = elementEvent.elementName();
+                token.attributes.clear();
+                foreach(const ExtractionScriptAttribute *attribute, elementEvent.attributes()) {
+                    token.attributes.append(QXmlStreamAttribute(attribute->nameSpace, attribute->name, attribute->value));
+                }
+            }
+        }
+        if(manager.isError() || (ExtractionScriptManager::EventResult_Error == token.result)) {
+            chunk->isError = true ;
+            chunk->errorMessage = manager.errorMessage();
+            break;
+        }
+    }
+    chunk->textEventsCount = manager.textEventsCount() - textEventsBefore ;
+    chunk->elementEventsCount = manager.elementEventsCount() - elementEventsBefore ;
+}
+
+/*!
+ * \brief the threads to use, 0 or less means one for each core
+ */
+int ExtractionScriptParallel::threadsForScripting(const int requestedThreads)
+{
+    if(requestedThreads > 0) {
+        return requestedThreads ;
+    }
+    return qMax(1, QThread::idealThreadCount());
+}
+
+bool ExtractionScriptParallel::start(const int threadsCount, ExtractionScriptManager *scriptManager)
+{
+    _scriptManager = scriptManager ;
+    // keeps the writer busy without holding the whole file in memory
+    _maxPendingChunks = threadsCount * 4 ;
+    FORINT(index, threadsCount) {
+        ExtractionScriptWorker *worker = new ExtractionScriptWorker(this, scriptManager->cloneFilterModels());
+        _workers.append(worker);
+        worker->start();
+    }
+    QMutexLocker locker(&_mutex);
+    while(_startedWorkers < _workers.size()) {
+        _workDone.wait(&_mutex);
+    }
+    return !_isInitError ;
+}
+
+void ExtractionScriptParallel::stop()
+{
+    {
+        QMutexLocker locker(&_mutex);
+        _isStopping = true ;
+        _workAvailable.wakeAll();
+    }
+    foreach(ExtractionScriptWorker *worker, _workers) {
+        worker->wait();
+    }
+    EMPTYPTRLIST(_workers, ExtractionScriptWorker)
+}
+
+QString ExtractionScriptParallel::errorMessage()
+{
+    QMutexLocker locker(&_mutex);
+    return _initErrorMessage ;
+}
+
+void ExtractionScriptParallel::setWorkerStarted(const bool isOk, const QString &errorMessage)
+{
+    QMutexLocker locker(&_mutex);
+    _startedWorkers++;
+    if(!isOk && !_isInitError) {
+        _isInitError = true ;
+        _initErrorMessage = errorMessage ;
+    }
+    _workDone.wakeAll();
+}
+
+ExtractionScriptChunk *ExtractionScriptParallel::takeWork()
+{
+    QMutexLocker locker(&_mutex);
+    while(_queue.isEmpty() && !_isStopping) {
+        _workAvailable.wait(&_mutex);
+    }
+    if(_isStopping) {
+        return NULL ;
+    }
+    return _queue.takeFirst();
+}
+
+void ExtractionScriptParallel::setWorkDone(ExtractionScriptChunk *chunk)
+{
+    QMutexLocker locker(&_mutex);
+    chunk->isDone = true ;
+    _workDone.wakeAll();
+}
+
+/*!
+ * \brief the tokens added from now on belong to a fragment or are outside the fragments;
+ * the current chunk must be submitted before.
+ */
+void ExtractionScriptParallel::setInFragment(const bool value)
+{
+    if(_isInFragment && !value) {
+        _isNewRun = true ;
+    }
+    _isInFragment = value ;
+}
+
+void ExtractionScriptParallel::addToken(const ExtractionScriptToken &token)
+{
+    if(NULL == _currentChunk) {
+        _currentChunk = new ExtractionScriptChunk();
+    }
+    _currentChunk->tokens.append(token);
+}
+
+bool ExtractionScriptParallel::isChunkFull()
+{
+    return (NULL != _currentChunk) && (_currentChunk->tokens.size() >= MaxTokensOutsideFragments);
+}
+
+void ExtractionScriptParallel::submitChunk()
+{
+    if(NULL == _currentChunk) {
+        return ;
+    }
+    if(!_isInFragment) {
+        // the manager of the caller keeps the globals along the run
+        if(_isNewRun && !_scriptManager->resetGlobals()) {
+            _currentChunk->isError = true ;
+            _currentChunk->errorMessage = _scriptManager->errorMessage();
+        } else {
+            evaluateChunk(*_scriptManager, _textEvent, _elementEvent, _currentChunk);
+        }
+        _isNewRun = false;
+        // already counted by the manager
+        _currentChunk->textEventsCount = 0 ;
+        _currentChunk->elementEventsCount = 0 ;
+        QMutexLocker locker(&_mutex);
+        _currentChunk->isDone = true ;
+        _chunks.append(_currentChunk);
+        _currentChunk = NULL ;
+        return ;
+    }
+    QMutexLocker locker(&_mutex);
+    _chunks.append(_currentChunk);
+    _queue.append(_currentChunk);
+    _currentChunk = NULL ;
+    _workAvailable.wakeOne();
+}
+
+bool ExtractionScriptParallel::isTooManyPending()
+{
+    QMutexLocker locker(&_mutex);
+    return _chunks.size() > _maxPendingChunks ;
+}
+
+bool ExtractionScriptParallel::hasPending()
+{
+    QMutexLocker locker(&_mutex);
+    return !_chunks.isEmpty();
+}
+
+/*!
+ * \brief the first chunk in document order, if evaluated. The caller owns the chunk.
+ * \param isWait waits for the evaluation to end
+ */
+ExtractionScriptChunk *ExtractionScriptParallel::takeCompleted(const bool isWait)
+{
+    QMutexLocker locker(&_mutex);
+    if(_chunks.isEmpty()) {
+        return NULL ;
+    }
+    ExtractionScriptChunk *first = _chunks.first();
+    while(!first->isDone) {
+        if(!isWait) {
+            return NULL ;
+        }
+        _workDone.wait(&_mutex);
+    }
+    _chunks.removeFirst();
+    return first ;
+}
@@ -0,0 +1,180 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef EXTRACTIONSCRIPTPARALLEL_H
+#define EXTRACTIONSCRIPTPARALLEL_H
+
+#include "xmlEdit.h"
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QXmlStreamReader>
+#include "extraction/scripting/extractionscriptmanager.h"
+
+/**
+  \brief A token read from the source, kept to be scripted and written later.
+  */
+class ExtractionScriptToken
+{
+public:
+    enum EAction {
+        // write the token as read
+        ActionWrite,
+        // evaluate the scripts and write following their result
+        ActionScript,
+        // open a new output file (split)
+        ActionOpenFile,
+        // close the current output file (split)
+        ActionCloseFile
+    };
+
+    EAction action;
+    QXmlStreamReader::TokenType tokenType;
+    int level;
+    int fragmentsCount;
+    QString path;
+    QString nameSpace;
+    QString localName;
+    QString qualifiedName;
+    QString text;
+    QString processingInstructionData;
+    bool isCDATA;
+    bool isWhitespace;
+    QXmlStreamAttributes attributes;
+    QXmlStreamNamespaceDeclarations namespaceDeclarations;
+    ExtractionScriptManager::EEventResult result;
+
+    ExtractionScriptToken();
+    ~ExtractionScriptToken();
+
+    static ExtractionScriptToken fromReader(const EAction action, const int level, const QString &path, QXmlStreamReader &reader);
+    static ExtractionScriptToken marker(const EAction action, const int fragmentsCount);
+    void writeTo(QXmlStreamWriter &writer) const;
+};
+
+/**
+  \brief A sequence of tokens evaluated by a single engine: a fragment or
+   a run of tokens outside the fragments.
+  */
+class ExtractionScriptChunk
+{
+public:
+    QList<ExtractionScriptToken> tokens;
+    bool isDone;
+    bool isError;
+    QString errorMessage;
+    int textEventsCount;
+    int elementEventsCount;
+
+    ExtractionScriptChunk();
+    ~ExtractionScriptChunk();
+};
+
+class ExtractionScriptParallel;
+
+/**
+  \brief A thread that owns its own script engines, created from the same filters.
+  */
+class ExtractionScriptWorker : public QThread
+{
+    Q_OBJECT
+
+    ExtractionScriptParallel *_pool;
+    // the definitions of the filters, to create the engines in the thread
+    QList<ExtractionScriptFilterModel*> _filterModels;
+
+    ExtractionScriptManager *newManager();
+
+protected:
+    void run();
+
+public:
+    ExtractionScriptWorker(ExtractionScriptParallel *pool, QList<ExtractionScriptFilterModel*> filterModels);
+    ~ExtractionScriptWorker();
+};
+
+/**
+  \brief Evaluates the scripts on the fragments in parallel, one engine per thread.
+  Scripting contract: the context (path, level) and the event belong to the token;
+  the script global variables are reset (ExtractionScriptManager::resetGlobals) at the
+  start of each fragment and of each run of tokens between two fragments, so they are kept
+  for the whole fragment or run but are not shared among them, whatever the number of threads.
+  The fragments are evaluated by the workers, the tokens outside the fragments
+  by the manager of the caller, in its thread and in document order.
+  The chunks are returned in document order.
+  */
+class ExtractionScriptParallel
+{
+    // only to limit the memory, the globals are not reset between these chunks
+    static const int MaxTokensOutsideFragments = 4096;
+
+    QMutex _mutex;
+    QWaitCondition _workAvailable;
+    QWaitCondition _workDone;
+    QList<ExtractionScriptWorker*> _workers;
+    // all the chunks not yet taken back, in document order
+    QList<ExtractionScriptChunk*> _chunks;
+    // the chunks waiting for a worker
+    QList<ExtractionScriptChunk*> _queue;
+    ExtractionScriptChunk *_currentChunk;
+    // evaluates the tokens outside the fragments
+    ExtractionScriptManager *_scriptManager;
+    ExtractionScriptTextEvent _textEvent;
+    ExtractionScriptElementEvent _elementEvent;
+    bool _isInFragment;
+    bool _isNewRun;
+    int _maxPendingChunks;
+    int _startedWorkers;
+    bool _isStopping;
+    bool _isInitError;
+    QString _initErrorMessage;
+
+    ExtractionScriptChunk *takeWork();
+    void setWorkDone(ExtractionScriptChunk *chunk);
+    void setWorkerStarted(const bool isOk, const QString &errorMessage);
+
+public:
+    ExtractionScriptParallel();
+    ~ExtractionScriptParallel();
+
+    bool start(const int threadsCount, ExtractionScriptManager *scriptManager);
+    void stop();
+    QString errorMessage();
+
+    void setInFragment(const bool value);
+    void addToken(const ExtractionScriptToken &token);
+    bool isChunkFull();
+    void submitChunk();
+    bool isTooManyPending();
+    bool hasPending();
+    ExtractionScriptChunk *takeCompleted(const bool isWait);
+
+    static int threadsForScripting(const int requestedThreads);
+    static void evaluateChunk(ExtractionScriptManager &manager, ExtractionScriptTextEvent &textEvent,
+                              ExtractionScriptElementEvent &elementEvent, ExtractionScriptChunk *chunk);
+
+    friend class ExtractionScriptWorker;
+};
+
+#endif // EXTRACTIONSCRIPTPARALLEL_H
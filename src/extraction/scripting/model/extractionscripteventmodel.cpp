@@ -23,8 +23,9 @@
 #include "extractionscripteventmodel.h"
 #include "xmlutils.h"
 #include "utils.h"
+#include <QAtomicInt>
 
-static int instancesCount = 0;
+static QAtomicInt instancesCount(0);
 
 //
 #define ATTR_TYPE           "type"
@@ -41,13 +42,26 @@ ExtractionScriptEventModel::ExtractionScriptEventModel()
 {
     _enabled = false;
     _eventType = ExtractionEventNone ;
-    instancesCount++;
+    instancesCount.ref();
 }
 
 ExtractionScriptEventModel::~ExtractionScriptEventModel()
 {
-    instancesCount--;
-    Q_ASSERT(instancesCount > -1);
+    // the models can be released by the scripting worker threads
+    const int remaining = instancesCount.fetchAndAddOrdered(-1) - 1 ;
+    Q_UNUSED(remaining);
+    Q_ASSERT(remaining > -1);
+}
+
+ExtractionScriptEventModel *ExtractionScriptEventModel::clone() const
+{
+    ExtractionScriptEventModel *copy = new ExtractionScriptEventModel();
+    copy->_enabled = _enabled ;
+    copy->_handlerName = _handlerName ;
+    copy->_code = _code ;
+    copy->_description = _description ;
+    copy->_eventType = _eventType ;
+    return copy ;
 }
 
 bool ExtractionScriptEventModel::enabled() const
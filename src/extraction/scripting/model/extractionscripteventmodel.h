@@ -56,6 +56,7 @@ public:
     void setEventType(const EExtractionEventType &eventType);
     //
     bool scanEventFromDom(const QDomElement &element);
+    ExtractionScriptEventModel *clone() const;
 };
 
 #endif // EXTRACTIONSCRIPTEVENTMODEL_H
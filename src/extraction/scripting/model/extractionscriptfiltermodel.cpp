@@ -23,8 +23,9 @@
 #include "extractionscriptfiltermodel.h"
 #include "xmlutils.h"
 #include "utils.h"
+#include <QAtomicInt>
 
-static int instancesCount = 0;
+static QAtomicInt instancesCount(0);
 
 //
 #define ATTR_ENABLED    "enabled"
@@ -35,7 +36,7 @@ static int instancesCount = 0;
 ExtractionScriptFilterModel::ExtractionScriptFilterModel()
 {
     _enabled = false;
-    instancesCount ++;
+    instancesCount.ref();
 }
 
 ExtractionScriptFilterModel::~ExtractionScriptFilterModel()
@@ -45,8 +46,9 @@ ExtractionScriptFilterModel::~ExtractionScriptFilterModel()
         delete event;
     }
     _eventsSet.clear();
-    instancesCount--;
-    Q_ASSERT(instancesCount > -1);
+    const int remaining = instancesCount.fetchAndAddOrdered(-1) - 1 ;
+    Q_UNUSED(remaining);
+    Q_ASSERT(remaining > -1);
 }
 
 bool ExtractionScriptFilterModel::enabled() const
@@ -102,6 +104,19 @@ QSet<ExtractionScriptEventModel*> ExtractionScriptFilterModel::events()
     return _eventsSet;
 }
 
+ExtractionScriptFilterModel *ExtractionScriptFilterModel::clone() const
+{
+    ExtractionScriptFilterModel *copy = new ExtractionScriptFilterModel();
+    copy->_id = _id ;
+    copy->_enabled = _enabled ;
+    copy->_name = _name ;
+    copy->_description = _description ;
+    foreach(ExtractionScriptEventModel *event, _eventsSet) {
+        copy->addEventModel(event->clone());
+    }
+    return copy ;
+}
+
 ExtractionScriptFilterModel* ExtractionScriptFilterModel::fromXMLString(const QString &codedValue)
 {
     ExtractionScriptFilterModel* model = new ExtractionScriptFilterModel();
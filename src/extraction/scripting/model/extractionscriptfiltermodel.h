@@ -53,6 +53,7 @@ public:
     void addEventModel(ExtractionScriptEventModel *newModel);
 
     QSet<ExtractionScriptEventModel*> events();
+    ExtractionScriptFilterModel *clone() const;
 
     static ExtractionScriptFilterModel* fromXMLString(const QString &codedValue);
 };
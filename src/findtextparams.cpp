@@ -27,6 +27,8 @@
 #include "utils.h"
 #include "regola.h"
 #include "qxmleditconfig.h"
+#include <QCache>
+#include <QMutex>
 
 #define SPLIT_SCOPE_CHAR '/'
 #define ATTR_CHAR        '@'
@@ -81,6 +83,7 @@ void FindTextParams::init(const EFindType findType, const QString &textToFind, c
     mIsWrapAround = isWrapAround ;
     mUseXQuery = useXQuery;
     mFirstMatch = NULL ;
+    compileMatcher();
 }
 
 FindTextParams::FindTextParams()
@@ -104,6 +107,7 @@ FindTextParams::FindTextParams()
     mIsWrapAround = true ;
     mSelection = NULL ;
     mFirstMatch = NULL ;
+    compileMatcher();
 }
 
 FindTextParams::~FindTextParams()
@@ -133,12 +137,23 @@ FindTextParams *FindTextParams::cloneFind()
     cloned->mUseXQuery = mUseXQuery;
     cloned->mIsWrapAround = mIsWrapAround;
     cloned->mSelection = mSelection ;
+    cloned->compileMatcher();
     return cloned ;
 }
 
 void FindTextParams::setCaseSensitive(bool value)
 {
     mIsCaseSensitive = value ;
+    compileMatcher();
+}
+
+/*!
+ * \brief FindTextParams::compileMatcher prepares the search of the text, the case folding of the pattern is done here once
+ */
+void FindTextParams::compileMatcher()
+{
+    mMatcher.setPattern(mTextToFind);
+    mMatcher.setCaseSensitivity(mIsCaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive);
 }
 
 FindTextParams::EFindType FindTextParams::findType()
@@ -213,23 +228,38 @@ bool FindTextParams::checkParams(bool &isErrorShown)
 
 bool FindTextParams::isTextMatched(const QString &textToExamine) const
 {
-    Qt::CaseSensitivity caseSensitivity =  mIsCaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive ;
     if(mIsMatchExact) {
+        Qt::CaseSensitivity caseSensitivity =  mIsCaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive ;
         return (0 == mTextToFind.compare(textToExamine, caseSensitivity));
     } else {
-        return textToExamine.contains(mTextToFind, caseSensitivity);
+        return mMatcher.indexIn(textToExamine) >= 0 ;
     }
 }
 
-bool FindTextParams::isTextBase64Matched(const QString & textToExamine) const
+// decoded base64 texts, shared by the searches; the cost is the length of the text
+#define BASE64_CACHE_SIZE    (8*1024*1024)
+static QMutex base64CacheMutex;
+static QCache<QString, QString> base64Cache(BASE64_CACHE_SIZE);
+
+static QString decodedBase64(const QString &text)
 {
-    QString textDecoded = Utils::fromBase64(textToExamine);
-    Qt::CaseSensitivity caseSensitivity =  mIsCaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive ;
-    if(mIsMatchExact) {
-        return (0 == mTextToFind.compare(textDecoded, caseSensitivity));
-    } else {
-        return textDecoded.contains(mTextToFind, caseSensitivity);
+    {
+        QMutexLocker lock(&base64CacheMutex);
+        QString *cached = base64Cache.object(text);
+        if(NULL != cached) {
+            return *cached ;
+        }
     }
+    QString decoded = Utils::fromBase64(text);
+    QMutexLocker lock(&base64CacheMutex);
+    base64Cache.insert(text, new QString(decoded), text.length() + 1);
+    return decoded;
+}
+
+bool FindTextParams::isTextBase64Matched(const QString & textToExamine) const
+{
+    QString textDecoded = decodedBase64(textToExamine);
+    return isTextMatched(textDecoded);
 }
 
 QStringList &FindTextParams::getScopes()
@@ -250,6 +280,7 @@ void FindTextParams::loadState()
     mIsShowSize =  Config::getBool(Config::KEY_SEARCH_SHOWSIZE, true);
     mIsWrapAround = Config::getBool(Config::KEY_SEARCH_WRAPAROUND, true);
     mUseXQuery = Config::getBool(Config::KEY_SEARCH_USEXQUERY, false);
+    compileMatcher();
 }
 
 void FindTextParams::saveState() const
@@ -335,6 +366,7 @@ void FindTextParams::addSelection(Element *newSelection)
 void FindTextParams::setSearchText(const QString &search)
 {
     mTextToFind = search ;
+    compileMatcher();
 }
 
 void FindTextParams::startElement(Element * /*currentElement*/)
@@ -357,6 +389,15 @@ bool FindTextParams::isExploreAllItems()
     return false;
 }
 
+/*!
+ * \brief FindTextParams::canSearchInParallel the base search does not change the data when matching,
+ * the elements can be examined in worker threads and the results applied later.
+ */
+bool FindTextParams::canSearchInParallel() const
+{
+    return true;
+}
+
 bool FindTextParams::handleAttributeName(Attribute * /*attribute*/)
 {
     return false;
@@ -606,6 +647,11 @@ bool ReplaceTextParams::isExploreAllItems()
     return true ;
 }
 
+bool ReplaceTextParams::canSearchInParallel() const
+{
+    return false ;
+}
+
 bool ReplaceTextParams::handleTextElement()
 {
     bool isCData = mCurrentElement->isCDATA() ;
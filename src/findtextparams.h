@@ -26,6 +26,7 @@
 #include "libQXmlEdit_global.h"
 #include <QApplication>
 #include <QUndoCommand>
+#include <QStringMatcher>
 #include "xmlEdit.h"
 
 class Element;
@@ -83,6 +84,10 @@ protected:
     bool        mIsWrapAround;
     QList<Element*> *mSelection;
     Element     *mFirstMatch;
+    // the text to find, compiled once for each search
+    QStringMatcher mMatcher;
+
+    void compileMatcher();
 
 public:
     FindTextParams();
@@ -218,6 +223,7 @@ public:
     virtual bool handleTextInline(TextChunk *tc);
     virtual bool handleProcessingInstruction();
     virtual bool isExploreAllItems();
+    virtual bool canSearchInParallel() const;
 
     void setCaseSensitive(bool value);
 
@@ -273,6 +279,7 @@ public:
     virtual bool handleTextInline(TextChunk *tc);
     virtual bool handleProcessingInstruction();
     virtual bool isExploreAllItems();
+    virtual bool canSearchInParallel() const;
 
     void setCommandGroup(QUndoCommand *undoCommandGroup);
 };
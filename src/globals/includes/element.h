@@ -37,6 +37,7 @@ class ReplaceTextParams;
 class ElementViewInfo;
 class AnonAlg;
 class NSContext;
+class NamespaceScope;
 class ElementUndoObserver;
 class ElementUndoInfo;
 
@@ -52,6 +53,9 @@ public:
 
 class TextChunk
 {
+    // the text decoded as base 64 for the display and its source, valid while the text is shared with it
+    QString _previewSource;
+    QString _previewDecoded;
 public:
     QString text;
     bool  isCDATA;
@@ -59,6 +63,7 @@ public:
     TextChunk(const bool isCDATA, const QString &text);
 
     TextChunk *clone();
+    QString decodedBase64Preview();
 };
 
 class QXmlException
@@ -263,6 +268,7 @@ public:
     bool isUsingPrefixRecursive(const QString &prefix);
     bool findPrefixForNamespace(const QString nsToSearch, QString &prefixToSet);
     QHash<QString, QString> findVisibleNamespaces();
+    const NamespaceScope *namespaceScope();
 
 
     static QRegExp terminatorSearch;
@@ -287,6 +293,7 @@ public:
     bool isEmpty() const;
     bool generateDom(QDomDocument &document, QDomNode &parent, ElementLoadInfoMap *dataMap);
     bool generateDom(QDomDocument &document, QDomNode &parent);
+    bool generateDomNS(QDomDocument &document, QDomNode &parent, ElementLoadInfoMap *dataMap, const QHash<QString, QString> &namespaces);
 
     bool writeStream(XMLSaveContext *context, QXmlStreamWriter &writer, ElementLoadInfoMap *dataMap = NULL);
 
@@ -409,6 +416,8 @@ public:
 
     bool findText(FindTextParams &findArgs);
     bool matchText(FindTextParams &findArgs);
+    void collectTextMatches(FindTextParams &findArgs, QList<Element*> &matches);
+    void showTextMatches(const QSet<Element*> &containers);
     bool searchInScope(FindTextParams &findArgs);
     bool replaceText(ReplaceTextParams &findArgs);
 
@@ -513,12 +522,16 @@ private:
     long    instanceId;
     Element *parentElement;
     Regola *parentRule;
+    // valid only if the generation is the one of the scopes of the document
+    const NamespaceScope *_namespaceScope;
+    int _namespaceScopeGeneration;
     QTreeWidgetItem *ui;
     EViewModes _viewMode;
     bool _edited;
     bool _saved;
 
     void houseWork(Regola *regola, Element *parent);
+    void namespacesChanged();
 
     void zeroUI();
     void zeroUISelf(const bool emitMe);
@@ -121,6 +121,9 @@ protected:
     ANotifier *_notifier;
     //--- endregion(notify)
 
+    // no user interface: batch mode under a QCoreApplication
+    bool _isHeadless;
+
     //--- region(xsdMode)
     XSDManager *_xsdManager;
     //--- endregion(xsdMode)
@@ -141,9 +144,11 @@ protected:
     void incrementAndClipCounter(uint &value);
 
 public:
-    QXmlEditData();
+    explicit QXmlEditData(const bool isHeadless = false);
     virtual ~QXmlEditData();
 
+    bool isHeadless() const;
+
     enum EIndentAttributes {
         AttributesIndentationNone,
         AttributesIndentationMaxCols,
@@ -39,6 +39,7 @@
 #include "paintinfo.h"
 #include "xmlprolog.h"
 #include "qxmleditdata.h"
+#include "modules/xml/namespacescope.h"
 
 class Element;
 class DocumentType;
@@ -61,6 +62,8 @@ public:
 
 class XMLSaveContext;
 class NamespaceManager;
+class TextSearchIndex;
+class XmlSourceMap;
 
 enum QxmlEditDeleteElements {
     DeleteAllSiblings,
@@ -189,11 +192,12 @@ private:
     bool _overrideGlobalIndentation;
     int _indent;
     bool _useMixedContent;
-    bool _isCrapCacheNSActivated;
-    QHash<QString, QString> _crapCachePrefixNs;
+    NamespaceScopeTable _namespaceScopes;
     QUndoStack _undoStack;
     XmlProlog _prolog;
     bool _forceDOM;
+    TextSearchIndex *_textIndex;
+    XmlSourceMap *_sourceMap;
 public:
 
     enum EExportOption {
@@ -302,6 +306,9 @@ public:
 private:
     bool writeStreamInternal(QIODevice *device, const bool useEncoding, ElementLoadInfoMap *map);
     bool writeStreamInternalElement(QIODevice *device, EExportOptions options, Element *selected);
+    bool closeOutputDevice(QIODevice *device);
+    void setupSaveContext(XMLSaveContext &context);
+    void deleteSourceMap();
 public:
     bool writeAsJavaString(QIODevice *device);
     bool writeAsCString(QIODevice *device);
@@ -312,6 +319,7 @@ public:
     QByteArray writeMemory();
     QString getAsText();
     QString getAsText(ElementLoadInfoMap *map);
+    bool generateDomNS(QDomDocument &document, ElementLoadInfoMap *map = NULL);
 private:
     QString getAsTextStream(ElementLoadInfoMap *map);
 public:
@@ -364,6 +372,10 @@ public:
 
     bool addTopElement(Element *theNewElement, const int position = -1);
     void notifyDeletionTopElement(Element *pEL);
+    //--- text index
+    void setTextIndexEnabled(const bool value);
+    TextSearchIndex *textIndex();
+    void notifyElementRemoved(Element *element);
     void appendComment(QWidget *window, QTreeWidget *tree);
     void appendComment(QWidget *window, QTreeWidget *tree, Element *newComment);
     void addComment(QWidget *window, QTreeWidget *tree);
@@ -505,7 +517,8 @@ public:
     QString namespacePrefixXSI();
     QString namespacePrefixInRoot(const QString &namespaceToFind);
     QMap<QString, QString> namespaces();
-    QString getCachedPrefixNS(const QString &nsURI);
+    NamespaceScopeTable *namespaceScopes();
+    void invalidateNamespaceScopes();
     bool hasXSLTNamespace();
     bool hasSCXMLNamespace();
     QSet<QString> namespacesURI();
@@ -565,6 +578,8 @@ public:
     ESaveAttributes saveAttributesMethod() const;
     void setSaveAttributesMethod(const ESaveAttributes saveAttributesMethod);
     static bool isSaveSortAlphaAttribute();
+    static bool isSaveIncremental();
+    XmlSourceMap *sourceMap() const;
 
     bool readFromStream(XMLLoadContext *context, QXmlStreamReader *xmlReader);
 
@@ -589,6 +604,8 @@ public:
     //--- end (sort attributes)
 
     void XSDSetNamespaceToParams(XSDOperationParameters *params, Element *element);
+private slots:
+    void onUndoIndexChanged(int index);
 signals:
     void wasModified();
     void undoStateChanged();
@@ -700,6 +717,8 @@ private:
     void processDocument(QDomDocument &document);
     QDomDocument createNewDocument();
     void searchWithXQuery(FindTextParams &findArgs, Element *selectedItem);
+    void findAllTextMatches(FindTextParams &findArgs, QList<Element*> &scope, const bool isWholeDocument);
+    bool findIndexedTextMatches(FindTextParams &findArgs, QList<Element*> &matches);
     //metadata
     void updateMetadataRecord(QTreeWidget *tree, Element *metaElement, MetadataInfo *info, const bool metaExists = false);
     void appendAMetadatum(QTreeWidget *tree, PseudoAttribute *attribute, const QString &type);
@@ -723,6 +742,7 @@ private:
 #endif
 
     bool setChildrenTreeFromStream(XMLLoadContext *context, QXmlStreamReader *xmlReader, Element *parent, QVector<Element*> *collection, const bool isTopLevel);
+    static Attribute *findSampleAttribute(Element *element, const QStringRef &name);
     bool decodePreamble(QXmlStreamReader *xmlReader, const QString &encoding);
     bool filterCommentsAfterReading(XMLLoadContext *context);
     virtual bool editTextualForInterface(QWidget *const parentWindow, Element *element);
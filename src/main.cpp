@@ -34,9 +34,11 @@
 #include "modules/services/anotifier.h"
 #include "modules/xslt/xsltexecutor.h"
 #include "modules/services/startactionsengine.h"
+#include "modules/services/batchrunner.h"
 #include <QMessageBox>
 #include <QTimer>
 #include "licensedialog.h"
+#include "modules/utils/perftrace.h"
 
 extern const char *APP_TITLE ;
 
@@ -74,6 +76,8 @@ static void removeMenuExtra(QXmlEditApplication *app, MainMenuBlock *mainMenuBlo
 static bool licenseAgreement();
 static int doAnonymize(QXmlEditApplication *app, StartParams &startParams);
 static bool handleCommandLineArguments(QXmlEditApplication &app, StartParams &startParams);
+static void startupPhase(const char *name, qint64 &phaseStart);
+static int batchMain(int argc, char *argv[]);
 
 static QTranslator qtLibTranslator;
 static QTranslator qXmlEditTranslator;
@@ -84,6 +88,9 @@ static LogHandler logHandler;
 
 int internalMain(int argc, char *argv[])
 {
+    if(StartParams::isBatchCommandLine(argc, argv)) {
+        return batchMain(argc, argv);
+    }
     StartParams startParams ;
     QXmlEditApplication app(argc, argv);
     Q_INIT_RESOURCE(risorse);
@@ -93,22 +100,29 @@ int internalMain(int argc, char *argv[])
     QCoreApplication::setApplicationName(APPLICATION_NAME);
     QXmlEditGlobals::setAppTitle(APP_TITLE);
 
+    const qint64 startupStart = PerfTrace::nowNs();
+    qint64 phaseStart = startupStart ;
     installMsgHandler();
     if(!Config::init()) {
         Utils::errorReadingUserSettings();
     }
+    startupPhase("config", phaseStart);
     ApplicationData appData;
     appData.setLogger(&logHandler);
     initLogger();
-    appData.init();
+    // the sessions database is opened by the event loop
+    appData.init(true);
+    startupPhase("appData", phaseStart);
     startTanslator(&app);
     app.setAppData(&appData);
     app.setLogger(&logHandler);
+    startupPhase("translators", phaseStart);
 
     todo();
     experimental();
     Element::loadIcons();
     app.setWindowIcon(QIcon(":/tree/icon.png"));
+    startupPhase("icons", phaseStart);
 
     if(!licenseAgreement()) {
         return -1 ;
@@ -135,6 +149,11 @@ int internalMain(int argc, char *argv[])
         StartActionsEngine startActionsEngine(&appData, &app);
         startActionsEngine.execute(startParams);
     }
+    startupPhase("firstWindow", phaseStart);
+    if(PerfTrace::isEnabled()) {
+        PerfTrace::addEvent("startup", "timeToFirstWindow", startupStart, phaseStart - startupStart);
+    }
+    logHandler.info(QString("Time to first window: %1 ms").arg((PerfTrace::nowNs() - startupStart) / 1000000));
     app.connect(appData.notifier(), SIGNAL(newWindowRequested()), &app, SLOT(onNewWindow()));
     app.connect(appData.notifier(), SIGNAL(encodingToolsRequested()), &app, SLOT(onEncodingTools()));
     app.connect(appData.notifier(), SIGNAL(codePageToolsRequested()), &app, SLOT(onCodePagesTools()));
@@ -208,6 +227,18 @@ static void removeMenuExtra(QXmlEditApplication *app, MainMenuBlock *mainMenuBlo
 #endif
 }
 
+/*!
+ * \brief records a startup phase in the performance trace, the next phase starts now
+ */
+static void startupPhase(const char *name, qint64 &phaseStart)
+{
+    const qint64 now = PerfTrace::nowNs();
+    if(PerfTrace::isEnabled()) {
+        PerfTrace::addEvent("startup", name, phaseStart, now - phaseStart);
+    }
+    phaseStart = now ;
+}
+
 static int doAnonymize(QXmlEditApplication *app, StartParams &startParams)
 {
     Utils::setBatch(true);
@@ -231,6 +262,51 @@ static int doAnonymize(QXmlEditApplication *app, StartParams &startParams)
     return returnCode ;
 }
 
+/*!
+ * \brief executes a job list without creating the graphic application, the jobs
+ * run in parallel and the outcome of each one is written to the standard output.
+ */
+static int batchMain(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setOrganizationName(ORGANIZATION_NAME);
+    QCoreApplication::setOrganizationDomain(ORGANIZATION_DOMAIN);
+    QCoreApplication::setApplicationName(APPLICATION_NAME);
+    QXmlEditGlobals::setAppTitle(APP_TITLE);
+    installMsgHandler();
+    Utils::setBatch(true);
+    QTextStream stdErr(stderr);
+    QTextStream stdOut(stdout);
+    StartParams startParams ;
+    if(!startParams.decodeCommandLine(app.arguments())) {
+        stdErr << startParams.errorMessage << "\n";
+        stdErr.flush();
+        printHelp();
+        return -1;
+    }
+    if(!Config::init()) {
+        stdErr << QObject::tr("Error reading the user settings.\n");
+    }
+    // no notifier, clipboard or user interface services: they need a QApplication
+    ApplicationData appData(true);
+    appData.setLogger(&logHandler);
+    initLogger();
+    BatchRunner runner(&appData);
+    if(startParams.threads > 0) {
+        runner.setThreads(startParams.threads);
+    }
+    if(!runner.readJobList(startParams.fileName)) {
+        stdErr << runner.errorMessage() << "\n";
+        return -1 ;
+    }
+    const bool isOk = runner.run();
+    runner.report(stdOut);
+    if(!runner.errorMessage().isEmpty()) {
+        stdErr << runner.errorMessage() << "\n";
+    }
+    return isOk ? 0 : -1 ;
+}
+
 static void initLogger()
 {
     bool isEnabled = Config::getBool(Config::KEY_LOGS_ENABLED, false);
@@ -327,8 +403,9 @@ void printHelp()
     stdOut << QString("QXmlEdit %1\n").arg(VERSION);
     stdOut << QObject::tr("Usage:\n");
     stdOut << QObject::tr(" -vis <file>: opens the data visualization panel\n");
-    stdOut << QObject::tr(" -anonymize <inputfile> <profile> <outputfile>: anonymize\n");
+    stdOut << QObject::tr(" -anonymize <inputfile> <profile> <outputfile>: anonymize, if the input is a folder all its XML files are anonymized into the output folder\n");
     stdOut << QObject::tr(" -xsl [-saxon] -xsl=<xslFile> -output=<outputfile>  {-p<name>=<value>}* <inputfile>: execute XSL transformation\n");
+    stdOut << QObject::tr(" -batch [-threads=<count>] <joblist>: execute the jobs in the list without the user interface\n");
     stdOut << QObject::tr(" any other argument is used as a file to open.\n");
 #endif //QXMLEDIT_NOMAIN
 }
@@ -67,6 +67,7 @@ extern const char *APP_TITLE ;
 #include "modules/style/editingtypesdialog.h"
 #include "modules/help/guidedvalidationdialog.h"
 #include "modules/help/shortcutsdialog.h"
+#include "modules/help/perftracedialog.h"
 #include "extraction/extractfragmentsdialog.h"
 #include "widgets/infoonkeyboardshoertcuts.h"
 #include "widgets/infooneditmode.h"
@@ -3747,6 +3748,11 @@ void MainWindow::on_actionShowPrincipalShortcuts_triggered()
     ShortcutsDialog::display(this);
 }
 
+void MainWindow::on_actionPerformanceTrace_triggered()
+{
+    PerfTraceDialog::display(this);
+}
+
 void MainWindow::on_actionAddFormattingInfo_triggered()
 {
     ui.editor->addFormattingInfo();
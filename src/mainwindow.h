@@ -407,6 +407,7 @@ private slots:
     void on_actionExecuteXSLTAsSource_triggered();
     void on_actionOpenSiblingsAtTheSameLevel_triggered();
     void on_actionShowPrincipalShortcuts_triggered();
+    void on_actionPerformanceTrace_triggered();
     void on_actionAddFormattingInfo_triggered();
     void on_actionRemoveFormattingInfo_triggered();
     void on_actionPresetApacheFOP_triggered();
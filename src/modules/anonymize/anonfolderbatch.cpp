@@ -0,0 +1,234 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+#include "anonfolderbatch.h"
+#include "modules/anonymize/anoncontext.h"
+#include "modules/anonymize/anonprofile.h"
+
+/*!
+ * \brief takes the files of the batch until there are no more
+ */
+class AnonFolderBatchWorker : public QRunnable
+{
+    AnonFolderBatch *_batch;
+public:
+    AnonFolderBatchWorker(AnonFolderBatch *batch)
+    {
+        _batch = batch ;
+    }
+
+    void run()
+    {
+        _batch->workerThread();
+    }
+};
+
+//--------------------------------------------------------------
+
+AnonFolderBatchItem::AnonFolderBatchItem(const QString &newInputPath, const QString &newOutputPath)
+{
+    inputPath = newInputPath ;
+    outputPath = newOutputPath ;
+    isDone = false ;
+}
+
+AnonFolderBatchItem::~AnonFolderBatchItem()
+{
+}
+
+//--------------------------------------------------------------
+
+AnonFolderBatch::AnonFolderBatch(QObject *parent) :
+    QObject(parent)
+{
+    _threads = qMax(1, QThread::idealThreadCount());
+    _profile = NULL ;
+}
+
+AnonFolderBatch::~AnonFolderBatch()
+{
+    EMPTYPTRLIST(_items, AnonFolderBatchItem);
+}
+
+int AnonFolderBatch::threads()
+{
+    return _threads ;
+}
+
+void AnonFolderBatch::setThreads(const int value)
+{
+    _threads = qMax(1, value);
+}
+
+QList<AnonFolderBatchItem*> AnonFolderBatch::items()
+{
+    return _items ;
+}
+
+const AnonOperationResult *AnonFolderBatch::result()
+{
+    return &_result ;
+}
+
+void AnonFolderBatch::addFile(const QString &inputPath, const QString &outputPath)
+{
+    _items.append(new AnonFolderBatchItem(inputPath, outputPath));
+}
+
+/*!
+ * \brief AnonFolderBatch::addFolder adds the files of the folder and of its subfolders.
+ * Each output file has the same path, relative to the output folder, of its input file; the
+ * output folders are created now, before the threads start.
+ */
+bool AnonFolderBatch::addFolder(const QString &inputFolder, const QString &outputFolder, const QStringList &nameFilters)
+{
+    QDir inputDir(inputFolder);
+    if(!inputDir.exists()) {
+        _result.setError(AnonOperationResult::RES_ERR_OPEN_INPUT_FILE, tr("The input folder '%1' does not exist.").arg(inputFolder));
+        return false;
+    }
+    QDir outputDir(outputFolder);
+    if(inputDir.absolutePath() == outputDir.absolutePath()) {
+        _result.setError(AnonOperationResult::RES_ERR_OPEN_OUTPUT_FILE, tr("The output folder must be different from the input one."));
+        return false;
+    }
+    QStringList files;
+    QDirIterator iterator(inputDir.absolutePath(), nameFilters, QDir::Files, QDirIterator::Subdirectories);
+    while(iterator.hasNext()) {
+        files.append(iterator.next());
+    }
+    // the order of the file system is not guaranteed
+    files.sort();
+    foreach(const QString &filePath, files) {
+        const QString outputPath = outputDir.absoluteFilePath(inputDir.relativeFilePath(filePath));
+        const QString outputFilePath = QFileInfo(outputPath).absolutePath();
+        if(!QDir().mkpath(outputFilePath)) {
+            _result.setError(AnonOperationResult::RES_ERR_OPEN_OUTPUT_FILE, tr("Unable to create the folder '%1'.").arg(outputFilePath));
+            return false;
+        }
+        addFile(filePath, outputPath);
+    }
+    return true ;
+}
+
+/*!
+ * \brief anonymizes all the files. An abort, requested also before the start, is never reset:
+ * the files not started are skipped and the running ones stop.
+ */
+const AnonOperationResult *AnonFolderBatch::perform(AnonProfile *profile)
+{
+    _result.reset();
+    if(NULL == profile) {
+        _result.setError(AnonOperationResult::RES_ERR_INVALID_CONTEXT, tr("Invalid profile"));
+        return result();
+    }
+    _profile = profile ;
+    _nextItem.fetchAndStoreOrdered(0);
+    _filesDone.fetchAndStoreOrdered(0);
+    _errorsCount.fetchAndStoreOrdered(0);
+    foreach(AnonFolderBatchItem * item, _items) {
+        item->isDone = false ;
+        item->result.reset();
+    }
+    const int workers = qMin(_threads, _items.size());
+    _pool.setMaxThreadCount(qMax(1, workers));
+    FORINT(i, workers) {
+        _pool.start(new AnonFolderBatchWorker(this));
+    }
+    _pool.waitForDone();
+    _profile = NULL ;
+    if(0 != _isAborted.fetchAndAddOrdered(0)) {
+        _result.setError(AnonOperationResult::RES_ERR_USERABORTED, tr("User abort requested."));
+    } else if(errorsCount() > 0) {
+        foreach(AnonFolderBatchItem * item, _items) {
+            if(item->result.isError()) {
+                _result.setError(item->result.code(), tr("%1 files with errors, the first is '%2': %3")
+                                 .arg(errorsCount()).arg(item->inputPath).arg(item->result.message()));
+                break;
+            }
+        }
+    }
+    return result();
+}
+
+void AnonFolderBatch::workerThread()
+{
+    AnonOperationBatch operation;
+    operation.setSharedAbort(&_isAborted);
+    {
+        QMutexLocker locker(&_mutex);
+        _runningOperations.append(&operation);
+    }
+    forever {
+        if(0 != _isAborted.fetchAndAddOrdered(0)) {
+            break;
+        }
+        const int index = _nextItem.fetchAndAddOrdered(1);
+        if(index >= _items.size()) {
+            break;
+        }
+        executeItem(&operation, _items.at(index));
+    }
+    {
+        QMutexLocker locker(&_mutex);
+        _runningOperations.removeAll(&operation);
+    }
+}
+
+void AnonFolderBatch::executeItem(AnonOperationBatch *operation, AnonFolderBatchItem *item)
+{
+    AnonContext context(NULL, "");
+    context.setAlg(_profile->params());
+    context.setProfile(_profile->clone());
+    const AnonOperationResult *res = operation->perform(item->inputPath, item->outputPath, &context);
+    item->result = *res ;
+    item->isDone = true ;
+    if(res->isError()) {
+        _errorsCount.fetchAndAddOrdered(1);
+    }
+    _filesDone.fetchAndAddOrdered(1);
+}
+
+void AnonFolderBatch::setAborted()
+{
+    _isAborted.fetchAndStoreOrdered(1);
+    QMutexLocker locker(&_mutex);
+    foreach(AnonOperationBatch * operation, _runningOperations) {
+        operation->setAborted();
+    }
+}
+
+int AnonFolderBatch::filesCount()
+{
+    return _items.size();
+}
+
+int AnonFolderBatch::filesDone()
+{
+    return _filesDone.fetchAndAddOrdered(0);
+}
+
+int AnonFolderBatch::errorsCount()
+{
+    return _errorsCount.fetchAndAddOrdered(0);
+}
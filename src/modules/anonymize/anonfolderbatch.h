@@ -0,0 +1,96 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef ANONFOLDERBATCH_H
+#define ANONFOLDERBATCH_H
+
+#include "xmlEdit.h"
+#include "libQXmlEdit_global.h"
+#include "modules/anonymize/anonoperationbatch.h"
+
+class AnonProfile;
+class AnonFolderBatch;
+
+/*!
+ * \brief a file of a folder batch, the output path is fixed before the run
+ */
+class LIBQXMLEDITSHARED_EXPORT AnonFolderBatchItem
+{
+public:
+    QString inputPath;
+    QString outputPath;
+    AnonOperationResult result;
+    bool isDone;
+
+    AnonFolderBatchItem(const QString &newInputPath, const QString &newOutputPath);
+    ~AnonFolderBatchItem();
+};
+
+/*!
+ * \brief AnonFolderBatch anonymizes many files on a pool of threads.
+ * The profile is shared read only, each file has its own context like the single file batch,
+ * so the result of a file does not depend on the order of the execution.
+ */
+class LIBQXMLEDITSHARED_EXPORT AnonFolderBatch : public QObject
+{
+    Q_OBJECT
+
+    int _threads;
+    QList<AnonFolderBatchItem*> _items;
+    AnonProfile *_profile;
+    QThreadPool _pool;
+    QAtomicInt _nextItem;
+    QAtomicInt _filesDone;
+    QAtomicInt _errorsCount;
+    QAtomicInt _isAborted;
+    QMutex _mutex;
+    QList<AnonOperationBatch*> _runningOperations;
+    AnonOperationResult _result;
+
+    friend class AnonFolderBatchWorker;
+
+    void workerThread();
+    void executeItem(AnonOperationBatch *operation, AnonFolderBatchItem *item);
+
+public:
+    explicit AnonFolderBatch(QObject *parent = 0);
+    virtual ~AnonFolderBatch();
+
+    int threads();
+    void setThreads(const int value);
+
+    bool addFolder(const QString &inputFolder, const QString &outputFolder, const QStringList &nameFilters);
+    void addFile(const QString &inputPath, const QString &outputPath);
+    QList<AnonFolderBatchItem*> items();
+
+    const AnonOperationResult *perform(AnonProfile *profile);
+    const AnonOperationResult *result();
+    void setAborted();
+
+    int filesCount();
+    int filesDone();
+    int errorsCount();
+};
+
+#endif // ANONFOLDERBATCH_H
@@ -92,6 +92,7 @@ AnonOperationBatch::AnonOperationBatch(QObject *parent) :
     _outProvider = this ;
     _isDocumentStandalone = false;
     isAborted = false ;
+    _sharedAbort = NULL ;
     _counterOperations = 0 ;
 }
 
@@ -332,6 +333,14 @@ void AnonOperationBatch::setAborted()
     _mutex.unlock();
 }
 
+/*!
+ * \brief a flag checked with the one of the operation, that each file resets
+ */
+void AnonOperationBatch::setSharedAbort(QAtomicInt *sharedAbort)
+{
+    _sharedAbort = sharedAbort ;
+}
+
 int AnonOperationBatch::operationsCount()
 {
     int result = 0 ;
@@ -348,6 +357,9 @@ bool AnonOperationBatch::checkStatus(AnonOperationResult * result)
     if(isAborted) {
         checkAbort = isAborted ;
     }
+    if((NULL != _sharedAbort) && (0 != _sharedAbort->fetchAndAddOrdered(0))) {
+        checkAbort = true ;
+    }
     if(checkAbort) {
         result->setMessage(AnonOperationResult::RES_ERR_USERABORTED,
                            QString("User aborted."), true);
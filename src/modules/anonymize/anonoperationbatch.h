@@ -27,6 +27,7 @@
 #include <QObject>
 #include <QIODevice>
 #include <QMutex>
+#include <QAtomicInt>
 #include "libQXmlEdit_global.h"
 
 /**
@@ -87,6 +88,8 @@ class LIBQXMLEDITSHARED_EXPORT AnonOperationBatch : public QObject, public AnonO
     bool _isDocumentStandalone ;
     QString _documentVersion;
     volatile bool isAborted ;
+    // the abort of a batch of files, not reset by each file
+    QAtomicInt *_sharedAbort;
     QMutex _mutex;
     volatile int _counterOperations;
     AnonOperationBatchOutputFileProvider *_outProvider;
@@ -98,6 +101,7 @@ public:
     const AnonOperationResult *perform(const QString &fileInputPath, const QString &fileOutputPath, AnonContext *startContext);
     const AnonOperationResult *result();
     void setAborted();
+    void setSharedAbort(QAtomicInt *sharedAbort);
     int operationsCount();
     int getIndent() const;
     void setIndent(int value);
@@ -30,11 +30,13 @@
 #include "modules/anonymize/anoncontext.h"
 #include "anonprofilemanager.h"
 #include "modules/anonymize/anonoperationbatch.h"
+#include "modules/anonymize/anonfolderbatch.h"
 
 AnonymizeBatch::AnonymizeBatch(ApplicationData *newData, const QString &newFileInputPath, const QString &newProfileName, const QString &newFileOutputPath, QObject *parent) :
     QObject(parent)
 {
     _outProvider = NULL ;
+    _profile = NULL ;
     _error = false ;
     _data = newData ;
     _fileInputPath = newFileInputPath;
@@ -78,12 +80,24 @@ void AnonymizeBatch::setOutputProvider(AnonOperationBatchOutputFileProvider* new
     }
 }
 
+/*!
+ * \brief AnonymizeBatch::setProfile uses an already loaded profile instead of reading it
+ * from the storage, the profile is not owned and is cloned for each operation.
+ */
+void AnonymizeBatch::setProfile(AnonProfile *newProfile)
+{
+    _profile = newProfile ;
+}
+
 bool AnonymizeBatch::operation()
 {
-    AnonProfile *profile = loadProfile();
+    AnonProfile *profile = (NULL != _profile) ? _profile->clone() : loadProfile();
     if(NULL == profile) {
         return error();
     }
+    if(QFileInfo(_fileInputPath).isDir()) {
+        return folderOperation(profile);
+    }
     AnonOperationBatch operation;
     AnonContext context(NULL, "");
     context.setAlg(profile->params());
@@ -104,6 +118,28 @@ bool AnonymizeBatch::operation()
 }
 
 
+/*!
+ * \brief AnonymizeBatch::folderOperation anonymizes all the XML files of a folder
+ * into the output folder, using many threads
+ */
+bool AnonymizeBatch::folderOperation(AnonProfile *profile)
+{
+    AnonFolderBatch operation;
+    QStringList nameFilters;
+    nameFilters << "*.xml" ;
+    if(operation.addFolder(_fileInputPath, _fileOutputPath, nameFilters)) {
+        operation.perform(profile);
+    }
+    delete profile;
+    const AnonOperationResult *res = operation.result();
+    if(res->isError()) {
+        _errorMessage = tr("Error: %1, '%2'").arg(res->code()).arg(res->message());
+        return error();
+    }
+    return true;
+}
+
+
 AnonProfile* AnonymizeBatch::getProfileFromProfileData(GenericPersistentData *input)
 {
     AnonProfile * result = new AnonProfile() ;
@@ -43,10 +43,11 @@ class AnonymizeBatch : public QObject
     //---
     bool error();
     bool setError(const QString &message);
-    AnonProfile* loadProfile();
     GenericPersistentData* getProfile(const QString &profileName);
     AnonProfile* getProfileFromProfileData(GenericPersistentData *input);
+    bool folderOperation(AnonProfile *profile);
     AnonOperationBatchOutputFileProvider *_outProvider;
+    AnonProfile *_profile;
 public:
     explicit AnonymizeBatch(ApplicationData *newData, const QString &newFileInputPath, const QString &newProfileName, const QString &newFileOutputPath, QObject *parent = 0);
     ~AnonymizeBatch();
@@ -55,6 +56,8 @@ public:
     bool operation();
     QString errorMessage();
     void setOutputProvider(AnonOperationBatchOutputFileProvider* newProvider);
+    AnonProfile* loadProfile();
+    void setProfile(AnonProfile *newProfile);
 
 signals:
 
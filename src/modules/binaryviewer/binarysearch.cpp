@@ -0,0 +1,92 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+#include "binarysearch.h"
+#include <string.h>
+
+/*!
+ * \brief the first occurrence starting at or after from, -1 if not found
+ */
+qint64 BinarySearch::indexOf(const char *data, const qint64 size, const QByteArray &pattern, const qint64 from)
+{
+    const qint64 patternLength = pattern.length();
+    if((NULL == data) || (0 == patternLength) || (from < 0) || ((size - from) < patternLength)) {
+        return -1 ;
+    }
+    const char *patternData = pattern.constData();
+    const size_t restLength = static_cast<size_t>(patternLength - 1);
+    const char first = patternData[0];
+    const char *position = data + from ;
+    const char *lastStart = data + (size - patternLength);
+    while(position <= lastStart) {
+        const void *found = memchr(position, first, static_cast<size_t>(lastStart - position) + 1);
+        if(NULL == found) {
+            return -1 ;
+        }
+        const char *candidate = static_cast<const char*>(found);
+        if(0 == memcmp(candidate + 1, patternData + 1, restLength)) {
+            return candidate - data ;
+        }
+        position = candidate + 1 ;
+    }
+    return -1 ;
+}
+
+/*!
+ * \brief the last occurrence starting at or before from, -1 if not found
+ */
+qint64 BinarySearch::lastIndexOf(const char *data, const qint64 size, const QByteArray &pattern, const qint64 from)
+{
+    const qint64 patternLength = pattern.length();
+    if((NULL == data) || (0 == patternLength) || (size < patternLength)) {
+        return -1 ;
+    }
+    const qint64 start = qMin(from, size - patternLength);
+    if(start < 0) {
+        return -1 ;
+    }
+    const char *patternData = pattern.constData();
+    const size_t restLength = static_cast<size_t>(patternLength - 1);
+    const char first = patternData[0];
+#if defined(__GLIBC__) && defined(_GNU_SOURCE)
+    qint64 length = start + 1 ;
+    while(length > 0) {
+        const void *found = memrchr(data, first, static_cast<size_t>(length));
+        if(NULL == found) {
+            return -1 ;
+        }
+        const char *candidate = static_cast<const char*>(found);
+        if(0 == memcmp(candidate + 1, patternData + 1, restLength)) {
+            return candidate - data ;
+        }
+        length = candidate - data ;
+    }
+#else
+    for(const char *candidate = data + start ; candidate >= data ; candidate--) {
+        if((*candidate == first) && (0 == memcmp(candidate + 1, patternData + 1, restLength))) {
+            return candidate - data ;
+        }
+    }
+#endif
+    return -1 ;
+}
@@ -0,0 +1,42 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef BINARYSEARCH_H
+#define BINARYSEARCH_H
+
+#include <QByteArray>
+
+/**
+  \brief Search of a sequence of bytes in memory, i.e. a mapped file.
+  The candidates are located with memchr, vectorized by the C library, and
+  verified with memcmp; all the offsets are 64 bit.
+  */
+class BinarySearch
+{
+public:
+    static qint64 indexOf(const char *data, const qint64 size, const QByteArray &pattern, const qint64 from);
+    static qint64 lastIndexOf(const char *data, const qint64 size, const QByteArray &pattern, const qint64 from);
+};
+
+#endif // BINARYSEARCH_H
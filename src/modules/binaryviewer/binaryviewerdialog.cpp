@@ -33,6 +33,7 @@ BinaryViewerDialog::BinaryViewerDialog(QStringList recentFiles, QWidget *parent)
     QDialog(parent),
     ui(new Ui::BinaryViewerDialog)
 {
+    _occurrencesCount = 0 ;
     ui->setupUi(this);
     finishSetup(recentFiles);
     start();
@@ -40,6 +41,7 @@ BinaryViewerDialog::BinaryViewerDialog(QStringList recentFiles, QWidget *parent)
 
 BinaryViewerDialog::~BinaryViewerDialog()
 {
+    _model.stopFindAll();
     delete ui;
 }
 
@@ -52,7 +54,10 @@ void BinaryViewerDialog::finishSetup(QStringList recentFiles)
     Utils::setupComboEncoding(ui->cmbEncodings);
     QString selection = Config::getString(Config::KEY_BINARY_ENCODING, "ISO-8859-15");
     Utils::selectComboText(ui->cmbEncodings, selection);
-    connect(&_model, SIGNAL(pageChanged(int)), this, SLOT(onCurrentPageChanged(int)));
+    connect(&_model, SIGNAL(pageChanged(qint64)), this, SLOT(onCurrentPageChanged(qint64)));
+    connect(&_model, SIGNAL(occurrencesFound(int, QList<qint64>)), this, SLOT(onOccurrencesFound(int, QList<qint64>)), Qt::QueuedConnection);
+    connect(&_model, SIGNAL(findAllProgress(int, int)), this, SLOT(onFindAllProgress(int, int)), Qt::QueuedConnection);
+    connect(&_model, SIGNAL(findAllFinished(int, qint64, bool)), this, SLOT(onFindAllFinished(int, qint64, bool)), Qt::QueuedConnection);
     setAcceptDrops(true);
 
     ui->fileComboBox->setEnabled(false);
@@ -131,6 +136,7 @@ void BinaryViewerDialog::assignFile(const QString &filePath)
 
 void BinaryViewerDialog::assignIO(QIODevice *ioDevice)
 {
+    resetFindAll();
     BinaryViewerModel::ErrCodes resultCode = _model.setFile(ioDevice) ;
     if(BinaryViewerModel::EC_NOERROR == resultCode) {
         ui->tableView->setUpdatesEnabled(false);
@@ -190,7 +196,7 @@ void BinaryViewerDialog::moveToPage(const bool isNext)
     setEnabled(true);
 }
 
-void BinaryViewerDialog::moveToPageAbs(const int newPage)
+void BinaryViewerDialog::moveToPageAbs(const qint64 newPage)
 {
     _model.goToPageAbs(newPage);
     ui->tableView->setUpdatesEnabled(false);
@@ -211,7 +217,7 @@ void BinaryViewerDialog::on_cmdPagePrev_clicked()
     moveToPage(false);
 }
 
-void BinaryViewerDialog::onCurrentPageChanged(int /*currentPage*/)
+void BinaryViewerDialog::onCurrentPageChanged(qint64 /*currentPage*/)
 {
     calcEnablePages();
 }
@@ -240,9 +246,11 @@ void BinaryViewerDialog::enableSearch()
     if(NULL == ui->tableView->model()) {
         ui->cmdSearchNext->setEnabled(false);
         ui->cmdSearchPrev->setEnabled(false);
+        ui->cmdFindAll->setEnabled(false);
         return ;
     }
     bool enable = !ui->searchBox->text().isEmpty();
+    ui->cmdFindAll->setEnabled(enable || _model.isFindAllRunning());
     bool isFirstRow = selRow() == 0;
     bool isLastRow = _model.isLastPage() && (selRow() == lastRow());
     ui->cmdSearchNext->setEnabled(enable && !isLastRow);
@@ -375,6 +383,93 @@ void BinaryViewerDialog::enableGoto()
     ui->cmdGoToAddress->setEnabled(!ui->gotoAddress->text().isEmpty() && (NULL != ui->tableView->model())) ;
 }
 
+//--- find all
+
+void BinaryViewerDialog::resetFindAll()
+{
+    _model.stopFindAll();
+    _occurrencesCount = 0 ;
+    ui->occurrencesList->clear();
+    ui->lblOccurrences->setText("");
+    ui->cmdFindAll->setText(tr("Find &All"));
+}
+
+void BinaryViewerDialog::showFindAllStatus(const QString &status)
+{
+    ui->lblOccurrences->setText(status);
+}
+
+void BinaryViewerDialog::on_cmdFindAll_clicked()
+{
+    if(_model.isFindAllRunning()) {
+        _model.stopFindAll();
+        return ;
+    }
+    QString text = ui->searchBox->text();
+    if(text.isEmpty()) {
+        Utils::error(this, tr("Insert a text to search."));
+        return ;
+    }
+    resetFindAll();
+    _model.startFindAll(text);
+    ui->cmdFindAll->setText(tr("S&top"));
+    showFindAllStatus(tr("Searching..."));
+}
+
+void BinaryViewerDialog::onOccurrencesFound(int findId, QList<qint64> addresses)
+{
+    if(findId != _model.findAllId()) {
+        return ;
+    }
+    ui->occurrencesList->setUpdatesEnabled(false);
+    foreach(qint64 address, addresses) {
+        if(_occurrencesCount < MaxOccurrencesShown) {
+            QListWidgetItem *item = new QListWidgetItem(QString("%1 (0x%2)").arg(address).arg(address, 0, 16));
+            item->setData(Qt::UserRole, address);
+            ui->occurrencesList->addItem(item);
+        }
+        _occurrencesCount++;
+    }
+    ui->occurrencesList->setUpdatesEnabled(true);
+    showFindAllStatus(tr("Searching... %1 occurrences").arg(_occurrencesCount));
+}
+
+void BinaryViewerDialog::onFindAllProgress(int findId, int percent)
+{
+    if(findId != _model.findAllId()) {
+        return ;
+    }
+    showFindAllStatus(tr("Searching... %1% - %2 occurrences").arg(percent).arg(_occurrencesCount));
+}
+
+void BinaryViewerDialog::onFindAllFinished(int findId, qint64 occurrences, bool isAborted)
+{
+    if(findId != _model.findAllId()) {
+        return ;
+    }
+    ui->cmdFindAll->setText(tr("Find &All"));
+    QString status = tr("%1 occurrences").arg(occurrences);
+    if(occurrences > MaxOccurrencesShown) {
+        status = tr("%1 occurrences, first %2 shown").arg(occurrences).arg(MaxOccurrencesShown);
+    }
+    if(isAborted) {
+        status = tr("Search stopped: %1").arg(status);
+    }
+    showFindAllStatus(status);
+    enableSearch();
+}
+
+void BinaryViewerDialog::on_occurrencesList_itemActivated(QListWidgetItem *item)
+{
+    if((NULL == item) || (NULL == ui->tableView->model())) {
+        return ;
+    }
+    BinaryViewerOperationResult result;
+    _model.findPageOfAddress(result, item->data(Qt::UserRole).toLongLong());
+    moveToPageAbs(result.page);
+    selectRowAndEnsureIsVisible(result.row);
+}
+
 void BinaryViewerDialog::keyPressEvent(QKeyEvent *e)
 {
     int key = e->key() ;
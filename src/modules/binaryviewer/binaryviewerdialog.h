@@ -27,6 +27,7 @@
 #include <QDialog>
 #include "libQXmlEdit_global.h"
 #include <QItemSelection>
+#include <QListWidgetItem>
 #include "binaryviewermodel.h"
 
 
@@ -40,8 +41,12 @@ class LIBQXMLEDITSHARED_EXPORT BinaryViewerDialog : public QDialog
 {
     Q_OBJECT
 
+    // occurrences shown in the list, the count is not limited
+    static const int MaxOccurrencesShown = 10000;
+
     BinaryViewerModel _model;
     QStringList _recentFiles;
+    qint64 _occurrencesCount;
 
 
 public:
@@ -55,7 +60,7 @@ protected:
     void start();
     void calcEnablePages();
     void moveToPage(const bool isNext);
-    void moveToPageAbs(const int newPage);
+    void moveToPageAbs(const qint64 newPage);
     void refreshData();
     void selectRowAndEnsureIsVisible(const int newRow, const bool setIsVisible = true);
     int selRow();
@@ -67,6 +72,8 @@ protected:
     void setNullModel();
     void msgNoModel();
     void msgInvalidAddress();
+    void resetFindAll();
+    void showFindAllStatus(const QString &status);
 protected:
     void assignIO(QIODevice *io);
     virtual void keyPressEvent(QKeyEvent *e);
@@ -75,7 +82,7 @@ protected:
 
 private slots:
     void on_cmdBrowse_clicked();
-    void onCurrentPageChanged(int currentPage);
+    void onCurrentPageChanged(qint64 currentPage);
     void on_cmdPageNext_clicked();
     void on_cmdPagePrev_clicked();
     void on_cmbEncodings_activated(const QString & text);
@@ -86,6 +93,11 @@ private slots:
     void on_fileComboBox_activated(const QString & text);
     void on_cmdGoToAddress_clicked();
     void on_gotoAddress_textChanged(const QString & text);
+    void on_cmdFindAll_clicked();
+    void on_occurrencesList_itemActivated(QListWidgetItem *item);
+    void onOccurrencesFound(int findId, QList<qint64> addresses);
+    void onFindAllProgress(int findId, int percent);
+    void onFindAllFinished(int findId, qint64 occurrences, bool isAborted);
 };
 
 #endif // BINARYVIEWERDIALOG_H
@@ -20,11 +20,14 @@
  * Boston, MA  02110-1301  USA                                            *
  **************************************************************************/
 
+#include "xmlEdit.h"
 #include "binaryviewermodel.h"
+#include "modules/binaryviewer/binarysearch.h"
 #include "utils.h"
 
 #include <QBuffer>
 #include <QByteArray>
+#include <string.h>
 
 
 //------
@@ -73,6 +76,10 @@ BinaryViewerModel::BinaryViewerModel(QObject *parent) :
     QAbstractItemModel(parent)
 {
     _io = NULL;
+    _data = NULL ;
+    _mappedData = NULL ;
+    _findAllId = 0 ;
+    qRegisterMetaType<QList<qint64> >("QList<qint64>");
     init();
 }
 
@@ -84,6 +91,8 @@ BinaryViewerModel::~BinaryViewerModel()
 
 void BinaryViewerModel::closeIO()
 {
+    stopFindAll();
+    unmapData();
     if(NULL != _io) {
         if(_io->isOpen()) {
             _io->close();
@@ -189,6 +198,42 @@ bool BinaryViewerModel::isOpenIO()
     return (NULL != _io) && _io->isOpen();
 }
 
+/*!
+ * \brief gives direct access to the data: a file is mapped in memory, a buffer
+ * is used as is; if the mapping fails the data are read by blocks.
+ */
+void BinaryViewerModel::mapData()
+{
+    unmapData();
+    QBuffer *buffer = qobject_cast<QBuffer*>(_io);
+    if(NULL != buffer) {
+        _data = buffer->data().constData();
+        return ;
+    }
+    QFile *file = qobject_cast<QFile*>(_io);
+    if(NULL != file) {
+        _mappedData = file->map(0, file->size());
+        _data = reinterpret_cast<const char*>(_mappedData);
+    }
+}
+
+void BinaryViewerModel::unmapData()
+{
+    if(NULL != _mappedData) {
+        QFile *file = qobject_cast<QFile*>(_io);
+        if(NULL != file) {
+            file->unmap(_mappedData);
+        }
+    }
+    _mappedData = NULL ;
+    _data = NULL ;
+}
+
+bool BinaryViewerModel::isMapped()
+{
+    return NULL != _data ;
+}
+
 BinaryViewerModel::ErrCodes BinaryViewerModel::setFile(QIODevice *newIoDevice)
 {
     closeIO();
@@ -203,6 +248,7 @@ BinaryViewerModel::ErrCodes BinaryViewerModel::setFile(QIODevice *newIoDevice)
                 return EC_FILEEMPTY;
             }
             calcSize(fileSize);
+            mapData();
             setPage(0);
         }
 
@@ -212,12 +258,12 @@ BinaryViewerModel::ErrCodes BinaryViewerModel::setFile(QIODevice *newIoDevice)
     return EC_OTHERERROR;
 }
 
-int BinaryViewerModel::currentPage()
+qint64 BinaryViewerModel::currentPage()
 {
     return _currentPage ;
 }
 
-void BinaryViewerModel::setPage(const int newPage)
+void BinaryViewerModel::setPage(const qint64 newPage)
 {
     if((newPage < 0) || (newPage >= _numPages)) {
         Utils::error(tr("Invalid page number in binary model"));
@@ -243,7 +289,7 @@ bool BinaryViewerModel::isLastPage()
     return _currentPage == _lastPage ;
 }
 
-int BinaryViewerModel::numPages()
+qint64 BinaryViewerModel::numPages()
 {
     return _numPages ;
 }
@@ -253,7 +299,7 @@ void BinaryViewerModel::goToPage(const bool isNextPage)
     setPage(_currentPage + (isNextPage ? 1 : -1));
 }
 
-void BinaryViewerModel::goToPageAbs(const int newPage)
+void BinaryViewerModel::goToPageAbs(const qint64 newPage)
 {
     setPage(newPage);
 }
@@ -378,6 +424,16 @@ int BinaryViewerModel::columnCount(const QModelIndex & /*parent*/) const
 QByteArray BinaryViewerModel::getRowData(const int nRow)
 {
     qint64 startOffset = _currentPage * SizeOfPage ;
+    if(NULL != _data) {
+        qint64 rowAddress = startOffset + static_cast<qint64>(nRow) * BinaryBlock::DataPerRow ;
+        if((nRow < 0) || (rowAddress >= _totalData)) {
+            Utils::error(tr("Invalid data read"));
+            QByteArray defaultData(BinaryBlock::SizeOfRow, 0);
+            return defaultData ;
+        }
+        int rowLen = static_cast<int>(qMin(static_cast<qint64>(BinaryBlock::SizeOfRow), _totalData - rowAddress));
+        return QByteArray(_data + rowAddress, rowLen);
+    }
     qint64 realBlockAddress = startOffset + (nRow / BinaryBlock::RowsPerBlock) * BinaryBlock::SizeOfBlock ;
 
     // look for an existing block
@@ -452,15 +508,31 @@ bool BinaryViewerModel::setCodecByName(const QString &codecName)
 
 //------------------------------------------------------------------------
 
-bool BinaryViewerModel::findOccurrences(BinaryViewerOperationResult &result, const QString &searchLemma, const int startPage, const int startLine, const bool searchForward)
+bool BinaryViewerModel::findOccurrences(BinaryViewerOperationResult &result, const QString &searchLemma, const qint64 startPage, const int startLine, const bool searchForward)
 {
     QByteArray reference = _codec->fromUnicode(searchLemma);
     return findOccurrencesBinary(result, reference, startPage, startLine, searchForward);
 }
 
 
-bool BinaryViewerModel::findOccurrencesBinary(BinaryViewerOperationResult &result, const QByteArray &reference, const int startPage, const int startLine, const bool searchForward)
+bool BinaryViewerModel::findOccurrencesBinary(BinaryViewerOperationResult &result, const QByteArray &reference, const qint64 startPage, const int startLine, const bool searchForward)
 {
+    if(reference.isEmpty()) {
+        return false;
+    }
+    if(NULL != _data) {
+        qint64 position ;
+        if(searchForward) {
+            position = BinarySearch::indexOf(_data, _totalData, reference, startPage * SizeOfPage + (startLine + 1) * BinaryBlock::DataPerRow);
+        } else {
+            position = BinarySearch::lastIndexOf(_data, _totalData, reference, startPage * SizeOfPage + startLine * BinaryBlock::DataPerRow - reference.length());
+        }
+        if(position < 0) {
+            return false;
+        }
+        setResultPosition(result, position);
+        return true;
+    }
     int bufferSize = SearchBufferSize + reference.length() - 1; // one is comprised in the original buffer
     qint64 bufferPosition = startPage * SizeOfPage + (startLine + 1) * BinaryBlock::DataPerRow;
     if(!searchForward)     {
@@ -508,25 +580,27 @@ bool BinaryViewerModel::findOccurrencesBinary(BinaryViewerOperationResult &resul
 
 bool BinaryViewerModel::findOccurrenceInBuffer(BinaryViewerOperationResult &result, const QByteArray &reference, const QByteArray &buffer, const qint64 absoluteOffsetOfBuffer, const bool searchForward)
 {
-    qint64 resultRow = 0;
-
-    int newPos = 0 ;
+    qint64 newPos = 0 ;
     if(searchForward) {
-        newPos = buffer.indexOf(reference);
+        newPos = BinarySearch::indexOf(buffer.constData(), buffer.length(), reference, 0);
     } else {
-        newPos = buffer.lastIndexOf(reference);
+        newPos = BinarySearch::lastIndexOf(buffer.constData(), buffer.length(), reference, buffer.length());
     }
     if(newPos < 0) {
         return false;
     }
     // the result must be in the buffer range.
-    qint64 absolutePositionOfMatch = absoluteOffsetOfBuffer + newPos;
-    resultRow = absolutePositionOfMatch / BinaryBlock::SizeOfRow;
-    result.page = absolutePositionOfMatch / SizeOfPage;
-    result.row = resultRow % RowsPerPage ;
+    setResultPosition(result, absoluteOffsetOfBuffer + newPos);
     return true;
 }
 
+void BinaryViewerModel::setResultPosition(BinaryViewerOperationResult &result, const qint64 address)
+{
+    qint64 resultRow = address / BinaryBlock::SizeOfRow;
+    result.page = address / SizeOfPage;
+    result.row = resultRow % RowsPerPage ;
+}
+
 
 bool BinaryViewerModel::findPageOfAddress(BinaryViewerOperationResult &result, const qint64 address)
 {
@@ -535,3 +609,150 @@ bool BinaryViewerModel::findPageOfAddress(BinaryViewerOperationResult &result, c
     return true;
 }
 
+
+//------------------------------------------------------------------------
+
+/*!
+ * \brief starts the search of all the occurrences in a background thread,
+ * the results are streamed with occurrencesFound(); returns the id of the search.
+ */
+int BinaryViewerModel::startFindAll(const QString &searchLemma)
+{
+    stopFindAll();
+    _findAllId++;
+    QByteArray reference = _codec->fromUnicode(searchLemma);
+    QString filePath ;
+    QFile *file = qobject_cast<QFile*>(_io);
+    if(NULL != file) {
+        filePath = file->fileName();
+    }
+    _isFindAllAborted = 0 ;
+    _findAllFuture = QtConcurrent::run(this, &BinaryViewerModel::findAllInThread, _findAllId, reference, filePath);
+    return _findAllId ;
+}
+
+void BinaryViewerModel::stopFindAll()
+{
+    _isFindAllAborted = 1 ;
+    _findAllFuture.waitForFinished();
+}
+
+void BinaryViewerModel::waitFindAll()
+{
+    _findAllFuture.waitForFinished();
+}
+
+bool BinaryViewerModel::isFindAllRunning()
+{
+    return _findAllFuture.isRunning();
+}
+
+int BinaryViewerModel::findAllId()
+{
+    return _findAllId ;
+}
+
+void BinaryViewerModel::findAllInThread(const int findId, const QByteArray reference, const QString filePath)
+{
+    qint64 occurrences = 0 ;
+    bool isCompleted = false;
+    if(!reference.isEmpty()) {
+        if(NULL != _data) {
+            isCompleted = findAllInData(findId, reference, occurrences);
+        } else if(!filePath.isEmpty()) {
+            isCompleted = findAllInFile(findId, reference, filePath, occurrences);
+        }
+    }
+    emit findAllFinished(findId, occurrences, !isCompleted);
+}
+
+void BinaryViewerModel::flushOccurrences(const int findId, QList<qint64> &addresses)
+{
+    if(!addresses.isEmpty()) {
+        emit occurrencesFound(findId, addresses);
+        addresses.clear();
+    }
+}
+
+bool BinaryViewerModel::findAllInData(const int findId, const QByteArray &reference, qint64 &occurrences)
+{
+    QList<qint64> addresses;
+    int lastPercent = -1 ;
+    qint64 position = BinarySearch::indexOf(_data, _totalData, reference, 0);
+    while(position >= 0) {
+        if(0 != _isFindAllAborted) {
+            flushOccurrences(findId, addresses);
+            return false;
+        }
+        occurrences++;
+        addresses.append(position);
+        if(addresses.size() >= FindAllBatchSize) {
+            flushOccurrences(findId, addresses);
+            int percent = static_cast<int>((position * 100) / _totalData);
+            if(percent != lastPercent) {
+                lastPercent = percent ;
+                emit findAllProgress(findId, percent);
+            }
+        }
+        position = BinarySearch::indexOf(_data, _totalData, reference, position + 1);
+    }
+    flushOccurrences(findId, addresses);
+    return true;
+}
+
+/*!
+ * \brief used when the file can not be mapped, reads the file using its own handle
+ * to leave the one of the model free.
+ */
+bool BinaryViewerModel::findAllInFile(const int findId, const QByteArray &reference, const QString &filePath, qint64 &occurrences)
+{
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QList<qint64> addresses;
+    const int overlap = reference.length() - 1 ;
+    QByteArray buffer;
+    buffer.resize(SearchBufferSize + overlap);
+    qint64 bufferPosition = 0 ;
+    int dataInBuffer = 0 ;
+    const qint64 fileSize = file.size();
+    int lastPercent = -1 ;
+    bool isEndOfFile = false;
+    while(!isEndOfFile) {
+        if(0 != _isFindAllAborted) {
+            flushOccurrences(findId, addresses);
+            return false;
+        }
+        qint64 dataRead = file.read(buffer.data() + dataInBuffer, buffer.length() - dataInBuffer);
+        if(dataRead < 0) {
+            flushOccurrences(findId, addresses);
+            return false;
+        }
+        isEndOfFile = (0 == dataRead);
+        dataInBuffer += static_cast<int>(dataRead);
+        qint64 position = BinarySearch::indexOf(buffer.constData(), dataInBuffer, reference, 0);
+        while(position >= 0) {
+            occurrences++;
+            addresses.append(bufferPosition + position);
+            if(addresses.size() >= FindAllBatchSize) {
+                flushOccurrences(findId, addresses);
+            }
+            position = BinarySearch::indexOf(buffer.constData(), dataInBuffer, reference, position + 1);
+        }
+        // keep the tail that could be the start of a match across the buffers
+        int toKeep = qMin(overlap, dataInBuffer);
+        memmove(buffer.data(), buffer.constData() + dataInBuffer - toKeep, toKeep);
+        bufferPosition += dataInBuffer - toKeep ;
+        dataInBuffer = toKeep ;
+        if(fileSize > 0) {
+            int percent = static_cast<int>((bufferPosition * 100) / fileSize);
+            if(percent != lastPercent) {
+                lastPercent = percent ;
+                emit findAllProgress(findId, percent);
+            }
+        }
+    }
+    flushOccurrences(findId, addresses);
+    return true;
+}
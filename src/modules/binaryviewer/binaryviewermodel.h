@@ -27,6 +27,8 @@
 #include <QAbstractItemModel>
 #include <QFile>
 #include <QTextCodec>
+#include <QFuture>
+#include <QAtomicInt>
 
 #include "modules/binaryviewer/binaryblock.h"
 
@@ -43,7 +45,7 @@ public:
 
     bool ok;
     int errorCode;
-    int page;
+    qint64 page;
     int row;
     BinaryViewerOperationResult();
     ~BinaryViewerOperationResult();
@@ -72,6 +74,8 @@ public:
     static const int SizeOfPage = BlocksPerPage * BinaryBlock::SizeOfBlock;
 
     static const int SearchBufferSize = 100 * 1024;
+    // occurrences sent together by find all
+    static const int FindAllBatchSize = 1024;
 
     enum ErrCodes {
         EC_NOERROR = 0,
@@ -104,22 +108,36 @@ private:
     QTextCodec *_codec ;
 
     QList<BinaryBlock*>_blocksList;
+    // the whole content when the file is mapped or the device is a buffer, else NULL
+    const char *_data;
+    uchar *_mappedData;
+    //--- find all
+    QFuture<void> _findAllFuture;
+    QAtomicInt _isFindAllAborted;
+    int _findAllId;
 public:
     explicit BinaryViewerModel(QObject *parent = 0);
     ~BinaryViewerModel();
 
     BinaryViewerModel::ErrCodes setFile(QIODevice *newIoDevice);
     //BinaryViewerModel::ErrCodes setDummyData();
-    int currentPage();
-    void setPage(const int newPage);
+    qint64 currentPage();
+    void setPage(const qint64 newPage);
     bool isFirstPage();
     bool isLastPage();
-    int numPages();
+    qint64 numPages();
     void goToPage(const bool isNextPage);
-    void goToPageAbs(const int newPage);
+    void goToPageAbs(const qint64 newPage);
     bool setCodecByName(const QString &codecName);
-    bool findOccurrences(BinaryViewerOperationResult &result, const QString &searchLemma, const int startPage, const int startLine, const bool searchForward);
+    bool findOccurrences(BinaryViewerOperationResult &result, const QString &searchLemma, const qint64 startPage, const int startLine, const bool searchForward);
     bool findPageOfAddress(BinaryViewerOperationResult &result, const qint64 address);
+    bool isMapped();
+    //--- find all
+    int startFindAll(const QString &searchLemma);
+    void stopFindAll();
+    void waitFindAll();
+    bool isFindAllRunning();
+    int findAllId();
 
     //------------------------------------------------
     QVariant data(const QModelIndex &index, int role) const;
@@ -131,7 +149,11 @@ public:
     int columnCount(const QModelIndex &parent = QModelIndex()) const;
 signals:
     void numberPopulated(int number);
-    void pageChanged(int currentPage);
+    void pageChanged(qint64 currentPage);
+    // emitted by the find all thread
+    void occurrencesFound(int findId, QList<qint64> addresses);
+    void findAllProgress(int findId, int percent);
+    void findAllFinished(int findId, qint64 occurrences, bool isAborted);
     //------------------------------------------------
 
 private:
@@ -144,9 +166,20 @@ private:
     BinaryBlock *readBlock(const qint64 realBlockAddress);
     void closeIO();
     bool isOpenIO();
+    void mapData();
+    void unmapData();
     //---
-    bool findOccurrencesBinary(BinaryViewerOperationResult &result, const QByteArray &reference, const int startPage, const int startLine, const bool searchForward);
+    bool findOccurrencesBinary(BinaryViewerOperationResult &result, const QByteArray &reference, const qint64 startPage, const int startLine, const bool searchForward);
     bool findOccurrenceInBuffer(BinaryViewerOperationResult &result, const QByteArray &reference, const QByteArray &buffer, const qint64 absoluteOffsetOfBuffer, const bool searchForward);
+    void setResultPosition(BinaryViewerOperationResult &result, const qint64 address);
+    void findAllInThread(const int findId, const QByteArray reference, const QString filePath);
+    bool findAllInData(const int findId, const QByteArray &reference, qint64 &occurrences);
+    bool findAllInFile(const int findId, const QByteArray &reference, const QString &filePath, qint64 &occurrences);
+    void flushOccurrences(const int findId, QList<qint64> &addresses);
 };
 
+#if QT_VERSION < QT_VERSION_CHECK(5,0,0)
+Q_DECLARE_METATYPE(QList<qint64>)
+#endif
+
 #endif // BINARYVIEWERMODEL_H
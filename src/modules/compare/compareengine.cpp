@@ -168,6 +168,21 @@ bool CompareEngine::compareQuick(Regola *one, const QString &fileName)
     return result;
 }
 
+/*!
+ * \brief CompareEngine::compareQuickFiles compares two files without a user interface
+ * \return false if one of the files cannot be loaded
+ */
+bool CompareEngine::compareQuickFiles(const QString &referenceFile, const QString &compareFile)
+{
+    Regola *one = loadRegola(referenceFile);
+    if(NULL == one) {
+        return false;
+    }
+    bool result = compareQuick(one, compareFile);
+    delete one ;
+    return result;
+}
+
 
 bool CompareEngine::compareQuick(Regola *one, QByteArray *dataIn)
 {
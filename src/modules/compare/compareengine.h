@@ -93,6 +93,7 @@ public:
     bool compareQuick(Regola *one, Regola *two);
     bool compareQuick(Regola *one, const QString &fileName);
     bool compareQuick(Regola *one, QByteArray *dataIn);
+    bool compareQuickFiles(const QString &referenceFile, const QString &compareFile);
 
     bool areDifferent();
 
@@ -350,12 +350,13 @@ bool NodesRelationsController::timedTick()
         handleForces();
         handleSprings();
         moving = updatePosition();
-        redraw();
         if(timedHide()) {
             moving = true ;
         }
         index -- ;
     } while(moving && (index > 0));
+    // the items are moved once per tick
+    redraw();
     return moving ;
 }
 
@@ -382,39 +383,24 @@ void NodesRelationsController::redraw()
 
 void NodesRelationsController::handleForces()
 {
-    foreach(TagMarker * src, markers) {
-        foreach(TagMarker * trg, markers) {
-            if(src == trg) {
-                continue ;
-            }
-            if(centerMode && !src->isVisible()) {
-                continue ;
-            }
-            // force is k*/distance
-            float dx = trg->position.x() - src->position.x();
-            float dy = trg->position.y() - src->position.y();
-
-            float distance = sqrt(dx * dx + dy * dy);
-            if(distance == 0) {
-                distance = 0.001 ;
-            }
-            if(distance > radiusOfTheForce) {
-                continue ;
-            }
-            float f = forceFactor / distance;
-            QVector2D df(trg->position);
-            df -= src->position;
-            df.normalize();
-            if((df.x() == 0) && (df.y() == 0)) {
-                float fx = ((float)qrand() / (float)RAND_MAX) * 10. - 5;
-                float fy = ((float)qrand() / (float)RAND_MAX) * 10. - 5;
-                df.setX(fx);
-                df.setY(fy);
-            }
-            df *= -f ;
-            src->velocity.setX(src->velocity.x() + df.x());
-            src->velocity.setY(src->velocity.y() + df.y());
-        }
+    const int count = markers.size();
+    forceBodies.resize(count);
+    for(int i = 0 ; i < count ; i ++) {
+        TagMarker *marker = markers.at(i);
+        TagForces::Body &body = forceBodies[i];
+        body.x = marker->position.x();
+        body.y = marker->position.y();
+        body.isActive = !(centerMode && !marker->isVisible());
+    }
+    // force is k*/distance
+    forces.setForceFactor(forceFactor);
+    forces.setRadius(radiusOfTheForce);
+    forces.compute(forceBodies);
+    for(int i = 0 ; i < count ; i ++) {
+        TagMarker *marker = markers.at(i);
+        const TagForces::Body &body = forceBodies.at(i);
+        marker->velocity.setX(marker->velocity.x() + body.fx);
+        marker->velocity.setY(marker->velocity.y() + body.fy);
     }
 }
 
@@ -28,6 +28,7 @@
 #include <QHash>
 #include <QTableWidget>
 #include <QTextBrowser>
+#include "tagforces.h"
 
 class NodesRelationsDialog;
 class TagNode;
@@ -65,6 +66,8 @@ protected:
     QString tagCentered;
     double curOpacity;
     double lastOpacity;
+    TagForces forces;
+    QVector<TagForces::Body> forceBodies;
 
     void handleForces();
     void handleSprings();
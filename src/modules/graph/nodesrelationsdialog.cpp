@@ -26,6 +26,7 @@
 #include "utils.h"
 #include "nodessax.h"
 #include "qxmleditdata.h"
+#include "visualization/fileanalysiscache.h"
 
 #include    <QFileDialog>
 #include    <QDragEnterEvent>
@@ -158,28 +159,30 @@ void NodesRelationsDialog::startTimer()
 
 //---------------------------------------------------------------------------------
 bool NodesRelationsDialog::loadNodesFromFile(QIODevice *inputDevice, const QString &newInputFileName)
+{
+    bool isScanOk = false;
+    return scanNodes(inputDevice, newInputFileName, isScanOk);
+}
+
+bool NodesRelationsDialog::scanNodes(QIODevice *inputDevice, const QString &newInputFileName, bool &isScanOk)
 {
     resetData();
     QHash<QString, TagNode*> newNodes;
     _attributesSummaryData->reset();
     NodesSax handler(&newNodes, _attributesSummaryData);
-    QXmlSimpleReader reader;
-    reader.setFeature("http://xml.org/sax/features/namespaces", false);
-    reader.setFeature("http://xml.org/sax/features/namespace-prefixes", true);
-    reader.setContentHandler(&handler);
-    reader.setErrorHandler(&handler);
+    XmlStreamScanner scanner;
 
     if(!inputDevice->open(QIODevice::ReadOnly | QIODevice::Text)) {
         Utils::error(tr("An error occurred opening the file."));
         return false ;
     }
     bool isOk = true ;
-    QXmlInputSource xmlInput(inputDevice);
-    if(!reader.parse(xmlInput)) {
+    if(!scanner.scan(inputDevice, &handler)) {
         isOk = false  ;
     }
     inputDevice->close();
     inputFileName = newInputFileName;
+    isScanOk = isOk ;
     if(!isOk) {
         Utils::error(tr("An error occurred loading data."));
     }
@@ -315,10 +318,27 @@ bool NodesRelationsDialog::loadFile(const QString &filePath)
     }
     //--- set data
     resetData();
-    QFile file(filePath);
-    if(!loadNodesFromFile(&file, filePath)) {
-        Utils::errorAccessingFile(this);
-        return false;
+    if(!loadNodesFromCache(filePath)) {
+        QFile file(filePath);
+        bool isScanOk = false;
+        if(!scanNodes(&file, filePath, isScanOk)) {
+            Utils::errorAccessingFile(this);
+            return false;
+        }
+        if(isScanOk) {
+            QHash<QString, TagNode*> scannedNodes;
+            foreach(TagNode * node, nodes) {
+                scannedNodes.insert(node->tag, node);
+            }
+            // the cached analyses are read only: a new one keeps the map of the previous analysis
+            QSharedPointer<FileAnalysis> analysis(new FileAnalysis());
+            QSharedPointer<FileAnalysis> previous = FileAnalysisCache::find(filePath);
+            if(!previous.isNull()) {
+                analysis->shareMapOf(*previous);
+            }
+            analysis->setTagNodes(scannedNodes, _attributesSummaryData);
+            FileAnalysisCache::insert(filePath, analysis);
+        }
     }
     ui->labelFile->setText(filePath);
     //-- make tooltip
@@ -334,6 +354,24 @@ bool NodesRelationsDialog::loadFile(const QString &filePath)
     return true ;
 }
 
+/*!
+ * \brief NodesRelationsDialog::loadNodesFromCache uses the data of a previous scan of the same file, if it did not change
+ * \return false if the file must be read
+ */
+bool NodesRelationsDialog::loadNodesFromCache(const QString &filePath)
+{
+    QSharedPointer<FileAnalysis> analysis = FileAnalysisCache::find(filePath);
+    if(analysis.isNull() || !analysis->hasTagNodes()) {
+        return false;
+    }
+    QHash<QString, TagNode*> newNodes;
+    analysis->copyTagNodesTo(newNodes);
+    analysis->copyAttributesTo(_attributesSummaryData);
+    inputFileName = filePath;
+    nodes.append(newNodes.values());
+    feedNewData(nodes, _attributesSummaryData);
+    return true ;
+}
 
 NodesRelationsController* NodesRelationsDialog::getController()
 {
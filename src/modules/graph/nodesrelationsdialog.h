@@ -83,6 +83,8 @@ class LIBQXMLEDITSHARED_EXPORT NodesRelationsDialog : public QDialog
     void exportAttributesCSV();
     bool exportAttributesCSVOnDevice(QIODevice &ioDevice);
     void updateEnableAttributeLists();
+    bool scanNodes(QIODevice *inputDevice, const QString &newInputFileName, bool &isScanOk);
+    bool loadNodesFromCache(const QString &filePath);
 public:
     explicit NodesRelationsDialog(const bool canLoadData, QList<TagNode*> &dataList, AttributesSummaryData *attributesSummaryData, QWidget *parent = 0);
     ~NodesRelationsDialog();
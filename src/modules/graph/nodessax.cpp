@@ -35,7 +35,7 @@ NodesSax::~NodesSax()
 {
 }
 
-void NodesSax::addTagNode(const QString &name)
+void NodesSax::addTagNode(XmlStreamScanner *scanner, const QString &name)
 {
     TagNode *node = tagNodes->value(name);
     if(NULL == node) {
@@ -45,7 +45,7 @@ void NodesSax::addTagNode(const QString &name)
     node->count++;
     // add the relationship
     if(elements.size() > 0) {
-        TagNode *parentNode = tagNodes->value(elements.top());
+        TagNode *parentNode = tagNodes->value(scanner->name(elements.top()));
         node->linksIn++;
         parentNode->linksOut++;
         // must be not null
@@ -58,14 +58,14 @@ void NodesSax::addTagNode(const QString &name)
     }
 }
 
-void NodesSax::handleAttributes(const QXmlAttributes & attributes)
+void NodesSax::handleAttributes(const QXmlStreamAttributes & attributes)
 {
     if(NULL != attributesSummaryData) {
         const int attrCount = attributes.count();
         for(int index = 0 ; index < attrCount ; index ++) {
-            const QString &attributeLocalName = attributes.qName(index);
-            const QString &attrValue = attributes.value(index);
-            const int thisAttrSize = attrValue.length();
+            const QXmlStreamAttribute &attribute = attributes.at(index);
+            const QString attributeLocalName = attribute.qualifiedName().toString();
+            const int thisAttrSize = attribute.value().length();
             QString attributePath = _currentElementPath + "/@" + attributeLocalName;
             AttributeSummaryData * attributeSummaryData = attributesSummaryData->attributeSummaryData(attributePath, attributeLocalName);
             attributeSummaryData->addHit(thisAttrSize);
@@ -73,19 +73,18 @@ void NodesSax::handleAttributes(const QXmlAttributes & attributes)
     }
 }
 
-bool NodesSax::startElement(const QString &/*namespaceURI*/, const QString & /*localName*/,
-                            const QString &qName, const QXmlAttributes & attributes)
+bool NodesSax::startElement(XmlStreamScanner *scanner, const int nameId, const QXmlStreamAttributes & attributes)
 {
-    addTagNode(qName);
-    elements.push(qName);
+    const QString &qName = scanner->name(nameId);
+    addTagNode(scanner, qName);
+    elements.push(nameId);
     _currentElementPath = Utils::pushCurrentElementPath(_currentElementPath, qName);
     handleAttributes(attributes);
     return true ;
 }
 
 
-bool NodesSax::endElement(const QString &/*namespaceURI*/, const QString &/*localName*/,
-                          const QString &/*qName*/)
+bool NodesSax::endElement(XmlStreamScanner * /*scanner*/, const int /*nameId*/)
 {
     elements.pop();
     _currentElementPath = Utils::popCurrentElementPath(_currentElementPath);
@@ -93,31 +92,14 @@ bool NodesSax::endElement(const QString &/*namespaceURI*/, const QString &/*loca
 }
 
 
-bool NodesSax::fatalError(const QXmlParseException &exception)
+void NodesSax::parseError(const QString &message)
 {
-    Utils::error(QObject::tr("Parse error (2) at line %1, column %2:\n%3")
-                 .arg(exception.lineNumber())
-                 .arg(exception.columnNumber())
-                 .arg(exception.message()));
-    return false;
+    Utils::error(message);
 }
 
-bool NodesSax::error(const QXmlParseException &exception)
-{
-    Utils::error(QObject::tr("Parse error (1) at line %1, column %2:\n%3")
-                 .arg(exception.lineNumber())
-                 .arg(exception.columnNumber())
-                 .arg(exception.message()));
-    return false;
-}
-
-QString NodesSax::errorString() const
-{
-    return QObject::tr("Generic error.");
-}
-
-bool NodesSax::startDocument()
+bool NodesSax::startDocument(XmlStreamScanner * /*scanner*/)
 {
     _currentElementPath = "";
+    elements.clear();
     return true ;
 }
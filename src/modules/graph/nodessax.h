@@ -24,34 +24,31 @@
 #ifndef NODESSAX_H
 #define NODESSAX_H
 
-#include <QXmlDefaultHandler>
 #include <QStack>
 #include "modules/graph/tagnodes.h"
+#include "modules/xml/xmlstreamscanner.h"
 
 class AttributesSummaryData;
 
-class NodesSax : public QXmlDefaultHandler
+class NodesSax : public XmlScanHandler
 {
 public:
-    QStack<QString> elements;
+    // names of the open elements, as ids of the scanner
+    QStack<int> elements;
     QHash<QString, TagNode*> *tagNodes;
     AttributesSummaryData *attributesSummaryData;
 private:
     QString _currentElementPath;
-    void addTagNode(const QString &name);
-    void handleAttributes(const QXmlAttributes & attributes);
+    void addTagNode(XmlStreamScanner *scanner, const QString &name);
+    void handleAttributes(const QXmlStreamAttributes & attributes);
 public:
     NodesSax(QHash<QString, TagNode*> *newTagNodes, AttributesSummaryData *attributesSummaryData);
     ~NodesSax();
 
-    bool startDocument();
-    bool startElement(const QString &namespaceURI, const QString &localName,
-                      const QString &qName, const QXmlAttributes &attributes);
-    bool endElement(const QString &namespaceURI, const QString &localName,
-                    const QString &qName);
-    bool fatalError(const QXmlParseException &exception);
-    bool error(const QXmlParseException &exception);
-    QString errorString() const;
+    bool startDocument(XmlStreamScanner *scanner);
+    bool startElement(XmlStreamScanner *scanner, const int nameId, const QXmlStreamAttributes &attributes);
+    bool endElement(XmlStreamScanner *scanner, const int nameId);
+    void parseError(const QString &message);
 };
 
 #endif // NODESSAX_H
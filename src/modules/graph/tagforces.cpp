@@ -0,0 +1,313 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#include "tagforces.h"
+#include "xmlEdit.h"
+#include "qtincludes.h"
+#include <QVarLengthArray>
+#include <math.h>
+
+TagForces::Cell::Cell()
+{
+    x0 = 0 ;
+    y0 = 0 ;
+    size = 0 ;
+    massX = 0 ;
+    massY = 0 ;
+    count = 0 ;
+    children[0] = -1 ;
+    children[1] = -1 ;
+    children[2] = -1 ;
+    children[3] = -1 ;
+}
+
+bool TagForces::Cell::isLeaf() const
+{
+    return !bodies.isEmpty() || ((children[0] < 0) && (children[1] < 0) && (children[2] < 0) && (children[3] < 0));
+}
+
+//------------------------------------------------------------------------
+
+TagForces::TagForces()
+{
+    _forceFactor = 16.0 ;
+    _radius = 300 ;
+    _theta = 0.7f ;
+    _isParallel = true ;
+    _isTree = false;
+    _bodies = NULL ;
+}
+
+TagForces::~TagForces()
+{
+}
+
+void TagForces::setForceFactor(const float value)
+{
+    _forceFactor = value ;
+}
+
+void TagForces::setRadius(const float value)
+{
+    _radius = value ;
+}
+
+void TagForces::setTheta(const float value)
+{
+    _theta = value ;
+}
+
+void TagForces::setParallel(const bool value)
+{
+    _isParallel = value ;
+}
+
+void TagForces::computeExact(QVector<Body> &bodies)
+{
+    const float theta = _theta ;
+    _theta = 0 ;
+    compute(bodies);
+    _theta = theta ;
+}
+
+void TagForces::compute(QVector<Body> &bodies)
+{
+    const int count = bodies.size();
+    _bodies = &bodies ;
+    for(int i = 0 ; i < count ; i ++) {
+        bodies[i].fx = 0 ;
+        bodies[i].fy = 0 ;
+    }
+    _isTree = (count >= BarnesHutThreshold) && (_theta > 0) ;
+    if(_isTree) {
+        buildTree();
+    }
+    int threads = QThread::idealThreadCount();
+    if(_isParallel && (count >= ParallelThreshold) && (threads > 1)) {
+        const int sliceSize = (count + threads - 1) / threads ;
+        QList<QFuture<void> > results;
+        for(int start = 0 ; start < count ; start += sliceSize) {
+            const int end = qMin(start + sliceSize, count);
+            results.append(QtConcurrent::run(this, &TagForces::computeSlice, start, end));
+        }
+        foreach(QFuture<void> future, results) {
+            future.waitForFinished();
+        }
+    } else {
+        computeSlice(0, count);
+    }
+    _cells.clear();
+    _bodies = NULL ;
+}
+
+void TagForces::buildTree()
+{
+    _cells.clear();
+    const QVector<Body> &bodies = *_bodies;
+    const int count = bodies.size();
+    if(0 == count) {
+        return ;
+    }
+    float minX = bodies[0].x;
+    float minY = bodies[0].y;
+    float maxX = minX ;
+    float maxY = minY ;
+    QVector<int> indexes(count);
+    for(int i = 0 ; i < count ; i ++) {
+        const Body &body = bodies[i];
+        minX = qMin(minX, body.x);
+        minY = qMin(minY, body.y);
+        maxX = qMax(maxX, body.x);
+        maxY = qMax(maxY, body.y);
+        indexes[i] = i ;
+    }
+    const float size = qMax(maxX - minX, maxY - minY) + 1 ;
+    _cells.reserve(count / LeafSize * 2 + 1);
+    buildCell(indexes, minX, minY, size, 0);
+}
+
+int TagForces::buildCell(const QVector<int> &indexes, const float x0, const float y0, const float size, const int depth)
+{
+    const QVector<Body> &bodies = *_bodies;
+    const int cellIndex = _cells.size();
+    _cells.append(Cell());
+    float massX = 0 ;
+    float massY = 0 ;
+    foreach(const int index, indexes) {
+        massX += bodies[index].x ;
+        massY += bodies[index].y ;
+    }
+    const int count = indexes.size();
+    {
+        Cell &cell = _cells[cellIndex];
+        cell.x0 = x0 ;
+        cell.y0 = y0 ;
+        cell.size = size ;
+        cell.count = count ;
+        cell.massX = massX / count ;
+        cell.massY = massY / count ;
+        if((count <= LeafSize) || (depth >= MaxDepth)) {
+            cell.bodies = indexes ;
+            return cellIndex ;
+        }
+    }
+    const float half = size / 2 ;
+    const float midX = x0 + half ;
+    const float midY = y0 + half ;
+    QVector<int> quadrants[4];
+    foreach(const int index, indexes) {
+        const Body &body = bodies[index];
+        const int quadrant = ((body.x >= midX) ? 1 : 0) + ((body.y >= midY) ? 2 : 0) ;
+        quadrants[quadrant].append(index);
+    }
+    for(int q = 0 ; q < 4 ; q ++) {
+        if(!quadrants[q].isEmpty()) {
+            const float cx = (q & 1) ? midX : x0 ;
+            const float cy = (q & 2) ? midY : y0 ;
+            // the vector can be reallocated by the recursion: no references kept
+            const int child = buildCell(quadrants[q], cx, cy, half, depth + 1);
+            _cells[cellIndex].children[q] = child ;
+        }
+    }
+    return cellIndex ;
+}
+
+void TagForces::computeSlice(const int start, const int end)
+{
+    for(int i = start ; i < end ; i ++) {
+        if(!(*_bodies)[i].isActive) {
+            continue ;
+        }
+        if(_isTree) {
+            computeBodyTree(i);
+        } else {
+            computeBodyExact(i);
+        }
+    }
+}
+
+void TagForces::computeBodyExact(const int index)
+{
+    QVector<Body> &bodies = *_bodies;
+    Body &src = bodies[index];
+    const int count = bodies.size();
+    for(int j = 0 ; j < count ; j ++) {
+        if(j != index) {
+            addPairForce(src, index, bodies[j], j);
+        }
+    }
+}
+
+void TagForces::computeBodyTree(const int index)
+{
+    QVector<Body> &bodies = *_bodies;
+    Body &src = bodies[index];
+    const float px = src.x ;
+    const float py = src.y ;
+    const float radius2 = _radius * _radius ;
+    QVarLengthArray<int, 128> stack;
+    stack.append(0);
+    while(!stack.isEmpty()) {
+        const int cellIndex = stack.last();
+        stack.removeLast();
+        const Cell &cell = _cells.at(cellIndex);
+        // nearest point of the cell: if out of the radius, no body of the cell exerts a force
+        const float x1 = cell.x0 + cell.size ;
+        const float y1 = cell.y0 + cell.size ;
+        const float nx = (px < cell.x0) ? (cell.x0 - px) : ((px > x1) ? (px - x1) : 0);
+        const float ny = (py < cell.y0) ? (cell.y0 - py) : ((py > y1) ? (py - y1) : 0);
+        if((nx * nx + ny * ny) > radius2) {
+            continue ;
+        }
+        if(cell.isLeaf()) {
+            foreach(const int j, cell.bodies) {
+                if(j != index) {
+                    addPairForce(src, index, bodies[j], j);
+                }
+            }
+            continue ;
+        }
+        const bool isInside = (nx == 0) && (ny == 0);
+        if(!isInside) {
+            // farthest point of the cell, the approximation is allowed only if all the bodies are in range
+            const float fx = qMax(qAbs(px - cell.x0), qAbs(px - x1));
+            const float fy = qMax(qAbs(py - cell.y0), qAbs(py - y1));
+            const float dx = cell.massX - px ;
+            const float dy = cell.massY - py ;
+            const float distance = sqrt(dx * dx + dy * dy);
+            if(((fx * fx + fy * fy) <= radius2) && (distance > 0) && ((cell.size / distance) < _theta)) {
+                const float f = (_forceFactor * cell.count) / distance ;
+                src.fx -= f * dx / distance ;
+                src.fy -= f * dy / distance ;
+                continue ;
+            }
+        }
+        for(int q = 0 ; q < 4 ; q ++) {
+            if(cell.children[q] >= 0) {
+                stack.append(cell.children[q]);
+            }
+        }
+    }
+}
+
+/**
+  \brief the force is k/distance, repulsive, limited to the radius of the force
+  */
+void TagForces::addPairForce(Body &src, const int srcIndex, const Body &trg, const int trgIndex)
+{
+    const float dx = trg.x - src.x;
+    const float dy = trg.y - src.y;
+    const float length = sqrt(dx * dx + dy * dy);
+    float distance = length ;
+    if(distance == 0) {
+        distance = 0.001f ;
+    }
+    if(distance > _radius) {
+        return ;
+    }
+    const float f = _forceFactor / distance;
+    float ux ;
+    float uy ;
+    if(length == 0) {
+        jitter(srcIndex, trgIndex, ux, uy);
+    } else {
+        ux = dx / length ;
+        uy = dy / length ;
+    }
+    src.fx -= f * ux ;
+    src.fy -= f * uy ;
+}
+
+/**
+  \brief overlapping markers are pushed in a random direction; the values are
+  derived from the indexes, so that the threads do not share a generator.
+  */
+void TagForces::jitter(const int srcIndex, const int trgIndex, float &jx, float &jy)
+{
+    uint seed = ((uint)srcIndex * 73856093U) ^ ((uint)trgIndex * 19349663U);
+    seed = seed * 1103515245U + 12345U;
+    jx = ((float)((seed >> 8) & 0xFFFF) / 65535.0f) * 10.0f - 5;
+    seed = seed * 1103515245U + 12345U;
+    jy = ((float)((seed >> 8) & 0xFFFF) / 65535.0f) * 10.0f - 5;
+}
@@ -0,0 +1,112 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef TAGFORCES_H
+#define TAGFORCES_H
+
+#include <QVector>
+
+/**
+  \brief Computes the repulsive forces between the markers of the relations graph.
+  Small graphs use the pairwise computation, large ones a Barnes-Hut quadtree
+  whose cells are culled by the radius of the force; the bodies are shared among
+  the available cores.
+  */
+class TagForces
+{
+public:
+    class Body
+    {
+    public:
+        float x;
+        float y;
+        float fx;
+        float fy;
+        //! if false, no force is computed for this body, but it acts on the others
+        bool isActive;
+
+        Body()
+        {
+            x = 0 ;
+            y = 0 ;
+            fx = 0 ;
+            fy = 0 ;
+            isActive = true ;
+        }
+    };
+
+    static const int BarnesHutThreshold = 128;
+    static const int ParallelThreshold = 512;
+
+private:
+    class Cell
+    {
+    public:
+        float x0;
+        float y0;
+        float size;
+        float massX;
+        float massY;
+        int count;
+        int children[4];
+        QVector<int> bodies;
+
+        Cell();
+        bool isLeaf() const;
+    };
+
+    static const int LeafSize = 8;
+    static const int MaxDepth = 20;
+
+    float _forceFactor;
+    float _radius;
+    float _theta;
+    bool _isParallel;
+    bool _isTree;
+    QVector<Cell> _cells;
+    QVector<Body> *_bodies;
+
+    int buildCell(const QVector<int> &indexes, const float x0, const float y0, const float size, const int depth);
+    void buildTree();
+    void computeSlice(const int start, const int end);
+    void computeBodyExact(const int index);
+    void computeBodyTree(const int index);
+    void addPairForce(Body &src, const int srcIndex, const Body &trg, const int trgIndex);
+    static void jitter(const int srcIndex, const int trgIndex, float &jx, float &jy);
+
+public:
+    TagForces();
+    ~TagForces();
+
+    void setForceFactor(const float value);
+    void setRadius(const float value);
+    //! opening angle of the approximation, 0 gives the exact value
+    void setTheta(const float value);
+    void setParallel(const bool value);
+
+    void compute(QVector<Body> &bodies);
+    void computeExact(QVector<Body> &bodies);
+};
+
+#endif // TAGFORCES_H
@@ -0,0 +1,106 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#include "perftracedialog.h"
+#include "ui_perftracedialog.h"
+#include "modules/utils/perftrace.h"
+#include "qxmleditdata.h"
+#include "utils.h"
+#include <QFileDialog>
+
+void PerfTraceDialog::display(QWidget *parent)
+{
+    PerfTraceDialog dialog(parent);
+    dialog.exec();
+}
+
+PerfTraceDialog::PerfTraceDialog(QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::PerfTraceDialog)
+{
+    ui->setupUi(this);
+    ui->chkEnabled->setChecked(PerfTrace::isEnabled());
+    loadData();
+}
+
+PerfTraceDialog::~PerfTraceDialog()
+{
+    delete ui;
+}
+
+void PerfTraceDialog::loadData()
+{
+    ui->zones->setSortingEnabled(false);
+    ui->zones->clear();
+    foreach(const PerfTraceSummary &summary, PerfTrace::summary()) {
+        QTreeWidgetItem *item = new QTreeWidgetItem();
+        item->setText(0, summary.category);
+        item->setText(1, summary.name);
+        item->setData(2, Qt::DisplayRole, summary.count);
+        item->setData(3, Qt::DisplayRole, summary.totalNs / 1000000.0);
+        item->setData(4, Qt::DisplayRole, summary.maxNs / 1000000.0);
+        ui->zones->addTopLevelItem(item);
+    }
+    ui->zones->setSortingEnabled(true);
+    ui->zones->sortByColumn(3, Qt::DescendingOrder);
+    ui->counters->clear();
+    QHashIterator<QString, qint64> counter(PerfTrace::counters());
+    while(counter.hasNext()) {
+        counter.next();
+        QTreeWidgetItem *item = new QTreeWidgetItem();
+        item->setText(0, counter.key());
+        item->setData(1, Qt::DisplayRole, counter.value());
+        ui->counters->addTopLevelItem(item);
+    }
+    ui->lblInfo->setText(tr("Events: %1, dropped: %2").arg(PerfTrace::eventsCount()).arg(PerfTrace::droppedEvents()));
+    ui->cmdExport->setEnabled(PerfTrace::eventsCount() > 0);
+}
+
+void PerfTraceDialog::on_chkEnabled_toggled(bool checked)
+{
+    PerfTrace::setEnabled(checked);
+}
+
+void PerfTraceDialog::on_cmdRefresh_clicked()
+{
+    loadData();
+}
+
+void PerfTraceDialog::on_cmdClear_clicked()
+{
+    PerfTrace::clear();
+    loadData();
+}
+
+void PerfTraceDialog::on_cmdExport_clicked()
+{
+    QString filePath = QFileDialog::getSaveFileName(this, tr("Export Chrome Trace"),
+                       QXmlEditData::sysFilePathForOperation(""), tr("JSON files (*.json);;All files (*)"));
+    if(filePath.isEmpty()) {
+        return ;
+    }
+    if(!PerfTrace::writeChromeTrace(filePath)) {
+        Utils::error(this, tr("Error writing the trace file '%1'.").arg(filePath));
+    }
+}
@@ -0,0 +1,56 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef PERFTRACEDIALOG_H
+#define PERFTRACEDIALOG_H
+
+#include <QDialog>
+
+namespace Ui
+{
+class PerfTraceDialog;
+}
+
+class PerfTraceDialog : public QDialog
+{
+    Q_OBJECT
+
+    void loadData();
+
+public:
+    explicit PerfTraceDialog(QWidget *parent = 0);
+    ~PerfTraceDialog();
+    static void display(QWidget *parent);
+
+private:
+    Ui::PerfTraceDialog *ui;
+
+private slots:
+    void on_chkEnabled_toggled(bool checked);
+    void on_cmdRefresh_clicked();
+    void on_cmdClear_clicked();
+    void on_cmdExport_clicked();
+};
+
+#endif // PERFTRACEDIALOG_H
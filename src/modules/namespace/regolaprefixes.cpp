@@ -24,6 +24,7 @@
 #include "xmlutils.h"
 #include "utils.h"
 #include "modules/namespace/nscontext.h"
+#include "modules/xml/namespacescope.h"
 
 //If the bookmarks are nested, the result is the list of the top levels.
 QList<Element*> Regola::getUniqueBookmarksElements(const TargetSelection::Type type)
@@ -294,6 +295,8 @@ bool Regola::removeNamespace(const QString &removedNS, QList<Element *>elements,
                                          isAllNamespaces, removeDeclarations, observer, lastContext)) {
                 ok = false;
             }
+            // the declarations can be changed
+            invalidateNamespaceScopes();
             EMPTYPTRLIST(contexts, NSContext);
         }
     }
@@ -311,6 +314,7 @@ bool Regola::setNamespace(const QString &ns, const QString &prefix, QList<Elemen
             if(!element->setNamespace(ns, prefix, targetSelection, observer, lastContext, true)) {
                 ok = false;
             }
+            invalidateNamespaceScopes();
             EMPTYPTRLIST(contexts, NSContext);
         }
     }
@@ -330,6 +334,7 @@ bool Regola::replaceNamespace(const QString &replacedNS, const QString &newNS, c
             if(!element->replaceNamespace(replacedNS, newNS, newPrefix, targetSelection, observer, lastContext, true, false)) {
                 ok = false;
             }
+            invalidateNamespaceScopes();
             EMPTYPTRLIST(contexts, NSContext);
         }
     }
@@ -403,6 +408,7 @@ bool Regola::namespaceNormalize(const QString &thePrefix, const QString &theNS,
             if(!element->normalizeNamespace(theNS, thePrefix, declareOnlyOnRoot, true, isDeclared, observer, context)) {
                 ok = false;
             }
+            invalidateNamespaceScopes();
             EMPTYPTRLIST(contexts, NSContext);
         }
     }
@@ -413,6 +419,27 @@ NSContext* Regola::buildContextInfo(QList<NSContext*> &contexts, Element *elemen
 {
     NSContext *lastContext = NULL ;
     Element *parent = element->parent() ;
+    const NamespaceScope *scope = (NULL != parent) ? parent->namespaceScope() : NULL ;
+    if(NULL != scope) {
+        // a context for each scope that declares namespaces, at least one
+        QList<const NamespaceScope*> scopes;
+        while(NULL != scope) {
+            if(!scope->declarations().isEmpty() || (scopes.isEmpty() && (NULL == scope->parent()))) {
+                scopes.insert(0, scope);
+            }
+            scope = scope->parent();
+        }
+        foreach(const NamespaceScope * theScope, scopes) {
+            NSContext *newContext = new NSContext(lastContext);
+            contexts.append(newContext);
+            lastContext = newContext ;
+            typedef QPair<QString, QString> Declaration;
+            foreach(const Declaration & declaration, theScope->declarations()) {
+                newContext->addNamespace(declaration.first, declaration.second);
+            }
+        }
+        return lastContext;
+    }
     // buildup up to the parent namespaces
     QList<Element*> parents;
     while(NULL != parent) {
@@ -23,10 +23,14 @@
 #include "regoladefinitions.h"
 #include "undo/elupdateelementcommand.h"
 #include "undo/undocommandgroup.h"
+#include "modules/search/textsearchindex.h"
+#include "modules/utils/perftrace.h"
+#include <QThread>
 
 
 Element * Regola::findText(FindTextParams &findArgs, Element *selectedItem)
 {
+    QXMLEDIT_TRACE_ZONE("search", "findText");
     if(findArgs.useXQuery()) {
         searchWithXQuery(findArgs, selectedItem);
         return NULL;
@@ -38,6 +42,19 @@ Element * Regola::findText(FindTextParams &findArgs, Element *selectedItem)
     if(!findArgs.isFindAllOccurrences()) {
         return findNextTextMatch(findArgs, selectedItem);
     }
+    if(findArgs.canSearchInParallel()) {
+        QList<Element*> scope;
+        const bool isWholeDocument = (NULL == selectedItem) || !findArgs.isLookOnlyChildren();
+        if(!isWholeDocument) {
+            scope.append(selectedItem);
+        } else {
+            foreach(Element * element, childItems) {
+                scope.append(element);
+            }
+        }
+        findAllTextMatches(findArgs, scope, isWholeDocument);
+        return NULL ;
+    }
     if((NULL != selectedItem) && findArgs.isLookOnlyChildren()) {
         if(findArgs.isCloseUnrelated() && (NULL != selectedItem->getUI())) {
             if(selectedItem->getUI()->isExpanded()) {
@@ -65,6 +82,113 @@ Element * Regola::findText(FindTextParams &findArgs, Element *selectedItem)
     return NULL ;
 }
 
+/*!
+ * \brief collectTextMatchesInRange examines the work units from start to end excluded, in a worker thread
+ * \param selfOnly if true for a unit, only the element is examined, else all its subtree
+ * \return the matching elements in document order
+ */
+static QList<Element*> collectTextMatchesInRange(FindTextParams *findArgs, const QVector<Element*> *units, const QVector<bool> *selfOnly,
+        const int start, const int end)
+{
+    QList<Element*> matches;
+    for(int i = start ; i < end ; i ++) {
+        Element *element = units->at(i);
+        if(selfOnly->at(i)) {
+            if(element->matchText(*findArgs)) {
+                matches.append(element);
+            }
+        } else {
+            element->collectTextMatches(*findArgs, matches);
+        }
+    }
+    return matches ;
+}
+
+/*!
+ * \brief Regola::findIndexedTextMatches the candidates given by the text index are verified by the search itself
+ * \return false if there is no index or it cannot answer, as for scoped searches
+ */
+bool Regola::findIndexedTextMatches(FindTextParams &findArgs, QList<Element*> &matches)
+{
+    if((NULL == _textIndex) || findArgs.isSearchWithScope()) {
+        return false;
+    }
+    QList<Element*> candidates;
+    if(!_textIndex->findCandidates(findArgs, candidates)) {
+        return false;
+    }
+    foreach(Element * element, candidates) {
+        if(element->matchText(findArgs)) {
+            matches.append(element);
+        }
+    }
+    return true ;
+}
+
+/*!
+ * \brief Regola::findAllTextMatches the matches of the whole document come from the text index, when it can answer;
+ * else the elements of the scope and their subtrees are split in units examined in parallel.
+ * Then the occurrences, the highlight and the bookmarks are applied here in document order.
+ */
+void Regola::findAllTextMatches(FindTextParams &findArgs, QList<Element*> &scope, const bool isWholeDocument)
+{
+    QList<Element*> matches;
+    if(!isWholeDocument || !findIndexedTextMatches(findArgs, matches)) {
+        QVector<Element*> units;
+        QVector<bool> selfOnly;
+        foreach(Element * element, scope) {
+            units.append(element);
+            selfOnly.append(true);
+            foreach(Element * child, *element->getChildItems()) {
+                units.append(child);
+                selfOnly.append(false);
+            }
+        }
+        const int unitsCount = units.size();
+        const int threads = QThread::idealThreadCount();
+        if((threads <= 1) || (unitsCount < 2)) {
+            matches = collectTextMatchesInRange(&findArgs, &units, &selfOnly, 0, unitsCount);
+        } else {
+            // more slices than threads to balance subtrees of different sizes
+            const int slices = qMin(unitsCount, threads * 4);
+            QList<QFuture<QList<Element*> > > results;
+            for(int slice = 0 ; slice < slices ; slice ++) {
+                const int start = (int)(((qint64)unitsCount * slice) / slices);
+                const int end = (int)(((qint64)unitsCount * (slice + 1)) / slices);
+                results.append(QtConcurrent::run(collectTextMatchesInRange, &findArgs, &units, &selfOnly, start, end));
+            }
+            for(int slice = 0 ; slice < slices ; slice ++) {
+                matches.append(results[slice].result());
+            }
+        }
+    }
+
+    const bool isCountingOnly = findArgs.isCountingOnly();
+    QSet<Element*> containers;
+    foreach(Element * element, matches) {
+        findArgs.newOccurence(element->selfInfo.totalSize + element->childrenInfo.totalSize);
+        if(!isCountingOnly) {
+            findArgs.addSelection(element);
+            element->hilite();
+            if(findArgs.isSelToBookmarks()) {
+                addBookmark(element);
+            }
+            if(findArgs.isCloseUnrelated()) {
+                Element *parent = element->parent();
+                while((NULL != parent) && !containers.contains(parent)) {
+                    containers.insert(parent);
+                    parent = parent->parent();
+                }
+            }
+        }
+    }
+    if(!isCountingOnly && findArgs.isCloseUnrelated()) {
+        foreach(Element * element, scope) {
+            element->showTextMatches(containers);
+        }
+    }
+}
+
 Element * Regola::replaceText(QTreeWidget *treeWidget, ReplaceTextParams &findArgs, Element *selectedItem)
 {
     if(!findArgs.isFindAllOccurrences()) {
@@ -286,6 +410,41 @@ bool Element::findText(FindTextParams &findArgs)
     return isFoundSomeWhere  ;
 }
 
+/*!
+ * \brief Element::collectTextMatches appends this element and the descendants that match, in document order.
+ * The elements are not changed, so it can run in a worker thread.
+ */
+void Element::collectTextMatches(FindTextParams &findArgs, QList<Element*> &matches)
+{
+    if(matchText(findArgs)) {
+        matches.append(this);
+    }
+    foreach(Element * child, childItems) {
+        child->collectTextMatches(findArgs, matches);
+    }
+}
+
+/*!
+ * \brief Element::showTextMatches expands the items that contain a match and collapses the others
+ * \param containers the ancestors of the matching elements
+ */
+void Element::showTextMatches(const QSet<Element*> &containers)
+{
+    if(NULL == ui) {
+        return ;
+    }
+    if(containers.contains(this)) {
+        if(!ui->isExpanded()) {
+            ui->setExpanded(true);
+        }
+    } else if(ui->isExpanded()) {
+        ui->setExpanded(false);
+    }
+    foreach(Element * child, childItems) {
+        child->showTextMatches(containers);
+    }
+}
+
 bool Element::replaceText(ReplaceTextParams &findArgs)
 {
     bool isReplaced = false;
@@ -0,0 +1,502 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+#include "textsearchindex.h"
+#include "regola.h"
+#include <QTimer>
+
+static QString indexKey(const int field, const QString &text)
+{
+    QString key;
+    key.reserve(text.length() + 1);
+    key.append(QChar('0' + field));
+    key.append(text);
+    return key ;
+}
+
+static quint64 gramKey(const QString &text, const int position)
+{
+    return (((quint64)text.at(position).unicode()) << 32)
+           | (((quint64)text.at(position + 1).unicode()) << 16)
+           | ((quint64)text.at(position + 2).unicode());
+}
+
+static void appendSource(QVector<TextSearchIndexSource> &sources, Element *element, const quint32 version, const int field, const QString &value)
+{
+    if(!value.isEmpty()) {
+        TextSearchIndexSource source;
+        source.element = element ;
+        source.version = version ;
+        source.field = field ;
+        source.value = value ;
+        sources.append(source);
+    }
+}
+
+//----------------------------------------------------------------------
+
+TextSearchIndexData::TextSearchIndexData()
+{
+    postingsCount = 0 ;
+}
+
+TextSearchIndexData::~TextSearchIndexData()
+{
+}
+
+void TextSearchIndexData::add(const TextSearchIndexSource &source)
+{
+    const QString folded = source.value.toCaseFolded();
+    TextSearchIndexPosting posting;
+    posting.element = source.element ;
+    posting.version = source.version ;
+    values[indexKey(source.field, folded)].append(posting);
+    postingsCount++;
+    QSet<QString> tokensOfValue;
+    foreach(const QString & token, TextSearchIndex::tokensOf(folded)) {
+        if(!tokensOfValue.contains(token)) {
+            tokensOfValue.insert(token);
+            tokens[indexKey(source.field, token)].append(posting);
+            postingsCount++;
+            addToken(token);
+        }
+    }
+}
+
+void TextSearchIndexData::addToken(const QString &token)
+{
+    if(vocabulary.contains(token)) {
+        return ;
+    }
+    vocabulary.insert(token);
+    const int last = token.length() - TextSearchIndex::GramLength ;
+    for(int i = 0 ; i <= last ; i ++) {
+        QVector<QString> &tokensOfGram = grams[gramKey(token, i)];
+        // the grams of a token are added together, a repeated gram finds it at the end
+        if(tokensOfGram.isEmpty() || (tokensOfGram.last() != token)) {
+            tokensOfGram.append(token);
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+
+TextSearchIndex::TextSearchIndex(Regola *regola, QObject *parent) : QObject(parent)
+{
+    _regola = regola ;
+    _data = NULL ;
+    _nextVersion = 1 ;
+    _isBuilding = false ;
+    _isStale = false ;
+    _isRebuildScheduled = false ;
+    _isTooBig = false ;
+    _answeredQueries = 0 ;
+    connect(&_watcher, SIGNAL(finished()), this, SLOT(onBuildFinished()));
+}
+
+TextSearchIndex::~TextSearchIndex()
+{
+    if(_isBuilding) {
+        _watcher.waitForFinished();
+        delete _watcher.result();
+    }
+    if(NULL != _data) {
+        delete _data ;
+    }
+}
+
+bool TextSearchIndex::isReady() const
+{
+    return (NULL != _data) && !_isStale && !_isBuilding && !_isTooBig ;
+}
+
+bool TextSearchIndex::isBuilding() const
+{
+    return _isBuilding ;
+}
+
+int TextSearchIndex::answeredQueries() const
+{
+    return _answeredQueries ;
+}
+
+QList<int> TextSearchIndex::fieldsOfTarget(const FindTextParams::EFindTarget target)
+{
+    QList<int> fields;
+    switch(target) {
+    case FindTextParams::FIND_ALL:
+        for(int field = 0 ; field < FieldCount ; field ++) {
+            fields.append(field);
+        }
+        break;
+    case FindTextParams::FIND_TAG:
+        fields.append(FieldTag);
+        break;
+    case FindTextParams::FIND_ATTRIBUTE_NAME:
+        fields.append(FieldAttributeName);
+        break;
+    case FindTextParams::FIND_ATTRIBUTE_VALUE:
+        fields.append(FieldAttributeValue);
+        break;
+    case FindTextParams::FIND_TEXT:
+        fields.append(FieldText);
+        break;
+    case FindTextParams::FIND_COMMENT:
+        fields.append(FieldComment);
+        break;
+    default:
+        // base 64 texts must be decoded, not indexed
+        break;
+    }
+    return fields;
+}
+
+QStringList TextSearchIndex::tokensOf(const QString &foldedText)
+{
+    QStringList tokens;
+    const int length = foldedText.length();
+    int start = -1 ;
+    for(int i = 0 ; i < length ; i ++) {
+        if(foldedText.at(i).isLetterOrNumber()) {
+            if(start < 0) {
+                start = i ;
+            }
+        } else if(start >= 0) {
+            tokens.append(foldedText.mid(start, i - start));
+            start = -1 ;
+        }
+    }
+    if(start >= 0) {
+        tokens.append(foldedText.mid(start));
+    }
+    return tokens;
+}
+
+TextSearchIndexData *TextSearchIndex::buildData(const QVector<TextSearchIndexSource> sources)
+{
+    TextSearchIndexData *data = new TextSearchIndexData();
+    foreach(const TextSearchIndexSource & source, sources) {
+        data->add(source);
+        if(data->postingsCount > MaxPostings) {
+            delete data ;
+            return NULL ;
+        }
+    }
+    return data;
+}
+
+/*!
+ * \brief TextSearchIndex::addSources the values examined by Element::matchText for each type of element
+ */
+void TextSearchIndex::addSources(Element *element, const quint32 version, QVector<TextSearchIndexSource> &sources)
+{
+    switch(element->getType()) {
+    case Element::ET_TEXT:
+        appendSource(sources, element, version, FieldText, element->text);
+        break;
+    case Element::ET_COMMENT:
+        appendSource(sources, element, version, FieldComment, element->getComment());
+        break;
+    case Element::ET_PROCESSING_INSTRUCTION:
+        appendSource(sources, element, version, FieldProcessingInstruction, element->getPITarget());
+        appendSource(sources, element, version, FieldProcessingInstruction, element->getPIData());
+        break;
+    default:
+        appendSource(sources, element, version, FieldTag, element->tag());
+        foreach(TextChunk * chunk, element->getTextChunks()) {
+            appendSource(sources, element, version, FieldText, chunk->text);
+        }
+        foreach(Attribute * attribute, element->attributes) {
+            appendSource(sources, element, version, FieldAttributeName, attribute->name);
+            appendSource(sources, element, version, FieldAttributeValue, attribute->value);
+        }
+        break;
+    }
+}
+
+void TextSearchIndex::collectSources(Element *element, QVector<TextSearchIndexSource> &sources, QHash<Element*, quint32> &versions)
+{
+    if(element->getParentRule() == _regola) {
+        const quint32 version = _nextVersion++ ;
+        versions.insert(element, version);
+        addSources(element, version, sources);
+    }
+    foreach(Element * child, *element->getChildItems()) {
+        collectSources(child, sources, versions);
+    }
+}
+
+/*!
+ * \brief TextSearchIndex::start builds the index in background, when the event loop is free
+ */
+void TextSearchIndex::start()
+{
+    if(!_isRebuildScheduled) {
+        _isRebuildScheduled = true ;
+        QTimer::singleShot(0, this, SLOT(startBuild()));
+    }
+}
+
+void TextSearchIndex::scheduleRebuild()
+{
+    if(!_isRebuildScheduled && !_isTooBig) {
+        _isRebuildScheduled = true ;
+        QTimer::singleShot(RebuildDelay, this, SLOT(startBuild()));
+    }
+}
+
+void TextSearchIndex::startBuild()
+{
+    _isRebuildScheduled = false ;
+    if(_isBuilding || _isTooBig) {
+        return ;
+    }
+    QVector<TextSearchIndexSource> sources;
+    _pendingVersions.clear();
+    foreach(Element * element, *_regola->getChildItems()) {
+        collectSources(element, sources, _pendingVersions);
+    }
+    _isStale = false ;
+    _isBuilding = true ;
+    _watcher.setFuture(QtConcurrent::run(&TextSearchIndex::buildData, sources));
+}
+
+void TextSearchIndex::onBuildFinished()
+{
+    if(!_isBuilding) {
+        return ;
+    }
+    _isBuilding = false ;
+    TextSearchIndexData *data = _watcher.result();
+    if(_isStale) {
+        // the document changed in a way that the copy does not reflect
+        if(NULL != data) {
+            delete data;
+        }
+        _pendingVersions.clear();
+        scheduleRebuild();
+        return ;
+    }
+    if(NULL != _data) {
+        delete _data ;
+    }
+    _data = data ;
+    _versions = _pendingVersions ;
+    _pendingVersions.clear();
+    if(NULL == _data) {
+        _isTooBig = true ;
+        _versions.clear();
+    }
+}
+
+/*!
+ * \brief TextSearchIndex::rebuild builds the index now, waiting for the end
+ */
+void TextSearchIndex::rebuild()
+{
+    if(_isBuilding) {
+        _watcher.waitForFinished();
+        onBuildFinished();
+    }
+    _isTooBig = false ;
+    startBuild();
+    _watcher.waitForFinished();
+    onBuildFinished();
+}
+
+void TextSearchIndex::invalidate()
+{
+    _isStale = true ;
+    scheduleRebuild();
+}
+
+/*!
+ * \brief TextSearchIndex::documentChanged is called for every modification of the document: the index
+ * is not updated element by element, since many editing paths change several elements at once.
+ */
+void TextSearchIndex::documentChanged()
+{
+    if(!_isTooBig) {
+        invalidate();
+    }
+}
+
+bool TextSearchIndex::isValid(const TextSearchIndexPosting &posting) const
+{
+    QHash<Element*, quint32>::const_iterator it = _versions.constFind(posting.element);
+    return (it != _versions.constEnd()) && (it.value() == posting.version);
+}
+
+void TextSearchIndex::addValid(const QVector<TextSearchIndexPosting> &postings, QSet<Element*> &found) const
+{
+    foreach(const TextSearchIndexPosting & posting, postings) {
+        if(isValid(posting)) {
+            found.insert(posting.element);
+        }
+    }
+}
+
+/*!
+ * \brief TextSearchIndex::addTokenMatches adds the elements having in the fields a token that contains the part,
+ * the tokens are taken from the rarest trigram of the part or, for a short part, from the whole vocabulary
+ */
+void TextSearchIndex::addTokenMatches(const QString &part, const QList<int> &fields, QSet<Element*> &found) const
+{
+    QList<QString> matchingTokens;
+    if(part.length() >= GramLength) {
+        const QVector<QString> *rarest = NULL ;
+        const int last = part.length() - GramLength ;
+        for(int i = 0 ; i <= last ; i ++) {
+            QHash<quint64, QVector<QString> >::const_iterator it = _data->grams.constFind(gramKey(part, i));
+            if(it == _data->grams.constEnd()) {
+                return ;
+            }
+            if((NULL == rarest) || (it.value().size() < rarest->size())) {
+                rarest = &it.value();
+            }
+        }
+        foreach(const QString & token, *rarest) {
+            if(token.contains(part)) {
+                matchingTokens.append(token);
+            }
+        }
+    } else {
+        foreach(const QString & token, _data->vocabulary) {
+            if(token.contains(part)) {
+                matchingTokens.append(token);
+            }
+        }
+    }
+    foreach(const QString & token, matchingTokens) {
+        foreach(const int field, fields) {
+            QHash<QString, QVector<TextSearchIndexPosting> >::const_iterator it = _data->tokens.constFind(indexKey(field, token));
+            if(it != _data->tokens.constEnd()) {
+                addValid(it.value(), found);
+            }
+        }
+    }
+}
+
+class TextSearchIndexOrder
+{
+public:
+    QVector<int> path;
+    Element *element;
+};
+
+static bool textSearchIndexOrderLessThan(const TextSearchIndexOrder &first, const TextSearchIndexOrder &second)
+{
+    const int length = qMin(first.path.size(), second.path.size());
+    for(int i = 0 ; i < length ; i ++) {
+        if(first.path.at(i) != second.path.at(i)) {
+            return first.path.at(i) < second.path.at(i);
+        }
+    }
+    return first.path.size() < second.path.size();
+}
+
+/*!
+ * \brief TextSearchIndex::sortInDocumentOrder orders the elements by their position in the tree,
+ * the elements not attached to the document are discarded. The positions of the children
+ * of each parent are computed once.
+ */
+void TextSearchIndex::sortInDocumentOrder(const QSet<Element*> &found, QList<Element*> &candidates)
+{
+    QHash<Element*, QHash<Element*, int> > positions;
+    QList<TextSearchIndexOrder> ordered;
+    foreach(Element * element, found) {
+        TextSearchIndexOrder order;
+        order.element = element ;
+        bool isAttached = true ;
+        Element *current = element ;
+        while(NULL != current) {
+            Element *parent = current->parent();
+            QHash<Element*, int> &positionsOfChildren = positions[parent];
+            if(positionsOfChildren.isEmpty()) {
+                QVector<Element*> *children = (NULL == parent) ? _regola->getChildItems() : parent->getChildItems();
+                const int childrenCount = children->size();
+                for(int i = 0 ; i < childrenCount ; i ++) {
+                    positionsOfChildren.insert(children->at(i), i);
+                }
+            }
+            QHash<Element*, int>::const_iterator it = positionsOfChildren.constFind(current);
+            if(it == positionsOfChildren.constEnd()) {
+                isAttached = false;
+                break;
+            }
+            order.path.prepend(it.value());
+            current = parent ;
+        }
+        if(isAttached) {
+            ordered.append(order);
+        }
+    }
+    qSort(ordered.begin(), ordered.end(), textSearchIndexOrderLessThan);
+    foreach(const TextSearchIndexOrder & order, ordered) {
+        candidates.append(order.element);
+    }
+}
+
+/*!
+ * \brief TextSearchIndex::findCandidates collects in document order the elements that can match the search
+ * \return false if the index cannot answer this search, as for a base 64 text or for too many candidates
+ */
+bool TextSearchIndex::findCandidates(FindTextParams &findArgs, QList<Element*> &candidates)
+{
+    if(!isReady()) {
+        return false;
+    }
+    const QList<int> fields = fieldsOfTarget(findArgs.getFindTarget());
+    const QString &text = findArgs.getTextToFind();
+    if(fields.isEmpty() || text.isEmpty()) {
+        return false;
+    }
+    const QString folded = text.toCaseFolded();
+    QSet<Element*> found;
+    if(findArgs.isIsMatchExact()) {
+        foreach(const int field, fields) {
+            QHash<QString, QVector<TextSearchIndexPosting> >::const_iterator it = _data->values.constFind(indexKey(field, folded));
+            if(it != _data->values.constEnd()) {
+                addValid(it.value(), found);
+            }
+        }
+    } else {
+        // each part of the text is contained in a token of the value, the longest is the most selective
+        QString longestPart;
+        foreach(const QString & part, tokensOf(folded)) {
+            if(part.length() > longestPart.length()) {
+                longestPart = part ;
+            }
+        }
+        if(longestPart.isEmpty()) {
+            return false;
+        }
+        addTokenMatches(longestPart, fields, found);
+    }
+    if(found.size() > (_versions.size() / MaxCandidatesDivisor)) {
+        return false;
+    }
+    sortInDocumentOrder(found, candidates);
+    _answeredQueries++;
+    return true ;
+}
@@ -0,0 +1,157 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef TEXTSEARCHINDEX_H
+#define TEXTSEARCHINDEX_H
+
+#include "xmlEdit.h"
+#include "libQXmlEdit_global.h"
+#include "findtextparams.h"
+#include <QFutureWatcher>
+
+class Element;
+class Regola;
+
+/**
+  \brief a value of an element to index, copied on the GUI thread so the worker never reads the tree.
+  */
+class TextSearchIndexSource
+{
+public:
+    Element *element;
+    quint32 version;
+    int field;
+    QString value;
+};
+
+/**
+  \brief an element holding a token or a value; valid only while the version is the current one of the element.
+  */
+class TextSearchIndexPosting
+{
+public:
+    Element *element;
+    quint32 version;
+};
+
+/**
+  \brief the tables of the index: the folded values, the folded tokens of the values
+  and the trigrams of the distinct tokens to resolve a substring search.
+  */
+class TextSearchIndexData
+{
+public:
+    QHash<QString, QVector<TextSearchIndexPosting> > values;
+    QHash<QString, QVector<TextSearchIndexPosting> > tokens;
+    QHash<quint64, QVector<QString> > grams;
+    QSet<QString> vocabulary;
+    qint64 postingsCount;
+
+    TextSearchIndexData();
+    ~TextSearchIndexData();
+
+    void add(const TextSearchIndexSource &source);
+    void addToken(const QString &token);
+};
+
+/**
+  \brief inverted index of the tags, attribute names and values, texts and comments of a document.
+  It is built in a worker thread from a copy of the values taken on the GUI thread.
+  Every modification of the document, and every undo or redo, invalidates the index that is built again
+  in background after the edits; meanwhile the search is done by a scan.
+  The candidates returned are always verified by the caller with the search itself.
+  */
+class LIBQXMLEDITSHARED_EXPORT TextSearchIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum EField {
+        FieldTag,
+        FieldAttributeName,
+        FieldAttributeValue,
+        FieldText,
+        FieldComment,
+        FieldProcessingInstruction,
+        FieldCount
+    };
+
+    enum {
+        GramLength = 3,
+        // above this size the index is not kept for the document
+        MaxPostings = 32 * 1024 * 1024,
+        // more candidates than the elements divided by this are handled better by a scan
+        MaxCandidatesDivisor = 4,
+        RebuildDelay = 500
+    };
+
+private:
+    Regola *_regola;
+    TextSearchIndexData *_data;
+    QHash<Element*, quint32> _versions;
+    QHash<Element*, quint32> _pendingVersions;
+    quint32 _nextVersion;
+    bool _isBuilding;
+    bool _isStale;
+    bool _isRebuildScheduled;
+    bool _isTooBig;
+    int _answeredQueries;
+    QFutureWatcher<TextSearchIndexData*> _watcher;
+
+    void collectSources(Element *element, QVector<TextSearchIndexSource> &sources, QHash<Element*, quint32> &versions);
+    void addSources(Element *element, const quint32 version, QVector<TextSearchIndexSource> &sources);
+    bool isValid(const TextSearchIndexPosting &posting) const;
+    void addValid(const QVector<TextSearchIndexPosting> &postings, QSet<Element*> &found) const;
+    void addTokenMatches(const QString &part, const QList<int> &fields, QSet<Element*> &found) const;
+    void sortInDocumentOrder(const QSet<Element*> &found, QList<Element*> &candidates);
+    void scheduleRebuild();
+
+public:
+    TextSearchIndex(Regola *regola, QObject *parent = NULL);
+    ~TextSearchIndex();
+
+    bool isReady() const;
+    bool isBuilding() const;
+    int answeredQueries() const;
+
+    void start();
+    void rebuild();
+
+    void invalidate();
+
+    bool findCandidates(FindTextParams &findArgs, QList<Element*> &candidates);
+
+    static QList<int> fieldsOfTarget(const FindTextParams::EFindTarget target);
+    static QStringList tokensOf(const QString &foldedText);
+    static TextSearchIndexData *buildData(const QVector<TextSearchIndexSource> sources);
+
+public slots:
+    void documentChanged();
+
+private slots:
+    void onBuildFinished();
+    void startBuild();
+};
+
+#endif // TEXTSEARCHINDEX_H
@@ -0,0 +1,203 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+#include "batchjob.h"
+
+BatchJob::BatchJob(const EJobType type, const QStringList &arguments, const int lineNumber)
+{
+    _type = type ;
+    _arguments = arguments ;
+    _lineNumber = lineNumber ;
+    _isExecuted = false ;
+    _isError = false ;
+    _elapsedMs = 0 ;
+    _bytes = 0 ;
+}
+
+BatchJob::~BatchJob()
+{
+}
+
+BatchJob::EJobType BatchJob::typeFromName(const QString &name)
+{
+    const QString lowerName = name.toLower();
+    if(lowerName == "split") {
+        return JobSplit ;
+    }
+    if(lowerName == "anonymize") {
+        return JobAnonymize ;
+    }
+    if(lowerName == "compare") {
+        return JobCompare ;
+    }
+    if(lowerName == "validate") {
+        return JobValidate ;
+    }
+    if(lowerName == "xslt") {
+        return JobXSLT ;
+    }
+    return JobUnknown ;
+}
+
+int BatchJob::minArguments(const EJobType type)
+{
+    switch(type) {
+    case JobSplit:
+        return 3 ;
+    case JobAnonymize:
+        return 3 ;
+    case JobCompare:
+        return 2 ;
+    case JobValidate:
+        return 2 ;
+    case JobXSLT:
+        return 3 ;
+    default:
+        return 0 ;
+    }
+}
+
+/*!
+ * \brief BatchJob::fromLine decodes a line of the job list. The fields are separated by tabs
+ * or, if the line has no tabs, by spaces:
+ *  split <inputFile> <splitPath> <outputFolder>
+ *  anonymize <inputFile> <profile> <outputFile>
+ *  compare <referenceFile> <compareFile>
+ *  validate <dataFile> <schemaFile>
+ *  xslt <inputFile> <xslFile> <outputFile> {<name>=<value>}*
+ * \return NULL for empty lines, comments (#) and errors; in case of error errorMessage is set.
+ */
+BatchJob *BatchJob::fromLine(const QString &line, const int lineNumber, QString &errorMessage)
+{
+    const QString trimmedLine = line.trimmed();
+    if(trimmedLine.isEmpty() || trimmedLine.startsWith("#")) {
+        return NULL ;
+    }
+    QStringList fields;
+    if(trimmedLine.contains('\t')) {
+        fields = trimmedLine.split('\t', QString::SkipEmptyParts);
+    } else {
+        fields = trimmedLine.split(' ', QString::SkipEmptyParts);
+    }
+    const QString name = fields.takeFirst();
+    const EJobType type = typeFromName(name);
+    if(JobUnknown == type) {
+        errorMessage = QObject::tr("Line %1: unknown operation '%2'.").arg(lineNumber).arg(name);
+        return NULL ;
+    }
+    if(fields.size() < minArguments(type)) {
+        errorMessage = QObject::tr("Line %1: the operation '%2' needs %3 arguments.").arg(lineNumber).arg(name).arg(minArguments(type));
+        return NULL ;
+    }
+    QStringList arguments;
+    foreach(const QString &field, fields) {
+        arguments.append(field.trimmed());
+    }
+    return new BatchJob(type, arguments, lineNumber);
+}
+
+BatchJob::EJobType BatchJob::type() const
+{
+    return _type ;
+}
+
+QString BatchJob::typeName() const
+{
+    switch(_type) {
+    case JobSplit:
+        return "split" ;
+    case JobAnonymize:
+        return "anonymize" ;
+    case JobCompare:
+        return "compare" ;
+    case JobValidate:
+        return "validate" ;
+    case JobXSLT:
+        return "xslt" ;
+    default:
+        return "?" ;
+    }
+}
+
+QStringList BatchJob::arguments() const
+{
+    return _arguments ;
+}
+
+QString BatchJob::argument(const int index) const
+{
+    if((index >= 0) && (index < _arguments.size())) {
+        return _arguments.at(index);
+    }
+    return "" ;
+}
+
+int BatchJob::lineNumber() const
+{
+    return _lineNumber ;
+}
+
+bool BatchJob::isExecuted() const
+{
+    return _isExecuted ;
+}
+
+bool BatchJob::isError() const
+{
+    return _isError ;
+}
+
+QString BatchJob::message() const
+{
+    return _message ;
+}
+
+qint64 BatchJob::elapsedMs() const
+{
+    return _elapsedMs ;
+}
+
+qint64 BatchJob::bytes() const
+{
+    return _bytes ;
+}
+
+/*!
+ * \brief BatchJob::throughputMBs the input data processed, in MB per second
+ */
+double BatchJob::throughputMBs() const
+{
+    if(_elapsedMs <= 0) {
+        return 0 ;
+    }
+    return (static_cast<double>(_bytes) / (1024.0 * 1024.0)) / (static_cast<double>(_elapsedMs) / 1000.0);
+}
+
+void BatchJob::setResult(const bool isError, const QString &message, const qint64 elapsedMs, const qint64 bytes)
+{
+    _isExecuted = true ;
+    _isError = isError ;
+    _message = message ;
+    _elapsedMs = elapsedMs ;
+    _bytes = bytes ;
+}
@@ -0,0 +1,82 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef BATCHJOB_H
+#define BATCHJOB_H
+
+#include "xmlEdit.h"
+
+/*!
+ * \brief one line of a batch job list: the operation, its arguments and, after the run, its outcome
+ */
+class BatchJob
+{
+public:
+    enum EJobType {
+        JobUnknown,
+        JobSplit,
+        JobAnonymize,
+        JobCompare,
+        JobValidate,
+        JobXSLT
+    };
+
+private:
+    EJobType _type;
+    QStringList _arguments;
+    int _lineNumber;
+    //----------------- results ---------------
+    bool _isExecuted;
+    bool _isError;
+    QString _message;
+    qint64 _elapsedMs;
+    qint64 _bytes;
+    //-----------------------------------------
+
+    static EJobType typeFromName(const QString &name);
+    static int minArguments(const EJobType type);
+
+public:
+    BatchJob(const EJobType type, const QStringList &arguments, const int lineNumber);
+    ~BatchJob();
+
+    static BatchJob *fromLine(const QString &line, const int lineNumber, QString &errorMessage);
+
+    EJobType type() const;
+    QString typeName() const;
+    QStringList arguments() const;
+    QString argument(const int index) const;
+    int lineNumber() const;
+
+    bool isExecuted() const;
+    bool isError() const;
+    QString message() const;
+    qint64 elapsedMs() const;
+    qint64 bytes() const;
+    double throughputMBs() const;
+
+    void setResult(const bool isError, const QString &message, const qint64 elapsedMs, const qint64 bytes);
+};
+
+#endif // BATCHJOB_H
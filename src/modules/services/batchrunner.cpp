@@ -0,0 +1,355 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+#include "batchrunner.h"
+#include "batchjob.h"
+#include "utils.h"
+#include "applicationdata.h"
+#include "operationresult.h"
+#include "extraction/extractionoperation.h"
+#include "extraction/extractresults.h"
+#include "modules/anonymize/anonymizebatch.h"
+#include "modules/anonymize/anonprofile.h"
+#include "modules/compare/compareengine.h"
+#include "modules/xsd/xsdvalidationexecutor.h"
+#include "modules/xslt/xsltexecutor.h"
+#include "modules/messages/sourceerror.h"
+
+BatchRunner::BatchRunner(ApplicationData *appData)
+{
+    _appData = appData ;
+    _threads = qMax(1, QThread::idealThreadCount());
+    _elapsedMs = 0 ;
+}
+
+BatchRunner::~BatchRunner()
+{
+    EMPTYPTRLIST(_jobs, BatchJob);
+    foreach(AnonProfile * profile, _profiles.values()) {
+        if(NULL != profile) {
+            delete profile ;
+        }
+    }
+    _profiles.clear();
+}
+
+bool BatchRunner::setError(const QString &message)
+{
+    if(_errorMessage.isEmpty()) {
+        _errorMessage = message ;
+    }
+    return false;
+}
+
+QString BatchRunner::errorMessage()
+{
+    return _errorMessage ;
+}
+
+int BatchRunner::threads()
+{
+    return _threads ;
+}
+
+void BatchRunner::setThreads(const int value)
+{
+    _threads = qMax(1, value);
+}
+
+QList<BatchJob*> BatchRunner::jobs()
+{
+    return _jobs ;
+}
+
+void BatchRunner::addJob(BatchJob *job)
+{
+    if(NULL != job) {
+        _jobs.append(job);
+    }
+}
+
+qint64 BatchRunner::elapsedMs()
+{
+    return _elapsedMs ;
+}
+
+bool BatchRunner::readJobList(const QString &filePath)
+{
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return setError(QObject::tr("Unable to open the job list '%1'.").arg(filePath));
+    }
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    const bool result = readJobList(stream);
+    file.close();
+    return result ;
+}
+
+bool BatchRunner::readJobList(QTextStream &stream)
+{
+    int lineNumber = 0 ;
+    bool isOk = true ;
+    while(!stream.atEnd()) {
+        const QString line = stream.readLine();
+        lineNumber++;
+        QString lineError;
+        BatchJob *job = BatchJob::fromLine(line, lineNumber, lineError);
+        if(NULL != job) {
+            _jobs.append(job);
+        } else if(!lineError.isEmpty()) {
+            isOk = setError(lineError);
+        }
+    }
+    return isOk ;
+}
+
+/*!
+ * \brief BatchRunner::loadProfiles reads once each profile used by the anonymize jobs.
+ */
+bool BatchRunner::loadProfiles()
+{
+    foreach(BatchJob * job, _jobs) {
+        if(BatchJob::JobAnonymize != job->type()) {
+            continue;
+        }
+        const QString profileName = job->argument(1);
+        if(_profiles.contains(profileName)) {
+            continue;
+        }
+        AnonymizeBatch loader(_appData, "", profileName, "");
+        AnonProfile *profile = loader.loadProfile();
+        if(NULL == profile) {
+            return setError(loader.errorMessage());
+        }
+        _profiles.insert(profileName, profile);
+    }
+    return true ;
+}
+
+/*!
+ * \brief BatchRunner::run executes all the jobs
+ * \return false if the jobs cannot start or if any of them failed.
+ */
+bool BatchRunner::run()
+{
+    QElapsedTimer timer;
+    timer.start();
+    if(!loadProfiles()) {
+        return false;
+    }
+    _nextJob.fetchAndStoreOrdered(0);
+    const int workers = qMin(_threads, _jobs.size());
+    QThreadPool *pool = QThreadPool::globalInstance();
+    if(pool->maxThreadCount() < workers) {
+        pool->setMaxThreadCount(workers);
+    }
+    QList<QFuture<void> > results;
+    FORINT(i, workers) {
+        results.append(QtConcurrent::run(this, &BatchRunner::workerThread));
+    }
+    foreach(QFuture<void> future, results) {
+        future.waitForFinished();
+    }
+    _elapsedMs = timer.elapsed();
+    return 0 == errorsCount();
+}
+
+int BatchRunner::errorsCount()
+{
+    int errors = 0 ;
+    foreach(BatchJob * job, _jobs) {
+        if(job->isError() || !job->isExecuted()) {
+            errors++;
+        }
+    }
+    return errors ;
+}
+
+void BatchRunner::workerThread()
+{
+    forever {
+        const int index = _nextJob.fetchAndAddOrdered(1);
+        if(index >= _jobs.size()) {
+            return ;
+        }
+        executeJob(_jobs.at(index));
+    }
+}
+
+void BatchRunner::executeJob(BatchJob *job)
+{
+    QElapsedTimer timer;
+    timer.start();
+    QString message;
+    bool isOk = false;
+    qint64 bytes = fileSize(job->argument(0));
+    switch(job->type()) {
+    case BatchJob::JobSplit:
+        isOk = executeSplit(job, message);
+        break;
+    case BatchJob::JobAnonymize:
+        isOk = executeAnonymize(job, message);
+        break;
+    case BatchJob::JobCompare:
+        bytes += fileSize(job->argument(1));
+        isOk = executeCompare(job, message);
+        break;
+    case BatchJob::JobValidate:
+        isOk = executeValidate(job, message);
+        break;
+    case BatchJob::JobXSLT:
+        isOk = executeXSLT(job, message);
+        break;
+    default:
+        message = QObject::tr("Unknown operation.");
+        break;
+    }
+    job->setResult(!isOk, message, timer.elapsed(), bytes);
+}
+
+qint64 BatchRunner::fileSize(const QString &filePath)
+{
+    QFileInfo info(filePath);
+    if(info.exists()) {
+        return info.size();
+    }
+    return 0 ;
+}
+
+bool BatchRunner::executeSplit(BatchJob *job, QString &message)
+{
+    ExtractResults results;
+    ExtractionOperation operation(&results);
+    operation.setInputFile(job->argument(0));
+    operation.setSplitType(ExtractionOperation::SplitUsingPath);
+    operation.setSplitPath(job->argument(1));
+    operation.setOperationType(ExtractionOperation::OperationSplit);
+    operation.setExtractDocuments(true);
+    operation.setExtractAllDocuments();
+    operation.setExtractFolder(job->argument(2));
+    operation.setIsMakeSubFolders(false);
+    QStringList namePattern;
+    namePattern.append(QFileInfo(job->argument(0)).completeBaseName() + "_");
+    namePattern.append(COUNTER_TOKEN_PTRN);
+    operation.setFilesNamePattern(namePattern);
+    const ExtractionOperation::EParamErrors paramError = operation.checkParameters();
+    if(ExtractionOperation::ParamNoError != paramError) {
+        message = QObject::tr("Invalid parameters, code: %1.").arg(paramError);
+        return false;
+    }
+    operation.performExtraction();
+    if(operation.isError()) {
+        message = operation.errorMessage();
+        return false;
+    }
+    message = QObject::tr("%1 documents extracted.").arg(operation.counterDocumentsFound);
+    return true;
+}
+
+bool BatchRunner::executeAnonymize(BatchJob *job, QString &message)
+{
+    AnonymizeBatch operation(_appData, job->argument(0), job->argument(1), job->argument(2));
+    operation.setProfile(_profiles.value(job->argument(1)));
+    operation.operation();
+    if(operation.isError()) {
+        message = operation.errorMessage();
+        return false;
+    }
+    return true;
+}
+
+bool BatchRunner::executeCompare(BatchJob *job, QString &message)
+{
+    CompareEngine engine;
+    if(!engine.compareQuickFiles(job->argument(0), job->argument(1))) {
+        message = QObject::tr("Unable to compare the files.");
+        return false;
+    }
+    if(engine.areDifferent()) {
+        message = QObject::tr("The files are different.");
+    } else {
+        message = QObject::tr("The files are equal.");
+    }
+    return true;
+}
+
+bool BatchRunner::executeValidate(BatchJob *job, QString &message)
+{
+    XSDValidationExecutor executor;
+    QPair<int, QString> result = executor.execute(job->argument(0), job->argument(1));
+    message = result.second ;
+    return 0 == result.first ;
+}
+
+bool BatchRunner::executeXSLT(BatchJob *job, QString &message)
+{
+    QList<QPair<QString, QString> > params;
+    const QStringList arguments = job->arguments();
+    for(int i = 3 ; i < arguments.size() ; i ++) {
+        const QString &parameter = arguments.at(i);
+        const int equalsIndex = parameter.indexOf('=');
+        if(equalsIndex < 0) {
+            params.append(QPair<QString, QString>(parameter, ""));
+        } else {
+            params.append(QPair<QString, QString>(parameter.left(equalsIndex), parameter.mid(equalsIndex + 1)));
+        }
+    }
+    MessagesOperationResult result;
+    const bool isOk = XSLTExecutor::execBatch(_appData, result, job->argument(0), job->argument(1), job->argument(2), params, false);
+    foreach(SourceMessage * sourceMessage, *result.messages()) {
+        if(sourceMessage->type() == SourceMessage::Error) {
+            message = sourceMessage->description();
+            break;
+        }
+    }
+    return isOk ;
+}
+
+/*!
+ * \brief BatchRunner::report writes a line for each job with its timing and throughput, then the totals
+ */
+void BatchRunner::report(QTextStream &stream)
+{
+    qint64 totalBytes = 0 ;
+    foreach(BatchJob * job, _jobs) {
+        totalBytes += job->bytes();
+        QString status;
+        if(!job->isExecuted()) {
+            status = QObject::tr("SKIPPED");
+        } else if(job->isError()) {
+            status = QObject::tr("ERROR");
+        } else {
+            status = QObject::tr("OK");
+        }
+        stream << QObject::tr("[%1] line %2 %3 %4: %5 ms, %6 bytes, %7 MB/s %8\n")
+               .arg(status).arg(job->lineNumber()).arg(job->typeName()).arg(job->argument(0))
+               .arg(job->elapsedMs()).arg(job->bytes()).arg(job->throughputMBs(), 0, 'f', 2)
+               .arg(job->message());
+    }
+    const double seconds = static_cast<double>(_elapsedMs) / 1000.0 ;
+    const double throughput = (seconds > 0) ? (static_cast<double>(totalBytes) / (1024.0 * 1024.0)) / seconds : 0 ;
+    stream << QObject::tr("Jobs: %1, errors: %2, threads: %3, elapsed: %4 ms, %5 MB/s\n")
+           .arg(_jobs.size()).arg(errorsCount()).arg(_threads).arg(_elapsedMs).arg(throughput, 0, 'f', 2);
+    stream.flush();
+}
@@ -0,0 +1,79 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include "xmlEdit.h"
+
+class ApplicationData;
+class AnonProfile;
+class BatchJob;
+
+/*!
+ * \brief executes a list of batch jobs without a user interface, a worker count
+ * of threads takes the next job from the list until the list is exhausted.
+ */
+class BatchRunner
+{
+    ApplicationData *_appData;
+    int _threads;
+    QList<BatchJob*> _jobs;
+    // profiles are read from the storage before the run, the storage is not shared between threads
+    QHash<QString, AnonProfile*> _profiles;
+    QAtomicInt _nextJob;
+    QString _errorMessage;
+    qint64 _elapsedMs;
+
+    bool setError(const QString &message);
+    bool loadProfiles();
+    void workerThread();
+    void executeJob(BatchJob *job);
+    bool executeSplit(BatchJob *job, QString &message);
+    bool executeAnonymize(BatchJob *job, QString &message);
+    bool executeCompare(BatchJob *job, QString &message);
+    bool executeValidate(BatchJob *job, QString &message);
+    bool executeXSLT(BatchJob *job, QString &message);
+    static qint64 fileSize(const QString &filePath);
+
+public:
+    BatchRunner(ApplicationData *appData);
+    ~BatchRunner();
+
+    int threads();
+    void setThreads(const int value);
+
+    bool readJobList(const QString &filePath);
+    bool readJobList(QTextStream &stream);
+    void addJob(BatchJob *job);
+    QList<BatchJob*> jobs();
+
+    bool run();
+    int errorsCount();
+    qint64 elapsedMs();
+    QString errorMessage();
+    void report(QTextStream &stream);
+};
+
+#endif // BATCHRUNNER_H
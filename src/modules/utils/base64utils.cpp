@@ -24,91 +24,312 @@
 #include "qxmleditdata.h"
 #include "utils.h"
 
-Base64Utils::Base64Utils()
+static const char StandardAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char UrlAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+/*!
+ * \brief the value of each character for the decoding, -1 if not in the alphabet
+ */
+class Base64DecodeTable
+{
+public:
+    signed char values[256];
+
+    Base64DecodeTable(const bool isUrl)
+    {
+        memset(values, -1, sizeof(values));
+        FORINT(i, 64) {
+            values[static_cast<uchar>(StandardAlphabet[i])] = static_cast<signed char>(i);
+        }
+        // the url variant accepts also the standard characters
+        if(isUrl) {
+            values[static_cast<uchar>('-')] = 62 ;
+            values[static_cast<uchar>('_')] = 63 ;
+        }
+    }
+};
+
+static const Base64DecodeTable StandardDecodeTable(false);
+static const Base64DecodeTable UrlDecodeTable(true);
+
+//--------------------------------------------------------------
+
+Base64Encoder::Base64Encoder(const Base64Utils::EBase64 type, const bool limitColumns, const int columns)
 {
+    _alphabet = (Base64Utils::RFC6920Url == type) ? UrlAlphabet : StandardAlphabet ;
+    _limitColumns = limitColumns && (columns > 0);
+    _columns = columns ;
+    _currentColumn = 0 ;
+    _pendingCount = 0 ;
 }
 
-Base64Utils::~Base64Utils()
+Base64Encoder::~Base64Encoder()
 {
 }
 
+int Base64Encoder::encodedLength(const qint64 dataLength, const bool limitColumns, const int columns)
+{
+    qint64 length = ((dataLength + 2) / 3) * 4 ;
+    if(limitColumns && (columns > 0) && (length > 0)) {
+        length += (length - 1) / columns ;
+    }
+    return static_cast<int>(length);
+}
 
-QString Base64Utils::standardToSpecific(const EBase64 type, const QString &text)
+QChar *Base64Encoder::writeChar(QChar *out, const char ch)
 {
-    if(RFC6920Url == type) {
-        QString res(text);
-        res = res.replace("+", "-");
-        res = res.replace("/", "_");
-        return res;
+    if(_limitColumns) {
+        if(_currentColumn == _columns) {
+            *out++ = QLatin1Char('\n');
+            _currentColumn = 0 ;
+        }
+        _currentColumn++;
     }
-    return text ;
+    *out++ = QLatin1Char(ch);
+    return out ;
+}
+
+QChar *Base64Encoder::writeQuad(QChar *out, const uint value)
+{
+    out = writeChar(out, _alphabet[(value >> 18) & 0x3F]);
+    out = writeChar(out, _alphabet[(value >> 12) & 0x3F]);
+    out = writeChar(out, _alphabet[(value >> 6) & 0x3F]);
+    out = writeChar(out, _alphabet[value & 0x3F]);
+    return out ;
+}
+
+/*!
+ * \brief Base64Encoder::encode appends the encoded data to the output, the bytes
+ * that do not complete a group of three are kept for the next call
+ */
+void Base64Encoder::encode(const char *data, const int length, QString &output)
+{
+    if(length <= 0) {
+        return ;
+    }
+    const int start = output.length();
+    output.resize(start + encodedLength(_pendingCount + length, _limitColumns, _columns) + 1);
+    QChar *base = output.data();
+    QChar *out = base + start ;
+    const uchar *in = reinterpret_cast<const uchar*>(data);
+    int index = 0 ;
+    if(_pendingCount > 0) {
+        uchar group[3];
+        group[0] = _pending[0];
+        group[1] = _pending[1];
+        int count = _pendingCount ;
+        while((count < 3) && (index < length)) {
+            group[count++] = in[index++];
+        }
+        if(count < 3) {
+            _pending[0] = group[0];
+            _pending[1] = group[1];
+            _pendingCount = count ;
+            output.resize(start);
+            return ;
+        }
+        out = writeQuad(out, (group[0] << 16) | (group[1] << 8) | group[2]);
+        _pendingCount = 0 ;
+    }
+    const int groupsEnd = index + ((length - index) / 3) * 3 ;
+    if(!_limitColumns) {
+        // the plain loop, without the check of the line length
+        for(; index < groupsEnd ; index += 3) {
+            const uint value = (in[index] << 16) | (in[index + 1] << 8) | in[index + 2];
+            out[0] = QLatin1Char(_alphabet[(value >> 18) & 0x3F]);
+            out[1] = QLatin1Char(_alphabet[(value >> 12) & 0x3F]);
+            out[2] = QLatin1Char(_alphabet[(value >> 6) & 0x3F]);
+            out[3] = QLatin1Char(_alphabet[value & 0x3F]);
+            out += 4 ;
+        }
+    } else {
+        for(; index < groupsEnd ; index += 3) {
+            out = writeQuad(out, (in[index] << 16) | (in[index + 1] << 8) | in[index + 2]);
+        }
+    }
+    while(index < length) {
+        _pending[_pendingCount++] = in[index++];
+    }
+    output.resize(static_cast<int>(out - base));
+}
+
+/*!
+ * \brief Base64Encoder::finish writes the last bytes with the padding
+ */
+void Base64Encoder::finish(QString &output)
+{
+    if(0 == _pendingCount) {
+        return ;
+    }
+    const int start = output.length();
+    output.resize(start + 8);
+    QChar *base = output.data();
+    QChar *out = base + start ;
+    uint value = _pending[0] << 16 ;
+    if(_pendingCount > 1) {
+        value |= _pending[1] << 8 ;
+    }
+    out = writeChar(out, _alphabet[(value >> 18) & 0x3F]);
+    out = writeChar(out, _alphabet[(value >> 12) & 0x3F]);
+    if(_pendingCount > 1) {
+        out = writeChar(out, _alphabet[(value >> 6) & 0x3F]);
+    } else {
+        out = writeChar(out, '=');
+    }
+    out = writeChar(out, '=');
+    _pendingCount = 0 ;
+    output.resize(static_cast<int>(out - base));
+}
+
+//--------------------------------------------------------------
+
+Base64Decoder::Base64Decoder(const Base64Utils::EBase64 type)
+{
+    _table = (Base64Utils::RFC6920Url == type) ? UrlDecodeTable.values : StandardDecodeTable.values ;
+    _buffer = 0 ;
+    _bits = 0 ;
+}
+
+Base64Decoder::~Base64Decoder()
+{
 }
 
+int Base64Decoder::maxDecodedLength(const int textLength)
+{
+    return ((textLength / 4) * 3) + 3 ;
+}
 
-QString Base64Utils::specificToStandard(const EBase64 type, const QString &text)
+/*!
+ * \brief Base64Decoder::decode decodes a chunk of text, the bits that do not complete
+ * a byte are kept for the next chunk.
+ * \param output must hold maxDecodedLength(length) bytes
+ * \return the number of bytes written
+ */
+int Base64Decoder::decode(const QChar *text, const int length, char *output)
 {
-    if(RFC6920Url == type) {
-        QString res(text);
-        res = res.replace("-", "+");
-        res = res.replace("_", "/");
-        return res;
+    char *out = output ;
+    uint buffer = _buffer ;
+    int bits = _bits ;
+    FORINT(i, length) {
+        const ushort ch = text[i].unicode();
+        if(ch > 255) {
+            continue;
+        }
+        const int value = _table[ch];
+        if(value < 0) {
+            continue;
+        }
+        buffer = (buffer << 6) | value ;
+        bits += 6 ;
+        if(bits >= 8) {
+            bits -= 8 ;
+            *out++ = static_cast<char>(buffer >> bits);
+            buffer &= (1 << bits) - 1 ;
+        }
     }
-    return text ;
+    _buffer = buffer ;
+    _bits = bits ;
+    return static_cast<int>(out - output);
+}
+
+//--------------------------------------------------------------
+
+Base64Utils::Base64Utils()
+{
+}
+
+Base64Utils::~Base64Utils()
+{
 }
 
 QString Base64Utils::doLimitColumns(const QString &text, const bool limitColumns, const int columns)
 {
-    QString result = text ;
-    if(limitColumns) {
-        if(columns > 0) {
-            int numInt = text.length() / columns ;
-            int lastInt = text.length() - (numInt * columns);
-            int base = 0;
-            QString work  ;
-            bool first = true;
-            FORINT(i, numInt) {
-                if(!first) {
-                    work += "\n";
-                }
-                work += text.mid(base, columns);
-                base += columns ;
-                first = false;
-            }
-            if(lastInt > 0) {
-                if(!first) {
-                    work += "\n";
-                }
-                work += text.mid(base, lastInt);
-            }
-            result = work;
+    if(!limitColumns || (columns <= 0)) {
+        return text ;
+    }
+    const int length = text.length();
+    if(length <= columns) {
+        return text ;
+    }
+    QString result;
+    result.reserve(length + ((length - 1) / columns));
+    for(int base = 0 ; base < length ; base += columns) {
+        if(base > 0) {
+            result += QLatin1Char('\n');
         }
+        result += text.midRef(base, columns);
     }
     return result ;
 }
 
 QString Base64Utils::toBase64(const EBase64 type, const QString &text, const bool limitColumns, const int columns)
 {
-    QString result = Utils::toBase64(text);
-    result = standardToSpecific(type, result);
-    result = doLimitColumns(result, limitColumns, columns);
-    return result ;
+    return toBase64(type, text.toUtf8(), limitColumns, columns);
 }
 
 QString Base64Utils::toBase64(const EBase64 type, const QByteArray &input, const bool limitColumns, const int columns)
 {
-    QByteArray resultBytes = input.toBase64();
-    QString result(resultBytes);
-    result = standardToSpecific(type, result);
-    result = doLimitColumns(result, limitColumns, columns);
+    QString result;
+    result.reserve(Base64Encoder::encodedLength(input.length(), limitColumns, columns) + 8);
+    Base64Encoder encoder(type, limitColumns, columns);
+    encoder.encode(input.constData(), input.length(), result);
+    encoder.finish(result);
     return result ;
 }
 
 QByteArray Base64Utils::fromBase64(const EBase64 type, const QString &text)
 {
-    QString toConvert = specificToStandard(type, text);
-    QByteArray array(toConvert.toLatin1());
-    QByteArray array2 = QByteArray::fromBase64(array);
-    return array2;
+    QByteArray result;
+    result.resize(Base64Decoder::maxDecodedLength(text.length()));
+    Base64Decoder decoder(type);
+    const int length = decoder.decode(text.constData(), text.length(), result.data());
+    result.resize(length);
+    return result;
+}
+
+/*!
+ * \brief Base64Utils::decodedTextPrefix decodes only the start of the text, the one
+ * that can be shown, as UTF-8
+ */
+QString Base64Utils::decodedTextPrefix(const QString &text, const int maxBytes)
+{
+    static const int SliceSize = 4096 ;
+    QByteArray buffer;
+    buffer.resize(maxBytes + Base64Decoder::maxDecodedLength(SliceSize));
+    Base64Decoder decoder(RFC4648Standard);
+    const QChar *data = text.constData();
+    const int length = text.length();
+    int decoded = 0 ;
+    for(int index = 0 ; (index < length) && (decoded < maxBytes) ; index += SliceSize) {
+        decoded += decoder.decode(data + index, qMin(SliceSize, length - index), buffer.data() + decoded);
+    }
+    return QString::fromUtf8(buffer.constData(), qMin(decoded, maxBytes));
+}
+
+/*!
+ * \brief Base64Utils::loadFromBinaryDevice encodes the device reading it in chunks
+ */
+bool Base64Utils::loadFromBinaryDevice(const EBase64 type, QIODevice *device, QString &result, const bool limitColumns, const int columns)
+{
+    result.clear();
+    if(!device->isSequential() && (device->size() > 0)) {
+        result.reserve(Base64Encoder::encodedLength(device->size(), limitColumns, columns) + 8);
+    }
+    Base64Encoder encoder(type, limitColumns, columns);
+    QByteArray chunk;
+    chunk.resize(EncodeChunkSize);
+    forever {
+        const qint64 bytesRead = device->read(chunk.data(), EncodeChunkSize);
+        if(bytesRead < 0) {
+            return false;
+        }
+        if(0 == bytesRead) {
+            break;
+        }
+        encoder.encode(chunk.constData(), static_cast<int>(bytesRead), result);
+    }
+    encoder.finish(result);
+    return true ;
 }
 
 QString Base64Utils::loadFromBinaryFile(const EBase64 type, QWidget *window, const QString &filePath, bool &isError, bool &isAbort, const bool limitColumns, const int columns)
@@ -117,7 +338,6 @@ QString Base64Utils::loadFromBinaryFile(const EBase64 type, QWidget *window, con
     isError = true ;
     isAbort = false ;
     QFile file(filePath);
-    QByteArray data ;
     if(file.open(QIODevice::ReadOnly)) {
         qint64 fileSize = file.size();
         if(fileSize > InputSizeLimit) {
@@ -127,16 +347,14 @@ QString Base64Utils::loadFromBinaryFile(const EBase64 type, QWidget *window, con
             }
         }
         if(!isAbort) {
-            data = file.readAll();
-            if(file.error() == QFile::NoError) {
+            if(loadFromBinaryDevice(type, &file, result, limitColumns, columns) && (file.error() == QFile::NoError)) {
                 isError = false ;
             }
         }
         file.close();
         if(isError) {
+            result.clear();
             Utils::error(window, QObject::tr("Error reading file."));
-        } else {
-            result = toBase64(type, data, limitColumns, columns);
         }
     } else {
         Utils::error(window, QString(QObject::tr("Unable to load file.\nError code is '%1'")).arg(file.error()));
@@ -144,7 +362,6 @@ QString Base64Utils::loadFromBinaryFile(const EBase64 type, QWidget *window, con
     return result ;
 }
 
-
 /////------------
 
 bool Base64Utils::saveBase64ToBinaryFile(const EBase64 type, QWidget *window, const QString &text, const QString &fileStartPath)
@@ -179,14 +396,21 @@ bool Base64Utils::saveToBinaryFile(const EBase64 type, QWidget *window, const QS
     return !isError ;
 }
 
+/*!
+ * \brief Base64Utils::saveToBinaryDevice decodes the text in chunks, writing each one
+ */
 bool Base64Utils::saveToBinaryDevice(const EBase64 type, QIODevice *device, const QString &text)
 {
-    bool isOk = true ;
-    QString base64 = specificToStandard(type, text);
-    QByteArray array(base64.toLatin1());
-    QByteArray binaryArray = QByteArray::fromBase64(array);
-    if(-1 == device->write(binaryArray)) {
-        isOk = false ;
+    Base64Decoder decoder(type);
+    QByteArray buffer;
+    buffer.resize(Base64Decoder::maxDecodedLength(DecodeChunkSize));
+    const QChar *data = text.constData();
+    const int length = text.length();
+    for(int index = 0 ; index < length ; index += DecodeChunkSize) {
+        const int decoded = decoder.decode(data + index, qMin(DecodeChunkSize, length - index), buffer.data());
+        if((decoded > 0) && (device->write(buffer.constData(), decoded) != decoded)) {
+            return false;
+        }
     }
-    return isOk;
+    return true;
 }
@@ -30,6 +30,9 @@
 class LIBQXMLEDITSHARED_EXPORT Base64Utils
 {
     static const int InputSizeLimit = 1024 * 1024 ;
+    // multiple of 3 to encode the chunks without padding
+    static const int EncodeChunkSize = 3 * 64 * 1024 ;
+    static const int DecodeChunkSize = 64 * 1024 ;
 
 public:
 
@@ -51,10 +54,52 @@ public:
     QString toBase64(const EBase64 type, const QString &text, const bool limitColumns = false, const int columns = 80);
     QString toBase64(const EBase64 type, const QByteArray &input, const bool limitColumns = false, const int columns = 80);
     QByteArray fromBase64(const EBase64 type, const QString &text);
-protected:
-    static QString standardToSpecific(const EBase64 type, const QString &text);
-    static QString specificToStandard(const EBase64 type, const QString &text);
 
+    bool loadFromBinaryDevice(const EBase64 type, QIODevice *device, QString &result, const bool limitColumns = false, const int columns = 80);
+    static QString decodedTextPrefix(const QString &text, const int maxBytes);
+};
+
+/*!
+ * \brief Base64Encoder encodes data in chunks, the output is appended to a string
+ * without intermediate copies; the lines can be limited in length.
+ */
+class LIBQXMLEDITSHARED_EXPORT Base64Encoder
+{
+    const char *_alphabet;
+    bool _limitColumns;
+    int _columns;
+    int _currentColumn;
+    uchar _pending[2];
+    int _pendingCount;
+
+    QChar *writeQuad(QChar *out, const uint value);
+    QChar *writeChar(QChar *out, const char ch);
+
+public:
+    Base64Encoder(const Base64Utils::EBase64 type, const bool limitColumns = false, const int columns = 80);
+    ~Base64Encoder();
+
+    static int encodedLength(const qint64 dataLength, const bool limitColumns, const int columns);
+    void encode(const char *data, const int length, QString &output);
+    void finish(QString &output);
+};
+
+/*!
+ * \brief Base64Decoder decodes text in chunks, the characters that are not part of
+ * the alphabet (spaces, new lines, padding) are skipped.
+ */
+class LIBQXMLEDITSHARED_EXPORT Base64Decoder
+{
+    const signed char *_table;
+    uint _buffer;
+    int _bits;
+
+public:
+    Base64Decoder(const Base64Utils::EBase64 type);
+    ~Base64Decoder();
+
+    static int maxDecodedLength(const int textLength);
+    int decode(const QChar *text, const int length, char *output);
 };
 
 #endif // BASE64UTILS_H
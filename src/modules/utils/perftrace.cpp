@@ -0,0 +1,178 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#include "perftrace.h"
+#include <QThread>
+#include <QFile>
+#include <QTextStream>
+#include <QMutexLocker>
+
+static QElapsedTimer startClock()
+{
+    QElapsedTimer clock;
+    clock.start();
+    return clock;
+}
+
+// the trace can be enabled from the start to measure the load of the first file
+volatile bool PerfTrace::_isEnabled = !qgetenv("QXMLEDIT_TRACE").isEmpty();
+QElapsedTimer PerfTrace::_clock = startClock();
+QMutex PerfTrace::_mutex;
+QVector<PerfTraceEvent> PerfTrace::_events;
+QHash<QString, qint64> PerfTrace::_counters;
+int PerfTrace::_droppedEvents = 0 ;
+
+PerfTraceSummary::PerfTraceSummary()
+{
+    count = 0 ;
+    totalNs = 0 ;
+    maxNs = 0 ;
+}
+
+void PerfTrace::setEnabled(const bool value)
+{
+    _isEnabled = value ;
+}
+
+qint64 PerfTrace::nowNs()
+{
+    return _clock.nsecsElapsed();
+}
+
+void PerfTrace::addEvent(const char *category, const char *name, const qint64 startNs, const qint64 durationNs)
+{
+    PerfTraceEvent event;
+    event.category = category ;
+    event.name = name ;
+    event.startNs = startNs ;
+    event.durationNs = durationNs ;
+    event.threadId = static_cast<quint64>(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+    QMutexLocker lock(&_mutex);
+    if(_events.size() >= MaxEvents) {
+        _droppedEvents ++ ;
+        return ;
+    }
+    _events.append(event);
+}
+
+void PerfTrace::addToCounter(const char *name, const qint64 delta)
+{
+    QMutexLocker lock(&_mutex);
+    _counters[QLatin1String(name)] += delta ;
+}
+
+void PerfTrace::clear()
+{
+    QMutexLocker lock(&_mutex);
+    _events.clear();
+    _counters.clear();
+    _droppedEvents = 0 ;
+}
+
+QList<PerfTraceSummary> PerfTrace::summary()
+{
+    QHash<QString, int> indexes;
+    QList<PerfTraceSummary> result;
+    QMutexLocker lock(&_mutex);
+    foreach(const PerfTraceEvent &event, _events) {
+        const QString key = QString("%1/%2").arg(event.category).arg(event.name);
+        int index = indexes.value(key, -1);
+        if(index < 0) {
+            index = result.size();
+            indexes.insert(key, index);
+            PerfTraceSummary newSummary;
+            newSummary.category = event.category ;
+            newSummary.name = event.name ;
+            result.append(newSummary);
+        }
+        PerfTraceSummary &item = result[index];
+        item.count ++ ;
+        item.totalNs += event.durationNs ;
+        item.maxNs = qMax(item.maxNs, event.durationNs);
+    }
+    return result;
+}
+
+QHash<QString, qint64> PerfTrace::counters()
+{
+    QMutexLocker lock(&_mutex);
+    return _counters ;
+}
+
+int PerfTrace::eventsCount()
+{
+    QMutexLocker lock(&_mutex);
+    return _events.size();
+}
+
+int PerfTrace::droppedEvents()
+{
+    QMutexLocker lock(&_mutex);
+    return _droppedEvents;
+}
+
+/*!
+ * \brief PerfTrace::toChromeTrace the format read by chrome://tracing and by Perfetto:
+ * zones are complete events, the counters are written with their final value.
+ */
+QByteArray PerfTrace::toChromeTrace()
+{
+    QString json;
+    QTextStream stream(&json);
+    const qint64 now = nowNs();
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    QMutexLocker lock(&_mutex);
+    bool isFirst = true;
+    foreach(const PerfTraceEvent &event, _events) {
+        stream << (isFirst ? "\n" : ",\n");
+        isFirst = false;
+        stream << "{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+               << "\",\"ph\":\"X\",\"ts\":" << QString::number(event.startNs / 1000.0, 'f', 3)
+               << ",\"dur\":" << QString::number(event.durationNs / 1000.0, 'f', 3)
+               << ",\"pid\":1,\"tid\":" << event.threadId << "}";
+    }
+    QHashIterator<QString, qint64> counter(_counters);
+    while(counter.hasNext()) {
+        counter.next();
+        stream << (isFirst ? "\n" : ",\n");
+        isFirst = false;
+        stream << "{\"name\":\"" << counter.key() << "\",\"ph\":\"C\",\"ts\":" << QString::number(now / 1000.0, 'f', 3)
+               << ",\"pid\":1,\"args\":{\"value\":" << counter.value() << "}}";
+    }
+    stream << "\n]}\n";
+    stream.flush();
+    return json.toUtf8();
+}
+
+bool PerfTrace::writeChromeTrace(const QString &filePath)
+{
+    QFile file(filePath);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const QByteArray data = toChromeTrace();
+    const bool isOk = (file.write(data) == data.size());
+    file.close();
+    return isOk && (QFile::NoError == file.error());
+}
@@ -0,0 +1,116 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef PERFTRACE_H
+#define PERFTRACE_H
+
+#include "xmlEdit.h"
+#include "libQXmlEdit_global.h"
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QVector>
+#include <QHash>
+
+/*!
+ * Scoped zones and counters to see where the time goes in a running instance.
+ * When the trace is disabled, a zone costs the test of a flag.
+ * The names must be string literals: they are stored as pointers.
+ */
+#define QXMLEDIT_TRACE_ZONE(category, name) PerfTraceZone perfTraceZone(category, name)
+#define QXMLEDIT_TRACE_COUNTER(name, delta) do { if(PerfTrace::isEnabled()) { PerfTrace::addToCounter(name, delta); } } while(false)
+
+class LIBQXMLEDITSHARED_EXPORT PerfTraceEvent
+{
+public:
+    const char *category;
+    const char *name;
+    qint64 startNs;
+    qint64 durationNs;
+    quint64 threadId;
+};
+
+class LIBQXMLEDITSHARED_EXPORT PerfTraceSummary
+{
+public:
+    QString category;
+    QString name;
+    int count;
+    qint64 totalNs;
+    qint64 maxNs;
+
+    PerfTraceSummary();
+};
+
+class LIBQXMLEDITSHARED_EXPORT PerfTrace
+{
+    static volatile bool _isEnabled;
+    static QElapsedTimer _clock;
+    static QMutex _mutex;
+    static QVector<PerfTraceEvent> _events;
+    static QHash<QString, qint64> _counters;
+    static int _droppedEvents;
+
+public:
+    static const int MaxEvents = 200000 ;
+
+    static bool isEnabled()
+    {
+        return _isEnabled ;
+    }
+    static void setEnabled(const bool value);
+    static qint64 nowNs();
+    static void addEvent(const char *category, const char *name, const qint64 startNs, const qint64 durationNs);
+    static void addToCounter(const char *name, const qint64 delta);
+    static void clear();
+
+    static QList<PerfTraceSummary> summary();
+    static QHash<QString, qint64> counters();
+    static int eventsCount();
+    static int droppedEvents();
+    static QByteArray toChromeTrace();
+    static bool writeChromeTrace(const QString &filePath);
+};
+
+class LIBQXMLEDITSHARED_EXPORT PerfTraceZone
+{
+    const char *_category;
+    const char *_name;
+    qint64 _startNs;
+
+public:
+    PerfTraceZone(const char *category, const char *name)
+    {
+        _category = category ;
+        _name = name ;
+        _startNs = PerfTrace::isEnabled() ? PerfTrace::nowNs() : -1 ;
+    }
+    ~PerfTraceZone()
+    {
+        if(_startNs >= 0) {
+            PerfTrace::addEvent(_category, _name, _startNs, PerfTrace::nowNs() - _startNs);
+        }
+    }
+};
+
+#endif // PERFTRACE_H
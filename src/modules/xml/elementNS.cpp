@@ -21,10 +21,59 @@
  **************************************************************************/
 
 #include "element.h"
+#include "regola.h"
 #include "xmlutils.h"
+#include "modules/xml/namespacescope.h"
+
+/*!
+ * \brief the scope of the namespaces visible in this element, built on demand and shared
+ * with the descendants that do not declare namespaces; NULL if the element is not in a document.
+ */
+const NamespaceScope *Element::namespaceScope()
+{
+    if(NULL == parentRule) {
+        return NULL ;
+    }
+    NamespaceScopeTable *table = parentRule->namespaceScopes();
+    if((NULL != _namespaceScope) && (_namespaceScopeGeneration == table->generation())) {
+        return _namespaceScope ;
+    }
+    const NamespaceScope *parentScope = NULL ;
+    if(NULL != parentElement) {
+        parentScope = parentElement->namespaceScope();
+    }
+    if(NULL == parentScope) {
+        parentScope = table->emptyScope();
+    }
+    QList<QPair<QString, QString> > declarations;
+    foreach(Attribute * attribute, attributes) {
+        QString prefix ;
+        if(XmlUtils::getNsPrefix(attribute->name, prefix)) {
+            declarations.append(QPair<QString, QString>(prefix, attribute->value));
+        }
+    }
+    if(declarations.isEmpty()) {
+        _namespaceScope = parentScope ;
+    } else {
+        _namespaceScope = table->newScope(parentScope, declarations);
+    }
+    _namespaceScopeGeneration = table->generation();
+    return _namespaceScope ;
+}
+
+void Element::namespacesChanged()
+{
+    if(NULL != parentRule) {
+        parentRule->invalidateNamespaceScopes();
+    }
+}
 
 QString Element::namespaceForPrefix(const QString &prefix)
 {
+    const NamespaceScope *scope = namespaceScope();
+    if(NULL != scope) {
+        return scope->namespaceForPrefix(prefix);
+    }
     Element *element = this ;
     while(NULL != element) {
         Attribute *declaration = element->nsDeclarationForPrefixOwned(prefix);
@@ -90,6 +139,10 @@ bool Element::areChildrenUsingPrefix(const QString &prefix)
  */
 bool Element::findPrefixForNamespace(const QString nsToSearch, QString &prefixToSet)
 {
+    const NamespaceScope *scope = namespaceScope();
+    if(NULL != scope) {
+        return scope->findPrefixForNamespace(nsToSearch, prefixToSet);
+    }
     QSet<QString> nss;
     Element *element = this ;
     while(NULL != element) {
@@ -118,6 +171,10 @@ bool Element::findPrefixForNamespace(const QString nsToSearch, QString &prefixTo
 
 QHash<QString, QString> Element::findVisibleNamespaces()
 {
+    const NamespaceScope *scope = namespaceScope();
+    if(NULL != scope) {
+        return scope->visibleNamespaces();
+    }
     QHash<QString, QString> nss;
     Element *element = this ;
     while(NULL != element) {
@@ -172,7 +172,7 @@ void Element::getVisInfo(PaintInfo *paintInfo, ElementViewInfo *dataInfo,
                         if(!textToShowBase64.isEmpty()) {
                             textToShowBase64.append("\n ---\n");
                         }
-                        textToShowBase64.append(limitLargeTextWithEllipsis(Utils::fromBase64(tx->text)));
+                        textToShowBase64.append(limitLargeTextWithEllipsis(tx->decodedBase64Preview()));
                     }
                     textToShow.append(limitLargeTextWithEllipsis(tx->text.simplified()));
                 } else {
@@ -180,7 +180,7 @@ void Element::getVisInfo(PaintInfo *paintInfo, ElementViewInfo *dataInfo,
                         if(!textToShowBase64.isEmpty()) {
                             textToShowBase64.append("\n ---\n");
                         }
-                        textToShowBase64.append(limitLargeTextWithEllipsis(Utils::fromBase64(tx->text)));
+                        textToShowBase64.append(limitLargeTextWithEllipsis(tx->decodedBase64Preview()));
                     }
                     textToShow.append(limitLargeTextWithEllipsis(tx->text));
                 }
@@ -0,0 +1,132 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+#include "namespacescope.h"
+#include "xmlEdit.h"
+#include <QSet>
+
+NamespaceScope::NamespaceScope(const NamespaceScope *newParent, const QList<QPair<QString, QString> > &declarations)
+{
+    _parent = newParent ;
+    _declarations = declarations ;
+    if(NULL != _parent) {
+        _visible = _parent->_visible ;
+    }
+    // the first declaration of a prefix in the element wins
+    const int count = _declarations.size();
+    for(int index = count - 1 ; index >= 0 ; index --) {
+        const QPair<QString, QString> &declaration = _declarations.at(index);
+        _visible.insert(declaration.first, declaration.second);
+    }
+}
+
+NamespaceScope::~NamespaceScope()
+{
+}
+
+const NamespaceScope *NamespaceScope::parent() const
+{
+    return _parent ;
+}
+
+const QList<QPair<QString, QString> > &NamespaceScope::declarations() const
+{
+    return _declarations ;
+}
+
+QString NamespaceScope::namespaceForPrefix(const QString &prefix) const
+{
+    QHash<QString, QString>::const_iterator it = _visible.find(prefix);
+    if(it != _visible.end()) {
+        return it.value();
+    }
+    return QString();
+}
+
+/*!
+ * \brief the nearest declaration of the namespace whose prefix is not shadowed by a nearer one
+ */
+bool NamespaceScope::findPrefixForNamespace(const QString &nsToSearch, QString &prefixToSet) const
+{
+    QSet<QString> shadowed;
+    const NamespaceScope *scope = this ;
+    while(NULL != scope) {
+        typedef QPair<QString, QString> Declaration;
+        foreach(const Declaration & declaration, scope->_declarations) {
+            if(!shadowed.contains(declaration.first)) {
+                if(declaration.second == nsToSearch) {
+                    prefixToSet = declaration.first ;
+                    return true ;
+                }
+                shadowed.insert(declaration.first);
+            }
+        }
+        scope = scope->_parent ;
+    }
+    return false;
+}
+
+QHash<QString, QString> NamespaceScope::visibleNamespaces() const
+{
+    return _visible ;
+}
+
+//-------------------------------------------------------------------
+
+NamespaceScopeTable::NamespaceScopeTable() : _emptyScope(NULL, QList<QPair<QString, QString> >())
+{
+    _generation = 1 ;
+}
+
+NamespaceScopeTable::~NamespaceScopeTable()
+{
+    EMPTYPTRLIST(_scopes, NamespaceScope);
+}
+
+int NamespaceScopeTable::generation() const
+{
+    return _generation ;
+}
+
+void NamespaceScopeTable::invalidate()
+{
+    _generation++;
+    EMPTYPTRLIST(_scopes, NamespaceScope);
+}
+
+const NamespaceScope *NamespaceScopeTable::emptyScope() const
+{
+    return &_emptyScope ;
+}
+
+const NamespaceScope *NamespaceScopeTable::newScope(const NamespaceScope *parent, const QList<QPair<QString, QString> > &declarations)
+{
+    NamespaceScope *scope = new NamespaceScope(parent, declarations);
+    _scopes.append(scope);
+    return scope ;
+}
+
+int NamespaceScopeTable::scopesCount() const
+{
+    return _scopes.size();
+}
@@ -0,0 +1,80 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef NAMESPACESCOPE_H
+#define NAMESPACESCOPE_H
+
+#include <QString>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include "libQXmlEdit_global.h"
+
+/**
+  \brief The namespaces visible in an element. A scope is immutable and is created
+  only where an element declares namespaces, the other elements share the scope
+  of the nearest declaring ancestor.
+  */
+class LIBQXMLEDITSHARED_EXPORT NamespaceScope
+{
+    const NamespaceScope *_parent;
+    // prefix and namespace, in the order of the attributes
+    QList<QPair<QString, QString> > _declarations;
+    // prefix to namespace, shared with the parent up to the first declaration
+    QHash<QString, QString> _visible;
+
+public:
+    NamespaceScope(const NamespaceScope *newParent, const QList<QPair<QString, QString> > &declarations);
+    ~NamespaceScope();
+
+    const NamespaceScope *parent() const;
+    const QList<QPair<QString, QString> > &declarations() const;
+    QString namespaceForPrefix(const QString &prefix) const;
+    bool findPrefixForNamespace(const QString &nsToSearch, QString &prefixToSet) const;
+    QHash<QString, QString> visibleNamespaces() const;
+};
+
+/**
+  \brief Owns the scopes of a document. When the namespace declarations or the structure
+  of the document change, all the scopes are discarded: the elements compare the generation
+  of their scope with the current one and rebuild it on demand.
+  */
+class LIBQXMLEDITSHARED_EXPORT NamespaceScopeTable
+{
+    int _generation;
+    NamespaceScope _emptyScope;
+    QList<NamespaceScope*> _scopes;
+
+public:
+    NamespaceScopeTable();
+    ~NamespaceScopeTable();
+
+    int generation() const;
+    void invalidate();
+    const NamespaceScope *emptyScope() const;
+    const NamespaceScope *newScope(const NamespaceScope *parent, const QList<QPair<QString, QString> > &declarations);
+    int scopesCount() const;
+};
+
+#endif // NAMESPACESCOPE_H
@@ -0,0 +1,105 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#include "xmlbackgroundloader.h"
+#include "regola.h"
+#include "modules/xml/xmlloadcontext.h"
+#include <QProgressDialog>
+#include <QFutureWatcher>
+#include <QTimer>
+
+XMLBackgroundLoader::XMLBackgroundLoader(Regola *regola, XMLLoadContext *context, QXmlStreamReader *xmlReader)
+{
+    _regola = regola ;
+    _context = context ;
+    _xmlReader = xmlReader ;
+    _totalSize = 0 ;
+    _progressDialog = NULL ;
+    QIODevice *device = _xmlReader->device();
+    if(NULL != device) {
+        _totalSize = device->size();
+    }
+}
+
+XMLBackgroundLoader::~XMLBackgroundLoader()
+{
+}
+
+/*!
+ * \brief XMLBackgroundLoader::isBackgroundLoad a stream is read in background if its size is known and
+ * it is at least the threshold; small streams are faster to read directly.
+ */
+bool XMLBackgroundLoader::isBackgroundLoad(QXmlStreamReader *xmlReader, const qint64 threshold)
+{
+    QIODevice *device = xmlReader->device();
+    if((NULL == device) || device->isSequential()) {
+        return false;
+    }
+    return device->size() >= threshold ;
+}
+
+bool XMLBackgroundLoader::readInWorkerThread()
+{
+    return _regola->readFromStream(_context, _xmlReader);
+}
+
+/*!
+ * \brief XMLBackgroundLoader::load reads the stream and waits for the end showing the progress
+ * \return the result of Regola::readFromStream
+ */
+bool XMLBackgroundLoader::load(QWidget *parent, const QString &filePath)
+{
+    QProgressDialog progressDialog(tr("Loading file %1").arg(filePath), tr("Abort"), 0, 100, parent);
+    progressDialog.setWindowTitle(tr("Loading Data"));
+    progressDialog.setModal(true);
+    progressDialog.setAutoClose(false);
+    progressDialog.setAutoReset(false);
+    progressDialog.setMinimumDuration(0);
+    _progressDialog = &progressDialog ;
+
+    QTimer progressTimer;
+    connect(&progressTimer, SIGNAL(timeout()), this, SLOT(onProgress()));
+    QFutureWatcher<bool> loadWatcher;
+    connect(&loadWatcher, SIGNAL(finished()), &progressDialog, SLOT(accept()));
+    QFuture<bool> future = QtConcurrent::run(this, &XMLBackgroundLoader::readInWorkerThread);
+    loadWatcher.setFuture(future);
+    progressTimer.start(ProgressInterval);
+    progressDialog.exec();
+    progressTimer.stop();
+    disconnect(&loadWatcher, SIGNAL(finished()), &progressDialog, SLOT(accept()));
+    if(progressDialog.wasCanceled()) {
+        _context->setAborted();
+    }
+    future.waitForFinished();
+    _progressDialog = NULL ;
+    return future.result();
+}
+
+void XMLBackgroundLoader::onProgress()
+{
+    if((NULL != _progressDialog) && (_totalSize > 0)) {
+        const qint64 bytesRead = _context->bytesRead();
+        _progressDialog->setValue((int)((bytesRead * 100) / _totalSize));
+    }
+}
@@ -0,0 +1,70 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef XMLBACKGROUNDLOADER_H
+#define XMLBACKGROUNDLOADER_H
+
+#include "xmlEdit.h"
+#include "libQXmlEdit_global.h"
+
+class Regola;
+class XMLLoadContext;
+class QProgressDialog;
+
+/**
+  \brief builds a model reading the stream in a worker thread while the calling window shows the progress
+  of the bytes read. The user can abort the loading: the model keeps the part read until then
+  and the context reports the abort as an error, so the caller can offer to open it anyway.
+  The model is created by the caller and returned filled, no data are copied between the threads.
+  */
+class LIBQXMLEDITSHARED_EXPORT XMLBackgroundLoader : public QObject
+{
+    Q_OBJECT
+
+    Regola *_regola;
+    XMLLoadContext *_context;
+    QXmlStreamReader *_xmlReader;
+    qint64 _totalSize;
+    QProgressDialog *_progressDialog;
+
+    bool readInWorkerThread();
+
+public:
+    enum {
+        BackgroundLoadThreshold = 4 * 1024 * 1024,
+        ProgressInterval = 200
+    };
+
+    XMLBackgroundLoader(Regola *regola, XMLLoadContext *context, QXmlStreamReader *xmlReader);
+    ~XMLBackgroundLoader();
+
+    bool load(QWidget *parent, const QString &filePath);
+
+    static bool isBackgroundLoad(QXmlStreamReader *xmlReader, const qint64 threshold);
+
+private slots:
+    void onProgress();
+};
+
+#endif // XMLBACKGROUNDLOADER_H
@@ -26,6 +26,8 @@
 #include "undo/elupdateelementcommand.h"
 #include "xmlsavecontext.h"
 #include "modules/xml/xmlloadcontext.h"
+#include "modules/xml/xmlsourcemap.h"
+#include "modules/utils/perftrace.h"
 
 //--------------------------------------------------
 
@@ -77,7 +79,7 @@ XMLLoadErrorHandler::~XMLLoadErrorHandler()
 
 Element *Regola::assegnaValori(QDomNode &node, Element *parent, QVector<Element*> *collection)
 {
-    _isCrapCacheNSActivated = false;
+    _namespaceScopes.invalidate();
     D(printf("sono in assegna \n"));
     int nodi = node.childNodes().count();
     // this it the only legal root item
@@ -193,7 +195,7 @@ Element *Regola::assegnaValori(QDomNode &node, Element *parent, QVector<Element*
 bool Regola::setChildrenTreeFromStream(XMLLoadContext *context, QXmlStreamReader *xmlReader,
                                        Element *parent, QVector<Element*> *collection, const bool isTopLevel)
 {
-    _isCrapCacheNSActivated = false;
+    _namespaceScopes.invalidate();
     // this it the only legal root item
     bool isMixedContent = false ;
     if(_useMixedContent) {
@@ -206,10 +208,14 @@ bool Regola::setChildrenTreeFromStream(XMLLoadContext *context, QXmlStreamReader
     int nodeIndex = -1 ;
     while(!xmlReader->atEnd()) {
         nodeIndex++;
+        const qint64 tokenStart = xmlReader->characterOffset();
         xmlReader->readNext();
         if(xmlReader->hasError()) {
             return context->setErrorFromReader(xmlReader);
         }
+        if(!context->checkProgress(xmlReader)) {
+            return context->setError(tr("Loading aborted by the user."), xmlReader);
+        }
         D(printf("trovato %d \n", xmlReader->tokenType()));
         switch(xmlReader->tokenType()) {
         default:
@@ -219,6 +225,9 @@ bool Regola::setChildrenTreeFromStream(XMLLoadContext *context, QXmlStreamReader
         case QXmlStreamReader::DTD:
             setDocType(xmlReader->dtdName().toString(), xmlReader->dtdSystemId().toString(), xmlReader->dtdPublicId().toString(), xmlReader->text().toString());
             context->setIsAfterDTD(true);
+            if(NULL != _sourceMap) {
+                _sourceMap->setDtdRange(tokenStart, xmlReader->characterOffset());
+            }
             D(printf("DTD:%s", xmlReader->text().toString().toLatin1().data());)
             break;
         case QXmlStreamReader::StartDocument: {
@@ -235,6 +244,9 @@ bool Regola::setChildrenTreeFromStream(XMLLoadContext *context, QXmlStreamReader
             break;
         case QXmlStreamReader::EndElement:
             if(!isTopLevel) {
+                if(NULL != _sourceMap) {
+                    _sourceMap->setElementEnd(parent, tokenStart, xmlReader->characterOffset());
+                }
                 if(!isMixedContent) {
                     parent->handleMixedContentToInnerText();
                 }
@@ -246,22 +258,26 @@ bool Regola::setChildrenTreeFromStream(XMLLoadContext *context, QXmlStreamReader
             break;
         case QXmlStreamReader::StartElement: {
             context->setFirstElementSeen(true);
-            const QString qualifiedName = xmlReader->qualifiedName().toString();
             Element *elem = NULL ;
             bool isExistingForSample = false;
+            bool isSampleChanged = false;
+            XMLSampleNode *sampleNode = NULL ;
             if(context->isSample()) {
-                const QString path = Utils::pathFromParent(parent, qualifiedName);
-                D(printf("  look for path: %s\n", path.toLatin1().data());)
-                if(!context->existsPath(path)) {
+                // the path is followed in the tree of the sample, no string is built for the known ones
+                XMLSampleNode *sampleParent = context->sampleCurrent();
+                sampleNode = sampleParent->findChild(xmlReader->qualifiedName());
+                if(NULL == sampleNode) {
+                    const QString qualifiedName = xmlReader->qualifiedName().toString();
                     elem = new Element(addNameToPool(qualifiedName), "", this, parent) ;
                     collection->append(elem);
-                    context->setElementByPath(path, elem);
+                    sampleNode = sampleParent->addChild(elem);
+                    context->sampleChanged();
                     D(printf("  NEW ELEM: %s\n", qualifiedName.toLatin1().data());)
                 } else {
                     isExistingForSample = true;
-                    D(printf("  RECALL : %s\n", qualifiedName.toLatin1().data());)
+                    elem = sampleNode->element();
+                    D(printf("  RECALL : %s\n", elem->tag().toLatin1().data());)
                 }
-                elem = context->getElementByPath(path);
                 parent = elem->parent();
                 if(NULL != parent) {
                     hasText = parent->hasText();
@@ -270,34 +286,50 @@ bool Regola::setChildrenTreeFromStream(XMLLoadContext *context, QXmlStreamReader
                 }
                 D(printf("  Situazione: %s parent hasText:%d\n", elem->tag().toLatin1().data(), hasText);)
             } else {
-                elem = new Element(addNameToPool(qualifiedName), "", this, parent) ;
+                elem = new Element(addNameToPool(xmlReader->qualifiedName().toString()), "", this, parent) ;
                 collection->append(elem);
             }
 
             QXmlStreamAttributes streamAttributes = xmlReader->attributes();
             foreach(QXmlStreamAttribute streamAttribute, streamAttributes) {
-                const QString attributeName = streamAttribute.qualifiedName().toString();
-                bool canAdd = true ;
                 if(isExistingForSample) {
-                    canAdd = !elem->hasAttribute(attributeName);
-                    if(!canAdd) {
-                        if(elem->getAttributeValue(attributeName).isEmpty()) {
-                            elem->setAttribute(attributeName, streamAttribute.value().toString());
+                    Attribute *existing = findSampleAttribute(elem, streamAttribute.qualifiedName());
+                    if(NULL != existing) {
+                        if(existing->value.isEmpty()) {
+                            existing->value = streamAttribute.value().toString();
                         }
+                        continue;
                     }
+                    isSampleChanged = true ;
+                    context->sampleChanged();
                 }
-                if(canAdd) {
-                    Attribute *attribute = new Attribute(
-                        getAttributeNameString(attributeName),
-                        getAttributeString(streamAttribute.value().toString()));
-                    elem->attributes.append(attribute);
-                }
+                Attribute *attribute = new Attribute(
+                    getAttributeNameString(streamAttribute.qualifiedName().toString()),
+                    getAttributeString(streamAttribute.value().toString()));
+                elem->attributes.append(attribute);
+            }
+            if(NULL != _sourceMap) {
+                _sourceMap->setElementStart(elem, tokenStart, xmlReader->characterOffset());
+            }
+            // an element of the sample that did not get new attributes
+            if(isExistingForSample && !isSampleChanged) {
+                context->sampleUnchanged();
             }
             D(printf(" add child %d %s\n", i, elem.tag().toLatin1().data()));
+            if(NULL != sampleNode) {
+                context->setSampleCurrent(sampleNode);
+            }
             if(!setChildrenTreeFromStream(context, xmlReader, elem, elem->getChildItems(), false)) {
                 return false;
             }
+            if(NULL != sampleNode) {
+                context->setSampleCurrent(sampleNode->parent());
+            }
             isMixedContent = true ;
+            // the sample does not change anymore, the rest of the file is not read
+            if(context->isSampleComplete()) {
+                return true ;
+            }
         }
         break;
         case QXmlStreamReader::Characters:
@@ -310,6 +342,9 @@ bool Regola::setChildrenTreeFromStream(XMLLoadContext *context, QXmlStreamReader
                     hasText = true ;
                 }
                 assignMixedContentText(parent, xmlReader->text().toString(), xmlReader->isCDATA(), collection);
+                if(NULL != _sourceMap) {
+                    _sourceMap->setItemRange(collection->last(), tokenStart, xmlReader->characterOffset());
+                }
             }
             break;
         case QXmlStreamReader::ProcessingInstruction: {
@@ -318,6 +353,9 @@ bool Regola::setChildrenTreeFromStream(XMLLoadContext *context, QXmlStreamReader
                 procInstr->setPIData(xmlReader->processingInstructionData().toString());
                 procInstr->setPITarget(xmlReader->processingInstructionTarget().toString());
                 collection->append(procInstr);
+                if(NULL != _sourceMap) {
+                    _sourceMap->setItemRange(procInstr, tokenStart, xmlReader->characterOffset());
+                }
                 isMixedContent = true ;
             }
         }
@@ -327,6 +365,9 @@ bool Regola::setChildrenTreeFromStream(XMLLoadContext *context, QXmlStreamReader
                 Element *comment = new Element(this, Element::ET_COMMENT, parent) ;
                 comment->setText(xmlReader->text().toString());
                 collection->append(comment);
+                if(NULL != _sourceMap) {
+                    _sourceMap->setItemRange(comment, tokenStart, xmlReader->characterOffset());
+                }
                 if(!context->firstElementSeen() && !context->isAfterDTD()) {
                     context->addFirstComment(comment);
                 }
@@ -335,8 +376,8 @@ bool Regola::setChildrenTreeFromStream(XMLLoadContext *context, QXmlStreamReader
         }
         break;
         case QXmlStreamReader::EntityReference:
-            Utils::error(tr("This XML contanins an entity reference.\nEntity references are not supported at the moment."));
-            return false;
+            // the model can be built outside the GUI thread, the message is shown by the caller
+            return context->setError(tr("This XML contanins an entity reference.\nEntity references are not supported at the moment."), xmlReader);
             break;
         } //if
     }//for
@@ -345,10 +386,36 @@ bool Regola::setChildrenTreeFromStream(XMLLoadContext *context, QXmlStreamReader
 }//setChildrenTreeFromStream()
 
 
+/*!
+ * \brief Regola::findSampleAttribute finds an attribute of an element of a sample comparing the name
+ * with the one in the buffer of the reader
+ */
+Attribute *Regola::findSampleAttribute(Element *element, const QStringRef &name)
+{
+    foreach(Attribute * attribute, element->attributes) {
+        if(name == attribute->name) {
+            return attribute;
+        }
+    }
+    return NULL ;
+}
+
 bool Regola::readFromStream(XMLLoadContext *context, QXmlStreamReader *xmlReader)
 {
+    QXMLEDIT_TRACE_ZONE("load", "readFromStream");
     xmlReader->setNamespaceProcessing(false);
+    deleteSourceMap();
+    // the file is hashed while it is parsed, the reader gets back its device at the end
+    QIODevice *sourceDevice = xmlReader->device();
+    XmlSourceHashDevice hashDevice(sourceDevice);
+    if(context->isRecordSourceRanges() && !context->isSample() && hashDevice.openSource()) {
+        _sourceMap = new XmlSourceMap();
+        xmlReader->setDevice(&hashDevice);
+    }
     bool result = setChildrenTreeFromStream(context, xmlReader, NULL, &childItems, true);
+    if(xmlReader->device() == &hashDevice) {
+        xmlReader->setDevice(sourceDevice);
+    }
     foreach(Element * child, childItems) {
         if(child->isElement()) {
             rootItem = child;
@@ -363,11 +430,17 @@ bool Regola::readFromStream(XMLLoadContext *context, QXmlStreamReader *xmlReader
             result = false;
         }
         if(!filterCommentsAfterReading(context)) {
+            deleteSourceMap();
             return false;
         }
         checkEncoding(true);
         checkValidationReference();
     }
+    if(NULL != _sourceMap) {
+        if(!result || !_sourceMap->completeLoad(this, sourceDevice, hashDevice.result(), context->encoding())) {
+            deleteSourceMap();
+        }
+    }
     return result;
 }
 
@@ -458,6 +531,9 @@ bool Regola::decodePreamble(QXmlStreamReader *xmlReader, const QString &inputEnc
         procInstr->setPIData(data);
         procInstr->setPITarget(target);
         childItems.insert(0, procInstr);
+        if(NULL != _sourceMap) {
+            _sourceMap->setItemRange(procInstr, startIndex, endIndex + 2);
+        }
         //printf("%s\n", data.toLatin1().data());
     }
     //delete codec;
@@ -22,6 +22,63 @@
 
 
 #include "xmlloadcontext.h"
+#include "element.h"
+
+XMLSampleNode::XMLSampleNode(XMLSampleNode *parent, Element *element)
+{
+    _parent = parent ;
+    _element = element ;
+    _lastChild = 0 ;
+}
+
+XMLSampleNode::~XMLSampleNode()
+{
+    EMPTYPTRLIST(_children, XMLSampleNode);
+}
+
+XMLSampleNode *XMLSampleNode::parent()
+{
+    return _parent ;
+}
+
+Element *XMLSampleNode::element()
+{
+    return _element ;
+}
+
+/*!
+ * \brief XMLSampleNode::findChild finds the child with the tag without building strings,
+ * the last child found is tried first because the same tag is usually repeated
+ */
+XMLSampleNode *XMLSampleNode::findChild(const QStringRef &tag)
+{
+    const int count = _children.size();
+    if(0 == count) {
+        return NULL ;
+    }
+    XMLSampleNode *last = _children.at(_lastChild);
+    if(tag == last->_element->tag()) {
+        return last ;
+    }
+    FORINT(i, count) {
+        XMLSampleNode *child = _children.at(i);
+        if(tag == child->_element->tag()) {
+            _lastChild = i ;
+            return child ;
+        }
+    }
+    return NULL ;
+}
+
+XMLSampleNode *XMLSampleNode::addChild(Element *element)
+{
+    XMLSampleNode *child = new XMLSampleNode(this, element);
+    _lastChild = _children.size();
+    _children.append(child);
+    return child ;
+}
+
+//----
 
 XMLLoadContext::XMLLoadContext()
 {
@@ -32,10 +89,22 @@ XMLLoadContext::XMLLoadContext()
     _column = -1 ;
     _characterOffset = -1 ;
     _isSample = false;
+    _sampleRoot = NULL ;
+    _sampleCurrent = NULL ;
+    _sampleStopUnchanged = 0 ;
+    _sampleUnchangedCount = 0 ;
+    _isSampleComplete = false ;
+    _isRecordSourceRanges = false;
+    _isAborted = false;
+    _bytesRead = 0 ;
+    _tokensToProgress = ProgressTokens ;
 }
 
 XMLLoadContext::~XMLLoadContext()
 {
+    if(NULL != _sampleRoot) {
+        delete _sampleRoot ;
+    }
 }
 
 //----
@@ -171,22 +240,97 @@ void XMLLoadContext::setSample(bool value)
     _isSample = value;
 }
 
-bool XMLLoadContext::existsPath(const QString &path)
+bool XMLLoadContext::isRecordSourceRanges() const
 {
-    const bool result = _elementsByPath.contains(path);
-    return result ;
+    return _isRecordSourceRanges;
 }
 
-void XMLLoadContext::setElementByPath(const QString &path, Element *element)
+void XMLLoadContext::setRecordSourceRanges(const bool value)
 {
-    _elementsByPath.insert(path, element);
+    _isRecordSourceRanges = value;
 }
 
-Element *XMLLoadContext::getElementByPath(const QString &path)
+/*!
+ * \brief XMLLoadContext::sampleCurrent is the node of the element being read, it follows the depth of the reader
+ */
+XMLSampleNode *XMLLoadContext::sampleCurrent()
 {
-    if(existsPath(path)) {
-        return _elementsByPath[path];
+    if(NULL == _sampleRoot) {
+        _sampleRoot = new XMLSampleNode(NULL, NULL);
+        _sampleCurrent = _sampleRoot ;
     }
-    return NULL;
+    return _sampleCurrent;
 }
 
+void XMLLoadContext::setSampleCurrent(XMLSampleNode *node)
+{
+    _sampleCurrent = node ;
+}
+
+int XMLLoadContext::sampleStopUnchanged() const
+{
+    return _sampleStopUnchanged;
+}
+
+/*!
+ * \brief XMLLoadContext::setSampleStopUnchanged stops the reading of a sample after a number
+ * of elements that do not add anything to it, 0 reads all the file
+ */
+void XMLLoadContext::setSampleStopUnchanged(const int elements)
+{
+    _sampleStopUnchanged = elements ;
+}
+
+bool XMLLoadContext::isSampleComplete() const
+{
+    return _isSampleComplete;
+}
+
+void XMLLoadContext::sampleChanged()
+{
+    _sampleUnchangedCount = 0 ;
+}
+
+void XMLLoadContext::sampleUnchanged()
+{
+    _sampleUnchangedCount++;
+    if((_sampleStopUnchanged > 0) && (_sampleUnchangedCount >= _sampleStopUnchanged)) {
+        _isSampleComplete = true ;
+    }
+}
+
+bool XMLLoadContext::isAborted()
+{
+    QMutexLocker lock(&_progressMutex);
+    return _isAborted;
+}
+
+void XMLLoadContext::setAborted()
+{
+    QMutexLocker lock(&_progressMutex);
+    _isAborted = true ;
+}
+
+qint64 XMLLoadContext::bytesRead()
+{
+    QMutexLocker lock(&_progressMutex);
+    return _bytesRead;
+}
+
+/*!
+ * \brief XMLLoadContext::checkProgress is called for every token read, once every ProgressTokens tokens
+ * publishes the position in the input and looks for an abort request
+ * \return false if the loading must stop
+ */
+bool XMLLoadContext::checkProgress(QXmlStreamReader *xmlReader)
+{
+    if(--_tokensToProgress > 0) {
+        return true ;
+    }
+    _tokensToProgress = ProgressTokens ;
+    QIODevice *device = xmlReader->device();
+    const qint64 position = (NULL != device) ? device->pos() : xmlReader->characterOffset();
+    QMutexLocker lock(&_progressMutex);
+    _bytesRead = position ;
+    return !_isAborted;
+}
@@ -26,9 +26,30 @@
 
 #include "xmlEdit.h"
 #include "libQXmlEdit_global.h"
+#include <QMutex>
 
 class Element ;
 
+/*!
+ * \brief XMLSampleNode is a node of the tree of the paths seen loading a sample,
+ * the children are matched by the pooled tag of their element
+ */
+class LIBQXMLEDITSHARED_EXPORT XMLSampleNode
+{
+    XMLSampleNode *_parent;
+    Element *_element;
+    QVector<XMLSampleNode*> _children;
+    int _lastChild;
+public:
+    XMLSampleNode(XMLSampleNode *parent, Element *element);
+    ~XMLSampleNode();
+
+    XMLSampleNode *parent();
+    Element *element();
+    XMLSampleNode *findChild(const QStringRef &tag);
+    XMLSampleNode *addChild(Element *element);
+};
+
 class LIBQXMLEDITSHARED_EXPORT XMLLoadContext
 {
     bool    _isError;
@@ -41,8 +62,22 @@ class LIBQXMLEDITSHARED_EXPORT XMLLoadContext
     qint64 _column;
     qint64 _characterOffset;
     bool _isSample;
-    QHash<QString, Element*> _elementsByPath;
+    bool _isRecordSourceRanges;
+    XMLSampleNode *_sampleRoot;
+    XMLSampleNode *_sampleCurrent;
+    int _sampleStopUnchanged;
+    int _sampleUnchangedCount;
+    bool _isSampleComplete;
+    // progress and abort, shared with the thread that shows the loading
+    QMutex _progressMutex;
+    bool _isAborted;
+    qint64 _bytesRead;
+    int _tokensToProgress;
 public:
+    enum {
+        ProgressTokens = 4096
+    };
+
     XMLLoadContext();
     ~XMLLoadContext();
 
@@ -79,9 +114,21 @@ public:
     //------- sample management -----
     bool isSample() const;
     void setSample(bool value);
-    bool existsPath(const QString &path);
-    void setElementByPath(const QString &path, Element *element);
-    Element *getElementByPath(const QString &path);
+    XMLSampleNode *sampleCurrent();
+    void setSampleCurrent(XMLSampleNode *node);
+    int sampleStopUnchanged() const;
+    void setSampleStopUnchanged(const int elements);
+    bool isSampleComplete() const;
+    void sampleChanged();
+    void sampleUnchanged();
+    //------- incremental save -----
+    bool isRecordSourceRanges() const;
+    void setRecordSourceRanges(const bool value);
+    //------- background loading -----
+    bool isAborted();
+    void setAborted();
+    qint64 bytesRead();
+    bool checkProgress(QXmlStreamReader *xmlReader);
 };
 
 #endif // XMLLOADCONTEXT_H
@@ -0,0 +1,892 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+#include "xmlsourcemap.h"
+#include "regola.h"
+#include "element.h"
+#include "xmlsavecontext.h"
+#include "utils.h"
+#include <QFileInfo>
+#include <QCryptographicHash>
+#include <QScopedPointer>
+#if QT_VERSION >= QT_VERSION_CHECK(5,1,0)
+#include <QSaveFile>
+#endif
+
+//--- fingerprints: FNV-1a on 64 bits
+
+static const quint64 FingerprintBasis = Q_UINT64_C(14695981039346656037);
+static const quint64 FingerprintPrime = Q_UINT64_C(1099511628211);
+static const int MIB_UTF8 = 106 ;
+static const int ReadBlockSize = 64 * 1024 ;
+
+static quint64 fingerprintAdd(quint64 hash, const quint64 value)
+{
+    for(int i = 0 ; i < 8 ; i ++) {
+        hash ^= (value >> (i * 8)) & 0xFF ;
+        hash *= FingerprintPrime ;
+    }
+    return hash ;
+}
+
+/*!
+ * \brief an unchanged string still shares its data with the copy
+ */
+static bool isSameString(const QString &current, const QString &saved)
+{
+    return current.isSharedWith(saved) || (current == saved);
+}
+
+static bool isSourceSpace(const QChar ch)
+{
+    return (ch == ' ') || (ch == '\n') || (ch == '\r') || (ch == '\t') ;
+}
+
+//--- range
+
+XmlSourceRange::XmlSourceRange()
+{
+    start = -1 ;
+    end = -1 ;
+    startTagLength = 0 ;
+    endTagLength = 0 ;
+    flags = 0 ;
+}
+
+bool XmlSourceRange::isSelfClosing() const
+{
+    return 0 == endTagLength ;
+}
+
+//--- data
+
+XmlSourceData::XmlSourceData()
+{
+    type = -1 ;
+    isCData = false ;
+    childrenFingerprint = 0 ;
+}
+
+bool XmlSourceData::isSame(Element *element) const
+{
+    if((type != element->getType()) || (isCData != element->_isCData)
+            || !isSameString(element->_tag, tag) || !isSameString(element->text, text)) {
+        return false;
+    }
+    if((element->attributes.size() * 2) != attributes.size()) {
+        return false;
+    }
+    int index = 0 ;
+    foreach(Attribute * attribute, element->attributes) {
+        if(!isSameString(attribute->name, attributes.at(index)) || !isSameString(attribute->value, attributes.at(index + 1))) {
+            return false;
+        }
+        index += 2 ;
+    }
+    QVector<TextChunk*> &textChunks = element->getTextChunks();
+    if(textChunks.size() != chunks.size()) {
+        return false;
+    }
+    index = 0 ;
+    foreach(TextChunk * chunk, textChunks) {
+        if((chunk->isCDATA != chunksCDATA.at(index)) || !isSameString(chunk->text, chunks.at(index))) {
+            return false;
+        }
+        index ++ ;
+    }
+    return true ;
+}
+
+void XmlSourceData::assign(Element *element)
+{
+    type = element->getType();
+    isCData = element->_isCData ;
+    tag = element->_tag ;
+    text = element->text ;
+    attributes.resize(0);
+    foreach(Attribute * attribute, element->attributes) {
+        attributes.append(attribute->name);
+        attributes.append(attribute->value);
+    }
+    chunks.resize(0);
+    chunksCDATA.resize(0);
+    foreach(TextChunk * chunk, element->getTextChunks()) {
+        chunks.append(chunk->text);
+        chunksCDATA.append(chunk->isCDATA);
+    }
+}
+
+//--- hash device
+
+XmlSourceHashDevice::XmlSourceHashDevice(QIODevice *source)
+    : _hash(QCryptographicHash::Sha1)
+{
+    _source = source ;
+    _hashedSize = 0 ;
+    _isInSequence = true ;
+}
+
+XmlSourceHashDevice::~XmlSourceHashDevice()
+{
+}
+
+/*!
+ * \brief opens the view on a random access device not yet read
+ */
+bool XmlSourceHashDevice::openSource()
+{
+    if((NULL == _source) || !_source->isOpen() || _source->isSequential() || (0 != _source->pos())) {
+        return false;
+    }
+    return open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+bool XmlSourceHashDevice::isSequential() const
+{
+    return false;
+}
+
+qint64 XmlSourceHashDevice::size() const
+{
+    return _source->size();
+}
+
+bool XmlSourceHashDevice::seek(qint64 pos)
+{
+    return QIODevice::seek(pos) && _source->seek(pos);
+}
+
+/*!
+ * \brief the bytes read again are not hashed twice, a jump ahead makes the hash not usable
+ */
+qint64 XmlSourceHashDevice::readData(char *data, qint64 maxSize)
+{
+    const qint64 position = _source->pos();
+    const qint64 count = _source->read(data, maxSize);
+    if(count > 0) {
+        const qint64 end = position + count ;
+        if(position > _hashedSize) {
+            _isInSequence = false ;
+        } else if(end > _hashedSize) {
+            _hash.addData(data + (_hashedSize - position), static_cast<int>(end - _hashedSize));
+            _hashedSize = end ;
+        }
+    }
+    return count ;
+}
+
+qint64 XmlSourceHashDevice::writeData(const char * /*data*/, qint64 /*maxSize*/)
+{
+    return -1 ;
+}
+
+/*!
+ * \brief the hash of the source, empty if it was not read completely and in sequence
+ */
+QByteArray XmlSourceHashDevice::result() const
+{
+    if(!_isInSequence || (_hashedSize != _source->size())) {
+        return QByteArray();
+    }
+    return _hash.result();
+}
+
+//--- writer
+
+/**
+  \brief writes a document copying from the source text the items that did not change.
+  */
+class XmlSourceWriter
+{
+    XmlSourceMap *_map;
+    Regola *_regola;
+    XMLSaveContext *_context;
+    const QString &_source;
+    QIODevice *_device;
+    QTextEncoder *_encoder;
+    QCryptographicHash _hash;
+    QString _output;
+    qint64 _flushed;
+    int _indent;
+    bool _isCRLF;
+    bool _isError;
+    bool _isMismatch;
+    bool _isDtdWritten;
+    qint64 _newDtdStart;
+
+    qint64 position() const;
+    bool flush(const bool isForced);
+    void append(const QString &text);
+    void appendSource(qint64 start, const qint64 end);
+    void appendGap(const qint64 start, const qint64 end);
+    void appendSeparator(Element *element, const int depth);
+    bool isSourceAt(const qint64 position, const QString &text) const;
+    bool isWhitespace(const qint64 start, const qint64 end) const;
+    bool isGap(const qint64 start, const qint64 end) const;
+    qint64 whitespaceBefore(qint64 position, const qint64 limit) const;
+    bool isSourceItem(Element *element, const XmlSourceRange &range) const;
+    void writeItem(Element *element, const int depth, const bool hasSeparator);
+    void writeChildren(QVector<Element*> &children, const qint64 innerStart, const qint64 innerEnd, const int depth);
+    void writeSerialized(Element *element, const int depth, const bool hasSeparator);
+    QString serialize(Element *element, const int depth);
+    void shiftRanges(Element *element, const qint64 delta);
+    void removeRanges(Element *element);
+
+public:
+    XmlSourceWriter(XmlSourceMap *map, Regola *regola, XMLSaveContext *context, const QString &source, QIODevice *device, QTextCodec *codec);
+    ~XmlSourceWriter();
+
+    bool writeDocument();
+    bool writeBytes(const QByteArray &data);
+    QByteArray hash() const;
+    bool isError() const;
+    bool isMismatch() const;
+    qint64 newDtdStart() const;
+};
+
+XmlSourceWriter::XmlSourceWriter(XmlSourceMap *map, Regola *regola, XMLSaveContext *context, const QString &source, QIODevice *device, QTextCodec *codec)
+    : _source(source), _hash(QCryptographicHash::Sha1)
+{
+    _map = map ;
+    _regola = regola ;
+    _context = context ;
+    _device = device ;
+    _encoder = codec->makeEncoder(QTextCodec::IgnoreHeader);
+    _flushed = 0 ;
+    _indent = context->indentation();
+    const int firstNewLine = source.indexOf('\n');
+    _isCRLF = (firstNewLine > 0) && (source.at(firstNewLine - 1) == '\r');
+    _isError = false ;
+    _isMismatch = false ;
+    _isDtdWritten = false ;
+    _newDtdStart = -1 ;
+}
+
+XmlSourceWriter::~XmlSourceWriter()
+{
+    delete _encoder ;
+}
+
+bool XmlSourceWriter::isError() const
+{
+    return _isError ;
+}
+
+bool XmlSourceWriter::isMismatch() const
+{
+    return _isMismatch ;
+}
+
+qint64 XmlSourceWriter::newDtdStart() const
+{
+    return _newDtdStart ;
+}
+
+/*!
+ * \brief writes to the device hashing the bytes, the hash is the one of the file written
+ */
+bool XmlSourceWriter::writeBytes(const QByteArray &data)
+{
+    if(_device->write(data) != data.length()) {
+        _isError = true ;
+        return false;
+    }
+    _hash.addData(data);
+    return true ;
+}
+
+QByteArray XmlSourceWriter::hash() const
+{
+    return _hash.result();
+}
+
+qint64 XmlSourceWriter::position() const
+{
+    return _flushed + _output.length();
+}
+
+bool XmlSourceWriter::flush(const bool isForced)
+{
+    if(_isError || _output.isEmpty()) {
+        return !_isError ;
+    }
+    if(!isForced && (_output.length() < XMLSaveContext::OutputBufferFlushSize)) {
+        return true ;
+    }
+    writeBytes(_encoder->fromUnicode(_output));
+    _flushed += _output.length();
+    _output.resize(0);
+    return !_isError ;
+}
+
+void XmlSourceWriter::append(const QString &text)
+{
+    _output.append(text);
+    flush(false);
+}
+
+/*!
+ * \brief copies a range of the source, a big range is copied in pieces to bound the memory used
+ */
+void XmlSourceWriter::appendSource(qint64 start, const qint64 end)
+{
+    while(start < end) {
+        const qint64 size = qMin(end - start, static_cast<qint64>(XMLSaveContext::OutputBufferFlushSize));
+        _output.append(_source.midRef(static_cast<int>(start), static_cast<int>(size)));
+        start += size ;
+        flush(false);
+    }
+}
+
+/*!
+ * \brief copies the text between two items, moving the DTD if it is there
+ */
+void XmlSourceWriter::appendGap(const qint64 start, const qint64 end)
+{
+    if(!_map->_dtd.isEmpty() && (_map->_dtdStart >= start) && (_map->_dtdEnd <= end)) {
+        _newDtdStart = position() + (_map->_dtdStart - start);
+        _isDtdWritten = true ;
+    }
+    appendSource(start, end);
+}
+
+/*!
+ * \brief adds a new line before an item moved from another place, as the serialization does
+ */
+void XmlSourceWriter::appendSeparator(Element *element, const int depth)
+{
+    if((_indent < 0) || element->isText()) {
+        return ;
+    }
+    append((_isCRLF ? QString("\r\n") : QString("\n")) + QString(_indent * depth, ' '));
+}
+
+bool XmlSourceWriter::isSourceAt(const qint64 position, const QString &text) const
+{
+    if((position < 0) || ((position + text.length()) > _source.length())) {
+        return false;
+    }
+    return _source.midRef(static_cast<int>(position), text.length()) == text ;
+}
+
+bool XmlSourceWriter::isWhitespace(const qint64 start, const qint64 end) const
+{
+    for(qint64 i = start ; i < end ; i ++) {
+        if(!isSourceSpace(_source.at(static_cast<int>(i)))) {
+            return false;
+        }
+    }
+    return true ;
+}
+
+/*!
+ * \brief true if the source between two items contains only spaces, and at the top level the DTD
+ */
+bool XmlSourceWriter::isGap(const qint64 start, const qint64 end) const
+{
+    if(start > end) {
+        return false;
+    }
+    if(!_map->_dtd.isEmpty() && (_map->_dtdStart >= start) && (_map->_dtdEnd <= end)) {
+        return isWhitespace(start, _map->_dtdStart) && isWhitespace(_map->_dtdEnd, end);
+    }
+    return isWhitespace(start, end);
+}
+
+qint64 XmlSourceWriter::whitespaceBefore(qint64 position, const qint64 limit) const
+{
+    while((position > limit) && isSourceSpace(_source.at(static_cast<int>(position - 1)))) {
+        position-- ;
+    }
+    return position ;
+}
+
+/*!
+ * \brief checks that the source text at the range is still the item that was read
+ */
+bool XmlSourceWriter::isSourceItem(Element *element, const XmlSourceRange &range) const
+{
+    const qint64 sourceLength = _source.length();
+    if((range.start < 0) || (range.end > sourceLength) || (range.start >= range.end)) {
+        return false;
+    }
+    switch(element->getType()) {
+    case Element::ET_ELEMENT: {
+        const qint64 startTagEnd = range.start + range.startTagLength ;
+        if((range.startTagLength < 3) || ((startTagEnd + range.endTagLength) > range.end)) {
+            return false;
+        }
+        if(!isSourceAt(range.start, "<") || !isSourceAt(startTagEnd - 1, ">")) {
+            return false;
+        }
+        const QChar first = _source.at(static_cast<int>(range.start + 1));
+        if((first == '/') || (first == '!') || (first == '?') || isSourceSpace(first)) {
+            return false;
+        }
+        if(range.isSelfClosing()) {
+            if(!isSourceAt(startTagEnd - 2, "/>")) {
+                return false;
+            }
+        } else {
+            if(!isSourceAt(range.end - range.endTagLength, "</") || !isSourceAt(range.end - 1, ">")) {
+                return false;
+            }
+        }
+        // a renamed element is checked only by its shape
+        if(!(range.flags & XmlSourceRange::OwnChanged)) {
+            const QString tag = element->tag();
+            const qint64 afterTag = range.start + 1 + tag.length();
+            if((afterTag >= startTagEnd) || !isSourceAt(range.start + 1, tag)) {
+                return false;
+            }
+            const QChar after = _source.at(static_cast<int>(afterTag));
+            if(!isSourceSpace(after) && (after != '/') && (after != '>')) {
+                return false;
+            }
+            if(!range.isSelfClosing() && !isSourceAt(range.end - range.endTagLength + 2, tag)) {
+                return false;
+            }
+        }
+        return true ;
+    }
+    case Element::ET_PROCESSING_INSTRUCTION:
+        return isSourceAt(range.start, "<?") && isSourceAt(range.end - 2, "?>");
+    case Element::ET_COMMENT:
+        return isSourceAt(range.start, "<!--") && isSourceAt(range.end - 3, "-->");
+    case Element::ET_TEXT:
+        return (range.start > 0) && (_source.at(static_cast<int>(range.start - 1)) == '>')
+               && ((range.end == sourceLength) || (_source.at(static_cast<int>(range.end)) == '<'));
+    default:
+        return false;
+    }
+}
+
+bool XmlSourceWriter::writeDocument()
+{
+    writeChildren(_regola->getItems(), 0, _source.length(), 0);
+    if(!_map->_dtd.isEmpty() && !_isDtdWritten) {
+        _isMismatch = true ;
+    }
+    if(_isMismatch) {
+        return false;
+    }
+    return flush(true);
+}
+
+/*!
+ * \brief writes the children of an element, or the top level items, keeping the original spaces between them
+ */
+void XmlSourceWriter::writeChildren(QVector<Element*> &children, const qint64 innerStart, const qint64 innerEnd, const int depth)
+{
+    qint64 cursor = innerStart ;
+    foreach(Element * child, children) {
+        if(_isMismatch || _isError) {
+            return ;
+        }
+        bool isOriginal = false;
+        qint64 childStart = 0 ;
+        qint64 childEnd = 0 ;
+        QHash<const Element*, XmlSourceRange>::const_iterator it = _map->_ranges.constFind(child);
+        if(it != _map->_ranges.constEnd()) {
+            childStart = it.value().start ;
+            childEnd = it.value().end ;
+            isOriginal = (childStart >= innerStart) && (childEnd <= innerEnd) ;
+        }
+        if(isOriginal) {
+            if((childStart >= cursor) && isGap(cursor, childStart)) {
+                appendGap(cursor, childStart);
+            } else {
+                appendSource(whitespaceBefore(childStart, innerStart), childStart);
+            }
+            writeItem(child, depth, true);
+            cursor = childEnd ;
+        } else {
+            writeItem(child, depth, false);
+        }
+    }
+    if(_isMismatch || _isError) {
+        return ;
+    }
+    if((cursor <= innerEnd) && isGap(cursor, innerEnd)) {
+        appendGap(cursor, innerEnd);
+    } else {
+        appendSource(whitespaceBefore(innerEnd, innerStart), innerEnd);
+    }
+}
+
+/*!
+ * \brief writes an item: copied when unchanged, keeping its tags when only the children changed, serialized otherwise
+ * \param hasSeparator true if the spaces before the item are already written
+ */
+void XmlSourceWriter::writeItem(Element *element, const int depth, const bool hasSeparator)
+{
+    if(!_map->_ranges.contains(element)) {
+        writeSerialized(element, depth, hasSeparator);
+        return ;
+    }
+    // a copy: the table can change during the recursion
+    const XmlSourceRange range = _map->_ranges.value(element);
+    if(!isSourceItem(element, range)) {
+        _isMismatch = true ;
+        return ;
+    }
+    if(!hasSeparator) {
+        appendSeparator(element, depth);
+    }
+    if(!(range.flags & XmlSourceRange::Changed)) {
+        const qint64 delta = position() - range.start ;
+        appendSource(range.start, range.end);
+        shiftRanges(element, delta);
+        return ;
+    }
+    if(element->isElement() && !(range.flags & XmlSourceRange::OwnChanged)
+            && !range.isSelfClosing() && (0 == element->getTextChunksNumber())) {
+        XmlSourceRange newRange = range ;
+        newRange.start = position();
+        const qint64 innerStart = range.start + range.startTagLength ;
+        const qint64 innerEnd = range.end - range.endTagLength ;
+        appendSource(range.start, innerStart);
+        writeChildren(element->getChildItemsRef(), innerStart, innerEnd, depth + 1);
+        appendSource(innerEnd, range.end);
+        newRange.end = position();
+        newRange.flags = 0 ;
+        _map->_ranges.insert(element, newRange);
+        return ;
+    }
+    // the separator is already there
+    writeSerialized(element, depth, true);
+}
+
+void XmlSourceWriter::writeSerialized(Element *element, const int depth, const bool hasSeparator)
+{
+    QString fragment = serialize(element, depth);
+    if(hasSeparator && !element->isText()) {
+        int index = 0 ;
+        if((index < fragment.length()) && (fragment.at(index) == '\n')) {
+            index++;
+        }
+        while((index < fragment.length()) && (fragment.at(index) == ' ')) {
+            index++;
+        }
+        fragment.remove(0, index);
+    }
+    if(_isCRLF) {
+        fragment.replace("\n", "\r\n");
+    }
+    append(fragment);
+    removeRanges(element);
+}
+
+/*!
+ * \brief serializes an item as the complete save does, enclosing it in fake parents to get the same indentation
+ */
+QString XmlSourceWriter::serialize(Element *element, const int depth)
+{
+    QString fragment ;
+    QXmlStreamWriter writer(&fragment);
+    XMLSaveContext context(*_context);
+    context.setDoIndent(true);
+    if(_indent >= 0) {
+        writer.setAutoFormatting(true);
+        writer.setAutoFormattingIndent(_indent);
+    }
+    for(int i = 0 ; i < depth ; i ++) {
+        writer.writeStartElement("_");
+    }
+    const int prefixLength = fragment.length();
+    if(!element->writeStream(&context, writer, NULL)) {
+        _isError = true ;
+    }
+    QString result = fragment.mid(prefixLength);
+    // the end of the start tag of the last fake parent
+    if((depth > 0) && result.startsWith('>')) {
+        result.remove(0, 1);
+    }
+    return result ;
+}
+
+void XmlSourceWriter::shiftRanges(Element *element, const qint64 delta)
+{
+    QHash<const Element*, XmlSourceRange>::iterator it = _map->_ranges.find(element);
+    if(it != _map->_ranges.end()) {
+        it.value().start += delta ;
+        it.value().end += delta ;
+        it.value().flags = 0 ;
+    }
+    foreach(Element * child, element->getChildItemsRef()) {
+        shiftRanges(child, delta);
+    }
+}
+
+void XmlSourceWriter::removeRanges(Element *element)
+{
+    _map->_ranges.remove(element);
+    foreach(Element * child, element->getChildItemsRef()) {
+        removeRanges(child);
+    }
+}
+
+//--- map
+
+XmlSourceMap::XmlSourceMap()
+{
+    _fileSize = 0 ;
+    _dtdStart = -1 ;
+    _dtdEnd = -1 ;
+}
+
+XmlSourceMap::~XmlSourceMap()
+{
+}
+
+void XmlSourceMap::setElementStart(const Element *element, const qint64 start, const qint64 startTagEnd)
+{
+    XmlSourceRange range;
+    range.start = start ;
+    range.startTagLength = static_cast<quint32>(startTagEnd - start);
+    _ranges.insert(element, range);
+}
+
+void XmlSourceMap::setElementEnd(const Element *element, const qint64 endTagStart, const qint64 end)
+{
+    QHash<const Element*, XmlSourceRange>::iterator it = _ranges.find(element);
+    if(it != _ranges.end()) {
+        it.value().endTagLength = static_cast<quint32>(end - endTagStart);
+        it.value().end = end ;
+    }
+}
+
+void XmlSourceMap::setItemRange(const Element *element, const qint64 start, const qint64 end)
+{
+    XmlSourceRange range;
+    range.start = start ;
+    range.end = end ;
+    _ranges.insert(element, range);
+}
+
+void XmlSourceMap::setDtdRange(const qint64 start, const qint64 end)
+{
+    _dtdStart = start ;
+    _dtdEnd = end ;
+}
+
+/*!
+ * \brief completes the map after a successful load, the source must be a file
+ * \param fileHash the hash of the file taken while it was parsed, see XmlSourceHashDevice
+ */
+bool XmlSourceMap::completeLoad(Regola *regola, QIODevice *device, const QByteArray &fileHash, const QString &encoding)
+{
+    QFile *file = qobject_cast<QFile*>(device);
+    if((NULL == file) || file->fileName().isEmpty() || fileHash.isEmpty()) {
+        return false;
+    }
+    QFileInfo info(file->fileName());
+    _filePath = info.absoluteFilePath();
+    _fileSize = info.size();
+    _fileModified = info.lastModified();
+    _fileHash = fileHash ;
+    _encoding = encoding.isEmpty() ? QString("UTF-8") : encoding ;
+    _dtd = regola->dtd();
+    // items not closed are not usable
+    QHash<const Element*, XmlSourceRange>::iterator it = _ranges.begin();
+    while(it != _ranges.end()) {
+        if(it.value().end < it.value().start) {
+            it = _ranges.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    foreach(Element * element, regola->getItems()) {
+        updateChanges(element);
+    }
+    for(it = _ranges.begin() ; it != _ranges.end() ; ++it) {
+        it.value().flags = 0 ;
+    }
+    return true ;
+}
+
+void XmlSourceMap::elementRemoved(const Element *element)
+{
+    _ranges.remove(element);
+    _data.remove(element);
+}
+
+int XmlSourceMap::count() const
+{
+    return _ranges.size();
+}
+
+bool XmlSourceMap::hasRange(const Element *element) const
+{
+    return _ranges.contains(element);
+}
+
+/*!
+ * \brief marks the items changed since the last time, comparing each item with the copy of its data
+ * and the identity of its children; an unchanged item costs only the comparison of the pointers
+ * \return true if the subtree changed
+ */
+bool XmlSourceMap::updateChanges(Element *element)
+{
+    bool isChanged = false;
+    // the identity of the children finds insertions, deletions and moves
+    quint64 children = FingerprintBasis ;
+    foreach(Element * child, element->getChildItemsRef()) {
+        children = fingerprintAdd(children, static_cast<quint64>(reinterpret_cast<quintptr>(child)));
+        if(updateChanges(child)) {
+            isChanged = true ;
+        }
+    }
+    bool isOwnChanged = false;
+    QHash<const Element*, XmlSourceData>::iterator data = _data.find(element);
+    if(data == _data.end()) {
+        data = _data.insert(element, XmlSourceData());
+        isOwnChanged = true ;
+    } else if(!data.value().isSame(element)) {
+        isOwnChanged = true ;
+    }
+    if(isOwnChanged) {
+        data.value().assign(element);
+    }
+    if(data.value().childrenFingerprint != children) {
+        data.value().childrenFingerprint = children ;
+        isChanged = true ;
+    }
+    isChanged = isChanged || isOwnChanged ;
+    QHash<const Element*, XmlSourceRange>::iterator it = _ranges.find(element);
+    if(it != _ranges.end()) {
+        XmlSourceRange &range = it.value();
+        range.flags = 0 ;
+        if(isChanged) {
+            range.flags |= XmlSourceRange::Changed ;
+        }
+        if(isOwnChanged) {
+            range.flags |= XmlSourceRange::OwnChanged ;
+        }
+    }
+    return isChanged ;
+}
+
+/*!
+ * \brief a quick check of the file, the content is verified by its hash when it is read for the save
+ */
+bool XmlSourceMap::isFileUnchanged() const
+{
+    QFileInfo info(_filePath);
+    return info.exists() && (info.size() == _fileSize) && (info.lastModified() == _fileModified);
+}
+
+/*!
+ * \brief writes the document to a file using the original one as source
+ * \return WriteNotApplicable if a complete save is needed, the file is untouched in this case
+ */
+XmlSourceMap::EWriteResult XmlSourceMap::write(Regola *regola, XMLSaveContext *context, const QString &filePath)
+{
+#if QT_VERSION < QT_VERSION_CHECK(5,1,0)
+    // without an atomic replacement a late mismatch would leave a broken file
+    Q_UNUSED(regola);
+    Q_UNUSED(context);
+    Q_UNUSED(filePath);
+    return WriteNotApplicable ;
+#else
+    if(context->isUsingDevicePosition() || !isFileUnchanged() || (regola->dtd() != _dtd)) {
+        return WriteNotApplicable ;
+    }
+    QTextCodec *declaredCodec = QTextCodec::codecForName(_encoding.toLatin1());
+    QTextCodec *outputCodec = QTextCodec::codecForName(regola->encoding().toLatin1());
+    if((NULL == declaredCodec) || (NULL == outputCodec)) {
+        return WriteNotApplicable ;
+    }
+    QFile sourceFile(_filePath);
+    if(!sourceFile.open(QIODevice::ReadOnly)) {
+        return WriteNotApplicable ;
+    }
+    // a single pass on the file: each block is hashed and decoded
+    const QByteArray utf8Bom("\xEF\xBB\xBF");
+    QCryptographicHash sourceHash(QCryptographicHash::Sha1);
+    QTextCodec *sourceCodec = NULL ;
+    QScopedPointer<QTextDecoder> decoder;
+    bool hasBom = false;
+    QString source;
+    while(!sourceFile.atEnd()) {
+        const QByteArray block = sourceFile.read(ReadBlockSize);
+        if(block.isEmpty()) {
+            return WriteNotApplicable ;
+        }
+        sourceHash.addData(block);
+        if(decoder.isNull()) {
+            // the offsets are characters: only a codec where the markup is one byte per character is safe to splice
+            sourceCodec = QTextCodec::codecForUtfText(block, declaredCodec);
+            if((sourceCodec != outputCodec) || !Utils::isAsciiCompatible(sourceCodec->name())) {
+                return WriteNotApplicable ;
+            }
+            hasBom = block.startsWith(utf8Bom);
+            decoder.reset(sourceCodec->makeDecoder());
+            source.reserve(static_cast<int>(_fileSize));
+        }
+        source.append(decoder->toUnicode(block));
+    }
+    sourceFile.close();
+    // a file rewritten with the same size within the resolution of the modification time
+    if(decoder.isNull() || (sourceHash.result() != _fileHash)) {
+        return WriteNotApplicable ;
+    }
+    if(source.startsWith(QChar(0xFEFF))) {
+        source.remove(0, 1);
+    }
+
+    foreach(Element * element, regola->getItems()) {
+        updateChanges(element);
+    }
+
+    QSaveFile file(filePath);
+    file.setDirectWriteFallback(true);
+    if(!file.open(QIODevice::WriteOnly)) {
+        Utils::error(QObject::tr("Error writing data: %1").arg(file.errorString()));
+        return WriteError ;
+    }
+    XmlSourceWriter writer(this, regola, context, source, &file, outputCodec);
+    if(hasBom && (sourceCodec->mibEnum() == MIB_UTF8)) {
+        writer.writeBytes(utf8Bom);
+    }
+    const bool isWritten = writer.writeDocument();
+    if(writer.isMismatch()) {
+        file.cancelWriting();
+        return WriteNotApplicable ;
+    }
+    if(!isWritten || writer.isError() || !file.commit()) {
+        Utils::error(QObject::tr("Error writing data: %1").arg(file.errorString()));
+        return WriteError ;
+    }
+    QFileInfo info(filePath);
+    _filePath = info.absoluteFilePath();
+    _fileSize = info.size();
+    _fileModified = info.lastModified();
+    _fileHash = writer.hash();
+    if(!_dtd.isEmpty()) {
+        _dtdEnd = writer.newDtdStart() + (_dtdEnd - _dtdStart);
+        _dtdStart = writer.newDtdStart();
+    }
+    return WriteDone ;
+#endif
+}
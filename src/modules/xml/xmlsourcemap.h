@@ -0,0 +1,162 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef XMLSOURCEMAP_H
+#define XMLSOURCEMAP_H
+
+#include "xmlEdit.h"
+#include "libQXmlEdit_global.h"
+#include <QIODevice>
+#include <QCryptographicHash>
+
+class Element;
+class Regola;
+class XMLSaveContext;
+class XmlSourceWriter;
+
+/**
+  \brief where an item was read in the source text, in characters as counted by the stream reader.
+  The start tag and the end tag of an element are kept by length, the other items have only a start and an end.
+  */
+class XmlSourceRange
+{
+public:
+    enum {
+        Changed = 1,
+        OwnChanged = 2
+    };
+    qint64 start;
+    qint64 end;
+    quint32 startTagLength;
+    quint32 endTagLength;
+    quint32 flags;
+
+    XmlSourceRange();
+    bool isSelfClosing() const;
+};
+
+/**
+  \brief the data of an item as it was read or last written. The strings are copies that share
+  their data with the ones of the item until the item changes them, so an unchanged item is
+  recognized comparing the pointers and only the changed ones compare the text.
+  */
+class XmlSourceData
+{
+public:
+    int type;
+    bool isCData;
+    QString tag;
+    QString text;
+    // names and values
+    QVector<QString> attributes;
+    QVector<QString> chunks;
+    QVector<bool> chunksCDATA;
+    // the identity of the children
+    quint64 childrenFingerprint;
+
+    XmlSourceData();
+    bool isSame(Element *element) const;
+    void assign(Element *element);
+};
+
+/**
+  \brief a read only view of a device that hashes the bytes while they are read in sequence,
+  to take the hash of a file during the parse without reading it again.
+  */
+class LIBQXMLEDITSHARED_EXPORT XmlSourceHashDevice : public QIODevice
+{
+    QIODevice *_source;
+    QCryptographicHash _hash;
+    qint64 _hashedSize;
+    bool _isInSequence;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize);
+    qint64 writeData(const char *data, qint64 maxSize);
+
+public:
+    XmlSourceHashDevice(QIODevice *source);
+    ~XmlSourceHashDevice();
+
+    bool openSource();
+    bool isSequential() const;
+    qint64 size() const;
+    bool seek(qint64 pos);
+    QByteArray result() const;
+};
+
+/**
+  \brief remembers the position of each item in the file that was read, so that a save can copy
+  the text of the unchanged subtrees from the original and serialize only the edited ones.
+  The changes are found comparing the data of each item and the identity of its children, kept when the file
+  was read and after every save, with the current ones: the edit flags of the elements are not complete enough for this.
+  An element whose own data did not change keeps its tags and the spaces between the children.
+  The file is used only if its content hash, taken while it is read or written, is the one of the file read or last written.
+  Whenever the source text does not match what is expected, the caller makes a complete save.
+  */
+class LIBQXMLEDITSHARED_EXPORT XmlSourceMap
+{
+    QHash<const Element*, XmlSourceRange> _ranges;
+    QHash<const Element*, XmlSourceData> _data;
+    QString _filePath;
+    qint64 _fileSize;
+    QDateTime _fileModified;
+    QByteArray _fileHash;
+    QString _encoding;
+    QString _dtd;
+    qint64 _dtdStart;
+    qint64 _dtdEnd;
+
+    bool updateChanges(Element *element);
+    bool isFileUnchanged() const;
+
+    friend class XmlSourceWriter;
+
+public:
+    enum EWriteResult {
+        WriteDone,
+        WriteNotApplicable,
+        WriteError
+    };
+
+    XmlSourceMap();
+    ~XmlSourceMap();
+
+    //--- loading
+    void setElementStart(const Element *element, const qint64 start, const qint64 startTagEnd);
+    void setElementEnd(const Element *element, const qint64 endTagStart, const qint64 end);
+    void setItemRange(const Element *element, const qint64 start, const qint64 end);
+    void setDtdRange(const qint64 start, const qint64 end);
+    bool completeLoad(Regola *regola, QIODevice *device, const QByteArray &fileHash, const QString &encoding);
+
+    //--- editing
+    void elementRemoved(const Element *element);
+    int count() const;
+    bool hasRange(const Element *element) const;
+
+    //--- saving
+    EWriteResult write(Regola *regola, XMLSaveContext *context, const QString &filePath);
+};
+
+#endif // XMLSOURCEMAP_H
@@ -0,0 +1,245 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+#include "xmlstreamscanner.h"
+#include "utils.h"
+#include <string.h>
+
+XmlScanHandler::XmlScanHandler()
+{
+}
+
+XmlScanHandler::~XmlScanHandler()
+{
+}
+
+bool XmlScanHandler::startDocument(XmlStreamScanner * /*scanner*/)
+{
+    return true ;
+}
+
+bool XmlScanHandler::startElement(XmlStreamScanner * /*scanner*/, const int /*nameId*/, const QXmlStreamAttributes & /*attributes*/)
+{
+    return true ;
+}
+
+bool XmlScanHandler::endElement(XmlStreamScanner * /*scanner*/, const int /*nameId*/)
+{
+    return true ;
+}
+
+bool XmlScanHandler::characters(XmlStreamScanner * /*scanner*/, const QStringRef & /*text*/)
+{
+    return true ;
+}
+
+void XmlScanHandler::parseError(const QString & /*message*/)
+{
+}
+
+//---------------------------------------------------------
+
+XmlStreamScanner::XmlStreamScanner()
+{
+    _isError = false ;
+    _isStopped = false ;
+    _lineNumber = 0 ;
+    _columnNumber = 0 ;
+}
+
+XmlStreamScanner::~XmlStreamScanner()
+{
+}
+
+uint XmlStreamScanner::hashName(const QChar *data, const int length)
+{
+    // FNV-1a
+    uint hash = 2166136261u;
+    for(int i = 0 ; i < length ; i ++) {
+        hash ^= data[i].unicode();
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+int XmlStreamScanner::findOrAddName(const QChar *data, const int length, const QStringRef *nameRef, const QString *name)
+{
+    const uint hash = hashName(data, length);
+    QMultiHash<uint, int>::const_iterator it = _namesByHash.constFind(hash);
+    while((it != _namesByHash.constEnd()) && (it.key() == hash)) {
+        const QString &candidate = _names.at(it.value());
+        if((candidate.length() == length) && (0 == memcmp(candidate.constData(), data, length * sizeof(QChar)))) {
+            return it.value();
+        }
+        ++it;
+    }
+    const int id = _names.size();
+    if(NULL != name) {
+        _names.append(*name);
+    } else {
+        _names.append(nameRef->toString());
+    }
+    _namesByHash.insert(hash, id);
+    return id;
+}
+
+int XmlStreamScanner::internName(const QStringRef &name)
+{
+    return findOrAddName(name.unicode(), name.length(), &name, NULL);
+}
+
+int XmlStreamScanner::internName(const QString &name)
+{
+    return findOrAddName(name.unicode(), name.length(), NULL, &name);
+}
+
+const QString &XmlStreamScanner::name(const int id) const
+{
+    static const QString emptyName;
+    if((id < 0) || (id >= _names.size())) {
+        return emptyName ;
+    }
+    return _names.at(id);
+}
+
+int XmlStreamScanner::namesCount() const
+{
+    return _names.size();
+}
+
+/*!
+ * \brief XmlStreamScanner::depth the number of the open elements, including the current one in startElement and endElement
+ */
+int XmlStreamScanner::depth() const
+{
+    return _openElements.size();
+}
+
+bool XmlStreamScanner::isError() const
+{
+    return _isError ;
+}
+
+bool XmlStreamScanner::isStopped() const
+{
+    return _isStopped ;
+}
+
+QString XmlStreamScanner::errorMessage() const
+{
+    return _errorMessage ;
+}
+
+qint64 XmlStreamScanner::lineNumber() const
+{
+    return _lineNumber ;
+}
+
+qint64 XmlStreamScanner::columnNumber() const
+{
+    return _columnNumber ;
+}
+
+bool XmlStreamScanner::stop()
+{
+    _isStopped = true ;
+    return false ;
+}
+
+bool XmlStreamScanner::scanFile(const QString &filePath, XmlScanHandler *handler)
+{
+    QFile file(filePath);
+    if(!file.open(QFile::ReadOnly | QFile::Text)) {
+        _isError = true ;
+        _isStopped = false ;
+        _errorMessage = QObject::tr("An error occurred opening the file: %1.").arg(file.errorString());
+        return false;
+    }
+    const bool isOk = scan(&file, handler);
+    file.close();
+    return isOk ;
+}
+
+/*!
+ * \brief XmlStreamScanner::scan reads the whole device sending the events to the handler
+ * \return false if the document is not well formed or the handler stopped the scan
+ */
+bool XmlStreamScanner::scan(QIODevice *device, XmlScanHandler *handler)
+{
+    _isError = false ;
+    _isStopped = false ;
+    _errorMessage = "" ;
+    _lineNumber = 0 ;
+    _columnNumber = 0 ;
+    _openElements.clear();
+
+    QXmlStreamReader reader(device);
+    reader.setNamespaceProcessing(false);
+    if(!handler->startDocument(this)) {
+        return stop();
+    }
+    while(!reader.atEnd()) {
+        switch(reader.readNext()) {
+        case QXmlStreamReader::StartElement: {
+            const int nameId = internName(reader.qualifiedName());
+            _openElements.append(nameId);
+            if(!handler->startElement(this, nameId, reader.attributes())) {
+                return stop();
+            }
+        }
+        break;
+        case QXmlStreamReader::EndElement: {
+            int nameId = -1 ;
+            if(!_openElements.isEmpty()) {
+                nameId = _openElements.last();
+            }
+            if(!handler->endElement(this, nameId)) {
+                return stop();
+            }
+            if(!_openElements.isEmpty()) {
+                _openElements.remove(_openElements.size() - 1);
+            }
+        }
+        break;
+        case QXmlStreamReader::Characters:
+            if(!handler->characters(this, reader.text())) {
+                return stop();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    if(reader.hasError()) {
+        _isError = true ;
+        _lineNumber = reader.lineNumber();
+        _columnNumber = reader.columnNumber();
+        _errorMessage = QObject::tr("Parse error at line %1, column %2:\n%3")
+                        .arg(_lineNumber)
+                        .arg(_columnNumber)
+                        .arg(reader.errorString());
+        handler->parseError(_errorMessage);
+        return false;
+    }
+    return true ;
+}
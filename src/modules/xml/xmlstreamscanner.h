@@ -0,0 +1,91 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+#ifndef XMLSTREAMSCANNER_H
+#define XMLSTREAMSCANNER_H
+
+#include "xmlEdit.h"
+#include "libQXmlEdit_global.h"
+#include <QXmlStreamReader>
+
+class XmlStreamScanner;
+
+/**
+  \brief receives the events of a XmlStreamScanner.
+  The names are given as ids interned by the scanner; texts and attributes refer to the reader buffer
+  and are valid only during the call. Returning false from an event stops the scan.
+  */
+class LIBQXMLEDITSHARED_EXPORT XmlScanHandler
+{
+public:
+    XmlScanHandler();
+    virtual ~XmlScanHandler();
+
+    virtual bool startDocument(XmlStreamScanner *scanner);
+    virtual bool startElement(XmlStreamScanner *scanner, const int nameId, const QXmlStreamAttributes &attributes);
+    virtual bool endElement(XmlStreamScanner *scanner, const int nameId);
+    virtual bool characters(XmlStreamScanner *scanner, const QStringRef &text);
+    virtual void parseError(const QString &message);
+};
+
+/**
+  \brief a forward only scanner shared by the analysis that do not need the document tree.
+  The element names are interned in a table that lives as long as the scanner, so that
+  each name is allocated once and the handlers can compare and index names using integers.
+  Namespaces are not processed: names are the qualified ones, as written in the document.
+  */
+class LIBQXMLEDITSHARED_EXPORT XmlStreamScanner
+{
+    QVector<QString> _names;
+    QMultiHash<uint, int> _namesByHash;
+    QVector<int> _openElements;
+    bool _isError;
+    bool _isStopped;
+    QString _errorMessage;
+    qint64 _lineNumber;
+    qint64 _columnNumber;
+
+    static uint hashName(const QChar *data, const int length);
+    int findOrAddName(const QChar *data, const int length, const QStringRef *nameRef, const QString *name);
+    bool stop();
+public:
+    XmlStreamScanner();
+    ~XmlStreamScanner();
+
+    bool scan(QIODevice *device, XmlScanHandler *handler);
+    bool scanFile(const QString &filePath, XmlScanHandler *handler);
+
+    int internName(const QStringRef &name);
+    int internName(const QString &name);
+    const QString &name(const int id) const;
+    int namesCount() const;
+    int depth() const;
+
+    bool isError() const;
+    bool isStopped() const;
+    QString errorMessage() const;
+    qint64 lineNumber() const;
+    qint64 columnNumber() const;
+};
+
+#endif // XMLSTREAMSCANNER_H
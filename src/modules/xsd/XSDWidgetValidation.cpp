@@ -50,6 +50,7 @@
 #include "modules/xsd/xsdhelper.h"
 #include "modules/xsd/xsddefaultannotationeditor.h"
 #include "modules/xml/xmlindentationdialog.h"
+#include "modules/utils/perftrace.h"
 
 //-----------------------------------
 bool XmlEditWidgetPrivate::validateUsingDocumentReferences()
@@ -103,9 +104,14 @@ bool XmlEditWidgetPrivate::validateWithFile(const QString &schemaUrl)
     }
     QByteArray dataXml = regola->getAsText().toUtf8();
     schemaHandler.setMessageHandler(&messageHandler);
-    QXmlSchemaValidator schemaValidator(schemaHandler);
+    bool isValid = false;
+    {
+        QXMLEDIT_TRACE_ZONE("validation", "validate");
+        QXmlSchemaValidator schemaValidator(schemaHandler);
+        isValid = schemaValidator.validate(dataXml);
+    }
     bool result = false;
-    if(schemaValidator.validate(dataXml)) {
+    if(isValid) {
         Utils::message(p, tr("XML is valid."));
         result = true ;
     } else {
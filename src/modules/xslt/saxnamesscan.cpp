@@ -35,52 +35,41 @@ SaxNamesScan::~SaxNamesScan()
 }
 
 
-bool SaxNamesScan::startElement(const QString &/*namespaceURI*/, const QString &localName,
-                                const QString &qName, const QXmlAttributes &attributes)
+bool SaxNamesScan::isNew(QVector<bool> &seen, const int nameId)
 {
-    // names with and without ns
-    if(!qName.isEmpty()) {
-        _helper->addNameForAutocompletion(qName);
+    while(seen.size() <= nameId) {
+        seen.append(false);
     }
-    if(!localName.isEmpty()) {
-        _helper->addNameForAutocompletion(localName);
+    if(seen.at(nameId)) {
+        return false;
+    }
+    seen[nameId] = true ;
+    return true ;
+}
+
+// names are not processed for namespaces: the qualified names are collected
+bool SaxNamesScan::startElement(XmlStreamScanner *scanner, const int nameId, const QXmlStreamAttributes &attributes)
+{
+    if(isNew(_seenElements, nameId)) {
+        const QString &qName = scanner->name(nameId);
+        if(!qName.isEmpty()) {
+            _helper->addNameForAutocompletion(qName);
+        }
     }
     int count = attributes.count();
     for(int i = 0 ; i < count ; i ++) {
-        QString name ;
-        QString aLocalName = attributes.localName(i);
-        if(!localName.isEmpty()) {
-            name = QString("@%1").arg(aLocalName);
-            _helper->addNameForAutocompletion(name);
-        }
-        QString aqName = attributes.qName(i);
-        if(!aqName.isEmpty()) {
-            name = QString("@%1").arg(aqName);
-            _helper->addNameForAutocompletion(name);
+        const int attributeId = scanner->internName(attributes.at(i).qualifiedName());
+        if(isNew(_seenAttributes, attributeId)) {
+            const QString &aqName = scanner->name(attributeId);
+            if(!aqName.isEmpty()) {
+                _helper->addNameForAutocompletion(QString("@%1").arg(aqName));
+            }
         }
     }
     return true ;
 }
 
-
-bool SaxNamesScan::fatalError(const QXmlParseException &exception)
-{
-    Utils::error(QObject::tr("Parse error (2) at line %1, column %2:\n%3")
-                 .arg(exception.lineNumber())
-                 .arg(exception.columnNumber())
-                 .arg(exception.message()));
-    return false;
-}
-
-bool SaxNamesScan::error(const QXmlParseException &exception)
-{
-    Utils::error(QObject::tr("Parse error (1) at line %1, column %2:\n%3")
-                 .arg(exception.lineNumber())
-                 .arg(exception.columnNumber())
-                 .arg(exception.message()));
-    return false;
-}
-QString SaxNamesScan::errorString() const
+void SaxNamesScan::parseError(const QString &message)
 {
-    return QObject::tr("Generic error.");
+    Utils::error(message);
 }
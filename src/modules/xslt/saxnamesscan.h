@@ -24,26 +24,23 @@
 #ifndef SAXNAMESSCAN_H
 #define SAXNAMESSCAN_H
 
-#include <QXmlDefaultHandler>
 #include "modules/xslt/xslthelper.h"
+#include "modules/xml/xmlstreamscanner.h"
 
-class SaxNamesScan : public QXmlDefaultHandler
+class SaxNamesScan : public XmlScanHandler
 {
     XsltHelper *_helper;
+    // names already given to the helper, indexed by the scanner ids
+    QVector<bool> _seenElements;
+    QVector<bool> _seenAttributes;
+
+    static bool isNew(QVector<bool> &seen, const int nameId);
 public:
     explicit SaxNamesScan(XsltHelper *helper);
     virtual ~SaxNamesScan();
 
-    bool startElement(const QString &namespaceURI, const QString &localName,
-                      const QString &qName, const QXmlAttributes &attributes);
-    bool fatalError(const QXmlParseException &exception);
-    bool error(const QXmlParseException &exception);
-    QString errorString() const;
-
-signals:
-
-public slots:
-
+    bool startElement(XmlStreamScanner *scanner, const int nameId, const QXmlStreamAttributes &attributes);
+    void parseError(const QString &message);
 };
 
 #endif // SAXNAMESSCAN_H
@@ -740,19 +740,14 @@ bool XsltHelper::prepareEditElement(Element *selectedElement, XsltElementDialogP
 bool XsltHelper::loadNamesFromFile(const QString &fileName)
 {
     SaxNamesScan handler(this);
-    QXmlSimpleReader reader;
-    reader.setFeature("http://xml.org/sax/features/namespaces", false);
-    reader.setFeature("http://xml.org/sax/features/namespace-prefixes", true);
-    reader.setContentHandler(&handler);
-    reader.setErrorHandler(&handler);
+    XmlStreamScanner scanner;
 
     QFile file(fileName);
     if(!file.open(QFile::ReadOnly | QFile::Text)) {
         return false;
     }
     bool isOk = true ;
-    QXmlInputSource xmlInput(&file);
-    if(!reader.parse(xmlInput)) {
+    if(!scanner.scan(&file, &handler)) {
         isOk = false  ;
     }
     file.close();
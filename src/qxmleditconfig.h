@@ -93,6 +93,7 @@ public:
     static const QString KEY_SEARCH_FINDTARGET;
     static const QString KEY_SEARCH_SHOWSIZE;
     static const QString KEY_SEARCH_USEXQUERY;
+    static const QString KEY_SEARCH_USEINDEX;
     static const QString KEY_MAIN_HIDEVIEW;
     static const QString KEY_MAIN_EXPANDONLOAD;
     static const QString KEY_SEARCH_ITEMS;
@@ -149,6 +150,7 @@ public:
     static const QString  KEY_FRAGMENTS_OPERATION_TYPE;
     static const QString  KEY_FRAGMENTS_USENAMESPACES;
     static const QString  KEY_FRAGMENTS_FILTERSID;
+    static const QString  KEY_FRAGMENTS_SCRIPTINGTHREADS;
 
     // welcome dialog and user profiling
     static const QString  KEY_WELCOMEDIALOG_ENABLED;
@@ -243,6 +245,8 @@ public:
 
     // xml
     static const QString KEY_XML_SAVE_SORTATTRIBUTES;
+    static const QString KEY_XML_SAVE_INCREMENTAL;
+    static const QString KEY_XML_SAMPLE_STOPUNCHANGED;
     //deprecated: do not use
     static const QString deprecated_KEY_XML_LOAD_STREAM;//deprecated
     static const QString deprecated_KEY_XML_SAVE_STREAM;//deprecated
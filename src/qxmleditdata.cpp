@@ -39,14 +39,20 @@
 #include "modules/xslt/xsltmanager.h"
 #include "modules/services/anotifier.h"
 #include "modules/encoding/unicodehelper.h"
+#include "modules/utils/perftrace.h"
 
 const QString QXmlEditData::XsltStyleName = "XSLT";
 const QString QXmlEditData::XsltStyleDescription = tr("Xslt predefined style");
 const QString QXmlEditData::SCXMLStyleName = "SCXML";
 const QString QXmlEditData::SCXMLStyleDescription = tr("SCXML predefined style");
 
-QXmlEditData::QXmlEditData()
+/*!
+ * \brief \param isHeadless no widget, tray icon or clipboard is used: the data of a batch run
+ * under a QCoreApplication
+ */
+QXmlEditData::QXmlEditData(const bool isHeadless)
 {
+    _isHeadless = isHeadless ;
     _notifier = NULL ;
     _xsltManager  = NULL ;
     _unicodeHelper = NULL ;
@@ -71,7 +77,9 @@ QXmlEditData::QXmlEditData()
 
 QXmlEditData::~QXmlEditData()
 {
-    disconnect(QApplication::clipboard(), SIGNAL(dataChanged()), this, SLOT(onClipboardDataChanged()));
+    if(!_isHeadless) {
+        disconnect(QApplication::clipboard(), SIGNAL(dataChanged()), this, SLOT(onClipboardDataChanged()));
+    }
     foreach(VStyle * style, _styles) {
         delete style ;
     }
@@ -117,6 +125,11 @@ VStyle *QXmlEditData::getStyle(const QString &tag) const
     }
     foreach(VStyle * style, _styles) {
         if(style->name() == tag) {
+            // the rules are read on first use
+            if(!style->initFromResources()) {
+                Utils::error(tr("Unable to activate style"));
+                return NULL ;
+            }
             return style ;
         }
     }
@@ -132,7 +145,7 @@ VStyle *QXmlEditData::getPredefinedStyle(const QString &tag) const
         if(style->name() == tag) {
             // load from resources
             if(!style->initFromResources()) {
-                Utils::error("Unable to activate style");
+                Utils::error(tr("Unable to activate style"));
                 return NULL ;
             }
             return style ;
@@ -169,19 +182,16 @@ void QXmlEditData::init()
 void QXmlEditData::internalInit()
 {
     if(NULL == _defaultStyle) {
+        QXMLEDIT_TRACE_ZONE("startup", "styles");
         _defaultStyle = createDefaultStyle() ;
         if(!loadStyles()) {
             Utils::error(tr("Error loading styles"));
         }
     }
-    _notifier = new ANotifier();
-    _xsltManager = new XsltManager();
-    _unicodeHelper = new UnicodeHelper();
-    _copyAttributesManager = new CopyAttributesManager();
-    _colorManager = new ColorManager();
-    _searchManager = new SearchManager();
-    _namespaceManager = new NamespaceManager();
-    _xsdManager = new XSDManager();
+    // the managers are created on first use by their accessors
+    if(!_isHeadless) {
+        _notifier = new ANotifier();
+    }
     //--
     _xsltStyle = new VStyle(XsltStyleName, XsltStyleDescription);
     _xsltStyle->setResFileName(":/xslt/xsltStyle");
@@ -191,9 +201,15 @@ void QXmlEditData::internalInit()
     _SCXMLStyle->setResFileName(":/SCXML/scxmlStyle");
     _predefinedStyles.append(_SCXMLStyle);
     //--
-    _colorManager->readCfg();
     _experimentalFeaturesEnabled = Config::getBool(Config::KEY_MAIN_ENABLEEXPERIMENTS, false);
-    connect(QApplication::clipboard(), SIGNAL(dataChanged()), this, SLOT(onClipboardDataChanged()));
+    if(!_isHeadless) {
+        connect(QApplication::clipboard(), SIGNAL(dataChanged()), this, SLOT(onClipboardDataChanged()));
+    }
+}
+
+bool QXmlEditData::isHeadless() const
+{
+    return _isHeadless ;
 }
 
 /** hook for pre-delete
@@ -216,6 +232,11 @@ const QVector<VStyle*> &QXmlEditData::getPredefinedStyles() const
 
 ColorManager *QXmlEditData::colorManager()
 {
+    if(NULL == _colorManager) {
+        QXMLEDIT_TRACE_ZONE("startup", "colorManager");
+        _colorManager = new ColorManager();
+        _colorManager->readCfg();
+    }
     return _colorManager;
 }
 
@@ -420,6 +441,9 @@ void QXmlEditData::setExperimentalFeaturesEnabled(const bool value)
 //--- region(copyAttributes)
 CopyAttributesManager *QXmlEditData::copyAttributesManager()
 {
+    if(NULL == _copyAttributesManager) {
+        _copyAttributesManager = new CopyAttributesManager();
+    }
     return _copyAttributesManager;
 }
 //--- endregion(copyAttributes)
@@ -435,6 +459,9 @@ QStringList &QXmlEditData::searchTerms()
 
 XsltManager *QXmlEditData::xsltManager()
 {
+    if(NULL == _xsltManager) {
+        _xsltManager = new XsltManager();
+    }
     return _xsltManager ;
 }
 bool QXmlEditData::isShowXSLTPanel()
@@ -562,6 +589,9 @@ void QXmlEditData::setInsertPrologEncoding(const QString &value)
 
 SearchManager *QXmlEditData::searchManager()
 {
+    if(NULL == _searchManager) {
+        _searchManager = new SearchManager();
+    }
     return _searchManager;
 }
 
@@ -751,6 +781,9 @@ DataInterface *QXmlEditData::storageManager()
 void QXmlEditData::setStorageManager(DataInterface *value)
 {
     _dataInterface = value ;
+    if(NULL != _namespaceManager) {
+        _namespaceManager->setDataInterface(value);
+    }
 }
 
 //--- endregion(data)
@@ -791,6 +824,10 @@ void QXmlEditData::setXmlIndentAttributesType(const QXmlEditData::EIndentAttribu
 //--- region(xsdMode)
 XSDManager *QXmlEditData::xsdManager()
 {
+    if(NULL == _xsdManager) {
+        QXMLEDIT_TRACE_ZONE("startup", "xsdManager");
+        _xsdManager = new XSDManager();
+    }
     return _xsdManager;
 }
 
@@ -799,6 +836,10 @@ XSDManager *QXmlEditData::xsdManager()
 //--- region(NamespaceManager)
 NamespaceManager *QXmlEditData::namespaceManager()
 {
+    if(NULL == _namespaceManager) {
+        _namespaceManager = new NamespaceManager();
+        _namespaceManager->setDataInterface(storageManager());
+    }
     return _namespaceManager;
 }
 //--- endregion(NamespaceManager)
@@ -830,6 +871,9 @@ int QXmlEditData::styleVersion()
 
 UnicodeHelper *QXmlEditData::unicodeHelper()
 {
+    if(NULL == _unicodeHelper) {
+        _unicodeHelper = new UnicodeHelper();
+    }
     return _unicodeHelper ;
 }
 
@@ -29,6 +29,14 @@
 #include "modules/xml/elmpath.h"
 #include "editelementwithtexteditor.h"
 #include "modules/xml/xmlloadcontext.h"
+#include "modules/xml/xmlsourcemap.h"
+#include "modules/search/textsearchindex.h"
+#include "modules/utils/perftrace.h"
+#if QT_VERSION >= QT_VERSION_CHECK(5,1,0)
+#include <QSaveFile>
+#endif
+
+static const int MIB_UTF8 = 106 ;
 
 //-----
 TextEditorInterface::TextEditorInterface() {}
@@ -106,6 +114,11 @@ Regola::Regola()
 
 Regola::~Regola()
 {
+    if(NULL != _textIndex) {
+        delete _textIndex;
+        _textIndex = NULL ;
+    }
+    deleteSourceMap();
     bookmarks.clear();
     clear();
     if(NULL != _docType) {
@@ -124,6 +137,8 @@ void Regola::housework()
     paintInfo = new PaintInfo() ;
     _ownPaintInfo = true ;
     _forceDOM = false;
+    _textIndex = NULL ;
+    _sourceMap = NULL ;
     _attributesIndentSettings = false;
     _indentAttributes = QXmlEditData::XmlIndentAttributesTypeDefault;
     _indentAttributesColumns = QXmlEditData::XmlIndentAttributesColumnsDefault ;
@@ -134,13 +149,13 @@ void Regola::housework()
     _overrideGlobalIndentation = false;
     _indent = QXmlEditData::XmlIndentDefault ;
     _deviceProvider = NULL ;
-    _isCrapCacheNSActivated = false;
     _useMixedContent = false ;
     _undoStack.setUndoLimit(UndoLimitCount);
     _editHook = NULL ;
     _editTextHook = NULL ;
     connect(&_undoStack, SIGNAL(canRedoChanged(bool)), this, SIGNAL(undoStateChanged()));
     connect(&_undoStack, SIGNAL(canUndoChanged(bool)), this, SIGNAL(undoStateChanged()));
+    connect(&_undoStack, SIGNAL(indexChanged(int)), this, SLOT(onUndoIndexChanged(int)));
     _docType = new DocumentType();
     _originalEncoding = DefaultEncoding ;
 }
@@ -258,6 +273,7 @@ void Regola::caricaValori(QTreeWidget *pTree)
 
 void Regola::redisplay()
 {
+    QXMLEDIT_TRACE_ZONE("display", "redisplay");
     QVectorIterator<Element*> it(childItems);
     while(it.hasNext()) {
         Element *el = it.next();
@@ -327,6 +343,7 @@ bool Regola::isUseStreamForSaving()
 
 bool Regola::write(QIODevice *device, const bool isMarkSaved)
 {
+    QXMLEDIT_TRACE_ZONE("save", "write");
     if(isUseStreamForSaving()) {
         return writeStream(device, isMarkSaved);
     }
@@ -352,7 +369,9 @@ bool Regola::write(QIODevice *device, const bool isMarkSaved)
     streamOut.setCodec(theEncoding.toLatin1().data());
     streamOut << document.toString(_indent);
     streamOut.flush();
-    device->close();
+    if(!closeOutputDevice(device)) {
+        return false;
+    }
     if(isMarkSaved) {
         foreach(Element * ep, childItems) {
             ep->markSavedRecursive();
@@ -366,6 +385,7 @@ bool Regola::write(QIODevice *device, const bool isMarkSaved)
 
 bool Regola::writeStreamInternal(QIODevice *device, const bool useEncoding, ElementLoadInfoMap *map)
 {
+    QXMLEDIT_TRACE_ZONE("save", "serialize");
     if(!device->isOpen()) {
         // open the stream in binary, since the codec will take care of everything.
         if(!device->open(QIODevice::WriteOnly)) {
@@ -377,22 +397,29 @@ bool Regola::writeStreamInternal(QIODevice *device, const bool useEncoding, Elem
         updateMetaInfoFormatting();
     }
 
-    QXmlStreamWriter outputStream(device);
     XMLSaveContext context;
-    context.setIndentation(_indent);
-    context.setIsSortAttributesAlpha(isSavingSortingAttributes());
-    context.setAttributesMaxColumns(xmlIndentAttributesColumns());
-    context.setIsAttributesColumns(xmlIndentAttributesType() == QXmlEditData::AttributesIndentationMaxCols);
+    setupSaveContext(context);
 
+    QTextCodec *codec = NULL ;
+    if(useEncoding) {
+        codec = QTextCodec::codecForName(encoding().toLatin1());
+    }
+    if(NULL == codec) {
+        codec = QTextCodec::codecForName("UTF-8"); // this should be the default anyway
+    }
+    // UTF-8 is written through a text buffer encoded in bulk, not one string at a time
+    QString textBuffer ;
+    const bool isBuffered = (codec->mibEnum() == MIB_UTF8) && !context.isUsingDevicePosition();
+    QScopedPointer<QXmlStreamWriter> writer(isBuffered ? new QXmlStreamWriter(&textBuffer) : new QXmlStreamWriter(device));
+    QXmlStreamWriter &outputStream = *writer ;
     outputStream.setAutoFormatting(false);
     outputStream.setAutoFormattingIndent(_indent);
-    QString theEncoding = encoding();
-    if(useEncoding) {
-        outputStream.setCodec(theEncoding.toLatin1().data());
+    if(isBuffered) {
+        context.setOutputBuffer(&textBuffer, device);
     } else {
-        outputStream.setCodec("UTF-8"); // this should be the default anyway
+        outputStream.setCodec(codec);
     }
-    context.setCodec(outputStream.codec());
+    context.setCodec(codec);
     //Se monobyte, usa text mode e crlf, se multibyte, solo \n. Questo a causa di un bug nello streamwritew.
     // il mio codice inserisce crlf, quello di libreria, no.
     device->setTextModeEnabled(context.canUseTextMode());
@@ -415,9 +442,11 @@ bool Regola::writeStreamInternal(QIODevice *device, const bool useEncoding, Elem
     if((_indent >= 0) && !childItems.isEmpty()) {
         outputStream.writeCharacters("\n");
     }
-    device->close();
-
-    return true;
+    if(!context.flushOutput(true)) {
+        Utils::error(tr("Error writing data: %1").arg(device->errorString()));
+        return false;
+    }
+    return closeOutputDevice(device);
 }
 
 bool Regola::writeStream(QIODevice *device, const bool isMarkSaved, ElementLoadInfoMap *map)
@@ -479,10 +508,7 @@ bool Regola::writeStreamInternalElement(QIODevice *device, EExportOptions option
 
     QXmlStreamWriter outputStream(device);
     XMLSaveContext context;
-    context.setIndentation(_indent);
-    context.setIsSortAttributesAlpha(isSavingSortingAttributes());
-    context.setAttributesMaxColumns(xmlIndentAttributesColumns());
-    context.setIsAttributesColumns(xmlIndentAttributesType() == QXmlEditData::AttributesIndentationMaxCols);
+    setupSaveContext(context);
 
     outputStream.setAutoFormatting(false);
     outputStream.setAutoFormattingIndent(_indent);
@@ -517,9 +543,50 @@ bool Regola::writeStreamInternalElement(QIODevice *device, EExportOptions option
     return true;
 }
 
+void Regola::setupSaveContext(XMLSaveContext &context)
+{
+    context.setIndentation(_indent);
+    context.setIsSortAttributesAlpha(isSavingSortingAttributes());
+    context.setAttributesMaxColumns(xmlIndentAttributesColumns());
+    context.setIsAttributesColumns(xmlIndentAttributesType() == QXmlEditData::AttributesIndentationMaxCols);
+}
+
 bool Regola::write(const QString &filePath, const bool isMarkSaved)
 {
+    if(NULL != _sourceMap) {
+        // only the changed parts are written when the file read is still there
+        XmlSourceMap::EWriteResult result = XmlSourceMap::WriteNotApplicable ;
+        if((NULL == _deviceProvider) && isUseStreamForSaving() && isSaveIncremental()) {
+            QXMLEDIT_TRACE_ZONE("save", "incremental");
+            if(Config::getBool(Config::KEY_FORMATTING_INFO_ENABLED, true)) {
+                updateMetaInfoFormatting();
+            }
+            XMLSaveContext context;
+            setupSaveContext(context);
+            result = _sourceMap->write(this, &context, filePath);
+        }
+        if(XmlSourceMap::WriteDone == result) {
+            if(isMarkSaved) {
+                foreach(Element * ep, childItems) {
+                    ep->markSavedRecursive();
+                }
+            }
+            redisplay();
+            return true ;
+        }
+        // the positions are not valid after a complete save
+        deleteSourceMap();
+        if(XmlSourceMap::WriteError == result) {
+            return false;
+        }
+    }
+#if QT_VERSION >= QT_VERSION_CHECK(5,1,0)
+    // the data goes to a temporary file that replaces the original only when complete
+    QSaveFile   file(filePath);
+    file.setDirectWriteFallback(true);
+#else
     QFile   file(filePath);
+#endif
     QIODevice *outDevice = NULL ;
     if(NULL != _deviceProvider) {
         outDevice = _deviceProvider->newDeviceForWrite(filePath);
@@ -529,6 +596,25 @@ bool Regola::write(const QString &filePath, const bool isMarkSaved)
     return write(outDevice, isMarkSaved);
 }
 
+/*!
+ * \brief closes the device, a QSaveFile is committed renaming the temporary file
+ */
+bool Regola::closeOutputDevice(QIODevice *device)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5,1,0)
+    QSaveFile *saveFile = qobject_cast<QSaveFile*>(device);
+    if(NULL != saveFile) {
+        if(!saveFile->commit()) {
+            Utils::error(tr("Error writing data: %1").arg(saveFile->errorString()));
+            return false;
+        }
+        return true ;
+    }
+#endif
+    device->close();
+    return true ;
+}
+
 QByteArray Regola::writeMemory()
 {
     QByteArray byteArray ;
@@ -547,6 +633,21 @@ QString Regola::getAsText(ElementLoadInfoMap *map)
     return getAsTextStream(map);
 }
 
+/*!
+ * \brief builds a namespace aware DOM from the data, without writing and parsing them
+ */
+bool Regola::generateDomNS(QDomDocument &document, ElementLoadInfoMap *map)
+{
+    QHash<QString, QString> namespaces;
+    namespaces.insert("xml", "http://www.w3.org/XML/1998/namespace");
+    foreach(Element * element, childItems) {
+        if(!element->generateDomNS(document, document, map, namespaces)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 QString Regola::getAsTextStream(ElementLoadInfoMap *map)
 {
     QBuffer buffer ;
@@ -685,6 +786,12 @@ void Regola::setModified(const bool state)
         bookmarks.setModified();
         checkValidationReference();
     }
+    if(state) {
+        _namespaceScopes.invalidate();
+    }
+    if(state && (NULL != _textIndex)) {
+        _textIndex->documentChanged();
+    }
     if(state || stateChanged) {
         emit wasModified();
     }
@@ -1479,6 +1586,49 @@ void Regola::notifyDeletionTopElement(Element *pEl)
     }
 }
 
+/*!
+ * \brief Regola::setTextIndexEnabled the index is built in background and used to find all the occurrences
+ */
+void Regola::setTextIndexEnabled(const bool value)
+{
+    if(value) {
+        if(NULL == _textIndex) {
+            _textIndex = new TextSearchIndex(this);
+            _textIndex->start();
+        }
+    } else {
+        if(NULL != _textIndex) {
+            delete _textIndex;
+            _textIndex = NULL ;
+        }
+    }
+}
+
+TextSearchIndex *Regola::textIndex()
+{
+    return _textIndex ;
+}
+
+void Regola::notifyElementRemoved(Element *element)
+{
+    if(NULL != _sourceMap) {
+        _sourceMap->elementRemoved(element);
+    }
+}
+
+XmlSourceMap *Regola::sourceMap() const
+{
+    return _sourceMap;
+}
+
+void Regola::deleteSourceMap()
+{
+    if(NULL != _sourceMap) {
+        delete _sourceMap;
+        _sourceMap = NULL ;
+    }
+}
+
 // empty-> top, else append to element
 void Regola::addComment(QWidget *window, QTreeWidget *tree)
 {
@@ -2048,19 +2198,14 @@ bool Regola::loadXplore(const QString &fileName)
     xmlFileName = fileName ;
 
     XSaxHandler handler(this);
-    QXmlSimpleReader reader;
-    reader.setFeature("http://xml.org/sax/features/namespaces", false);
-    reader.setFeature("http://xml.org/sax/features/namespace-prefixes", true);
-    reader.setContentHandler(&handler);
-    reader.setErrorHandler(&handler);
+    XmlStreamScanner scanner;
 
     QFile file(fileName);
     if(!file.open(QFile::ReadOnly | QFile::Text)) {
         return false;
     }
     bool isOk = true ;
-    QXmlInputSource xmlInput(&file);
-    if(!reader.parse(xmlInput)) {
+    if(!scanner.scan(&file, &handler)) {
         isOk = false  ;
     }
     file.close();
@@ -2576,12 +2721,21 @@ int Regola::undoCount()
 
 void Regola::undo()
 {
-    return _undoStack.undo();
+    QXMLEDIT_TRACE_ZONE("undo", "undo");
+    _undoStack.undo();
+    // the commands restore the elements without notifying them
+    if(NULL != _textIndex) {
+        _textIndex->invalidate();
+    }
 }
 
 void Regola::redo()
 {
-    return _undoStack.redo();
+    QXMLEDIT_TRACE_ZONE("undo", "redo");
+    _undoStack.redo();
+    if(NULL != _textIndex) {
+        _textIndex->invalidate();
+    }
 }
 
 //--------------------------------------------------------------------------------
@@ -2918,25 +3072,23 @@ QSet<QString> Regola::namespacesURI()
     return result;
 }
 
-QString Regola::getCachedPrefixNS(const QString &nsURI)
+NamespaceScopeTable *Regola::namespaceScopes()
 {
-    if(!_isCrapCacheNSActivated) {
-        if(NULL != rootItem) {
-            _isCrapCacheNSActivated = true ;
-            foreach(Attribute * attribute, rootItem->getAttributesList()) {
-                if(attribute->name.startsWith("xmlns:")) {
-                    _crapCachePrefixNs[attribute->name] = attribute->value;
-                } else if(attribute->name == "xmlns") {
-                    _crapCachePrefixNs[attribute->name] = attribute->value;
-                }
-            } // foreach
-        }
-    }
-    QString str = _crapCachePrefixNs[nsURI];
-    if(NULL == str) {
-        str = "" ;
-    }
-    return str;
+    return &_namespaceScopes ;
+}
+
+/*!
+ * \brief to be called when namespace declarations or the structure of the document change
+ */
+void Regola::invalidateNamespaceScopes()
+{
+    _namespaceScopes.invalidate();
+}
+
+// every edit, undo and redo passes from here
+void Regola::onUndoIndexChanged(int /*index*/)
+{
+    _namespaceScopes.invalidate();
 }
 
 // static method
@@ -3139,6 +3291,11 @@ bool Regola::isSaveSortAlphaAttribute()
     return Config::getBool(Config::KEY_XML_SAVE_SORTATTRIBUTES, false);
 }
 
+bool Regola::isSaveIncremental()
+{
+    return Config::getBool(Config::KEY_XML_SAVE_INCREMENTAL, false);
+}
+
 Regola::ESaveAttributes Regola::saveAttributesMethod() const
 {
     return _saveAttributesMethod;
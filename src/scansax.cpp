@@ -127,14 +127,23 @@ ScanSax::~ScanSax()
 {
 }
 
+bool ScanSax::startDocument(XmlStreamScanner *scanner)
+{
+    deep = -1 ;
+    _tokenIds.clear();
+    foreach(const QString &token, info.tokens) {
+        _tokenIds.append(scanner->internName(token));
+    }
+    return true ;
+}
+
 //TODO: check if the axis is valid or we are seeking into a brother not to be searched
 /**
   Note: to check that the scan is proceding on the selected axis, we take advantage from the
   fact that nodes are visited in hierarchical order, that is the constraint is: to access a node, first
   the father has to be visited
 */
-bool ScanSax::startElement(const QString & /*namespaceURI*/, const QString &/*localName*/,
-                           const QString &qName, const QXmlAttributes &/*attributes*/)
+bool ScanSax::startElement(XmlStreamScanner * /*scanner*/, const int nameId, const QXmlStreamAttributes &/*attributes*/)
 {
     if(info.isAbort) {
         return false;
@@ -147,7 +156,7 @@ bool ScanSax::startElement(const QString & /*namespaceURI*/, const QString &/*lo
                 return true ;
             }
         }
-        if(info.tokens.at(deep) == qName) {
+        if(_tokenIds.at(deep) == nameId) {
             info.inAxisArray[deep] = true ;
             // deep < info.size is tested at the start of the funciton
             if(deep >= 0) {
@@ -166,8 +175,7 @@ bool ScanSax::startElement(const QString & /*namespaceURI*/, const QString &/*lo
     return true ;
 }
 
-bool ScanSax::endElement(const QString & /*namespaceURI*/, const QString & /*localName*/,
-                         const QString & /*qName*/)
+bool ScanSax::endElement(XmlStreamScanner * /*scanner*/, const int /*nameId*/)
 {
     if(info.isGroup) {
         if(info.inAxisArray[deep]) {
@@ -197,34 +205,10 @@ void ScanSax::setFinalCountForItem(const int level)
 }
 
 
-bool ScanSax::fatalError(const QXmlParseException &exception)
+void ScanSax::parseError(const QString &message)
 {
     if(info.isAbort) {
-        return false;
+        return ;
     }
-
-    Utils::error(QObject::tr("Parse error (2) at line %1, column %2:\n%3")
-                 .arg(exception.lineNumber())
-                 .arg(exception.columnNumber())
-                 .arg(exception.message()));
-    return false;
+    Utils::error(message);
 }
-
-bool ScanSax::error(const QXmlParseException &exception)
-{
-    if(info.isAbort) {
-        return false;
-    }
-
-    Utils::error(QObject::tr("Parse error (1) at line %1, column %2:\n%3")
-                 .arg(exception.lineNumber())
-                 .arg(exception.columnNumber())
-                 .arg(exception.message()));
-    return false;
-}
-
-QString ScanSax::errorString() const
-{
-    return QObject::tr("Generic error.");
-}
-
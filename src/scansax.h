@@ -23,8 +23,8 @@
 #ifndef SCANSAX_H
 #define SCANSAX_H
 
-#include <QXmlDefaultHandler>
 #include <QMap>
+#include "modules/xml/xmlstreamscanner.h"
 
 class XmlScanInfo
 {
@@ -50,23 +50,22 @@ public:
 };
 
 
-class ScanSax : public QXmlDefaultHandler
+class ScanSax : public XmlScanHandler
 {
     int deep;
     XmlScanInfo &info;
+    // the tokens of the path as names of the scanner
+    QVector<int> _tokenIds;
 
     void setFinalCountForItem(const int level);
 public:
     ScanSax(XmlScanInfo &newValue);
     ~ScanSax();
 
-    bool startElement(const QString &namespaceURI, const QString &localName,
-                      const QString &qName, const QXmlAttributes &attributes);
-    bool endElement(const QString &namespaceURI, const QString &localName,
-                    const QString &qName);
-    bool fatalError(const QXmlParseException &exception);
-    bool error(const QXmlParseException &exception);
-    QString errorString() const;
+    bool startDocument(XmlStreamScanner *scanner);
+    bool startElement(XmlStreamScanner *scanner, const int nameId, const QXmlStreamAttributes &attributes);
+    bool endElement(XmlStreamScanner *scanner, const int nameId);
+    void parseError(const QString &message);
 };
 
 #endif // SCANSAX_H
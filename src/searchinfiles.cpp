@@ -219,20 +219,14 @@ void SearchInFiles::searchInFileWorking(volatile bool *running, XmlScanInfo *inf
     }
 
     ScanSax handler(*info);
-    QXmlSimpleReader reader;
-    reader.setFeature("http://xml.org/sax/features/namespaces", false);
-    reader.setFeature("http://xml.org/sax/features/namespace-prefixes", true);
-    reader.setContentHandler(&handler);
-    reader.setErrorHandler(&handler);
-
+    XmlStreamScanner scanner;
     QFile file(filePath);
     if(!file.open(QFile::ReadOnly | QFile::Text)) {
         info->isError = true ;
         info->errorMessage = tr("Error opening input file.");
         return ;
     }
-    QXmlInputSource xmlInput(&file);
-    if(!reader.parse(xmlInput)) {
+    if(!scanner.scan(&file, &handler)) {
         info->isError = true ;
     }
     file.close();
@@ -118,6 +118,7 @@ SOURCES += sessionmanager.cpp \
     data_access/model/attrfilterdetail.cpp \
     data_access/model/genericpersistentdbdata.cpp \
     data_access/sqllitegenericdata.cpp \
+    data_access/sqllitewritebehind.cpp \
     sessionprivatedefault.cpp
 
 HEADERS +=  precompiled_lib.h \
@@ -141,6 +142,7 @@ HEADERS +=  precompiled_lib.h \
     sessionoperationstatus.h \
     data_access/sqllitedataaccess.h \
     data_access/sqllitedataaccessprivate.h \
+    data_access/sqllitewritebehind.h \
     data_access/model/filemodel.h \
     data_access/model/sessionlistmodel.h \
     widgets/sessiondetailwidget.h \
@@ -42,6 +42,10 @@ public:
     virtual void closeAndDispose() = 0 ;
 
     virtual bool enrollFile(SessionOperationStatus &context, SessionModel *model, const QString &filePath) = 0;
+    /** \brief true if the accesses are written by a background thread,
+      the completion is notified by the signal pendingWritesCompleted(int,bool)
+      */
+    virtual bool isWriteBehind();
 
     virtual bool newSession(SessionOperationStatus &context, SessionModel *model) = 0;
     virtual bool readSession(SessionOperationStatus &context, SessionModel *model) = 0;
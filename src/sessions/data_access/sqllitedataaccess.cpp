@@ -137,7 +137,6 @@
     TABLE_TAGS \
     " (tag)"
 
-#define FILE_FIELDS "f.id, f.path, f.description, f.creationdate, f.starred"
 #define OFFSET_ACCESS_FILEACCESS (5)
 
 //--------------------------
@@ -152,6 +151,11 @@ SessionDataInterface::~SessionDataInterface()
 {
 }
 
+bool SessionDataInterface::isWriteBehind()
+{
+    return false;
+}
+
 //--------------------------
 
 SQLLiteDataAccess::SQLLiteDataAccess(QObject *parent) :
@@ -187,6 +191,21 @@ void SQLLiteDataAccess::setLogger(FrwLogger *newLogger)
     d->setLogger(newLogger);
 }
 
+void SQLLiteDataAccess::setWriteBehindEnabled(const bool value)
+{
+    d->setWriteBehindEnabled(value);
+}
+
+bool SQLLiteDataAccess::flushPendingWrites()
+{
+    return d->flushPendingWrites();
+}
+
+bool SQLLiteDataAccess::isWriteBehind()
+{
+    return d->isWriteBehindActive();
+}
+
 void SQLLiteDataAccess::closeAndDispose()
 {
     d->close();
@@ -318,6 +337,8 @@ SQLLiteDataAccess::Private::Private(SQLLiteDataAccess *publicInterface, QObject
     _isInited = false;
     _logger = NULL ;
     _logInfo.source = LOG_TK;
+    _isWriteBehindEnabled = true ;
+    _writeBehind = NULL ;
 }
 
 SQLLiteDataAccess::Private::~Private()
@@ -327,6 +348,8 @@ SQLLiteDataAccess::Private::~Private()
 
 void SQLLiteDataAccess::Private::close()
 {
+    stopWriteBehind();
+    clearPreparedQueries();
     if(_db.isOpen() || _dbIsOpen) {
         _dbIsOpen = false;
         _db.close();
@@ -429,6 +452,90 @@ SQLLiteDataAccess::ErrorCode SQLLiteDataAccess::Private::getErrorCode()
     return _errorCode;
 }
 
+/**
+  \brief returns a statement prepared only once for the life of the connection.
+  */
+QSqlQuery &SQLLiteDataAccess::Private::preparedQuery(const QString &sql)
+{
+    QSqlQuery *query = _preparedQueries.value(sql, NULL);
+    if(NULL == query) {
+        query = new QSqlQuery(_db);
+        if(!query->prepare(sql)) {
+            if(_logger) {
+                _logger->error(QString("error preparing statement %1").arg(sql), &_logInfo);
+            }
+        }
+        _preparedQueries.insert(sql, query);
+    }
+    return *query;
+}
+
+void SQLLiteDataAccess::Private::clearPreparedQueries()
+{
+    foreach(QSqlQuery *query, _preparedQueries.values()) {
+        delete query;
+    }
+    _preparedQueries.clear();
+}
+
+void SQLLiteDataAccess::Private::setWriteBehindEnabled(const bool value)
+{
+    _isWriteBehindEnabled = value ;
+}
+
+bool SQLLiteDataAccess::Private::isWriteBehindActive()
+{
+    return NULL != _writeBehind ;
+}
+
+/**
+  \brief starts the database thread. In memory databases can not be shared between connections,
+   they are written synchronously.
+  */
+void SQLLiteDataAccess::Private::startWriteBehind(const QString &configuration)
+{
+    if(!_isWriteBehindEnabled || configuration.isEmpty() || configuration.startsWith(":memory:")) {
+        return ;
+    }
+    _writeBehind = new SQLLiteWriteBehind();
+    connect(_writeBehind, SIGNAL(batchWritten(int, bool)), p, SIGNAL(pendingWritesCompleted(int, bool)));
+    if(!_writeBehind->startWriter(configuration)) {
+        if(_logger) {
+            _logger->warning(QString("%1: write behind not available, using synchronous writes: %2").arg(LOG_TK).arg(_writeBehind->errorMessage()), &_logInfo);
+        }
+        delete _writeBehind;
+        _writeBehind = NULL ;
+    }
+}
+
+void SQLLiteDataAccess::Private::stopWriteBehind()
+{
+    if(NULL != _writeBehind) {
+        _writeBehind->stopWriter();
+        delete _writeBehind;
+        _writeBehind = NULL ;
+    }
+}
+
+/**
+  \brief waits for the pending writes, must be called before reading or changing data
+   touched by the database thread. A failed write is logged and reported only here,
+   it does not affect the operation that follows.
+  */
+bool SQLLiteDataAccess::Private::flushPendingWrites()
+{
+    if(NULL == _writeBehind) {
+        return true ;
+    }
+    if(!_writeBehind->flush()) {
+        if(_logger) {
+            _logger->error(QString("%1: error writing the file accesses: %2").arg(LOG_TK).arg(_writeBehind->errorMessage()), &_logInfo);
+        }
+        return false;
+    }
+    return true ;
+}
+
 //tested
 bool SQLLiteDataAccess::Private::initDB(const QString &configuration)
 {
@@ -446,6 +553,9 @@ bool SQLLiteDataAccess::Private::initDB(const QString &configuration)
     _connectionName = _db.connectionName();
     _dbIsOpen = true;
     bool isOk = createTables();
+    if(isOk) {
+        startWriteBehind(configuration);
+    }
     if(_logger) {
         _logger->info(QString("%1 end started code %2").arg(LOG_TK).arg(isOk), &_logInfo);
     }
@@ -466,6 +576,12 @@ bool SQLLiteDataAccess::Private::createTables()
         }
         return false ;
     }
+    if(!SQLLiteWriteBehind::configureConnection(_db)) {
+        // not fatal: the database works with the default journal
+        if(_logger) {
+            _logger->warning(QString("%1: write ahead log not available").arg(LOG_TK), &_logInfo);
+        }
+    }
     if(!query.exec(SQL_CREATE_TABLE_SESSIONS_IF_NOT_EXISTS)) {
         setError();
         if(_logger) {
@@ -573,6 +689,9 @@ bool SQLLiteDataAccess::Private::enrollFile(SessionOperationStatus &context, Ses
     if(_logger) {
         _logger->debug("SQLLiteDataAccess::Private::enrollFile enter", &_logInfo);
     }
+    if(NULL != _writeBehind) {
+        return enqueueEnrollment(context, model, filePath);
+    }
 
     if(!openTrans()) {
         setError();
@@ -611,6 +730,28 @@ bool SQLLiteDataAccess::Private::enrollFile(SessionOperationStatus &context, Ses
     return context.ok;
 }
 
+/**
+  \brief checks the session and queues the access for the database thread.
+  */
+bool SQLLiteDataAccess::Private::enqueueEnrollment(SessionOperationStatus &context, SessionModel *model, const QString &filePath)
+{
+    resetError();
+    if(!_knownSessions.contains(model->id)) {
+        SessionModel sessionModel;
+        if(!readSessionModel(&sessionModel, model->id)) {
+            if(_logger) {
+                _logger->error("SQLLiteDataAccess::Private::enqueueEnrollment session not found", &_logInfo);
+            }
+            context.ok = false;
+            return false;
+        }
+        _knownSessions.insert(model->id);
+    }
+    _writeBehind->enqueueEnrollment(model->id, filePath);
+    context.ok = true ;
+    return true ;
+}
+
 //tested chain
 bool SQLLiteDataAccess::Private::enrollFileInternal(SessionModel *inputSessionModel, const QString &filePath)
 {
@@ -656,20 +797,14 @@ bool SQLLiteDataAccess::Private::enrollFileInternal(SessionModel *inputSessionMo
     return true;
 }
 
-#define SQL_INSERT_FILEACCESS  ""\
-    "insert into FILE_SESSION_ACCESSES ( fileId, sessionId, accessDate) "\
-    " values ( "\
-    " :fileId, :sessionId, datetime('now', 'localtime') )"
-
 //tested
 bool SQLLiteDataAccess::Private::insertFileAccess(SessionModel *sessionModel, FileModel *fileModel)
 {
     if(_logger) {
         _logger->debug("SQLLiteDataAccess::insertFileAccess enter", &_logInfo);
     }
-    QSqlQuery query(_db) ;
+    QSqlQuery &query = preparedQuery(SQL_INSERT_FILEACCESS);
     bool isOk = true ;
-    query.prepare(SQL_INSERT_FILEACCESS);
     query.bindValue(":fileId", fileModel->id);
     query.bindValue(":sessionId", sessionModel->id);
     if(!query.exec()) {
@@ -686,8 +821,6 @@ bool SQLLiteDataAccess::Private::insertFileAccess(SessionModel *sessionModel, Fi
     return isOk ;
 }
 
-#define SQL_SELECT_FILE "select " FILE_FIELDS " from FILES f where f.path = :path"
-
 //tested chain
 void SQLLiteDataAccess::Private::readAFileModel(QSqlQuery &query, const int offset, FileModel *model)
 {
@@ -706,9 +839,9 @@ bool SQLLiteDataAccess::Private::getFile(FileModel *model, const QString & path,
         _logger->debug("SQLLiteDataAccess::getFile enter", &_logInfo);
     }
     isFound = false;
-    QSqlQuery query(_db) ;
+    flushPendingWrites();
+    QSqlQuery &query = preparedQuery(SQL_SELECT_FILE);
     bool isOk = false;
-    query.prepare(SQL_SELECT_FILE);
     query.bindValue(":path", path);
     if(query.exec()) {
         if(query.next()) {
@@ -737,20 +870,14 @@ bool SQLLiteDataAccess::Private::getFile(FileModel *model, const QString & path,
     return isOk ;
 }
 
-#define SQL_INSERT_FILE  ""\
-    "insert into FILES ( path, description, creationdate, starred) "\
-    " values ( "\
-    " :path, :description, datetime('now', 'localtime'), :starred )"
-
 //tested
 bool SQLLiteDataAccess::Private::insertFile(FileModel *model)
 {
     if(_logger) {
         _logger->debug("SQLLiteDataAccess::insertFile enter", &_logInfo);
     }
-    QSqlQuery query(_db) ;
+    QSqlQuery &query = preparedQuery(SQL_INSERT_FILE);
     bool isOk = true ;
-    query.prepare(SQL_INSERT_FILE);
     query.bindValue(":path", model->path);
     query.bindValue(":description", model->description);
     query.bindValue(":starred", model->starred);
@@ -824,8 +951,7 @@ bool SQLLiteDataAccess::Private::readSessionModel(SessionModel *model, const int
     if(_logger) {
         _logger->debug("SQLLiteDataAccess::readSessionModel", &_logInfo);
     }
-    QSqlQuery query(_db) ;
-    query.prepare(SQL_SELECT_SESSION);
+    QSqlQuery &query = preparedQuery(SQL_SELECT_SESSION);
     query.bindValue(":id", sessionId);
     if(query.exec()) {
         if(query.next()) {
@@ -868,8 +994,8 @@ bool SQLLiteDataAccess::Private::countSessionFileAccesses(SessionModel *sessionM
     if(_logger) {
         _logger->debug("SQLLiteDataAccess::countSessionFileAccesses", &_logInfo);
     }
-    QSqlQuery query(_db) ;
-    query.prepare(SQL_SELECT_SESS_ACC_F_SUM);
+    flushPendingWrites();
+    QSqlQuery &query = preparedQuery(SQL_SELECT_SESS_ACC_F_SUM);
     query.bindValue(":fileId", fileModel->id);
     query.bindValue(":sessionId", sessionModel->id);
     if(query.exec()) {
@@ -930,6 +1056,7 @@ bool SQLLiteDataAccess::Private::readSession(SessionOperationStatus &context, Se
         _logger->debug("SQLLiteDataAccess::Private::readSession", &_logInfo);
     }
 
+    flushPendingWrites();
     isOk = readSessionModel(model, model->id);
     if(isOk) {
         if(_logger) {
@@ -956,6 +1083,7 @@ bool SQLLiteDataAccess::Private::readSessionData(SessionOperationStatus &context
     if(_logger) {
         _logger->debug("SQLLiteDataAccess::Private::readSessionData enter", &_logInfo);
     }
+    flushPendingWrites();
     if(!openTrans()) {
         setError();
         if(_logger) {
@@ -1106,6 +1234,7 @@ QVector<SessionListModel*> SQLLiteDataAccess::Private::readSessionList(SessionOp
     if(_logger) {
         _logger->debug("SQLLiteDataAccess::readSessionList", &_logInfo);
     }
+    flushPendingWrites();
     QSqlQuery query(_db) ;
     query.prepare(SQL_SELECT_ACCESS_BY_SESSION);
     QSet<int> sessionMap;
@@ -1412,6 +1541,7 @@ bool SQLLiteDataAccess::Private::genericTransaction(SessionOperationStatus &cont
         _logger->debug(QString("Enter %1").arg(baseObj->idOperaz), &_logInfo);
     }
 
+    flushPendingWrites();
     if(!openTrans()) {
         setError();
         if(_logger) {
@@ -1447,6 +1577,11 @@ bool SQLLiteDataAccess::Private::genericTransaction(SessionOperationStatus &cont
             _logger->error(QString("%1 failed").arg(baseObj->idOperaz), &_logInfo);
         }
     }
+    // sessions and files could have been deleted
+    _knownSessions.clear();
+    if(NULL != _writeBehind) {
+        _writeBehind->invalidateCache();
+    }
     context.ok = isOk ;
     context.message = _errorMessage;
     return isOk;
@@ -1459,6 +1594,11 @@ bool SQLLiteDataAccess::Private::deleteAllSessionData(SessionOperationStatus &co
 {
     SqlOperDeleteAllSessionData oper(this, "deleteAllSessionData");
     if(genericTransaction(context, NULL, &oper)) {
+        if(NULL != _writeBehind) {
+            // the vacuum can take seconds, the database thread takes care of it
+            _writeBehind->enqueueVacuum();
+            return true ;
+        }
         QSqlQuery query(_db) ;
         query.prepare(SQL_VACUUM);
         if(!execQuery(query, "deleteAllSessionData: error in vacuumm")) {
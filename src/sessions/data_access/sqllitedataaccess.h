@@ -51,6 +51,10 @@ public:
     virtual void closeAndDispose() ;
 
     void setLogger(FrwLogger *logger);
+    //! must be called before init
+    void setWriteBehindEnabled(const bool value);
+    bool flushPendingWrites();
+    virtual bool isWriteBehind();
 
     virtual bool enrollFile(SessionOperationStatus &context, SessionModel *model, const QString &filePath);
     virtual bool newSession(SessionOperationStatus &context, SessionModel *model) ;
@@ -80,6 +84,7 @@ public:
     virtual OperationStatus* readGenericData(const QString &type, const int id, QList<GenericPersistentData*> &resultList);
     virtual GenericPersistentData *newPersistentDatum(const QString &type);
 signals:
+    void pendingWritesCompleted(const int count, const bool isOk);
 
 public slots:
 
@@ -31,6 +31,7 @@
 #include "dataresult.h"
 #include "model/attrfilterdetail.h"
 #include "model/attrfilterprofile.h"
+#include "sqllitewritebehind.h"
 
 
 //-- definitions
@@ -42,6 +43,30 @@
 #define TABLE_GENERIC_OBJECTS   "GENERIC_OBJECTS"
 #define TABLE_TAGS_RELATIONS "OBJECT_AND_TAGS"
 
+#define FILE_FIELDS "f.id, f.path, f.description, f.creationdate, f.starred"
+
+// shared with the write behind thread
+
+#define SQL_SELECT_FILE "select " FILE_FIELDS " from FILES f where f.path = :path"
+
+#define SQL_INSERT_FILE  ""\
+    "insert into FILES ( path, description, creationdate, starred) "\
+    " values ( "\
+    " :path, :description, datetime('now', 'localtime'), :starred )"
+
+#define SQL_INSERT_FILEACCESS  ""\
+    "insert into FILE_SESSION_ACCESSES ( fileId, sessionId, accessDate) "\
+    " values ( "\
+    " :fileId, :sessionId, datetime('now', 'localtime') )"
+
+// the access is written later, the date is the one of the request
+#define SQL_INSERT_FILEACCESS_WITH_DATE  ""\
+    "insert into FILE_SESSION_ACCESSES ( fileId, sessionId, accessDate) "\
+    " values ( "\
+    " :fileId, :sessionId, :accessDate )"
+
+#define SQL_DATETIME_FORMAT "yyyy-MM-dd hh:mm:ss"
+
 
 class SQLLiteDataAccess::Private : public QObject
 {
@@ -62,6 +87,10 @@ class SQLLiteDataAccess::Private : public QObject
     QString _dbErrorText;
     FrwLogger *_logger;
     LogInfo _logInfo;
+    bool _isWriteBehindEnabled;
+    SQLLiteWriteBehind *_writeBehind;
+    QSet<int> _knownSessions;
+    QHash<QString, QSqlQuery*> _preparedQueries;
 
     bool enrollFileInternal(SessionModel *model, const QString &filePath);
 
@@ -96,6 +125,12 @@ class SQLLiteDataAccess::Private : public QObject
     bool execQuery(const QString &queryLiteral, const QString &logData);
     bool execQuery(QSqlQuery &query, const QString &logData);
 
+    QSqlQuery &preparedQuery(const QString &sql);
+    void clearPreparedQueries();
+    void startWriteBehind(const QString &configuration);
+    void stopWriteBehind();
+    bool enqueueEnrollment(SessionOperationStatus &context, SessionModel *model, const QString &filePath);
+
     //------------------------------------------------------------
 
     // base of the generic operations
@@ -150,6 +185,9 @@ public:
     {
         return _connectionName;
     }
+    void setWriteBehindEnabled(const bool value);
+    bool isWriteBehindActive();
+    bool flushPendingWrites();
 
     SessionDataInterface::ErrorCode getErrorCode();
     void setLogger(FrwLogger *newLogger);
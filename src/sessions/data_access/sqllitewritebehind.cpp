@@ -0,0 +1,354 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#include "sqllitewritebehind.h"
+#include "sqllitedataaccessprivate.h"
+#include <QSqlError>
+#include <QVariant>
+#include <QMutexLocker>
+
+#define SQL_DRIVER  "QSQLITE"
+#define SQL_BUSY_TIMEOUT "PRAGMA busy_timeout = 5000"
+#define SQL_JOURNAL_MODE_WAL "PRAGMA journal_mode = WAL"
+#define SQL_SYNCHRONOUS_NORMAL "PRAGMA synchronous = NORMAL"
+#define SQL_ENABLE_FOREIGN_KEYS_WB "PRAGMA foreign_keys = ON"
+#define SQL_VACUUM_WB "vacuum"
+
+SQLLiteWriteBehind::Statements::Statements(QSqlDatabase &db) :
+    selectFile(db),
+    insertFile(db),
+    insertAccess(db)
+{
+}
+
+bool SQLLiteWriteBehind::Statements::prepare()
+{
+    if(!selectFile.prepare(SQL_SELECT_FILE)) {
+        return false;
+    }
+    if(!insertFile.prepare(SQL_INSERT_FILE)) {
+        return false;
+    }
+    if(!insertAccess.prepare(SQL_INSERT_FILEACCESS_WITH_DATE)) {
+        return false;
+    }
+    return true ;
+}
+
+//------------------------------------------------------------------------
+
+SQLLiteWriteBehind::SQLLiteWriteBehind(QObject *parent) :
+    QThread(parent)
+{
+    _isStarted = false;
+    _isOpen = false;
+    _isWriting = false;
+    _isStopping = false;
+    _isFlushRequested = false;
+    _isCacheInvalid = false;
+    _lastResult = true ;
+}
+
+SQLLiteWriteBehind::~SQLLiteWriteBehind()
+{
+    stopWriter();
+}
+
+/**
+  \brief Switches a connection to the write ahead log, so that the readers in the GUI
+   are not blocked by the writer and commits do not need a full sync.
+  */
+bool SQLLiteWriteBehind::configureConnection(QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    if(!query.exec(SQL_BUSY_TIMEOUT)) {
+        return false;
+    }
+    if(!query.exec(SQL_JOURNAL_MODE_WAL)) {
+        return false;
+    }
+    // the mode is not changed if the file system does not support it
+    bool isWal = false;
+    if(query.next()) {
+        isWal = (query.value(0).toString().toLower() == "wal");
+    }
+    query.finish();
+    if(isWal) {
+        if(!query.exec(SQL_SYNCHRONOUS_NORMAL)) {
+            return false;
+        }
+    }
+    return isWal ;
+}
+
+bool SQLLiteWriteBehind::startWriter(const QString &dbPath)
+{
+    _dbPath = dbPath ;
+    start();
+    QMutexLocker locker(&_mutex);
+    while(!_isStarted) {
+        _workDone.wait(&_mutex);
+    }
+    return _isOpen ;
+}
+
+void SQLLiteWriteBehind::stopWriter()
+{
+    if(!isRunning()) {
+        return ;
+    }
+    {
+        QMutexLocker locker(&_mutex);
+        _isStopping = true ;
+        _workAvailable.wakeAll();
+    }
+    wait();
+}
+
+void SQLLiteWriteBehind::enqueue(const Task &task)
+{
+    QMutexLocker locker(&_mutex);
+    _pending.append(task);
+    // the worker waits a little to coalesce the requests, wake it only when needed
+    if((_pending.size() == 1) || (_pending.size() >= MaxBatchSize)) {
+        _workAvailable.wakeAll();
+    }
+}
+
+void SQLLiteWriteBehind::enqueueEnrollment(const int sessionId, const QString &filePath)
+{
+    enqueue(Task(TASK_ENROLL, sessionId, filePath));
+}
+
+void SQLLiteWriteBehind::enqueueVacuum()
+{
+    enqueue(Task(TASK_VACUUM, 0, ""));
+}
+
+/**
+  \brief waits until all the pending requests are written.
+  \return false if any write since the last flush failed
+  */
+bool SQLLiteWriteBehind::flush()
+{
+    QMutexLocker locker(&_mutex);
+    if(_isStarted && _isOpen) {
+        _isFlushRequested = true ;
+        _workAvailable.wakeAll();
+        while(!_pending.isEmpty() || _isWriting) {
+            _workDone.wait(&_mutex);
+        }
+        _isFlushRequested = false ;
+    }
+    bool result = _lastResult ;
+    _lastResult = true ;
+    return result ;
+}
+
+/**
+  \brief the file ids cached by the worker must be reloaded, i.e. files were deleted.
+  */
+void SQLLiteWriteBehind::invalidateCache()
+{
+    QMutexLocker locker(&_mutex);
+    _isCacheInvalid = true ;
+}
+
+QString SQLLiteWriteBehind::errorMessage()
+{
+    QMutexLocker locker(&_mutex);
+    return _errorMessage ;
+}
+
+void SQLLiteWriteBehind::setWorkerError(const QString &message)
+{
+    QMutexLocker locker(&_mutex);
+    _errorMessage = message ;
+    _lastResult = false;
+}
+
+void SQLLiteWriteBehind::run()
+{
+    const QString connectionName = QString("qxmledit-wb-%1").arg((ulong)(void*)this);
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase(SQL_DRIVER, connectionName);
+        db.setDatabaseName(_dbPath);
+        bool isOpen = false;
+        if(db.open()) {
+            QSqlQuery query(db);
+            isOpen = query.exec(SQL_ENABLE_FOREIGN_KEYS_WB) && configureConnection(db);
+        }
+        if(!isOpen) {
+            setWorkerError(db.lastError().text());
+        }
+        {
+            Statements statements(db);
+            if(isOpen) {
+                isOpen = statements.prepare();
+            }
+            {
+                QMutexLocker locker(&_mutex);
+                _isOpen = isOpen ;
+                _isStarted = true ;
+                _workDone.wakeAll();
+            }
+            if(isOpen) {
+                processTasks(db, statements);
+            }
+        }
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
+void SQLLiteWriteBehind::processTasks(QSqlDatabase &db, Statements &statements)
+{
+    forever {
+        QList<Task> batch;
+        {
+            QMutexLocker locker(&_mutex);
+            while(_pending.isEmpty() && !_isStopping) {
+                _workAvailable.wait(&_mutex);
+            }
+            if(_pending.isEmpty()) {
+                // stopping and nothing left to write
+                break;
+            }
+            if(!_isStopping && !_isFlushRequested && (_pending.size() < MaxBatchSize)) {
+                _workAvailable.wait(&_mutex, CoalesceDelayMs);
+            }
+            batch = _pending ;
+            _pending.clear();
+            _isWriting = true ;
+            if(_isCacheInvalid) {
+                _isCacheInvalid = false;
+                _fileIds.clear();
+            }
+        }
+        const bool isOk = writeBatch(db, statements, batch);
+        {
+            QMutexLocker locker(&_mutex);
+            _isWriting = false ;
+            _workDone.wakeAll();
+        }
+        emit batchWritten(batch.size(), isOk);
+    }
+}
+
+bool SQLLiteWriteBehind::writeBatch(QSqlDatabase &db, Statements &statements, const QList<Task> &batch)
+{
+    bool isOk = true ;
+    bool isInTransaction = false;
+    foreach(const Task &task, batch) {
+        if(TASK_VACUUM == task.type) {
+            if(isInTransaction) {
+                if(!db.commit()) {
+                    setWorkerError(db.lastError().text());
+                    isOk = false;
+                }
+                isInTransaction = false;
+            }
+            if(!vacuum(db)) {
+                isOk = false;
+            }
+            continue;
+        }
+        if(!isInTransaction) {
+            if(!db.transaction()) {
+                setWorkerError(db.lastError().text());
+                return false;
+            }
+            isInTransaction = true ;
+        }
+        // a failed statement does not abort the transaction, the other accesses are kept
+        if(!writeEnrollment(statements, task)) {
+            isOk = false;
+        }
+    }
+    if(isInTransaction) {
+        if(!db.commit()) {
+            setWorkerError(db.lastError().text());
+            db.rollback();
+            _fileIds.clear();
+            isOk = false;
+        }
+    }
+    return isOk ;
+}
+
+bool SQLLiteWriteBehind::writeEnrollment(Statements &statements, const Task &task)
+{
+    int fileId = 0 ;
+    if(!findOrInsertFile(statements, task.path, fileId)) {
+        return false;
+    }
+    statements.insertAccess.bindValue(":fileId", fileId);
+    statements.insertAccess.bindValue(":sessionId", task.sessionId);
+    statements.insertAccess.bindValue(":accessDate", task.requestDate.toString(SQL_DATETIME_FORMAT));
+    if(!statements.insertAccess.exec()) {
+        setWorkerError(statements.insertAccess.lastError().text());
+        return false;
+    }
+    return true ;
+}
+
+bool SQLLiteWriteBehind::findOrInsertFile(Statements &statements, const QString &path, int &fileId)
+{
+    if(_fileIds.contains(path)) {
+        fileId = _fileIds.value(path);
+        return true ;
+    }
+    statements.selectFile.bindValue(":path", path);
+    if(!statements.selectFile.exec()) {
+        setWorkerError(statements.selectFile.lastError().text());
+        return false;
+    }
+    const bool isFound = statements.selectFile.next();
+    if(isFound) {
+        fileId = statements.selectFile.value(0).toInt();
+    }
+    statements.selectFile.finish();
+    if(!isFound) {
+        statements.insertFile.bindValue(":path", path);
+        statements.insertFile.bindValue(":description", QString());
+        statements.insertFile.bindValue(":starred", 0);
+        if(!statements.insertFile.exec()) {
+            setWorkerError(statements.insertFile.lastError().text());
+            return false;
+        }
+        fileId = statements.insertFile.lastInsertId().toInt();
+    }
+    _fileIds.insert(path, fileId);
+    return true ;
+}
+
+bool SQLLiteWriteBehind::vacuum(QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    if(!query.exec(SQL_VACUUM_WB)) {
+        setWorkerError(query.lastError().text());
+        return false;
+    }
+    return true ;
+}
@@ -0,0 +1,130 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef SQLLITEWRITEBEHIND_H
+#define SQLLITEWRITEBEHIND_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QHash>
+#include <QList>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QDateTime>
+
+/**
+  \brief Dedicated database thread that writes the session accesses behind the GUI.
+  The thread owns its own connection to the sessions database, collects the requests
+  and writes them in batched transactions using statements prepared only once.
+  */
+class SQLLiteWriteBehind : public QThread
+{
+    Q_OBJECT
+
+public:
+    enum ETaskType {
+        TASK_ENROLL,
+        TASK_VACUUM
+    };
+
+private:
+    class Task
+    {
+    public:
+        ETaskType type;
+        int sessionId;
+        QString path;
+        QDateTime requestDate;
+
+        Task(const ETaskType newType, const int newSessionId, const QString &newPath)
+        {
+            type = newType;
+            sessionId = newSessionId;
+            path = newPath ;
+            requestDate = QDateTime::currentDateTime();
+        }
+    };
+
+    class Statements
+    {
+    public:
+        QSqlQuery selectFile;
+        QSqlQuery insertFile;
+        QSqlQuery insertAccess;
+
+        Statements(QSqlDatabase &db);
+        bool prepare();
+    };
+
+    static const int CoalesceDelayMs = 50;
+    static const int MaxBatchSize = 1000;
+
+    QString _dbPath;
+    QMutex _mutex;
+    QWaitCondition _workAvailable;
+    QWaitCondition _workDone;
+    QList<Task> _pending;
+    bool _isStarted;
+    bool _isOpen;
+    bool _isWriting;
+    bool _isStopping;
+    bool _isFlushRequested;
+    bool _isCacheInvalid;
+    bool _lastResult;
+    QString _errorMessage;
+    // written only by the worker thread
+    QHash<QString, int> _fileIds;
+
+    void enqueue(const Task &task);
+    void processTasks(QSqlDatabase &db, Statements &statements);
+    bool writeBatch(QSqlDatabase &db, Statements &statements, const QList<Task> &batch);
+    bool writeEnrollment(Statements &statements, const Task &task);
+    bool findOrInsertFile(Statements &statements, const QString &path, int &fileId);
+    bool vacuum(QSqlDatabase &db);
+    void setWorkerError(const QString &message);
+
+protected:
+    void run();
+
+public:
+    explicit SQLLiteWriteBehind(QObject *parent = 0);
+    ~SQLLiteWriteBehind();
+
+    bool startWriter(const QString &dbPath);
+    void stopWriter();
+
+    void enqueueEnrollment(const int sessionId, const QString &filePath);
+    void enqueueVacuum();
+    bool flush();
+    void invalidateCache();
+    QString errorMessage();
+
+    static bool configureConnection(QSqlDatabase &db);
+
+signals:
+    void batchWritten(const int count, const bool isOk);
+};
+
+#endif // SQLLITEWRITEBEHIND_H
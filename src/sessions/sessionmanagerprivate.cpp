@@ -37,6 +37,7 @@ SessionManager::Private::Private(SessionManager* manager, QObject *parent) :
     _isEnabled = false ;
     _currentSession = NULL ;
     _dataAccess = NULL ;
+    _isRefreshPending = false;
 }
 
 SessionManager::Private::~Private()
@@ -86,6 +87,11 @@ void SessionManager::Private::setEnabled(const bool value)
     if(startDB && (NULL != _dataAccess)) {
         if(!_dataAccess->init(_storageConfiguration)) {
             emit _manager->storageError("Session storage could not be inited.");
+        } else if(_dataAccess->isWriteBehind()) {
+            QObject *source = dynamic_cast<QObject*>(_dataAccess);
+            if(NULL != source) {
+                connect(source, SIGNAL(pendingWritesCompleted(int, bool)), this, SLOT(onPendingWritesCompleted(int, bool)), Qt::UniqueConnection);
+            }
         }
     }
     emit _manager->enablingChanged();
@@ -190,8 +196,11 @@ bool SessionManager::Private::enrollFile(const QString &filePath)
         if(NULL != _currentSession) {
             bool result = _currentSession ->enrollFile(_dataAccess, filePath);
             if(result) {
-                _currentSession->read(_dataAccess, _currentSession ->id());
-                emit _manager->dataChanged();
+                // with a write behind storage the data is read when written
+                _isRefreshPending = true ;
+                if(!_dataAccess->isWriteBehind()) {
+                    refreshPendingSessionData();
+                }
             }
             return result ;
         }
@@ -205,11 +214,29 @@ SessionSummary* SessionManager::Private::getSummary(SessionOperationStatus &cont
         _logger->debug("SessionManager::getSummaryData");
     }
     if(isEnabled() && (NULL != _currentSession)) {
+        refreshPendingSessionData();
         return _currentSession->getSummary(context);
     }
     return NULL ;
 }
 
+void SessionManager::Private::refreshPendingSessionData()
+{
+    if(_isRefreshPending && (NULL != _currentSession)) {
+        _isRefreshPending = false;
+        _currentSession->read(_dataAccess, _currentSession->id());
+        emit _manager->dataChanged();
+    }
+}
+
+void SessionManager::Private::onPendingWritesCompleted(const int /*count*/, const bool isOk)
+{
+    if(!isOk && _logger) {
+        _logger->error("SessionManager: error writing the file accesses");
+    }
+    refreshPendingSessionData();
+}
+
 bool SessionManager::Private::setActiveSession(const int idSession, const Session::SessionState sessionState)
 {
     if(_logger) {
@@ -43,9 +43,11 @@ class SessionManager::Private : public QObject
     QString _storageConfiguration ;
     QStringList _lastFiles;
     FrwLogger *_logger;
+    bool _isRefreshPending;
 
     void refreshCurrentSessionData(UIDelegate *uiDelegate);
     void activateSession(const Session::SessionState newState = Session::Active);
+    void refreshPendingSessionData();
 
 public:
     explicit Private(SessionManager* manager, QObject *parent = 0);
@@ -96,6 +98,7 @@ signals:
 
 public slots:
     void onSessionDeleted(const int sessionCode);
+    void onPendingWritesCompleted(const int count, const bool isOk);
 
 };
 
@@ -29,6 +29,7 @@ StartParams::StartParams()
     type = Nothing;
     parametersError = false ;
     forceSaxon = false;
+    threads = 0 ;
 }
 
 StartParams::~StartParams()
@@ -128,6 +129,27 @@ bool StartParams::decodeCommandLine(QStringList args)
             this->fileName = inputFile ;
             this->xsl = xslFile;
             this->outputFile = outputFile ;
+        } else if(arg1 == QString("-batch")) {
+            this->type = StartParams::Batch ;
+            for(int i = 2 ; i < size ; i ++) {
+                const QString &parameter = args.at(i);
+                if(parameter.indexOf("-threads=") == 0) {
+                    bool isOk = false;
+                    this->threads = parameter.mid(9).toInt(&isOk);
+                    if(!isOk || (this->threads <= 0)) {
+                        this->parametersError = true ;
+                        this->errorMessage = QObject::tr("The number of threads is not valid.");
+                        return false;
+                    }
+                } else {
+                    this->fileName = parameter ;
+                }
+            }
+            if(this->fileName.isEmpty()) {
+                this->parametersError = true ;
+                this->errorMessage = QObject::tr("Job list file not specified.");
+                return false;
+            }
         } else {
             this->fileName = args.at(1);
             if(!this->fileName.isEmpty()) {
@@ -142,3 +164,14 @@ bool StartParams::decodeCommandLine(QStringList args)
     return true;
 }
 
+/*!
+ * \brief StartParams::isBatchCommandLine tells, before the application object exists,
+ * if the batch mode is requested, the batch mode does not use the graphic system.
+ */
+bool StartParams::isBatchCommandLine(int argc, char *argv[])
+{
+    if(argc > 1) {
+        return QString(argv[1]) == QString("-batch");
+    }
+    return false;
+}
@@ -25,6 +25,7 @@
 #include "stylepersistence.h"
 #include "utils.h"
 #include "element.h"
+#include "modules/utils/perftrace.h"
 
 //----------------------------------------------------------
 StyleCalc::StyleCalc(const QString &newTp)
@@ -873,6 +874,7 @@ StyleEntry* VStyle::getStyleOfKeyword(const QString &kw)
 
 StyleEntry* VStyle::getCalculatedStyle(Element *element)
 {
+    QXMLEDIT_TRACE_COUNTER("style.calculatedStyles", 1);
     foreach(StyleRuleSet * rs, _ruleSets) {
         if(rs->evaluate(element)) {
             QString idStyle = rs->idStyle();
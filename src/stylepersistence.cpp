@@ -26,6 +26,7 @@
 
 #include <QFile>
 #include <QDir>
+#include <QXmlStreamReader>
 
 #define STYLE_ROOT_ELEMENT          "style"
 #define STYLESETENTRY_TAGNAME       "styles"
@@ -428,10 +429,46 @@ bool StylePersistence::scanDirectory(const QString &dirName, QVector<VStyle*> *s
     dir.setNameFilters(names);
     QFileInfoList fileList = dir.entryInfoList();
     foreach(QFileInfo info, fileList) {
-        if(!readStyleFile(styles, info.absoluteFilePath())) {
+        if(!readStyleHeader(styles, info.absoluteFilePath())) {
             isOK = false ;
         }
     }
     return isOK;
 }
 
+/*!
+ * \brief reads only the attributes of the root element of a style file.
+ * The rules are parsed by VStyle::initFromResources() on first use,
+ * so the startup does not pay for styles that are never activated.
+ */
+bool StylePersistence::readStyleHeader(QVector<VStyle*> *styles, const QString & filePath)
+{
+    bool isOk = false;
+    QFile file(filePath);
+    if(file.open(QIODevice::ReadOnly)) {
+        QXmlStreamReader reader(&file);
+        while(!reader.atEnd()) {
+            if(reader.readNext() == QXmlStreamReader::StartElement) {
+                break;
+            }
+        }
+        if(reader.isStartElement()) {
+            QXmlStreamAttributes attributes = reader.attributes();
+            VStyle *style = new VStyle(attributes.value("name").toString(), attributes.value("description").toString());
+            QString nameSpace = attributes.value(STYLE_NAMESPACE).toString();
+            if(!nameSpace.isEmpty()) {
+                style->setNamespace(nameSpace);
+            }
+            style->setResFileName(filePath);
+            styles->append(style);
+            isOk = true ;
+        } else {
+            Utils::error(tr("Unable to parse XML"));
+        }
+        file.close();
+    } else {
+        Utils::error(QString(tr("Unable to load file.\n Error code is '%1'")).arg(file.error()));
+    }
+    return isOk ;
+}
+
@@ -49,6 +49,7 @@ private:
     bool scanStyleData(VStyle *style, QDomNode &rootNode);
     bool scanData(QVector<VStyle*> *styles, QDomNode &rootNode);
     bool readStyleFile(QVector<VStyle*> *styles, const QString & filePath);
+    bool readStyleHeader(QVector<VStyle*> *styles, const QString & filePath);
     void completeStyle(VStyle *style);
     bool scanDataSingleStyle(VStyle* style, QDomNode &rootNode);
     bool collectDefault(VStyle *style, QDomNodeList nodes);
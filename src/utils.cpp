@@ -27,6 +27,7 @@
 #include "regola.h"
 #include "utils.h"
 #include "qxmleditconfig.h"
+#include "modules/utils/base64utils.h"
 
 #define BATCH_ON_NOZERO    (0x55)
 
@@ -60,6 +61,15 @@ bool Utils::isSilenceMode()
         && !filler1  && !filler2 ;
 }
 
+/*!
+ * \brief isNotGUIThread the message boxes can be shown only by the GUI thread,
+ * the workers only log the messages
+ */
+static bool isNotGUIThread()
+{
+    return (NULL == qApp) || (QThread::currentThread() != qApp->thread());
+}
+
 void Utils::error(const QString & message)
 {
     Utils::error(NULL, message) ;
@@ -68,7 +78,7 @@ void Utils::error(const QString & message)
 void Utils::error(QWidget *parent, const QString & message)
 {
     qWarning("%s", message.toLatin1().data());
-    if(isSilenceMode()) {
+    if(isSilenceMode() || isNotGUIThread()) {
         return ;
     }
     QMessageBox::critical(parent, QXmlEditGlobals::appTitle(), message) ;
@@ -82,7 +92,7 @@ void Utils::warning(const QString & message)
 void Utils::warning(QWidget *parent, const QString & message)
 {
     qWarning("%s", message.toLatin1().data());
-    if(isSilenceMode()) {
+    if(isSilenceMode() || isNotGUIThread()) {
         return ;
     }
     QMessageBox::warning(parent, QXmlEditGlobals::appTitle(), message) ;
@@ -98,7 +108,7 @@ void Utils::message(const QString & message)
 
 void Utils::message(QWidget *parent, const QString & message)
 {
-    if(isSilenceMode()) {
+    if(isSilenceMode() || isNotGUIThread()) {
         return ;
     }
     QMessageBox::information(parent, QXmlEditGlobals::appTitle(), message) ;
@@ -273,8 +283,8 @@ int Utils::decodeInt(const QString &str, const int defaultVale)
 
 QString Utils::fromBase64Xml(const QString &text)
 {
-    QByteArray array(text.toLatin1());
-    QByteArray array2 = QByteArray::fromBase64(array);
+    Base64Utils base64Utils;
+    QByteArray array2 = base64Utils.fromBase64(Base64Utils::RFC4648Standard, text);
     // safe string
     QXmlInputSource xmlInputSource;
     xmlInputSource.setData(array2);
@@ -284,8 +294,8 @@ QString Utils::fromBase64Xml(const QString &text)
 
 QString Utils::fromBase64(const QString &text)
 {
-    QByteArray array(text.toLatin1());
-    QByteArray array2 = QByteArray::fromBase64(array);
+    Base64Utils base64Utils;
+    QByteArray array2 = base64Utils.fromBase64(Base64Utils::RFC4648Standard, text);
     // safe string
     QString strText = QString::fromUtf8(array2.data(), array2.length());
     return strText;
@@ -293,11 +303,8 @@ QString Utils::fromBase64(const QString &text)
 
 QString Utils::toBase64(const QString &text)
 {
-    QByteArray array;
-    array.append(text.toUtf8());
-    QByteArray converted = array.toBase64();
-    QString strBase64 = converted.data();
-    return strBase64 ;
+    Base64Utils base64Utils;
+    return base64Utils.toBase64(Base64Utils::RFC4648Standard, text.toUtf8());
 }
 
 //-------------------------------------------------------
@@ -46,6 +46,7 @@
 #include <QToolTip>
 #include <QMenu>
 #include <QElapsedTimer>
+#include <qmath.h>
 #include "utils.h"
 #include "modules/services/uidservices.h"
 #include "modules/services/threadservices.h"
@@ -95,6 +96,7 @@ DataWidget::DataWidget(QWidget *parent) :
     _newData = false;
     _dataPoints = NULL;
     _dataPointsMask = NULL ;
+    _dilatedRows = NULL ;
     _bkColor = DEFAULT_BACKGROUND_COLOR ;
     _emptyValueColor = DEFAULT_GRAY_COLOR;
     _loudness = NoLoudness;
@@ -284,6 +286,7 @@ void DataWidget::losePoints()
 void DataWidget::setData(ElementBase *data)
 {
     _data = data;
+    _tables.clear();
     recalc();
 }
 
@@ -292,6 +295,11 @@ int DataWidget::levels()
     return _dataMap->numColumns;
 }
 
+QRect DataWidget::dataWindow() const
+{
+    return _dataWindow;
+}
+
 void DataWidget::recalc()
 {
     if(_freeze) {
@@ -406,6 +414,9 @@ void DataWidget::generateImage(const bool forceStandard)
             if(forceStandard) {
                 computeImageStandard();
             } else {
+                if(Distribution != _measType) {
+                    buildTables();
+                }
                 if(_mtEnabled && (Distribution != _measType)) {
                     computeImageThreaded();
                 } else {
@@ -627,36 +638,72 @@ void DataWidget::computeImageThreaded()
     //items[lastItem] += lastWindowFraction ;
     int starty = 0 ;
     QList<QFuture<void> > results;
+    QSemaphore slicesDone;
 
     foreach(int thisWindowHeight, items) {
         int endy = starty + thisWindowHeight ;
-        results.append(QtConcurrent::run(this, &DataWidget::computeImageSlice, starty, endy));
+        results.append(QtConcurrent::run(this, &DataWidget::computeImageSliceSignaling, starty, endy, &slicesDone));
         starty += windowsHeight ;
     }
-    waitCalcImage(results);
+    waitCalcImage(results, slicesDone);
 }
 
-void DataWidget::waitCalcImage(QList<QFuture<void> > &threads)
+void DataWidget::computeImageSliceSignaling(const int paramStartY, const int paramEndY, QSemaphore *slicesDone)
 {
-    QElapsedTimer timer;
-    timer.start();
-    bool done = false;
-    UIDesktopServices uiServices(mainWindow());
-    while(!done) {
-        ThreadServices::msleep(250);
-        if(timer.elapsed() > (THRESHOLD_SECONDS * 1000)) {
-            uiServices.startIconProgressBar();
-            uiServices.setIconProgressBar(50);
-        }
-        done = true ;
-        foreach(QFuture<void> future, threads) {
-            if(!future.isFinished()) {
-                done = false;
-                break;
-            }
-        }
+    computeImageSlice(paramStartY, paramEndY);
+    slicesDone->release();
+}
+
+/*!
+ * \brief DataWidget::waitCalcImage each slice signals its end; the progress is shown only if the wait is long
+ */
+void DataWidget::waitCalcImage(QList<QFuture<void> > &threads, QSemaphore &slicesDone)
+{
+    const int slices = threads.size();
+    if(!slicesDone.tryAcquire(slices, THRESHOLD_SECONDS * 1000)) {
+        UIDesktopServices uiServices(mainWindow());
+        uiServices.startIconProgressBar();
+        uiServices.setIconProgressBar(50);
+        slicesDone.acquire(slices);
+        uiServices.endIconProgressBar();
+    }
+    foreach(QFuture<void> future, threads) {
+        future.waitForFinished();
+    }
+}
+
+/*!
+ * \brief DataWidget::buildTables the tables depend only on the map and on the value shown,
+ * zoom, position and slice reuse them
+ */
+void DataWidget::buildTables()
+{
+    PtrToValue valueFunction = getGetValueFunction();
+    if(!_tables.isBuiltFor(_dataMap, valueFunction)) {
+        _tables.build(_dataMap, valueFunction, _mtEnabled);
+    }
+}
+
+/*!
+ * \brief DataWidget::runInSlices runs the function on bands of the image rows, in parallel if enabled
+ */
+void DataWidget::runInSlices(void (*function)(DataWidget *, const int, const int))
+{
+    const int heightImage = _yPoints ;
+    int threads = QThread::idealThreadCount();
+    if(!_mtEnabled || (threads <= 1) || (heightImage < threads)) {
+        function(this, 0, heightImage);
+        return ;
+    }
+    QList<QFuture<void> > results;
+    int starty = 0 ;
+    foreach(int thisWindowHeight, computeSlices(threads, heightImage)) {
+        results.append(QtConcurrent::run(function, this, starty, starty + thisWindowHeight));
+        starty += thisWindowHeight ;
+    }
+    foreach(QFuture<void> future, results) {
+        future.waitForFinished();
     }
-    uiServices.endIconProgressBar();
 }
 
 void DataWidget::computeImageSlice(const int paramStartY, const int paramEndY)
@@ -668,12 +715,9 @@ void DataWidget::computeImageSlice(const int paramStartY, const int paramEndY)
     float dataWidth = _dataWindow.width();
     float imgWidth = _xPoints ;
     float ptiPerPxX = dataWidth / imgWidth ;
-
-    /*PtrToValue getValueP = getGetValueFunction();
-    if(NULL == getValueP) {
-        return ;
-    }*/
-    //qint64 (DataWidget::*getValue1)(ElementBase*) = getGetValueFunction();
+    // the window behind a pixel, as in computeImageStandard
+    const int windowRows = qCeil(ptiPerPxY);
+    const int windowColumns = qCeil(ptiPerPxX);
 
     //int heightImage = _yPoints;
     int widthImage = _xPoints ;
@@ -707,7 +751,6 @@ void DataWidget::computeImageSlice(const int paramStartY, const int paramEndY)
                 VisDataRow *row = _dataMap->rows.at(yyy);
                 if(row->_numColumns > xxx) {
                     ElementBase *e = row->_columns[xxx];
-                    int values = 1;
                     found = true;
 
                     if(_measType == Distribution) {
@@ -737,52 +780,21 @@ void DataWidget::computeImageSlice(const int paramStartY, const int paramEndY)
                             }
                         }
                     } else {
+                        // the window of data behind the pixel, the center counts once more
+                        quint64 windowSum = 0 ;
+                        int windowCount = 0 ;
+                        float windowMax = -1 ;
+                        const int firstRow = yyy - limy ;
+                        const int firstColumn = xxx - limx ;
+                        _tables.window(firstRow, firstRow + windowRows, firstColumn, firstColumn + windowColumns,
+                                       windowSum, windowCount, windowMax);
+                        const quint64 centerValue = getValue(e);
                         if(_loudness == NoLoudness) {
-                            //value = ((this)->*getValueP)(e);
-                            value = getValue(e);
-                            for(int yi = 0; yi < ptiPerPxY ; yi++) {
-                                VisDataRow *row = getRowAt(yyy - limy + yi);
-                                if(NULL != row) {
-                                    int startX = qMax(0, xxx - limx);
-                                    int endX = qMin((int)(xxx - limx + ptiPerPxX), row->_numColumns);
-                                    ElementBase *ex = getElementRow(row, startX);
-                                    if(NULL != ex) {
-                                        //for(int xi = 0; xi < ptiPerPxX ; xi++) {
-                                        for(int xi = startX; xi < endX ; xi++) {
-                                            ElementBase *e2 = ex ++ ;
-                                            //ElementBase *e2 = getElementRow(row, xxx - limx + xi);
-                                            if(NULL != e2) {
-                                                values ++ ;
-                                                value += getValue(e2);//((this)->*getValueP)(e2);
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                            value /= values ;
+                            value = (double)(centerValue + windowSum) / (1 + windowCount) ;
                         } else {
-                            value = getValue(e);
-                            for(int yi = 0; yi < ptiPerPxY ; yi++) {
-                                VisDataRow *row = getRowAt(yyy - limy + yi);
-                                if(NULL != row) {
-                                    int startX = qMax(0, xxx - limx);
-                                    int endX = qMin((int)(xxx - limx + ptiPerPxX), row->_numColumns);
-                                    ElementBase *ex = getElementRow(row, startX);
-                                    if(NULL != ex) {
-                                        //for(int xi = 0; xi < ptiPerPxX ; xi++) {
-                                        for(int xi = startX; xi < endX ; xi++) {
-                                            ElementBase *e2 = ex ++ ;
-                                            //ElementBase *e2 = getElementRow( row, xxx - limx + xi);
-                                            if(NULL != e2) {
-                                                //float nowValue = ((this)->*getValueP)(e2);
-                                                float nowValue = getValue(e2);
-                                                if(nowValue > value) {
-                                                    value = nowValue ;
-                                                }
-                                            }
-                                        }
-                                    }
-                                }
+                            value = centerValue ;
+                            if(windowMax > value) {
+                                value = windowMax ;
                             }
                         }
                     }
@@ -1027,125 +1039,113 @@ inline VisDataRow *DataWidget::getRowAt(const int y)
     return NULL ;
 }
 
+/*!
+ * \brief DataWidget::drawImage the rows of the image are colored in parallel, writing the scan lines
+ */
 void DataWidget::drawImage()
 {
-    //QString s;
-    float *mapp = _dataPoints ;
-    float maxVal = getMaxValue();
-    uint *cmap = _colorMap->values();
-    bool *pMask = _dataPointsMask;
-    int h = height() ;
-    int w = width();
-    for(int y = 0 ; y < h ; y ++) {
-        //s += QString("y:%1 max:%2\n").arg(y).arg(maxVal);
-        for(int x = 0 ; x < w; x ++) {
-            //s += QString("%1 ").arg((int)*mapp);
-            //if( *mapp>=maxVal ) {
-            //    s += QString("***");
-            //}
-            assignRealColors(mapp, maxVal, cmap, pMask, x, y);
-            pMask++;
-            mapp++;
-        }
-        //s += "\n";
-    }
-    //QClipboard *clipboard = QApplication::clipboard();
-    //clipboard->setText(s);
+    // detach the image in this thread, the slices write to distinct rows only
+    _cachedImage.bits();
+    runInSlices(&DataWidget::drawImageSlice);
 }
 
-
-static inline void findMax(const int x, const int y, float &maxValue, bool *mask, float *data, const int width)
+void DataWidget::drawImageSlice(DataWidget *widget, const int startY, const int endY)
 {
-    if(mask[width * y + x]) {
-        float value = data[width * y + x];
-        if(value > maxValue) {
-            maxValue = value ;
+    const float maxVal = widget->getMaxValue();
+    const uint *cmap = widget->_colorMap->values();
+    const int w = widget->_xPoints ;
+    for(int y = startY ; y < endY ; y ++) {
+        const float *mapp = &widget->_dataPoints[w * y];
+        const bool *pMask = &widget->_dataPointsMask[w * y];
+        uint *line = reinterpret_cast<uint*>(const_cast<uchar*>(widget->_cachedImage.constScanLine(y)));
+        for(int x = 0 ; x < w; x ++) {
+            line[x] = widget->realColor(mapp[x], pMask[x], maxVal, cmap);
         }
     }
 }
 
+/*!
+ * \brief DataWidget::filterImage the 3x3 dilation is separable: a pass on the rows, then one on the columns.
+ * The loops have no branches to let the compiler vectorize them.
+ */
 void DataWidget::filterImage()
 {
     if(LoudnessDilate == _loudness) {
-        int h = _yPoints;
-        int w = _xPoints;
-        int h1 = h - 1 ;
-        int w1 = w - 1;
-
-        int theSize = _sizeOfPoints;
-        float *newData = new float[theSize];
-        if(NULL != newData) {
-
-            float *src = _dataPoints;
-            float *dst = newData;
-            int loopCount = theSize ;
-            while(loopCount--) {
-                *dst++ = *src++ ;
-            }
-
-            for(int y = 1 ; y < h1 ; y ++) {
-                for(int x = 1 ; x < w1; x ++) {
-                    float maxVal = 0 ;
-                    findMax(x - 1, y - 1, maxVal, _dataPointsMask, newData, w);
-                    findMax(x, y - 1, maxVal, _dataPointsMask, newData, w);
-                    findMax(x + 1, y - 1, maxVal, _dataPointsMask, newData, w);
-                    //-
-                    findMax(x - 1, y, maxVal, _dataPointsMask, newData, w);
-                    findMax(x, y, maxVal, _dataPointsMask, newData, w);
-                    findMax(x + 1, y, maxVal, _dataPointsMask, newData, w);
-                    //-
-                    findMax(x - 1, y + 1, maxVal, _dataPointsMask, newData, w);
-                    findMax(x, y + 1, maxVal, _dataPointsMask, newData, w);
-                    findMax(x + 1, y + 1, maxVal, _dataPointsMask, newData, w);
-                    //-
-                    //*(_dataPoints[width*y+x]) = maxVal ;
-                    _dataPoints[w * y + x] = maxVal ;
+        if((_xPoints < 3) || (_yPoints < 3)) {
+            return ;
+        }
+        _dilatedRows = new float[_sizeOfPoints];
+        if(NULL != _dilatedRows) {
+            runInSlices(&DataWidget::dilateRowsSlice);
+            runInSlices(&DataWidget::dilateColumnsSlice);
+            delete [] _dilatedRows;
+            _dilatedRows = NULL ;
+        }
+    }
+}
 
-                }
-            }
-            delete [] newData;
+void DataWidget::dilateRowsSlice(DataWidget *widget, const int startY, const int endY)
+{
+    const int w = widget->_xPoints ;
+    const int w1 = w - 1 ;
+    for(int y = startY ; y < endY ; y ++) {
+        const float *src = &widget->_dataPoints[w * y];
+        const bool *mask = &widget->_dataPointsMask[w * y];
+        float *dst = &widget->_dilatedRows[w * y];
+        dst[0] = 0 ;
+        dst[w1] = 0 ;
+        for(int x = 1 ; x < w1 ; x ++) {
+            const float left = mask[x - 1] ? src[x - 1] : 0 ;
+            const float center = mask[x] ? src[x] : 0 ;
+            const float right = mask[x + 1] ? src[x + 1] : 0 ;
+            dst[x] = qMax(qMax(left, center), qMax(right, 0.0f));
         }
     }
 }
 
-void DataWidget::assignRealColors(float *mapp, float maxVal, uint *cmap, bool *pMask, const int x, const int y)
+void DataWidget::dilateColumnsSlice(DataWidget *widget, const int paramStartY, const int paramEndY)
 {
-    switch(_measType) {
-    case Distribution: {
-        if(*pMask) {
-            float value = *mapp;
-            if(value > 0) {
-                _cachedImage.setPixel(x, y, RED_COLOR);
-            } else if(value < 0) {
-                _cachedImage.setPixel(x, y, BLUE_COLOR);
-            } else {
-                _cachedImage.setPixel(x, y, PALEYELLOW_COLOR);
-            }
-        } else {
-            _cachedImage.setPixel(x, y, DEFAULT_BACKGROUND_COLOR);
+    const int w = widget->_xPoints ;
+    const int w1 = w - 1 ;
+    const int startY = qMax(1, paramStartY);
+    const int endY = qMin((int)widget->_yPoints - 1, paramEndY);
+    for(int y = startY ; y < endY ; y ++) {
+        const float *above = &widget->_dilatedRows[w * (y - 1)];
+        const float *center = &widget->_dilatedRows[w * y];
+        const float *below = &widget->_dilatedRows[w * (y + 1)];
+        float *dst = &widget->_dataPoints[w * y];
+        for(int x = 1 ; x < w1 ; x ++) {
+            dst[x] = qMax(qMax(above[x], center[x]), below[x]);
         }
     }
-    break;
-    default: {
-        if(*pMask) {
-            int value = (ColorMap::MapElements * ((*mapp)  / maxVal));
-            if(0 == value) {
-                _cachedImage.setPixel(x, y, _emptyValueColor);
-            } else {
-                if(value < 0) {
-                    value = 0 ;
-                } else if(value >= ColorMap::MapElements) {
-                    value = ColorMap::MapElements - 1;
-                }
-                _cachedImage.setPixel(x, y, cmap[value]);
-            }
-            //s += QString("[ x:%1 ] %2 %3").arg(x).arg(*mapp).arg(value);
-        } else {
-            _cachedImage.setPixel(x, y, _bkColor);
+}
+
+uint DataWidget::realColor(const float value, const bool isData, const float maxVal, const uint *cmap) const
+{
+    if(Distribution == _measType) {
+        if(!isData) {
+            return DEFAULT_BACKGROUND_COLOR ;
+        }
+        if(value > 0) {
+            return RED_COLOR ;
+        } else if(value < 0) {
+            return BLUE_COLOR ;
         }
+        return PALEYELLOW_COLOR ;
     }
-    break;
+    if(!isData) {
+        return _bkColor ;
     }
+    int index = (ColorMap::MapElements * (value  / maxVal));
+    if(0 == index) {
+        return _emptyValueColor ;
+    }
+    if(index < 0) {
+        index = 0 ;
+    } else if(index >= ColorMap::MapElements) {
+        index = ColorMap::MapElements - 1;
+    }
+    return cmap[index];
 }
 
 void DataWidget::dumpData()
@@ -1185,6 +1185,7 @@ void DataWidget::setSlice(const int newSliceLevel)
 void DataWidget::setDataMap(VisDataMap *newDataMap)
 {
     _dataMap = newDataMap;
+    _tables.clear();
     recalc();
 }
 
@@ -1324,6 +1325,11 @@ void DataWidget::on_actionExtractThisFragment_triggered()
         int x = _dataWindow.left() + (_contextMenuPos.x() * _dataWindow.width()) / width();
         ElementBase *e = getElement(x, y);
         if(NULL != e) {
+            // aggregated elements carry the ordinal of the fragment in their column
+            if(_dataMap->isAggregated) {
+                emit extractFragment(e->id + 1, x);
+                return ;
+            }
             // Find the # of the document and emits a signal.
             QSet<int> slices;
             int rowMax = _dataMap->rows.size();
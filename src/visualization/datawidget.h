@@ -30,10 +30,12 @@
 #include <QPointF>
 #include <QTextStream>
 #include <QFuture>
+#include <QSemaphore>
 
 #include "elementbase.h"
 #include "visdatamap.h"
 #include "colormap.h"
+#include "visdatatables.h"
 
 #ifdef  QWT_PLOT3D
 #include <math.h>
@@ -85,6 +87,8 @@ private:
     bool _isLogScale;
     float *_dataPoints;
     bool *_dataPointsMask;
+    // maxima of the horizontal neighbours, used while dilating
+    float *_dilatedRows;
     ColorMap *_colorMap;
     bool _debugMode;
     /** \brief if the data are to be divided using level n of the tree
@@ -109,6 +113,7 @@ private:
      * \brief _mtEnabled: enables multi threading
      */
     bool _mtEnabled ;
+    VisDataTables _tables;
 
     unsigned int _sizeOfPoints, _xPoints, _yPoints;
     QWidget *_mainWindow;
@@ -125,9 +130,10 @@ public:
     void setData(ElementBase *data);
     void setColorMap(ColorMap *newMap);
     void dumpData();
-    void assignRealColors(float *mapp, float maxVal, uint *cmap, bool *pMask, const int x, const int y);
+    uint realColor(const float value, const bool isData, const float maxVal, const uint *cmap) const;
     void setZoom(const int newZoom);
     int levels();
+    QRect dataWindow() const;
     void setSlice(const int newSliceLevel);
     void setDataMap(VisDataMap *newDataMap);
     void freeze();
@@ -159,14 +165,20 @@ private:
     Ui::DataWidget *ui;
 
 
-    typedef  quint64(DataWidget::*PtrToValue)(ElementBase *e);
+    typedef  quint64(*PtrToValue)(ElementBase *e);
 
     void generateImage(const bool forceStandard = false);
     void computeImage();
     void computeImageStandard();
     void computeImageThreaded();
     void computeImageSlice(const int paramStartY, const int paramEndY);
-    void waitCalcImage(QList<QFuture<void> > &threads);
+    void computeImageSliceSignaling(const int paramStartY, const int paramEndY, QSemaphore *slicesDone);
+    void waitCalcImage(QList<QFuture<void> > &threads, QSemaphore &slicesDone);
+    void buildTables();
+    void runInSlices(void (*function)(DataWidget *, const int, const int));
+    static void drawImageSlice(DataWidget *widget, const int startY, const int endY);
+    static void dilateRowsSlice(DataWidget *widget, const int startY, const int endY);
+    static void dilateColumnsSlice(DataWidget *widget, const int startY, const int endY);
     inline ElementBase *getElement(const int x, const int y);
     inline ElementBase *getElementRow(VisDataRow *row, const int x);
     inline VisDataRow *getRowAt(const int y);
@@ -175,14 +187,14 @@ private:
     void losePoints();
     inline quint64 getValue(ElementBase *e);
     quint64 getMaxValue();
-    quint64 getValueAttributesCount(ElementBase *e);
-    quint64 getValueAttributesCountCumulative(ElementBase *e);
-    quint64 getValueSize(ElementBase *e);
-    quint64 getValueSizeCumulative(ElementBase *e);
-    quint64 getValueElements(ElementBase *e);
-    quint64 getValueElementsCumulative(ElementBase *e);
-    quint64 getValuePayload(ElementBase *e);
-    quint64 getValuePayloadCumulative(ElementBase *e);
+    static quint64 getValueAttributesCount(ElementBase *e);
+    static quint64 getValueAttributesCountCumulative(ElementBase *e);
+    static quint64 getValueSize(ElementBase *e);
+    static quint64 getValueSizeCumulative(ElementBase *e);
+    static quint64 getValueElements(ElementBase *e);
+    static quint64 getValueElementsCumulative(ElementBase *e);
+    static quint64 getValuePayload(ElementBase *e);
+    static quint64 getValuePayloadCumulative(ElementBase *e);
     PtrToValue getGetValueFunction();
     QList<int> computeSlices(const int idealThreadCount, const int heightImage);
     int computeWindowsHeight(const int idealThreadCount);
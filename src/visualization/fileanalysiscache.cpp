@@ -0,0 +1,250 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#include "fileanalysiscache.h"
+#include <QFileInfo>
+#include <QMutexLocker>
+
+FileAnalysisPayload::FileAnalysisPayload()
+{
+}
+
+FileAnalysisPayload::~FileAnalysisPayload()
+{
+}
+
+//----------------------------------------
+
+FileAnalysis::FileAnalysis()
+{
+    _hasTagNodes = false;
+}
+
+FileAnalysis::~FileAnalysis()
+{
+    EMPTYPTRLIST(_tagNodes, TagNode);
+}
+
+bool FileAnalysis::hasTagNodes() const
+{
+    return _hasTagNodes;
+}
+
+static TagNode *copyTagNode(const TagNode *source)
+{
+    TagNode *tagNode = new TagNode(source->tag, source->id);
+    tagNode->count = source->count ;
+    tagNode->linksIn = source->linksIn ;
+    tagNode->linksOut = source->linksOut ;
+    foreach(const TagNodeTarget * target, source->targets) {
+        TagNodeTarget *newTarget = new TagNodeTarget(target->tag);
+        newTarget->count = target->count ;
+        tagNode->targets.insert(newTarget->tag, newTarget);
+    }
+    return tagNode;
+}
+
+static void copyAttributes(const AttributesSummaryData *source, AttributesSummaryData *destination)
+{
+    destination->reset();
+    QHashIterator<QString, AttributeSummaryData*> it(source->data);
+    while(it.hasNext()) {
+        it.next();
+        const AttributeSummaryData *attribute = it.value();
+        AttributeSummaryData *newAttribute = destination->attributeSummaryData(it.key(), attribute->name);
+        newAttribute->setData(attribute->count, attribute->dataSize, attribute->countEmpty);
+    }
+}
+
+void FileAnalysis::setTagNodes(const QHash<QString, TagNode*> &tagNodes, const AttributesSummaryData *attributesSummaryData)
+{
+    EMPTYPTRLIST(_tagNodes, TagNode);
+    foreach(const TagNode * tagNode, tagNodes) {
+        _tagNodes.insert(tagNode->tag, copyTagNode(tagNode));
+    }
+    copyAttributes(attributesSummaryData, &_attributesSummaryData);
+    _hasTagNodes = true ;
+}
+
+void FileAnalysis::copyTagNodesTo(QHash<QString, TagNode*> &destination) const
+{
+    foreach(const TagNode * tagNode, _tagNodes) {
+        destination.insert(tagNode->tag, copyTagNode(tagNode));
+    }
+}
+
+/*!
+ * \brief FileAnalysis::copyAttributesTo copies only the counters, the white and black lists of the destination are preserved
+ */
+void FileAnalysis::copyAttributesTo(AttributesSummaryData *destination) const
+{
+    copyAttributes(&_attributesSummaryData, destination);
+}
+
+FileAnalysisPayload *FileAnalysis::map() const
+{
+    return _map.data() ;
+}
+
+void FileAnalysis::setMap(FileAnalysisPayload *newMap)
+{
+    if(newMap != _map.data()) {
+        _map = QSharedPointer<FileAnalysisPayload>(newMap);
+    }
+}
+
+/*!
+ * \brief FileAnalysis::shareMapOf uses the map of another analysis, the map is read only and stays alive
+ * as long as one of the analyses uses it
+ */
+void FileAnalysis::shareMapOf(const FileAnalysis &other)
+{
+    _map = other._map ;
+}
+
+qint64 FileAnalysis::memoryCost() const
+{
+    qint64 cost = sizeof(FileAnalysis);
+    foreach(const TagNode * tagNode, _tagNodes) {
+        cost += sizeof(TagNode) + tagNode->targets.size() * sizeof(TagNodeTarget);
+    }
+    cost += _attributesSummaryData.data.size() * sizeof(AttributeSummaryData);
+    if(!_map.isNull()) {
+        cost += _map->memoryCost();
+    }
+    return cost ;
+}
+
+//----------------------------------------
+
+QMutex FileAnalysisCache::_mutex;
+QList<FileAnalysisCache::Entry> FileAnalysisCache::_entries;
+qint64 FileAnalysisCache::_memoryBudget = FileAnalysisCache::DefaultMemoryBudget ;
+
+QString FileAnalysisCache::key(const QString &path)
+{
+    return QFileInfo(path).absoluteFilePath();
+}
+
+int FileAnalysisCache::indexOf(const QString &path)
+{
+    const int entries = _entries.size();
+    for(int i = 0 ; i < entries ; i ++) {
+        if(_entries.at(i).path == path) {
+            return i ;
+        }
+    }
+    return -1 ;
+}
+
+/*!
+ * \brief FileAnalysisCache::find returns the analysis of the file if the file did not change since its scan,
+ * the entry becomes the most recently used one. A stale entry is removed.
+ */
+QSharedPointer<FileAnalysis> FileAnalysisCache::find(const QString &path)
+{
+    QFileInfo fileInfo(path);
+    const QString filePath = fileInfo.absoluteFilePath();
+    QMutexLocker lock(&_mutex);
+    const int index = indexOf(filePath);
+    if(index < 0) {
+        return QSharedPointer<FileAnalysis>();
+    }
+    Entry entry = _entries.takeAt(index);
+    if(!fileInfo.exists() || (fileInfo.size() != entry.size) || (fileInfo.lastModified() != entry.lastModified)) {
+        return QSharedPointer<FileAnalysis>();
+    }
+    _entries.prepend(entry);
+    return entry.analysis;
+}
+
+/*!
+ * \brief FileAnalysisCache::insert stores the analysis of a file, replacing any previous one,
+ * and evicts the least recently used entries beyond the limits.
+ */
+void FileAnalysisCache::insert(const QString &path, QSharedPointer<FileAnalysis> analysis)
+{
+    QFileInfo fileInfo(path);
+    if(analysis.isNull() || !fileInfo.exists()) {
+        return ;
+    }
+    Entry entry;
+    entry.path = fileInfo.absoluteFilePath();
+    entry.size = fileInfo.size();
+    entry.lastModified = fileInfo.lastModified();
+    entry.analysis = analysis ;
+    QMutexLocker lock(&_mutex);
+    const int index = indexOf(entry.path);
+    if(index >= 0) {
+        _entries.removeAt(index);
+    }
+    _entries.prepend(entry);
+    trim();
+}
+
+void FileAnalysisCache::trim()
+{
+    qint64 cost = 0 ;
+    int kept = 0 ;
+    const int entries = _entries.size();
+    for(; kept < entries ; kept ++) {
+        cost += _entries.at(kept).analysis->memoryCost();
+        // the most recent entry is always kept
+        if((kept > 0) && ((kept >= MaxEntries) || (cost > _memoryBudget))) {
+            break;
+        }
+    }
+    while(_entries.size() > kept) {
+        _entries.removeLast();
+    }
+}
+
+void FileAnalysisCache::remove(const QString &path)
+{
+    const QString filePath = key(path);
+    QMutexLocker lock(&_mutex);
+    const int index = indexOf(filePath);
+    if(index >= 0) {
+        _entries.removeAt(index);
+    }
+}
+
+void FileAnalysisCache::clear()
+{
+    QMutexLocker lock(&_mutex);
+    _entries.clear();
+}
+
+int FileAnalysisCache::count()
+{
+    QMutexLocker lock(&_mutex);
+    return _entries.size();
+}
+
+void FileAnalysisCache::setMemoryBudget(const qint64 value)
+{
+    QMutexLocker lock(&_mutex);
+    _memoryBudget = value ;
+    trim();
+}
@@ -0,0 +1,115 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef FILEANALYSISCACHE_H
+#define FILEANALYSISCACHE_H
+
+#include "xmlEdit.h"
+#include <QSharedPointer>
+#include <QDateTime>
+#include <QMutex>
+#include "libQXmlEdit_global.h"
+#include "attributessummarydata.h"
+#include "modules/graph/tagnodes.h"
+
+/**
+  \brief results of an analysis of a file that are not bound to a view,
+  the map module stores here its own data.
+  */
+class LIBQXMLEDITSHARED_EXPORT FileAnalysisPayload
+{
+public:
+    FileAnalysisPayload();
+    virtual ~FileAnalysisPayload();
+    /** \brief estimated memory used by the payload, in bytes */
+    virtual qint64 memoryCost() const = 0;
+};
+
+/**
+  \brief what a single scan of a file collected: the relations among tags,
+  the attributes summary and, if the scan was made by the map, the map data.
+  The data are read only once stored in the cache, the views work on copies of the tags and of the attributes.
+  */
+class LIBQXMLEDITSHARED_EXPORT FileAnalysis
+{
+    bool _hasTagNodes;
+    QHash<QString, TagNode*> _tagNodes;
+    AttributesSummaryData _attributesSummaryData;
+    QSharedPointer<FileAnalysisPayload> _map;
+
+public:
+    FileAnalysis();
+    ~FileAnalysis();
+
+    bool hasTagNodes() const;
+    void setTagNodes(const QHash<QString, TagNode*> &tagNodes, const AttributesSummaryData *attributesSummaryData);
+    void copyTagNodesTo(QHash<QString, TagNode*> &destination) const;
+    void copyAttributesTo(AttributesSummaryData *destination) const;
+
+    FileAnalysisPayload *map() const;
+    void setMap(FileAnalysisPayload *newMap);
+    void shareMapOf(const FileAnalysis &other);
+
+    qint64 memoryCost() const;
+};
+
+/**
+  \brief keeps the analyses of the last scanned files, an entry is valid while
+  the path, the size and the modification time of the file do not change.
+  The cache is shared by the analysis views and it is thread safe.
+  */
+class LIBQXMLEDITSHARED_EXPORT FileAnalysisCache
+{
+    class Entry
+    {
+    public:
+        QString path;
+        qint64 size;
+        QDateTime lastModified;
+        QSharedPointer<FileAnalysis> analysis;
+    };
+
+    static QMutex _mutex;
+    static QList<Entry> _entries;
+    static qint64 _memoryBudget;
+
+    static void trim();
+    static int indexOf(const QString &path);
+    static QString key(const QString &path);
+
+public:
+    enum {
+        MaxEntries = 4,
+        DefaultMemoryBudget = 512 * 1024 * 1024
+    };
+
+    static QSharedPointer<FileAnalysis> find(const QString &path);
+    static void insert(const QString &path, QSharedPointer<FileAnalysis> analysis);
+    static void remove(const QString &path);
+    static void clear();
+    static int count();
+    static void setMemoryBudget(const qint64 value);
+};
+
+#endif // FILEANALYSISCACHE_H
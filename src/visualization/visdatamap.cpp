@@ -22,6 +22,7 @@
 
 
 #include "visdatamap.h"
+#include "vismapgrid.h"
 
 //test: 5M : 62.000
 //100M 1 946 626
@@ -48,6 +49,11 @@ void VisDataMap::reset()
     totalAttributesSize = 0 ;
     maxAttributesSizePerElement = 0 ;
     numElements = 0 ;
+    isAggregated = false ;
+    rowsPerBucket = 1 ;
+    firstDocumentRow = 0 ;
+    documentRows = 0 ;
+    elementsPerDepth.clear();
     workRow.clear();
     clearRows();
 }
@@ -63,6 +69,10 @@ void VisDataMap::clearRows()
         delete row;
     }
     rows.clear();
+    foreach(ElementBase * element, _aggregatedElements) {
+        delete element;
+    }
+    _aggregatedElements.clear();
 }
 
 void VisDataMap::calculate(ElementBase *root)
@@ -108,3 +118,82 @@ void VisDataMap::consolidateLine()
     }
     rows.append(newRow);
 }
+
+ElementBase *VisDataMap::newAggregatedElement(ElementBase *parent, const QString &name)
+{
+    // not linked to the parent children, the map owns each one of them
+    ElementBase *element = new ElementBase(NULL, name);
+    element->parent = parent ;
+    _aggregatedElements.append(element);
+    return element;
+}
+
+/*!
+ * \brief VisDataMap::calculate builds a row for each bucket of the grid,
+ *  the values of each column are the mean of the elements in the bucket at that depth.
+ *  The id of an aggregated element is the ordinal of the first element of its depth in the bucket.
+ */
+void VisDataMap::calculate(const VisMapGrid &grid)
+{
+    _root = NULL ;
+    workRow.clear();
+    clearRows();
+    numColumns = 0 ;
+    maxData = 0 ;
+    reset();
+    isAggregated = true ;
+    rowsPerBucket = grid.rowsPerBucket();
+    firstDocumentRow = grid.windowFirstRow();
+    documentRows = grid.rowsCount();
+
+    _root = newAggregatedElement(NULL, grid.rootName());
+    _root->totalSize = grid.rootTotalSize();
+    _root->totalChildrenCount = grid.rootTotalChildrenCount();
+    _root->totalText = grid.rootTotalText();
+    _root->totalAttributesCount = (int)grid.rootTotalAttributesCount();
+
+    numElements = (int)grid.numElements();
+    maxSize = grid.maxSize();
+    maxChildrenCount = grid.maxChildrenCount();
+    maxAttributesCount = grid.maxAttributesCount();
+    maxText = grid.maxText();
+    totalAttributesSize = grid.totalAttributesSize();
+    maxAttributesSizePerElement = grid.maxAttributesSizePerElement();
+    numColumns = grid.numColumns();
+    for(int depth = 0 ; depth < numColumns ; depth ++) {
+        elementsPerDepth.append(grid.elementsAtDepth(depth));
+    }
+
+    const int buckets = grid.bucketsCount();
+    const int columns = grid.columnsCount();
+    for(int bucket = 0 ; bucket < buckets ; bucket ++) {
+        int rowColumns = 0 ;
+        while((rowColumns < columns) && (grid.cell(rowColumns, bucket).rows > 0)) {
+            rowColumns++;
+        }
+        VisDataRow *newRow = new VisDataRow();
+        newRow->_numColumns = rowColumns ;
+        if(numColumns < rowColumns) {
+            numColumns = rowColumns;
+        }
+        newRow->_columns = new ElementBase * [rowColumns];
+        ElementBase *parent = NULL ;
+        for(int depth = 0 ; depth < rowColumns ; depth ++) {
+            const VisMapGridCell &cell = grid.cell(depth, bucket);
+            const double rows = cell.rows ;
+            ElementBase *element = newAggregatedElement(parent, cell.name);
+            element->id = (int)cell.firstElement ;
+            element->size = qRound64(cell.size / rows);
+            element->totalSize = qRound64(cell.totalSize / rows);
+            element->childrenCount = qRound64(cell.childrenCount / rows);
+            element->totalChildrenCount = qRound64(cell.totalChildrenCount / rows);
+            element->text = qRound64(cell.text / rows);
+            element->totalText = qRound64(cell.totalText / rows);
+            element->attributesCount = qRound(cell.attributesCount / rows);
+            element->totalAttributesCount = qRound(cell.totalAttributesCount / rows);
+            newRow->_columns[depth] = element ;
+            parent = element ;
+        }
+        rows.append(newRow);
+    }
+}
@@ -29,6 +29,8 @@
 #include "elementbase.h"
 #include "visdatarow.h"
 
+class VisMapGrid;
+
 /**
   this object maps the data to the visualization
   */
@@ -50,18 +52,30 @@ public:
     quint64 totalAttributesSize;
     quint64 maxAttributesSizePerElement;
 
+    /** \brief true if the rows are buckets of a VisMapGrid and the elements are their averages
+      */
+    bool isAggregated;
+    qint64 rowsPerBucket;
+    qint64 firstDocumentRow;
+    qint64 documentRows;
+    QVector<qint64> elementsPerDepth;
+
     void buildMap(ElementBase *element, const int level);
     void consolidateLine();
     void reset();
     void resetData();
 private:
+    QVector<ElementBase *> _aggregatedElements;
+
     void clearRows();
+    ElementBase *newAggregatedElement(ElementBase *parent, const QString &name);
 
 public:
     explicit VisDataMap(QObject *parent = 0);
     virtual ~VisDataMap();
 
     void calculate(ElementBase *root);
+    void calculate(const VisMapGrid &grid);
 signals:
 
 public slots:
@@ -25,16 +25,16 @@
 #include "summarydata.h"
 #include "utils.h"
 
-VisDataSax::VisDataSax(QSet<QString> *newNames, QHash<QString, TagNode*> *newTagNodes, AttributesSummaryData *newAttributesSummaryData)
+VisDataSax::VisDataSax(QHash<QString, TagNode*> *newTagNodes, AttributesSummaryData *newAttributesSummaryData)
 {
     attributesSummaryData = newAttributesSummaryData;
     root = NULL ;
     currentElement = NULL ;
-    names = newNames;
     tagNodes = newTagNodes;
     _elementsCount = 0;
     _userAborted = false;
     _hasError = false ;
+    _grid = NULL ;
 }
 
 VisDataSax::~VisDataSax()
@@ -72,7 +72,15 @@ void VisDataSax::setUserAborted(bool value)
     _userAborted = value;
 }
 
-void VisDataSax::addTagNode(const QString &name)
+/*!
+ * \brief VisDataSax::setGrid if set, the data are aggregated in the grid and no element tree is built
+ */
+void VisDataSax::setGrid(VisMapGrid *grid)
+{
+    _grid = grid ;
+}
+
+void VisDataSax::addTagNode(const QString &name, const QString *parentName)
 {
     TagNode *node = tagNodes->value(name);
     if(NULL == node) {
@@ -81,8 +89,8 @@ void VisDataSax::addTagNode(const QString &name)
     }
     node->count++;
     // add the relationship
-    if(NULL != currentElement) {
-        TagNode *parentNode = tagNodes->value(currentElement->name);
+    if(NULL != parentName) {
+        TagNode *parentNode = tagNodes->value(*parentName);
         node->linksIn++;
         parentNode->linksOut++;
         // must be not null
@@ -95,93 +103,109 @@ void VisDataSax::addTagNode(const QString &name)
     }
 }
 
-bool VisDataSax::startDocument()
+bool VisDataSax::startDocument(XmlStreamScanner * /*scanner*/)
 {
     _currentElementPath = "";
     return true ;
 }
 
-bool VisDataSax::startElement(const QString &/*namespaceURI*/, const QString & /*localName*/,
-                              const QString &qName, const QXmlAttributes &attributes)
+bool VisDataSax::startElement(XmlStreamScanner *scanner, const int nameId, const QXmlStreamAttributes &attributes)
 {
     _elementsCount ++ ;
     // I know, but can only be set from another thread
     if(_userAborted) {
         return false;
     }
-    QSet<QString>::const_iterator iter = names->insert(qName);
-    QString name = *iter;
+    const QString &name = scanner->name(nameId);
     if(NULL != tagNodes) {
-        addTagNode(name);
+        const QString *parentName = NULL ;
+        if(NULL != _grid) {
+            parentName = _grid->currentName();
+        } else if(NULL != currentElement) {
+            parentName = &currentElement->name ;
+        }
+        addTagNode(name, parentName);
     }
-    ElementBase *elem = new ElementBase(currentElement, name) ;
-    if(NULL == currentElement) {
-        root = elem;
+    if(NULL != attributesSummaryData) {
+        _currentElementPath = Utils::pushCurrentElementPath(_currentElementPath, name);
     }
-    _currentElementPath = Utils::pushCurrentElementPath(_currentElementPath, name);
 
     const int attrCount = attributes.count();
     quint64 attributesSize = 0;
+    qint64 size = 0 ;
     for(int index = 0 ; index < attrCount ; index ++) {
-        const QString &attributeLocalName = attributes.qName(index);
-        elem->size += attributeLocalName.length();
-        const QString &attrValue = attributes.value(index);
-        const int thisAttrSize = attrValue.length();
+        const QXmlStreamAttribute &attribute = attributes.at(index);
+        const QStringRef attributeQName = attribute.qualifiedName();
+        size += attributeQName.length();
+        const int thisAttrSize = attribute.value().length();
         attributesSize += (unsigned)thisAttrSize ;
-        elem->size += thisAttrSize;
-        elem->size += 4; // blank, equals, 2 quotes
-        QString attributePath = _currentElementPath + "/@" + attributeLocalName;
-        AttributeSummaryData * attributeSummaryData = attributesSummaryData->attributeSummaryData(attributePath, attributeLocalName);
-        attributeSummaryData->addHit(thisAttrSize);
+        size += thisAttrSize;
+        size += 4; // blank, equals, 2 quotes
+        if(NULL != attributesSummaryData) {
+            const QString attributeLocalName = attributeQName.toString();
+            QString attributePath = _currentElementPath + "/@" + attributeLocalName;
+            AttributeSummaryData * attributeSummaryData = attributesSummaryData->attributeSummaryData(attributePath, attributeLocalName);
+            attributeSummaryData->addHit(thisAttrSize);
+        }
+    }
+    if(NULL != _grid) {
+        _grid->startElement(name, size, attrCount, attributesSize);
+        return true ;
+    }
+    ElementBase *elem = new ElementBase(currentElement, name) ;
+    if(NULL == currentElement) {
+        root = elem;
     }
+    elem->size = size ;
     elem->attributesCount = attrCount;
     elem->totalAttributesSize = attributesSize ;
     currentElement = elem ;
     return true ;
 }
 
-bool VisDataSax::endElement(const QString &/*namespaceURI*/, const QString &/*localName*/,
-                            const QString &/*qName*/)
+bool VisDataSax::endElement(XmlStreamScanner * /*scanner*/, const int /*nameId*/)
 {
-    if(NULL != currentElement) {
+    if(NULL != _grid) {
+        _grid->endElement();
+    } else if(NULL != currentElement) {
         currentElement = currentElement->parent;
     }
-    _currentElementPath = Utils::popCurrentElementPath(_currentElementPath);
+    if(NULL != attributesSummaryData) {
+        _currentElementPath = Utils::popCurrentElementPath(_currentElementPath);
+    }
     return true;
 }
 
-bool VisDataSax::characters(const QString &str)
+/*!
+ * \brief VisDataSax::trimmedLength the length of the text as trimmed(), without copying it
+ */
+int VisDataSax::trimmedLength(const QStringRef &str)
 {
-    if(NULL != currentElement) {
-        int len = str.length();
-        currentElement->size += len;
-        QString s2 = str.trimmed();
-        currentElement->text += s2.length();
+    const QChar *data = str.unicode();
+    int start = 0 ;
+    int end = str.length();
+    while((start < end) && data[start].isSpace()) {
+        start++;
     }
-    return true ;
+    while((end > start) && data[end - 1].isSpace()) {
+        end--;
+    }
+    return end - start ;
 }
 
-bool VisDataSax::fatalError(const QXmlParseException &exception)
+bool VisDataSax::characters(XmlStreamScanner * /*scanner*/, const QStringRef &str)
 {
-    _hasError = true ;
-    _errorMessage = QObject::tr("Parse error (2) at line %1, column %2:\n%3")
-                    .arg(exception.lineNumber())
-                    .arg(exception.columnNumber())
-                    .arg(exception.message());
-    return false;
+    if(NULL != _grid) {
+        _grid->addText(str.length(), trimmedLength(str));
+    } else if(NULL != currentElement) {
+        currentElement->size += str.length();
+        currentElement->text += trimmedLength(str);
+    }
+    return true ;
 }
 
-bool VisDataSax::error(const QXmlParseException &exception)
+void VisDataSax::parseError(const QString &message)
 {
     _hasError = true ;
-    _errorMessage = QObject::tr("Parse error (1) at line %1, column %2:\n%3")
-                    .arg(exception.lineNumber())
-                    .arg(exception.columnNumber())
-                    .arg(exception.message());
-    return false;
-}
-
-QString VisDataSax::errorString() const
-{
-    return QObject::tr("Generic error.");
+    _errorMessage = message ;
 }
@@ -24,19 +24,18 @@
 #ifndef VISDATASAX_H
 #define VISDATASAX_H
 
-#include <QXmlDefaultHandler>
-#include <QSet>
 #include "xmlEdit.h"
+#include "modules/xml/xmlstreamscanner.h"
 #include "elementbase.h"
 #include "modules/graph/tagnodes.h"
 #include "attributessummarydata.h"
+#include "vismapgrid.h"
 
-class VisDataSax : public QXmlDefaultHandler
+class VisDataSax : public XmlScanHandler
 {
 public:
     ElementBase *root;
     ElementBase *currentElement;
-    QSet<QString> *names;
     QHash<QString, TagNode*> *tagNodes;
     int _elementsCount;
     AttributesSummaryData *attributesSummaryData;
@@ -45,27 +44,26 @@ private :
     QString _errorMessage;
     volatile bool _userAborted;
     QString _currentElementPath;
+    VisMapGrid *_grid;
 private:
-    void addTagNode(const QString &name);
+    void addTagNode(const QString &name, const QString *parentName);
+    static int trimmedLength(const QStringRef &str);
 public:
-    VisDataSax(QSet<QString> *newNames, QHash<QString, TagNode*> *newTagNodes, AttributesSummaryData *newAttributesSummaryData);
+    VisDataSax(QHash<QString, TagNode*> *newTagNodes, AttributesSummaryData *newAttributesSummaryData);
     ~VisDataSax();
 
-    bool startDocument();
-    bool startElement(const QString &namespaceURI, const QString &localName,
-                      const QString &qName, const QXmlAttributes &attributes);
-    bool endElement(const QString &namespaceURI, const QString &localName,
-                    const QString &qName);
-    bool characters(const QString &str);
-    bool fatalError(const QXmlParseException &exception);
-    bool error(const QXmlParseException &exception);
-    QString errorString() const;
+    bool startDocument(XmlStreamScanner *scanner);
+    bool startElement(XmlStreamScanner *scanner, const int nameId, const QXmlStreamAttributes &attributes);
+    bool endElement(XmlStreamScanner *scanner, const int nameId);
+    bool characters(XmlStreamScanner *scanner, const QStringRef &text);
+    void parseError(const QString &message);
     bool hasError() const;
     void setHasError(bool hasError);
     QString errorMessage() const;
     void setErrorMessage(const QString &errorMessage);
     bool userAborted() const;
     void setUserAborted(bool userAborted);
+    void setGrid(VisMapGrid *grid);
 };
 
 
@@ -0,0 +1,195 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+#include "visdatatables.h"
+
+VisDataTables::ColumnTables::ColumnTables()
+{
+    leaves = 0 ;
+}
+
+VisDataTables::VisDataTables()
+{
+    _dataMap = NULL ;
+    _valueFunction = NULL ;
+    _rows = 0 ;
+    _blocks = 0 ;
+}
+
+VisDataTables::~VisDataTables()
+{
+}
+
+void VisDataTables::clear()
+{
+    _dataMap = NULL ;
+    _valueFunction = NULL ;
+    _rows = 0 ;
+    _blocks = 0 ;
+    _columns.clear();
+}
+
+bool VisDataTables::isBuiltFor(VisDataMap *dataMap, VisDataValueFunction valueFunction) const
+{
+    return (NULL != dataMap) && (dataMap == _dataMap) && (valueFunction == _valueFunction)
+           && (dataMap->rows.size() == _rows) && (dataMap->numColumns == _columns.size());
+}
+
+/*!
+ * \brief VisDataTables::build the columns are independent and are built in parallel if requested
+ */
+void VisDataTables::build(VisDataMap *dataMap, VisDataValueFunction valueFunction, const bool isParallel)
+{
+    clear();
+    if((NULL == dataMap) || (NULL == valueFunction)) {
+        return ;
+    }
+    _dataMap = dataMap ;
+    _valueFunction = valueFunction ;
+    _rows = dataMap->rows.size();
+    _blocks = (_rows + BlockRows - 1) / BlockRows ;
+    const int columns = qMax(0, dataMap->numColumns);
+    _columns.resize(columns);
+    if(isParallel && (columns > 1)) {
+        QList<QFuture<void> > futures;
+        for(int column = 0 ; column < columns ; column ++) {
+            futures.append(QtConcurrent::run(&VisDataTables::buildColumnInThread, this, column));
+        }
+        foreach(QFuture<void> future, futures) {
+            future.waitForFinished();
+        }
+    } else {
+        for(int column = 0 ; column < columns ; column ++) {
+            buildColumn(column);
+        }
+    }
+}
+
+void VisDataTables::buildColumnInThread(VisDataTables *tables, const int column)
+{
+    tables->buildColumn(column);
+}
+
+void VisDataTables::buildColumn(const int column)
+{
+    ColumnTables &tables = _columns[column];
+    tables.sums.resize(_blocks + 1);
+    tables.counts.resize(_blocks + 1);
+    tables.leaves = 1 ;
+    while(tables.leaves < _blocks) {
+        tables.leaves *= 2 ;
+    }
+    tables.maxima.fill(-1, tables.leaves * 2);
+    quint64 sum = 0 ;
+    quint32 count = 0 ;
+    tables.sums[0] = 0 ;
+    tables.counts[0] = 0 ;
+    for(int block = 0 ; block < _blocks ; block ++) {
+        const int firstRow = block * BlockRows ;
+        const int endRow = qMin(firstRow + BlockRows, _rows);
+        quint64 blockSum = 0 ;
+        int blockCount = 0 ;
+        float blockMax = -1 ;
+        addRows(column, firstRow, endRow, blockSum, blockCount, blockMax);
+        sum += blockSum ;
+        count += blockCount ;
+        tables.sums[block + 1] = sum ;
+        tables.counts[block + 1] = count ;
+        tables.maxima[tables.leaves + block] = blockMax ;
+    }
+    for(int node = tables.leaves - 1 ; node > 0 ; node --) {
+        tables.maxima[node] = qMax(tables.maxima[2 * node], tables.maxima[2 * node + 1]);
+    }
+}
+
+inline void VisDataTables::addRows(const int column, const int firstRow, const int endRow, quint64 &sum, int &count, float &maxValue) const
+{
+    for(int rowIndex = firstRow ; rowIndex < endRow ; rowIndex ++) {
+        VisDataRow *row = _dataMap->rows.at(rowIndex);
+        if(column < row->_numColumns) {
+            ElementBase *e = row->_columns[column];
+            if(NULL != e) {
+                const quint64 value = _valueFunction(e);
+                sum += value ;
+                count ++ ;
+                if(value > maxValue) {
+                    maxValue = value ;
+                }
+            }
+        }
+    }
+}
+
+float VisDataTables::maxOfBlocks(const ColumnTables &tables, const int firstBlock, const int endBlock) const
+{
+    float maxValue = -1 ;
+    int low = firstBlock + tables.leaves ;
+    int high = endBlock + tables.leaves ;
+    while(low < high) {
+        if(low & 1) {
+            maxValue = qMax(maxValue, tables.maxima[low]);
+            low ++ ;
+        }
+        if(high & 1) {
+            high -- ;
+            maxValue = qMax(maxValue, tables.maxima[high]);
+        }
+        low /= 2 ;
+        high /= 2 ;
+    }
+    return maxValue ;
+}
+
+/*!
+ * \brief VisDataTables::window adds the values of the rows from firstRow to endRow excluded
+ * in the columns from firstColumn to endColumn excluded; the window is clipped to the map.
+ * maxValue is not changed if there are no values greater than it.
+ */
+void VisDataTables::window(const int paramFirstRow, const int paramEndRow, const int paramFirstColumn, const int paramEndColumn,
+                           quint64 &sum, int &count, float &maxValue) const
+{
+    const int firstRow = qMax(0, paramFirstRow);
+    const int endRow = qMin(_rows, paramEndRow);
+    const int firstColumn = qMax(0, paramFirstColumn);
+    const int endColumn = qMin(_columns.size(), paramEndColumn);
+    if((firstRow >= endRow) || (firstColumn >= endColumn)) {
+        return ;
+    }
+    const int firstBlock = (firstRow + BlockRows - 1) / BlockRows ;
+    const int endBlock = endRow / BlockRows ;
+    for(int column = firstColumn ; column < endColumn ; column ++) {
+        if(firstBlock < endBlock) {
+            const ColumnTables &tables = _columns.at(column);
+            sum += tables.sums.at(endBlock) - tables.sums.at(firstBlock);
+            count += tables.counts.at(endBlock) - tables.counts.at(firstBlock);
+            const float blocksMax = maxOfBlocks(tables, firstBlock, endBlock);
+            if(blocksMax > maxValue) {
+                maxValue = blocksMax ;
+            }
+            addRows(column, firstRow, firstBlock * BlockRows, sum, count, maxValue);
+            addRows(column, endBlock * BlockRows, endRow, sum, count, maxValue);
+        } else {
+            addRows(column, firstRow, endRow, sum, count, maxValue);
+        }
+    }
+}
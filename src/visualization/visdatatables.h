@@ -0,0 +1,81 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef VISDATATABLES_H
+#define VISDATATABLES_H
+
+#include "xmlEdit.h"
+#include "visdatamap.h"
+
+typedef quint64(*VisDataValueFunction)(ElementBase *e);
+
+/**
+  \brief precomputed tables of a VisDataMap for one kind of value, one set for each column of the map:
+  the prefix sums and counts of the values by blocks of rows and a tree of the maxima of the blocks.
+  The sum, the count and the maximum of any window of rows cost the blocks at its ends and
+  a walk of the tree, so a pixel costs the same at every zoom level and position.
+  */
+class VisDataTables
+{
+public:
+    enum {
+        BlockRows = 16
+    };
+
+private:
+    class ColumnTables
+    {
+    public:
+        QVector<quint64> sums;
+        QVector<quint32> counts;
+        // a binary tree stored as an array, the leaves are the blocks; -1 if no values
+        QVector<float> maxima;
+        int leaves;
+
+        ColumnTables();
+    };
+
+    VisDataMap *_dataMap;
+    VisDataValueFunction _valueFunction;
+    int _rows;
+    int _blocks;
+    QVector<ColumnTables> _columns;
+
+    void buildColumn(const int column);
+    static void buildColumnInThread(VisDataTables *tables, const int column);
+    inline void addRows(const int column, const int firstRow, const int endRow, quint64 &sum, int &count, float &maxValue) const;
+    float maxOfBlocks(const ColumnTables &tables, const int firstBlock, const int endBlock) const;
+
+public:
+    VisDataTables();
+    ~VisDataTables();
+
+    void build(VisDataMap *dataMap, VisDataValueFunction valueFunction, const bool isParallel);
+    bool isBuiltFor(VisDataMap *dataMap, VisDataValueFunction valueFunction) const;
+    void clear();
+    void window(const int firstRow, const int endRow, const int firstColumn, const int endColumn,
+                quint64 &sum, int &count, float &maxValue) const;
+};
+
+#endif // VISDATATABLES_H
@@ -0,0 +1,100 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#include "vismapanalysis.h"
+
+/*!
+ * \brief VisMapAnalysis::VisMapAnalysis takes the ownership of the tree, the statistics are read from the map
+ */
+VisMapAnalysis::VisMapAnalysis(ElementBase *newRoot, const VisDataMap &dataMap)
+{
+    _root = newRoot ;
+    _grid = NULL ;
+    _numElements = dataMap.numElements ;
+    _maxSize = dataMap.maxSize ;
+    _maxChildrenCount = dataMap.maxChildrenCount ;
+    _maxAttributesCount = dataMap.maxAttributesCount ;
+    _maxText = dataMap.maxText ;
+    _totalAttributesSize = dataMap.totalAttributesSize ;
+    _maxAttributesSizePerElement = dataMap.maxAttributesSizePerElement ;
+}
+
+VisMapAnalysis::VisMapAnalysis(const VisMapGrid &grid)
+{
+    _root = NULL ;
+    _grid = new VisMapGrid(grid);
+    _numElements = (int)grid.numElements();
+    _maxSize = grid.maxSize();
+    _maxChildrenCount = grid.maxChildrenCount();
+    _maxAttributesCount = grid.maxAttributesCount();
+    _maxText = grid.maxText();
+    _totalAttributesSize = grid.totalAttributesSize();
+    _maxAttributesSizePerElement = grid.maxAttributesSizePerElement();
+}
+
+VisMapAnalysis::~VisMapAnalysis()
+{
+    DELETE_IF_NOTNULL(_root);
+    DELETE_IF_NOTNULL(_grid);
+}
+
+ElementBase *VisMapAnalysis::root() const
+{
+    return _root ;
+}
+
+bool VisMapAnalysis::isGrid() const
+{
+    return NULL != _grid ;
+}
+
+/*!
+ * \brief VisMapAnalysis::applyTo builds the rows of the map without touching the stored data
+ */
+void VisMapAnalysis::applyTo(VisDataMap &dataMap) const
+{
+    if(NULL != _grid) {
+        dataMap.calculate(*_grid);
+        return ;
+    }
+    dataMap.calculate(_root);
+    dataMap.numElements = _numElements ;
+    dataMap.maxSize = _maxSize ;
+    dataMap.maxChildrenCount = _maxChildrenCount ;
+    dataMap.maxAttributesCount = _maxAttributesCount ;
+    dataMap.maxText = _maxText ;
+    dataMap.totalAttributesSize = _totalAttributesSize ;
+    dataMap.maxAttributesSizePerElement = _maxAttributesSizePerElement ;
+}
+
+qint64 VisMapAnalysis::memoryCost() const
+{
+    qint64 cost = sizeof(VisMapAnalysis);
+    if(NULL != _grid) {
+        cost += sizeof(VisMapGrid) + (qint64)_grid->columnsCount() * _grid->resolution() * sizeof(VisMapGridCell);
+    } else {
+        cost += (qint64)_numElements * sizeof(ElementBase);
+    }
+    return cost ;
+}
@@ -0,0 +1,62 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef VISMAPANALYSIS_H
+#define VISMAPANALYSIS_H
+
+#include "xmlEdit.h"
+#include "fileanalysiscache.h"
+#include "elementbase.h"
+#include "visdatamap.h"
+#include "vismapgrid.h"
+
+/**
+  \brief the map of a file stored in the analysis cache: the element tree with its totals already computed
+  or the grid aggregated while scanning, with the statistics of the document.
+  The data are read only, so they can be shown by more than one map at once.
+  */
+class VisMapAnalysis : public FileAnalysisPayload
+{
+    ElementBase *_root;
+    VisMapGrid *_grid;
+    int _numElements;
+    qint64 _maxSize;
+    qint64 _maxChildrenCount;
+    int _maxAttributesCount ;
+    qint64 _maxText;
+    quint64 _totalAttributesSize;
+    quint64 _maxAttributesSizePerElement;
+
+public:
+    VisMapAnalysis(ElementBase *newRoot, const VisDataMap &dataMap);
+    VisMapAnalysis(const VisMapGrid &grid);
+    virtual ~VisMapAnalysis();
+
+    ElementBase *root() const;
+    bool isGrid() const;
+    void applyTo(VisDataMap &dataMap) const;
+    virtual qint64 memoryCost() const;
+};
+
+#endif // VISMAPANALYSIS_H
@@ -28,6 +28,7 @@
 #include "ui_vismapdialog.h"
 #include "utils.h"
 #include "visdatasax.h"
+#include "vismapanalysis.h"
 #include "extraction/extractfragmentsdialog.h"
 #include "choosecolormap.h"
 #include "modules/graph/nodesrelationsdialog.h"
@@ -36,13 +37,13 @@
 #include "modules/services/anotifier.h"
 #include "modules/services/uidservices.h"
 
-#include <QXmlSimpleReader>
 #include <QFileDialog>
 #include <QTimer>
 #include <QTextStream>
 #include <QDateTime>
 #include <QUrl>
 #include <QFutureWatcher>
+#include <QFileInfo>
 
 VisMapDialog::VisMapDialog(QXmlEditData *newData, QWidget *parent, QWidget *theMainWindow, const QString &fileName) :
     QDialog(parent),
@@ -54,6 +55,8 @@ VisMapDialog::VisMapDialog(QXmlEditData *newData, QWidget *parent, QWidget *theM
     _isAutoDelete = false ;
     _appData = newData ;
     _dataRoot = NULL ;
+    _isStreamingMap = false ;
+    _streamingThreshold = StreamingThreshold ;
     if(NULL == theMainWindow) {
         theMainWindow = this ;
     }
@@ -68,6 +71,7 @@ VisMapDialog::VisMapDialog(QXmlEditData *newData, QWidget *parent, QWidget *theM
     _filePath = fileName ;
     ui->exportStatsCmd->setEnabled(false);
     ui->cmdViewGraph->setEnabled(false);
+    ui->refineMap->setEnabled(false);
     ui->checkAnalyzeNodes->setChecked(true);
 
     ui->comboLoudness->addItem(QString("None"), QVariant(DataWidget::NoLoudness));
@@ -104,7 +108,7 @@ VisMapDialog::VisMapDialog(QXmlEditData *newData, QWidget *parent, QWidget *theM
 VisMapDialog::~VisMapDialog()
 {
     delete ui;
-    newData(NULL);
+    newData(QSharedPointer<FileAnalysis>());
     clearTagNodes();
 }
 
@@ -147,12 +151,16 @@ void VisMapDialog::closeEvent(QCloseEvent * event)
     }
 }
 
-void VisMapDialog::newData(ElementBase *newRoot)
+void VisMapDialog::newData(QSharedPointer<FileAnalysis> newAnalysis)
 {
-    if(NULL != _dataRoot) {
-        delete _dataRoot;
+    _analysis = newAnalysis ;
+    _dataRoot = NULL ;
+    if(!_analysis.isNull()) {
+        VisMapAnalysis *map = dynamic_cast<VisMapAnalysis*>(_analysis->map());
+        if(NULL != map) {
+            _dataRoot = map->root();
+        }
     }
-    _dataRoot = newRoot ;
 }
 
 void VisMapDialog::clearTagNodes()
@@ -170,26 +178,51 @@ void VisMapDialog::onLoadFile()
 }
 
 void VisMapDialog::loadFile(const QString &fileName)
+{
+    bool useGrid = false;
+    if(!fileName.isEmpty()) {
+        QFileInfo fileInfo(fileName);
+        useGrid = fileInfo.size() >= _streamingThreshold ;
+    }
+    loadData(fileName, useGrid, false, 0, -1);
+}
+
+/*!
+ * \brief VisMapDialog::loadData scans the file
+ * \param useGrid if true the map is aggregated while scanning, else the element tree is built
+ * \param isRefine if true, only the map rows between firstRow and lastRow are reloaded, the statistics are preserved
+ */
+void VisMapDialog::loadData(const QString &fileName, const bool useGrid, const bool isRefine, const qint64 firstRow, const qint64 lastRow)
 {
     //QDateTime tstart = QDateTime::currentDateTime();
     if(!fileName.isEmpty()) {
+        if(!isRefine && loadFromCache(fileName, useGrid)) {
+            return ;
+        }
         QProgressDialog progressDialogLoad(tr("Loading file %1").arg(fileName), tr("Abort"), 0, 0, this);
         progressDialogLoad.setAutoClose(true);
         progressDialogLoad.setWindowTitle(tr("Loading Data"));
         progressDialogLoad.setModal(true);
         setEnabled(false);
         progressDialogLoad.setEnabled(true);
-        clearTagNodes();
         QHash<QString, TagNode*> *nodes = NULL ;
         AttributesSummaryData *attributesSummaryData = NULL;
-        if(ui->checkAnalyzeNodes->isChecked()) {
-            nodes = &_tagNodes;
-            attributesSummaryData = &_attributesSummaryData;
+        if(!isRefine) {
+            clearTagNodes();
+            if(ui->checkAnalyzeNodes->isChecked()) {
+                nodes = &_tagNodes;
+                attributesSummaryData = &_attributesSummaryData;
+                attributesSummaryData->reset();
+            }
         }
 
         _filePath = fileName ;
-        attributesSummaryData->reset();
-        VisDataSax handler(&names, nodes, attributesSummaryData);
+        VisDataSax handler(nodes, attributesSummaryData);
+        VisMapGrid grid;
+        if(useGrid) {
+            grid.setRowWindow(firstRow, lastRow);
+            handler.setGrid(&grid);
+        }
         QFutureWatcher<void> loadWatcher;
         connect(&progressDialogLoad, SIGNAL(canceled()), &loadWatcher, SLOT(cancel()));
         connect(&loadWatcher, SIGNAL(finished()), &progressDialogLoad, SLOT(reset()));
@@ -216,32 +249,40 @@ void VisMapDialog::loadFile(const QString &fileName)
         ui->dataWidget->setData(NULL);
         _dataMap.resetData();
         if(isOk) {
-            UIDesktopServices uiServices(mainWindow());
-            uiServices.startIconProgressBar();
-            uiServices.setIconProgressBar(50);
-            newData(handler.root);
-            _dataMap.calculate(handler.root);
-            calcSize(handler.root, _dataMap);
-            recalc();
-            calcSlice(1);
-            displayNumbers();
-            ui->fileName->setText(_filePath);
-            ui->dataWidget->setData(handler.root);
-            ui->dataWidget->setDataMap(&_dataMap);
-            ui->dataWidget->unfreeze();
-            ui->sliceLevel->clear();
-            int levels = ui->dataWidget->levels();
-            for(int i = 0 ; i < levels ; i ++) {
-                ui->sliceLevel->addItem(QString("%1").arg(i + 1), QVariant(i));
-                if(1 == i) {
-                    ui->sliceLevel->setCurrentIndex(1);
+            _isStreamingMap = useGrid ;
+            if(isRefine) {
+                _dataMap.calculate(grid);
+            } else {
+                QSharedPointer<FileAnalysis> analysis(new FileAnalysis());
+                if(NULL != nodes) {
+                    analysis->setTagNodes(_tagNodes, &_attributesSummaryData);
+                } else {
+                    QSharedPointer<FileAnalysis> previous = FileAnalysisCache::find(fileName);
+                    if(!previous.isNull() && previous->hasTagNodes()) {
+                        QHash<QString, TagNode*> previousNodes;
+                        AttributesSummaryData previousAttributes;
+                        previous->copyTagNodesTo(previousNodes);
+                        previous->copyAttributesTo(&previousAttributes);
+                        analysis->setTagNodes(previousNodes, &previousAttributes);
+                        EMPTYPTRLIST(previousNodes, TagNode);
+                    }
+                }
+                if(useGrid) {
+                    _dataMap.calculate(grid);
+                    analysis->setMap(new VisMapAnalysis(grid));
+                } else {
+                    _dataMap.calculate(handler.root);
+                    calcSize(handler.root, _dataMap);
+                    analysis->setMap(new VisMapAnalysis(handler.root, _dataMap));
                 }
+                newData(analysis);
+                FileAnalysisCache::insert(fileName, analysis);
             }
-            ui->exportStatsCmd->setEnabled(true);
-            ui->cmdViewGraph->setEnabled(_tagNodes.count() > 0);
-            _appData->notifier()->notify(NULL, tr("Data ready."));
-            uiServices.endIconProgressBar();
+            showData(isRefine);
+        } else {
+            _isStreamingMap = false ;
         }
+        ui->refineMap->setEnabled(_isStreamingMap);
         setEnabled(true);
         /*QDateTime tend = QDateTime::currentDateTime();
         qint64  msecs = tend.toMSecsSinceEpoch() - tstart.toMSecsSinceEpoch();
@@ -249,18 +290,106 @@ void VisMapDialog::loadFile(const QString &fileName)
     }
 }
 
+/*!
+ * \brief VisMapDialog::loadFromCache shows the map of a file already scanned and not changed since, without reading it again
+ * \return false if the file must be scanned
+ */
+bool VisMapDialog::loadFromCache(const QString &fileName, const bool useGrid)
+{
+    QSharedPointer<FileAnalysis> analysis = FileAnalysisCache::find(fileName);
+    if(analysis.isNull()) {
+        return false;
+    }
+    VisMapAnalysis *map = dynamic_cast<VisMapAnalysis*>(analysis->map());
+    const bool analyzeNodes = ui->checkAnalyzeNodes->isChecked();
+    if((NULL == map) || (map->isGrid() != useGrid) || (analyzeNodes && !analysis->hasTagNodes())) {
+        return false;
+    }
+    ui->dataWidget->freeze();
+    ui->dataWidget->setData(NULL);
+    _dataMap.resetData();
+    _filePath = fileName ;
+    clearTagNodes();
+    if(analyzeNodes) {
+        analysis->copyTagNodesTo(_tagNodes);
+        analysis->copyAttributesTo(&_attributesSummaryData);
+    }
+    newData(analysis);
+    map->applyTo(_dataMap);
+    _isStreamingMap = useGrid ;
+    showData(false);
+    ui->refineMap->setEnabled(_isStreamingMap);
+    return true ;
+}
+
+void VisMapDialog::showData(const bool isRefine)
+{
+    UIDesktopServices uiServices(mainWindow());
+    uiServices.startIconProgressBar();
+    uiServices.setIconProgressBar(50);
+    recalc();
+    calcSlice(1);
+    displayNumbers();
+    ui->fileName->setText(_filePath);
+    ui->dataWidget->setData(_dataMap._root);
+    ui->dataWidget->setDataMap(&_dataMap);
+    if(isRefine) {
+        ui->zoom->setValue(ui->zoom->minimum());
+    }
+    ui->dataWidget->unfreeze();
+    ui->sliceLevel->clear();
+    int levels = ui->dataWidget->levels();
+    for(int i = 0 ; i < levels ; i ++) {
+        ui->sliceLevel->addItem(QString("%1").arg(i + 1), QVariant(i));
+        if(1 == i) {
+            ui->sliceLevel->setCurrentIndex(1);
+        }
+    }
+    ui->exportStatsCmd->setEnabled(true);
+    ui->cmdViewGraph->setEnabled(_tagNodes.count() > 0);
+    _appData->notifier()->notify(NULL, tr("Data ready."));
+    uiServices.endIconProgressBar();
+}
+
+/*!
+ * \brief VisMapDialog::on_refineMap_clicked rescans the file aggregating only the rows visible in the map,
+ * if all the rows are visible the whole document is loaded again.
+ */
+void VisMapDialog::on_refineMap_clicked()
+{
+    if(!_isStreamingMap || _filePath.isEmpty()) {
+        return ;
+    }
+    QRect window = ui->dataWidget->dataWindow();
+    const int buckets = _dataMap.rows.size();
+    if((window.height() <= 0) || ((window.top() <= 0) && (window.height() >= buckets))) {
+        if(0 == _dataMap.firstDocumentRow) {
+            return ;
+        }
+        loadData(_filePath, true, true, 0, -1);
+        return ;
+    }
+    const qint64 firstRow = _dataMap.firstDocumentRow + window.top() * _dataMap.rowsPerBucket ;
+    const qint64 lastRow = _dataMap.firstDocumentRow + (window.top() + window.height()) * _dataMap.rowsPerBucket ;
+    loadData(_filePath, true, true, firstRow, lastRow);
+}
+
+void VisMapDialog::setStreamingThreshold(const qint64 value)
+{
+    _streamingThreshold = value ;
+}
+
+bool VisMapDialog::isStreamingMap()
+{
+    return _isStreamingMap ;
+}
+
 /*!
  * \brief VisMapDialog::loadFileWorkerMethod uses instance variable to complete work
  * \param fileName
  */
 void VisMapDialog::loadFileWorkerMethod(VisDataSax *handler, const QString &fileName)
 {
-    QXmlSimpleReader reader;
-    reader.setFeature("http://xml.org/sax/features/namespaces", false);
-    reader.setFeature("http://xml.org/sax/features/namespace-prefixes", true);
-    reader.setContentHandler(handler);
-    reader.setErrorHandler(handler);
-
     QFile file(fileName);
     if(!file.open(QFile::ReadOnly | QFile::Text)) {
         Utils::error(tr("An error occurred opening the file: %1.").arg(file.errorString()));
@@ -269,8 +398,8 @@ void VisMapDialog::loadFileWorkerMethod(VisDataSax *handler, const QString &file
     }
     _filePath = fileName ;
 
-    QXmlInputSource xmlInput(&file);
-    if(!reader.parse(xmlInput)) {
+    XmlStreamScanner scanner;
+    if(!scanner.scan(&file, handler)) {
         handler->setHasError(true);
     }
     file.close();
@@ -468,6 +597,10 @@ ElementBase *VisMapDialog::getElement(const int x, const int y)
 
 void VisMapDialog::calcSlice(const int nSlice)
 {
+    if(_dataMap.isAggregated) {
+        _summary.totalFragments = (int)_dataMap.elementsPerDepth.value(nSlice, 0);
+        return ;
+    }
     QSet<int> slices;
     int rowMax = _dataMap.rows.size();
     for(int y = 0 ; y < rowMax ; y ++) {
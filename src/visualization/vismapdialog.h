@@ -36,6 +36,7 @@
 #include "modules/graph/tagnodes.h"
 #include "attributessummarydata.h"
 #include "qxmleditdata.h"
+#include "fileanalysiscache.h"
 
 class VisDataSax;
 
@@ -54,17 +55,27 @@ class VisMapDialog : public QDialog
     GrayColorMap _grayColorMap;
     QString _filePath;
     SummaryData _summary;
-    QSet<QString> names;
     QString _saveStatsPath;
     AttributesSummaryData _attributesSummaryData;
+    /** \brief the scan shown by the map, shared with the analysis cache; it owns the element tree
+      */
+    QSharedPointer<FileAnalysis> _analysis;
     ElementBase *_dataRoot;
     QHash<QString, TagNode*> _tagNodes ;
     QXmlEditData *_appData;
     bool _isAutoDelete;
     QWidget *_mainWindow;
+    /** \brief files bigger than this are aggregated while scanning without building the element tree
+      */
+    qint64 _streamingThreshold;
+    bool _isStreamingMap;
 
     static void calcSize(ElementBase *e, VisDataMap &dataMap);
 public:
+    enum {
+        StreamingThreshold = 64 * 1024 * 1024
+    };
+
     explicit VisMapDialog(QXmlEditData *newData, QWidget *parent, QWidget *mainWindow, const QString &fileName = "");
     ~VisMapDialog();
     void setAutoDelete();
@@ -73,18 +84,23 @@ public:
     AttributesSummaryData *attributesSummaryData();
     bool loadAttributeWhiteList(const QString &whiteListFile);
     bool loadAttributeBlackList(const QString &blackListFile);
+    void setStreamingThreshold(const qint64 value);
+    bool isStreamingMap();
 
 private:
     Ui::VisMapDialog *ui;
 
     void loadFile(const QString &fileName);
+    void loadData(const QString &fileName, const bool useGrid, const bool isRefine, const qint64 firstRow, const qint64 lastRow);
+    bool loadFromCache(const QString &fileName, const bool useGrid);
+    void showData(const bool isRefine);
     void recalc();
     void displayNumbers();
     void newNumbersItem(const QString &label, const QString &data);
     void calcVerticalPosition();
     void calcSlice(const int nSlice);
     ElementBase *getElement(const int x, const int y);
-    void newData(ElementBase *newRoot);
+    void newData(QSharedPointer<FileAnalysis> newAnalysis);
     void clearTagNodes();
     // drag and drop
     void dragEnterEvent(QDragEnterEvent *event);
@@ -111,6 +127,7 @@ private slots:
     void on_cbGrid_stateChanged(int /*state*/);
     void on_cbPoints_stateChanged(int /*state*/);
     void on_copyImageToClipboard_clicked();
+    void on_refineMap_clicked();
 #ifdef QXMLEDIT_TEST
     friend class TestVis;
 #endif
@@ -0,0 +1,393 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#include "vismapgrid.h"
+
+VisMapGridCell::VisMapGridCell()
+{
+    reset();
+}
+
+void VisMapGridCell::reset()
+{
+    rows = 0 ;
+    size = 0 ;
+    totalSize = 0 ;
+    childrenCount = 0 ;
+    totalChildrenCount = 0 ;
+    text = 0 ;
+    totalText = 0 ;
+    attributesCount = 0 ;
+    totalAttributesCount = 0 ;
+    firstElement = -1 ;
+    name = QString();
+}
+
+void VisMapGridCell::merge(const VisMapGridCell &other)
+{
+    if(firstElement < 0) {
+        firstElement = other.firstElement;
+        name = other.name ;
+    }
+    rows += other.rows ;
+    size += other.size ;
+    totalSize += other.totalSize ;
+    childrenCount += other.childrenCount ;
+    totalChildrenCount += other.totalChildrenCount ;
+    text += other.text ;
+    totalText += other.totalText ;
+    attributesCount += other.attributesCount ;
+    totalAttributesCount += other.totalAttributesCount ;
+}
+
+//---------------------------------------------------------
+
+VisMapGrid::OpenElement::OpenElement()
+{
+    firstRow = 0 ;
+    ordinal = 0 ;
+    size = 0 ;
+    childrenCount = 0 ;
+    text = 0 ;
+    attributesCount = 0 ;
+    attributesSize = 0 ;
+    totalSize = 0 ;
+    totalChildrenCount = 0 ;
+    totalText = 0 ;
+    totalAttributesCount = 0 ;
+}
+
+//---------------------------------------------------------
+
+VisMapGrid::VisMapGrid(const int resolution)
+{
+    // merging buckets two by two requires an even resolution
+    _resolution = qMax(2, resolution + (resolution & 1));
+    _windowFirstRow = 0 ;
+    _windowLastRow = -1 ;
+    reset();
+}
+
+VisMapGrid::~VisMapGrid()
+{
+}
+
+void VisMapGrid::reset()
+{
+    _rowsPerBucket = 1 ;
+    _rows = 0 ;
+    _stack.clear();
+    _elementsPerDepth.clear();
+    _columns.clear();
+    _numElements = 0 ;
+    _numColumns = 0 ;
+    _maxSize = 0 ;
+    _maxChildrenCount = 0 ;
+    _maxAttributesCount = 0 ;
+    _maxText = 0 ;
+    _totalAttributesSize = 0 ;
+    _maxAttributesSizePerElement = 0 ;
+    _root = OpenElement();
+}
+
+/*!
+ * \brief VisMapGrid::setRowWindow restricts the buckets to the rows [firstRow, lastRow)
+ * \param lastRow -1 for the end of the document
+ */
+void VisMapGrid::setRowWindow(const qint64 firstRow, const qint64 lastRow)
+{
+    _windowFirstRow = qMax(Q_INT64_C(0), firstRow);
+    _windowLastRow = lastRow ;
+    reset();
+}
+
+qint64 VisMapGrid::windowFirstRow() const
+{
+    return _windowFirstRow ;
+}
+
+QVector<VisMapGridCell> &VisMapGrid::column(const int depth)
+{
+    while(_columns.size() <= depth) {
+        _columns.append(QVector<VisMapGridCell>(_resolution));
+    }
+    return _columns[depth];
+}
+
+void VisMapGrid::coarsen()
+{
+    _rowsPerBucket *= 2 ;
+    const int half = _resolution / 2 ;
+    const int columnsCount = _columns.size();
+    for(int depth = 0 ; depth < columnsCount ; depth ++) {
+        QVector<VisMapGridCell> &cells = _columns[depth];
+        for(int i = 0 ; i < half ; i ++) {
+            VisMapGridCell merged = cells.at(2 * i);
+            merged.merge(cells.at(2 * i + 1));
+            cells[i] = merged ;
+        }
+        for(int i = half ; i < _resolution ; i ++) {
+            cells[i].reset();
+        }
+    }
+}
+
+void VisMapGrid::accumulate(const int depth, const OpenElement &element, const qint64 lastRow)
+{
+    qint64 first = qMax(element.firstRow, _windowFirstRow);
+    qint64 last = lastRow ;
+    if((_windowLastRow >= 0) && (last > _windowLastRow)) {
+        last = _windowLastRow ;
+    }
+    if(first >= last) {
+        return ;
+    }
+    first -= _windowFirstRow ;
+    last -= _windowFirstRow ;
+    while(((last - 1) / _rowsPerBucket) >= _resolution) {
+        coarsen();
+    }
+    QVector<VisMapGridCell> &cells = column(depth);
+    const qint64 lastBucket = (last - 1) / _rowsPerBucket ;
+    for(qint64 bucket = first / _rowsPerBucket ; bucket <= lastBucket ; bucket ++) {
+        const qint64 start = qMax(first, bucket * _rowsPerBucket);
+        const qint64 end = qMin(last, (bucket + 1) * _rowsPerBucket);
+        const double rows = end - start ;
+        VisMapGridCell &cell = cells[(int)bucket];
+        if(cell.firstElement < 0) {
+            cell.firstElement = element.ordinal ;
+            cell.name = element.name ;
+        }
+        cell.rows += end - start ;
+        cell.size += rows * element.size ;
+        cell.totalSize += rows * element.totalSize ;
+        cell.childrenCount += rows * element.childrenCount ;
+        cell.totalChildrenCount += rows * element.totalChildrenCount ;
+        cell.text += rows * element.text ;
+        cell.totalText += rows * element.totalText ;
+        cell.attributesCount += rows * element.attributesCount ;
+        cell.totalAttributesCount += rows * element.totalAttributesCount ;
+    }
+}
+
+void VisMapGrid::startElement(const QString &name, const qint64 size, const int attributesCount, const quint64 attributesSize)
+{
+    const int depth = _stack.size();
+    if(depth > 0) {
+        _stack[depth - 1].childrenCount++;
+    }
+    if(_elementsPerDepth.size() <= depth) {
+        _elementsPerDepth.append(0);
+    }
+    OpenElement element;
+    element.name = name ;
+    element.firstRow = _rows ;
+    element.ordinal = _elementsPerDepth[depth]++ ;
+    element.size = size ;
+    element.attributesCount = attributesCount ;
+    element.attributesSize = attributesSize ;
+    _stack.append(element);
+    if(_numColumns < (depth + 1)) {
+        _numColumns = depth + 1 ;
+    }
+}
+
+void VisMapGrid::addText(const qint64 size, const qint64 text)
+{
+    if(!_stack.isEmpty()) {
+        OpenElement &element = _stack[_stack.size() - 1];
+        element.size += size ;
+        element.text += text ;
+    }
+}
+
+void VisMapGrid::endElement()
+{
+    if(_stack.isEmpty()) {
+        return ;
+    }
+    const int depth = _stack.size() - 1 ;
+    OpenElement &element = _stack[depth];
+    element.totalSize += element.size ;
+    element.totalText += element.text ;
+    element.totalAttributesCount += element.attributesCount ;
+    element.totalChildrenCount += element.childrenCount ;
+    // a row of the map ends at each leaf
+    if(0 == element.childrenCount) {
+        _rows ++ ;
+    }
+    accumulate(depth, element, _rows);
+
+    _numElements ++ ;
+    _totalAttributesSize += element.attributesSize ;
+    if(_maxSize < element.size) {
+        _maxSize = element.size ;
+    }
+    if(_maxChildrenCount < element.childrenCount) {
+        _maxChildrenCount = element.childrenCount ;
+    }
+    if(_maxAttributesCount < element.attributesCount) {
+        _maxAttributesCount = element.attributesCount ;
+    }
+    if(_maxText < element.text) {
+        _maxText = element.text ;
+    }
+    if(_maxAttributesSizePerElement < element.attributesSize) {
+        _maxAttributesSizePerElement = element.attributesSize ;
+    }
+
+    if(depth > 0) {
+        OpenElement &parent = _stack[depth - 1];
+        parent.totalSize += element.totalSize ;
+        parent.totalText += element.totalText ;
+        parent.totalAttributesCount += element.totalAttributesCount ;
+        parent.totalChildrenCount += element.totalChildrenCount ;
+    } else {
+        _root = element ;
+    }
+    _stack.remove(depth);
+}
+
+const QString *VisMapGrid::currentName() const
+{
+    if(_stack.isEmpty()) {
+        return NULL ;
+    }
+    return &_stack.at(_stack.size() - 1).name ;
+}
+
+int VisMapGrid::resolution() const
+{
+    return _resolution ;
+}
+
+qint64 VisMapGrid::rowsPerBucket() const
+{
+    return _rowsPerBucket ;
+}
+
+int VisMapGrid::bucketsCount() const
+{
+    qint64 last = _rows ;
+    if((_windowLastRow >= 0) && (last > _windowLastRow)) {
+        last = _windowLastRow ;
+    }
+    const qint64 rows = last - _windowFirstRow ;
+    if(rows <= 0) {
+        return 0 ;
+    }
+    return (int)qMin((qint64)_resolution, (rows + _rowsPerBucket - 1) / _rowsPerBucket);
+}
+
+int VisMapGrid::columnsCount() const
+{
+    return _columns.size();
+}
+
+const VisMapGridCell &VisMapGrid::cell(const int depth, const int bucket) const
+{
+    static const VisMapGridCell emptyCell;
+    if((depth < 0) || (depth >= _columns.size()) || (bucket < 0) || (bucket >= _resolution)) {
+        return emptyCell ;
+    }
+    return _columns.at(depth).at(bucket);
+}
+
+qint64 VisMapGrid::rowsCount() const
+{
+    return _rows ;
+}
+
+qint64 VisMapGrid::numElements() const
+{
+    return _numElements ;
+}
+
+int VisMapGrid::numColumns() const
+{
+    return _numColumns ;
+}
+
+qint64 VisMapGrid::elementsAtDepth(const int depth) const
+{
+    if((depth < 0) || (depth >= _elementsPerDepth.size())) {
+        return 0 ;
+    }
+    return _elementsPerDepth.at(depth);
+}
+
+qint64 VisMapGrid::maxSize() const
+{
+    return _maxSize ;
+}
+
+qint64 VisMapGrid::maxChildrenCount() const
+{
+    return _maxChildrenCount ;
+}
+
+int VisMapGrid::maxAttributesCount() const
+{
+    return _maxAttributesCount ;
+}
+
+qint64 VisMapGrid::maxText() const
+{
+    return _maxText ;
+}
+
+quint64 VisMapGrid::totalAttributesSize() const
+{
+    return _totalAttributesSize ;
+}
+
+quint64 VisMapGrid::maxAttributesSizePerElement() const
+{
+    return _maxAttributesSizePerElement ;
+}
+
+QString VisMapGrid::rootName() const
+{
+    return _root.name ;
+}
+
+qint64 VisMapGrid::rootTotalSize() const
+{
+    return _root.totalSize ;
+}
+
+qint64 VisMapGrid::rootTotalChildrenCount() const
+{
+    return _root.totalChildrenCount ;
+}
+
+qint64 VisMapGrid::rootTotalText() const
+{
+    return _root.totalText ;
+}
+
+qint64 VisMapGrid::rootTotalAttributesCount() const
+{
+    return _root.totalAttributesCount ;
+}
@@ -0,0 +1,147 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+#ifndef VISMAPGRID_H
+#define VISMAPGRID_H
+
+#include "xmlEdit.h"
+#include <QVector>
+
+/**
+  \brief aggregated values of the elements of one depth in a bucket of map rows
+  The sums are weighted by the number of rows that each element spans in the bucket.
+  */
+class VisMapGridCell
+{
+public:
+    qint64 rows;
+    double size;
+    double totalSize;
+    double childrenCount;
+    double totalChildrenCount;
+    double text;
+    double totalText;
+    double attributesCount;
+    double totalAttributesCount;
+    // ordinal of the first element of this depth that falls in the bucket, -1 if none
+    qint64 firstElement;
+    QString name;
+
+    VisMapGridCell();
+    void reset();
+    void merge(const VisMapGridCell &other);
+};
+
+/**
+  \brief computes the visualization map on the fly while the document is scanned.
+  A map row ends at every leaf element; the rows are collected in a fixed number of buckets
+  and, when the document has more rows than buckets, adjacent buckets are merged doubling the rows per bucket.
+  Only the elements currently open are kept, so the memory depends on the resolution and on the depth of the document.
+  A window of rows can be set to refine a part of the map in a new scan.
+  */
+class VisMapGrid
+{
+    class OpenElement
+    {
+    public:
+        QString name;
+        qint64 firstRow;
+        qint64 ordinal;
+        qint64 size;
+        qint64 childrenCount;
+        qint64 text;
+        int attributesCount;
+        quint64 attributesSize;
+        qint64 totalSize;
+        qint64 totalChildrenCount;
+        qint64 totalText;
+        qint64 totalAttributesCount;
+
+        OpenElement();
+    };
+
+    int _resolution;
+    qint64 _rowsPerBucket;
+    qint64 _windowFirstRow;
+    qint64 _windowLastRow;
+    qint64 _rows;
+    QVector<OpenElement> _stack;
+    QVector<qint64> _elementsPerDepth;
+    QVector<QVector<VisMapGridCell> > _columns;
+
+    // document totals, always computed on the whole document
+    qint64 _numElements;
+    int _numColumns;
+    qint64 _maxSize;
+    qint64 _maxChildrenCount;
+    int _maxAttributesCount;
+    qint64 _maxText;
+    quint64 _totalAttributesSize;
+    quint64 _maxAttributesSizePerElement;
+    OpenElement _root;
+
+    void accumulate(const int depth, const OpenElement &element, const qint64 lastRow);
+    void coarsen();
+    QVector<VisMapGridCell> &column(const int depth);
+
+public:
+    enum {
+        DefaultResolution = 2048
+    };
+
+    VisMapGrid(const int resolution = DefaultResolution);
+    ~VisMapGrid();
+
+    void reset();
+    void setRowWindow(const qint64 firstRow, const qint64 lastRow);
+    qint64 windowFirstRow() const;
+
+    void startElement(const QString &name, const qint64 size, const int attributesCount, const quint64 attributesSize);
+    void addText(const qint64 size, const qint64 text);
+    void endElement();
+    const QString *currentName() const;
+
+    int resolution() const;
+    qint64 rowsPerBucket() const;
+    int bucketsCount() const;
+    int columnsCount() const;
+    const VisMapGridCell &cell(const int depth, const int bucket) const;
+
+    qint64 rowsCount() const;
+    qint64 numElements() const;
+    int numColumns() const;
+    qint64 elementsAtDepth(const int depth) const;
+    qint64 maxSize() const;
+    qint64 maxChildrenCount() const;
+    int maxAttributesCount() const;
+    qint64 maxText() const;
+    quint64 totalAttributesSize() const;
+    quint64 maxAttributesSizePerElement() const;
+    QString rootName() const;
+    qint64 rootTotalSize() const;
+    qint64 rootTotalChildrenCount() const;
+    qint64 rootTotalText() const;
+    qint64 rootTotalAttributesCount() const;
+};
+
+#endif // VISMAPGRID_H
@@ -55,6 +55,7 @@
 #include "modules/xsd/schemareferencesdialog.h"
 #include "modules/namespace/namespacereferenceentry.h"
 #include "modules/xml/xmlloadcontext.h"
+#include "modules/xml/xmlbackgroundloader.h"
 #include "modules/replica/replicasettingsdialog.h"
 #include "modules/replica/replicamanager.h"
 #include "undo/undoreplicacommand.h"
@@ -74,6 +75,7 @@
 #include "modules/xsd/namespacemanager.h"
 #include "modules/specialized/scxml/scxmlinfo.h"
 #include "modules/specialized/scxml/scxmleditormanager.h"
+#include "modules/utils/perftrace.h"
 
 void ShowTextInDialog(QWidget *parent, const QString &text);
 
@@ -756,6 +758,7 @@ PaintInfo* XmlEditWidgetPrivate::getPaintInfo()
 
 void XmlEditWidgetPrivate::display()
 {
+    QXMLEDIT_TRACE_ZONE("display", "display");
     if(NULL != regola) {
         p->ui->treeWidget->setUpdatesEnabled(false);
         regola->caricaValori(p->ui->treeWidget);
@@ -2132,10 +2135,20 @@ bool XmlEditWidgetPrivate::readData(XMLLoadStatus *status, QXmlStreamReader *xml
 {
     XMLLoadContext context;
     context.setSample(status->isSample());
+    context.setSampleStopUnchanged(Config::getInt(Config::KEY_XML_SAMPLE_STOPUNCHANGED, 0));
+    context.setRecordSourceRanges(Regola::isSaveIncremental());
     status->clearErrors();
     Regola *newModel = new Regola(filePath);
     houseworkRegola(newModel);
-    if(!newModel->readFromStream(&context, xmlReader)) {
+    bool isRead = false;
+    // big files are read in a worker thread, an abort is handled as an error keeping what was read
+    if(XMLBackgroundLoader::isBackgroundLoad(xmlReader, XMLBackgroundLoader::BackgroundLoadThreshold)) {
+        XMLBackgroundLoader loader(newModel, &context, xmlReader);
+        isRead = loader.load(p->window(), filePath);
+    } else {
+        isRead = newModel->readFromStream(&context, xmlReader);
+    }
+    if(!isRead) {
         if(showLoadError(context.errorMessage(), errorHandler, &context, xmlReader)) {
             status->setErrorsPresent();
         } else {
@@ -2144,6 +2157,7 @@ bool XmlEditWidgetPrivate::readData(XMLLoadStatus *status, QXmlStreamReader *xml
         }
     }
     assignRegola(newModel, isSetState);
+    regola->setTextIndexEnabled(Config::getBool(Config::KEY_SEARCH_USEINDEX, true));
     return true;
 }
 
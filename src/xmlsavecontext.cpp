@@ -37,6 +37,9 @@ XMLSaveContext::XMLSaveContext()
     _attrIndex = 0 ;
     _bytesPerChar = 1 ;
     _canUseTextMode = false;
+    _outputBuffer = NULL ;
+    _outputDevice = NULL ;
+    _isOutputError = false ;
 }
 
 XMLSaveContext::~XMLSaveContext()
@@ -164,7 +167,9 @@ void XMLSaveContext::setIsAttributesColumns(bool isAttributesColumns)
 void XMLSaveContext::startElement(QXmlStreamWriter &writer)
 {
     _currentAttrPos = 0;
-    _baseAttrPos = writer.device()->pos();
+    if(isUsingDevicePosition()) {
+        _baseAttrPos = writer.device()->pos();
+    }
     _attrIndex = 0;
 }
 
@@ -217,3 +222,50 @@ bool XMLSaveContext::hasNamespaceDeclarations()
 {
     return _namespacesToInsert.size() > 0;
 }
+
+/*!
+ * \brief the attributes in columns are measured on the output device,
+ * the other layouts can be written through a text buffer.
+ */
+bool XMLSaveContext::isUsingDevicePosition() const
+{
+    return (_indentation > 0) && isAttributesColumns() ;
+}
+
+/*!
+ * \brief the writer appends to the buffer, that is encoded as UTF-8 in bulk
+ * and written to the device every OutputBufferFlushSize characters.
+ */
+void XMLSaveContext::setOutputBuffer(QString *buffer, QIODevice *device)
+{
+    _outputBuffer = buffer ;
+    _outputDevice = device ;
+    _isOutputError = false ;
+    if(NULL != _outputBuffer) {
+        // keeps the capacity between flushes
+        _outputBuffer->reserve(OutputBufferFlushSize + OutputBufferFlushSize / 8);
+    }
+}
+
+bool XMLSaveContext::flushOutput(const bool isForced)
+{
+    if((NULL == _outputBuffer) || _isOutputError) {
+        return !_isOutputError ;
+    }
+    if(!isForced && (_outputBuffer->length() < OutputBufferFlushSize)) {
+        return true ;
+    }
+    if(!_outputBuffer->isEmpty()) {
+        const QByteArray data = _outputBuffer->toUtf8();
+        if(_outputDevice->write(data) != data.length()) {
+            _isOutputError = true ;
+        }
+        _outputBuffer->resize(0);
+    }
+    return !_isOutputError ;
+}
+
+bool XMLSaveContext::isOutputError() const
+{
+    return _isOutputError ;
+}
@@ -42,11 +42,16 @@ class XMLSaveContext
     QByteArray _crBytes;
     int _bytesPerChar;
     bool _canUseTextMode;
+    QString *_outputBuffer;
+    QIODevice *_outputDevice;
+    bool _isOutputError;
 
     bool isAsciiCompatible(const QByteArray &encoding);
     QByteArray translateData(const QString &string, const QByteArray &encoding);
 
 public:
+    static const int OutputBufferFlushSize = 1024 * 1024 ;
+
     XMLSaveContext();
     ~XMLSaveContext();
 
@@ -78,6 +83,11 @@ public:
     QHash<QString, QString> &namespaceDeclarationsReference();
     bool hasNamespaceDeclarations();
     bool canUseTextMode();
+    //---
+    bool isUsingDevicePosition() const;
+    void setOutputBuffer(QString *buffer, QIODevice *device);
+    bool flushOutput(const bool isForced);
+    bool isOutputError() const;
 };
 
 #endif // XMLSAVECONTEXT_H
@@ -33,11 +33,18 @@ XSaxHandler::~XSaxHandler()
 {
 }
 
-bool XSaxHandler::startElement(const QString &/*namespaceURI*/, const QString &/*localName*/,
-                               const QString &qName, const QXmlAttributes &/*attributes*/)
+bool XSaxHandler::startElement(XmlStreamScanner *scanner, const int nameId, const QXmlStreamAttributes &/*attributes*/)
 {
+    while(_isPooled.size() <= nameId) {
+        _isPooled.append(false);
+        _pooledNames.append(QString());
+    }
+    if(!_isPooled.at(nameId)) {
+        _pooledNames[nameId] = xmlTree->addNameToPool(scanner->name(nameId));
+        _isPooled[nameId] = true ;
+    }
     //TODO Element *elem = new Element( xmlTree->getTag(qName), QString(""), xmlTree, currentElement ) ;
-    Element *elem = new Element(xmlTree->addNameToPool(qName), QString(""), xmlTree, currentElement) ;
+    Element *elem = new Element(_pooledNames.at(nameId), QString(""), xmlTree, currentElement) ;
     if(NULL == currentElement) {
         xmlTree->setRootElement(elem);
     } else {
@@ -47,8 +54,7 @@ bool XSaxHandler::startElement(const QString &/*namespaceURI*/, const QString &/
     return true ;
 }
 
-bool XSaxHandler::endElement(const QString &/*namespaceURI*/, const QString &/*localName*/,
-                             const QString &/*qName*/)
+bool XSaxHandler::endElement(XmlStreamScanner * /*scanner*/, const int /*nameId*/)
 {
     if(NULL != currentElement) {
         currentElement = currentElement->parent();
@@ -56,7 +62,7 @@ bool XSaxHandler::endElement(const QString &/*namespaceURI*/, const QString &/*l
     return true;
 }
 
-bool XSaxHandler::characters(const QString &str)
+bool XSaxHandler::characters(XmlStreamScanner * /*scanner*/, const QStringRef &str)
 {
     if(NULL != currentElement) {
         currentElement->incrementSizeInfo(str.length());
@@ -64,24 +70,7 @@ bool XSaxHandler::characters(const QString &str)
     return true ;
 }
 
-bool XSaxHandler::fatalError(const QXmlParseException &exception)
-{
-    Utils::error(QObject::tr("Parse error (2) at line %1, column %2:\n%3")
-                 .arg(exception.lineNumber())
-                 .arg(exception.columnNumber())
-                 .arg(exception.message()));
-    return false;
-}
-
-bool XSaxHandler::error(const QXmlParseException &exception)
-{
-    Utils::error(QObject::tr("Parse error (1) at line %1, column %2:\n%3")
-                 .arg(exception.lineNumber())
-                 .arg(exception.columnNumber())
-                 .arg(exception.message()));
-    return false;
-}
-QString XSaxHandler::errorString() const
+void XSaxHandler::parseError(const QString &message)
 {
-    return QObject::tr("Generic error.");
+    Utils::error(message);
 }
@@ -23,25 +23,24 @@
 #ifndef XSAXHANDLER_H
 #define XSAXHANDLER_H
 
-#include <QXmlDefaultHandler>
 #include "regola.h"
+#include "modules/xml/xmlstreamscanner.h"
 
-class XSaxHandler : public QXmlDefaultHandler
+class XSaxHandler : public XmlScanHandler
 {
     Regola *xmlTree;
     Element *currentElement;
+    // the pooled names of the tree, indexed by the scanner ids
+    QVector<QString> _pooledNames;
+    QVector<bool> _isPooled;
 public:
     XSaxHandler(Regola *regola);
     ~XSaxHandler();
 
-    bool startElement(const QString &namespaceURI, const QString &localName,
-                      const QString &qName, const QXmlAttributes &attributes);
-    bool endElement(const QString &namespaceURI, const QString &localName,
-                    const QString &qName);
-    bool characters(const QString &str);
-    bool fatalError(const QXmlParseException &exception);
-    bool error(const QXmlParseException &exception);
-    QString errorString() const;
+    bool startElement(XmlStreamScanner *scanner, const int nameId, const QXmlStreamAttributes &attributes);
+    bool endElement(XmlStreamScanner *scanner, const int nameId);
+    bool characters(XmlStreamScanner *scanner, const QStringRef &text);
+    void parseError(const QString &message);
 };
 
 #endif // XSAXHANDLER_H
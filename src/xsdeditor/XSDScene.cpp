@@ -25,6 +25,9 @@
 
 XSDScene::XSDScene()
 {
+    _isLowDetail = false ;
+    _areDetailsHidden = false ;
+    _updatesNesting = 0 ;
     _bkConfig.load();
     /*
     // a gradient background TODO
@@ -61,6 +64,74 @@ void XSDScene::updateBounds()
 
 }
 
+/*!
+ * \brief XSDScene::beginUpdate many items are going to be added or moved: the index is rebuilt once at the end
+ */
+void XSDScene::beginUpdate()
+{
+    if(0 == _updatesNesting) {
+        setItemIndexMethod(QGraphicsScene::NoIndex);
+    }
+    _updatesNesting ++ ;
+}
+
+void XSDScene::endUpdate()
+{
+    _updatesNesting -- ;
+    if(0 == _updatesNesting) {
+        setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+    }
+}
+
+bool XSDScene::isLowDetail() const
+{
+    return _isLowDetail ;
+}
+
+void XSDScene::setViewScale(const qreal scale)
+{
+    const bool isLowDetail = scale < XSD_LOW_DETAIL_LEVEL ;
+    if(isLowDetail != _isLowDetail) {
+        _isLowDetail = isLowDetail ;
+        applyLevelOfDetail();
+    }
+}
+
+/*!
+ * \brief XSDScene::applyLevelOfDetail when zoomed out, the texts and the icons inside the boxes are not painted.
+ * They stay visible to keep the measures of the layout.
+ */
+void XSDScene::applyLevelOfDetail()
+{
+    if(!_isLowDetail && !_areDetailsHidden) {
+        return ;
+    }
+    const qreal opacity = _isLowDetail ? 0 : 1 ;
+    foreach(QGraphicsItem * item, items()) {
+        if(NULL != item->parentItem()) {
+            item->setOpacity(opacity);
+        }
+    }
+    _areDetailsHidden = _isLowDetail ;
+}
+
+/*!
+ * \brief XSDScene::render prints and exports always use all the details
+ */
+void XSDScene::render(QPainter *painter, const QRectF &target, const QRectF &source, Qt::AspectRatioMode aspectRatioMode)
+{
+    const bool isLowDetail = _isLowDetail ;
+    if(isLowDetail) {
+        _isLowDetail = false ;
+        applyLevelOfDetail();
+    }
+    QGraphicsScene::render(painter, target, source, aspectRatioMode);
+    if(isLowDetail) {
+        _isLowDetail = true ;
+        applyLevelOfDetail();
+    }
+}
+
 void XSDScene::gotoItem(QGraphicsItem *item)
 {
     if(NULL == item) {
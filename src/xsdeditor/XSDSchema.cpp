@@ -27,6 +27,7 @@
 #include <QHash>
 #include "utils.h"
 #include "xmlutils.h"
+#include "element.h"
 #include "xsdeditor/XSchemaIOContants.h"
 #include "xsdeditor/io/xschemaloader.h"
 
@@ -314,10 +315,14 @@ void XSDSchema::addNamespace(QDomAttr &attr)
     if(index <= 0) {
         XsdError("TODO");
     }
-    QString nsPrefix = name.mid(index + 1);
-    _namespaces.insert(attr.value());
-    _namespacesByPrefix.insert(nsPrefix, attr.value());
-    _prefixesByNamespace.insert(attr.value(), nsPrefix);
+    addNamespace(name.mid(index + 1), attr.value());
+}
+
+void XSDSchema::addNamespace(const QString &nsPrefix, const QString &ns)
+{
+    _namespaces.insert(ns);
+    _namespacesByPrefix.insert(nsPrefix, ns);
+    _prefixesByNamespace.insert(ns, nsPrefix);
 }
 
 void XSDSchema::addDefaultNamespace(const QString &ns)
@@ -388,6 +393,58 @@ QList<XSchemaElement *> XSDSchema::collectCandidateRootElement()
 
 //------------------------ I/O handling ------------------------------------------------------------------------------
 
+static const quint64 FingerprintBasis = Q_UINT64_C(14695981039346656037);
+static const quint64 FingerprintPrime = Q_UINT64_C(1099511628211);
+
+static quint64 addToFingerprint(quint64 hash, const quint64 value)
+{
+    FORINT(i, 8) {
+        hash ^= (value >> (i * 8)) & 0xFF ;
+        hash *= FingerprintPrime ;
+    }
+    return hash ;
+}
+
+static quint64 addToFingerprint(quint64 hash, const QString &text)
+{
+    const QChar *data = text.constData();
+    const int length = text.length();
+    FORINT(i, length) {
+        hash ^= data[i].unicode();
+        hash *= FingerprintPrime ;
+    }
+    // the length separates the strings
+    return addToFingerprint(hash, static_cast<quint64>(length));
+}
+
+/*!
+ * \brief fingerprintOfDom a 64 bit FNV-1a hash of a DOM branch, the attributes are combined
+ * without regard to their order
+ */
+static quint64 fingerprintOfDom(const QDomNode &node)
+{
+    quint64 hash = addToFingerprint(FingerprintBasis, static_cast<quint64>(node.nodeType()));
+    hash = addToFingerprint(hash, node.nodeName());
+    if(node.isElement()) {
+        quint64 attributesHash = 0 ;
+        QDomNamedNodeMap attributes = node.attributes();
+        const int attributesCount = attributes.length();
+        FORINT(i, attributesCount) {
+            QDomNode attribute = attributes.item(i);
+            attributesHash += addToFingerprint(addToFingerprint(FingerprintBasis, attribute.nodeName()), attribute.nodeValue());
+        }
+        hash = addToFingerprint(hash, attributesHash);
+        QDomNodeList childNodes = node.childNodes();
+        const int childrenCount = childNodes.count();
+        FORINT(i, childrenCount) {
+            hash = addToFingerprint(hash, fingerprintOfDom(childNodes.item(i)));
+        }
+    } else {
+        hash = addToFingerprint(hash, node.nodeValue());
+    }
+    return hash ;
+}
+
 bool XSDSchema::scanSchema(XSDLoadContext *loadContext, const QDomElement &schema)
 {
     if(!isValidSchema(schema)) {
@@ -450,6 +507,7 @@ bool XSDSchema::scanSchema(XSDLoadContext *loadContext, const QDomElement &schem
         if(childNode.isElement()) {
             QDomElement element = childNode.toElement();
             QString name = element.localName();
+            const int childrenBefore = _children.size();
 
             if(element.namespaceURI() == namespaceURI()) {
                 if(name == IO_XSD_TAGINCLUDE) {
@@ -478,6 +536,10 @@ bool XSDSchema::scanSchema(XSDLoadContext *loadContext, const QDomElement &schem
             } else {
                 raiseError(loadContext, this, element, true);
             }
+            // the fingerprint lets the comparison skip the components that are the same
+            if(_children.size() > childrenBefore) {
+                _children.last()->setFingerprint(fingerprintOfDom(element));
+            }
         }
     }
     registerData();
@@ -525,6 +587,24 @@ bool XSDSchema::scanSchemaNS(const QDomElement &schema)
     return true;
 }
 
+bool XSDSchema::scanSchemaNS(Element *schema)
+{
+    if(!schema->tag().endsWith(IO_XSD_SCHEMA)) {
+        return false ;
+    }
+    foreach(Attribute * attribute, schema->attributes) {
+        QString nsPrefix ;
+        if(XmlUtils::getNsPrefix(attribute->name, nsPrefix)) {
+            if(nsPrefix.isEmpty()) {
+                addDefaultNamespace(attribute->value);
+            } else {
+                addNamespace(nsPrefix, attribute->value);
+            }
+        }
+    }
+    return true;
+}
+
 bool XSDSchema::canAddChild(const ESchemaType newType)
 {
     switch(newType) {
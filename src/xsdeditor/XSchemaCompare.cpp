@@ -70,13 +70,158 @@ XSDCompareResult *XSchemaObject::compare(XSDCompareResult *result, XSchemaObject
     return compareOrdered(result, getChildren(), target->getChildren(), options);
 }
 
+quint64 XSchemaObject::fingerprint()
+{
+    return _fingerprint;
+}
+
+void XSchemaObject::setFingerprint(const quint64 value)
+{
+    _fingerprint = value ;
+}
+
+/*!
+ * \brief XSchemaObject::compareComponent compares the children of a couple of top level components,
+ * if the fingerprints of their source are the same the children are unchanged without comparing them
+ */
+XSDCompareResult *XSchemaObject::compareComponent(XSDCompareResult *result, XSchemaObject *target, XSDCompareOptions &options)
+{
+    if((0 != _fingerprint) && (_fingerprint == target->_fingerprint)) {
+        markChildrenUnchanged();
+        return result;
+    }
+    return compare(result, target, options);
+}
+
+/*!
+ * \brief XSchemaObject::markChildrenUnchanged marks the objects as compare() marks them
+ * when nothing is changed; the annotations are not examined by the comparison.
+ */
+void XSchemaObject::markChildrenUnchanged()
+{
+    foreach(XSchemaObject * child, getChildren()) {
+        child->setCompareState(XSDCompareState::COMPARE_UNCHANGED);
+        child->markChildrenUnchanged();
+    }
+}
+
+void XSchemaElement::markChildrenUnchanged()
+{
+    XSchemaObject::markChildrenUnchanged();
+    foreach(XSchemaObject * attribute, attributes()) {
+        attribute->setCompareState(XSDCompareState::COMPARE_UNCHANGED);
+        attribute->markChildrenUnchanged();
+    }
+}
+
+/*!
+ * \brief XSchemaObject::compareAttributes the list of the children compared apart, if any
+ */
+QList<XSchemaObject*> *XSchemaObject::compareAttributes()
+{
+    return NULL ;
+}
+
+QList<XSchemaObject*> *XSchemaElement::compareAttributes()
+{
+    return &_attributes ;
+}
+
+/*!
+ * \brief XSchemaObject::collectCompareNodes collects this object and the compared ones below it,
+ * in preorder: the children before the attributes
+ */
+void XSchemaObject::collectCompareNodes(QList<XSchemaObject*> &nodes)
+{
+    nodes.append(this);
+    foreach(XSchemaObject * child, getChildren()) {
+        child->collectCompareNodes(nodes);
+    }
+    QList<XSchemaObject*> *attributes = compareAttributes();
+    if(NULL != attributes) {
+        foreach(XSchemaObject * attribute, *attributes) {
+            attribute->collectCompareNodes(nodes);
+        }
+    }
+}
+
+void XSchemaObject::removeCompareNodes(const QSet<XSchemaObject*> &nodes)
+{
+    QList<XSchemaObject*> &children = getChildren();
+    foreach(XSchemaObject * node, nodes) {
+        children.removeOne(node);
+    }
+    QList<XSchemaObject*> *attributes = compareAttributes();
+    if(NULL != attributes) {
+        foreach(XSchemaObject * node, nodes) {
+            attributes->removeOne(node);
+        }
+    }
+}
+
+/*!
+ * \brief XSchemaObject::restoreCompareResult sets the state and the children found by a comparison,
+ * the children coming from another parent are moved here.
+ */
+void XSchemaObject::restoreCompareResult(const XSDCompareState::EXSDCompareState newState, const QList<XSchemaObject*> &children, const QList<XSchemaObject*> &attributes)
+{
+    setCompareState(newState);
+    getChildren() = children;
+    QList<XSchemaObject*> *compared = compareAttributes();
+    if(NULL != compared) {
+        *compared = attributes ;
+    }
+    foreach(XSchemaObject * child, children) {
+        if(child->xsdParent() != this) {
+            child->reparent(this);
+        }
+    }
+    foreach(XSchemaObject * child, attributes) {
+        if(child->xsdParent() != this) {
+            child->reparent(this);
+        }
+    }
+}
+
+/*!
+ * \brief XSchemaObject::compareChild compares a couple of children now or, if a collection is given,
+ * collects them to compare later
+ */
+void XSchemaObject::compareChild(XSDCompareResult *result, XSchemaObject *reference, XSchemaObject *target, XSDCompareOptions &options, XSDCompareComponents *components)
+{
+    if(NULL != components) {
+        components->add(reference, target);
+    } else {
+        reference->compare(result, target, options);
+    }
+}
+
+/*!
+ * \brief XSDSchema::compare matches the top level components in this thread, the couples found
+ * are compared in parallel, since each one is a separate branch.
+ */
 XSDCompareResult *XSDSchema::compare(XSDCompareResult *result, XSchemaObject *target, XSDCompareOptions &options)
 {
-    XSDCompareResult *resultOp = compareOrdered(result, getChildren(), target->getChildren(), options);
+    XSDCompareComponents components;
+    XSDCompareResult *resultOp = compareOrdered(result, getChildren(), target->getChildren(), options, &components);
+    components.execute(result, options);
     regenerateInternalLists();
     return resultOp ;
 }
 
+/*!
+ * \brief XSDSchema::compareComponents compares the schemas as compare() does, the couples of components
+ * whose sources are the same of the last comparison take the result from the cache.
+ */
+XSDCompareResult *XSDSchema::compareComponents(XSDCompareResult *result, XSDSchema *target, XSDCompareOptions &options, XSDCompareCache *cache)
+{
+    XSDCompareComponents components;
+    compareOrdered(result, getChildren(), target->getChildren(), options, &components);
+    components.execute(result, options, cache);
+    regenerateInternalLists();
+    return result;
+}
+
 XSDCompareResult *XSchemaElement::compare(XSDCompareResult *result, XSchemaObject *target, XSDCompareOptions &options)
 {
     XSchemaObject::compare(result, target, options);
@@ -110,7 +255,7 @@ void XSchemaElement::restoreAttributesListInGeneric(QList<XSchemaObject*> &list)
     }
 }
 
-XSDCompareResult *XSchemaObject::compareOrdered(XSDCompareResult *result, QList<XSchemaObject*> &referenceList, QList<XSchemaObject*> &targetList, XSDCompareOptions &options)
+XSDCompareResult *XSchemaObject::compareOrdered(XSDCompareResult *result, QList<XSchemaObject*> &referenceList, QList<XSchemaObject*> &targetList, XSDCompareOptions &options, XSDCompareComponents *components)
 {
     XSDCompareData data(referenceList, targetList);
     int indexRef = 0 ;
@@ -131,12 +276,12 @@ XSDCompareResult *XSchemaObject::compareOrdered(XSDCompareResult *result, QList<
                 break;
             case XSDCompareObject::XSDOBJECT_UNCHANGED:
                 referenceChild->advanceChild(data, XSDCompareState::COMPARE_UNCHANGED);
-                referenceChild->compare(result, targetChild, options);
+                compareChild(result, referenceChild, targetChild, options, components);
                 break;
 
             case XSDCompareObject::XSDOBJECT_MODIFIED:
                 referenceChild->advanceChild(data, XSDCompareState::COMPARE_MODIFIED);
-                referenceChild->compare(result, targetChild, options);
+                compareChild(result, referenceChild, targetChild, options, components);
                 result->setDifferent(true);
                 break;
 
@@ -146,7 +291,7 @@ XSDCompareResult *XSchemaObject::compareOrdered(XSDCompareResult *result, QList<
             // all the elements that are remaining in the target list, are considedered deleted.
             // the cloned elements are inserted at the end of the scan.
             case XSDCompareObject::XSDOBJECT_DIFFERENT:
-                referenceChild->compareDifferentObjects(result, data, targetList, options);
+                referenceChild->compareDifferentObjects(result, data, targetList, options, components);
                 result->setDifferent(true);
                 break;
             } // switch
@@ -178,7 +323,7 @@ void XSchemaObject::advanceChild(XSDCompareData &data, const XSDCompareState::EX
 }
 
 
-void XSchemaObject::compareDifferentObjects(XSDCompareResult *result, XSDCompareData &data, QList<XSchemaObject*> &targetList, XSDCompareOptions &options)
+void XSchemaObject::compareDifferentObjects(XSDCompareResult *result, XSDCompareData &data, QList<XSchemaObject*> &targetList, XSDCompareOptions &options, XSDCompareComponents *components)
 {
     for(int indexRefOuter = data.indexTarget + 1 ; indexRefOuter < data.targetCount ; indexRefOuter ++) {
         XSchemaObject *targetTest = data.targetCollection.at(indexRefOuter);
@@ -200,7 +345,7 @@ void XSchemaObject::compareDifferentObjects(XSDCompareResult *result, XSDCompare
             } else {
                 setCompareState(XSDCompareState::COMPARE_MODIFIED);
             }
-            compare(result, targetTest, options);
+            compareChild(result, this, targetTest, options, components);
             data.indexTarget = indexRefOuter + 1 ;
             return ;
         } // if same object fountd
@@ -212,27 +357,23 @@ void XSchemaObject::compareDifferentObjects(XSDCompareResult *result, XSDCompare
 
 
 
-QString XSchemaObject::hashNameOfObject(XSchemaObject* target)
-{
-    QString result = QString("%1<>%2<>%3").arg(target->getType()).arg(target->name()).arg(target->nameOrReference());
-    return result;
-}
-
 XSDCompareResult *XSchemaObject::compareUnordered(XSDCompareResult *result, QList<XSchemaObject*>&referenceList, QList<XSchemaObject*>&targetList, XSDCompareOptions &options)
 {
     QList<XSchemaObject*> finalList;
-    QHash<QString, XSchemaObject*> scanMap;
+    QHash<XSDCompareKey, XSchemaObject*> scanMap;
     // fill the list
     foreach(XSchemaObject * child, targetList) {
         // warning to the name collisions
-        scanMap.insert(hashNameOfObject(child), child);
+        scanMap.insert(XSDCompareKey(child), child);
     }
 
     foreach(XSchemaObject * child, referenceList) {
         finalList.append(child);
-        QString key = hashNameOfObject(child);
-        if(scanMap.contains(key)) {
-            XSchemaObject *targetChild = scanMap[key];
+        const XSDCompareKey key(child);
+        QHash<XSDCompareKey, XSchemaObject*>::iterator found = scanMap.find(key);
+        if(found != scanMap.end()) {
+            XSchemaObject *targetChild = found.value();
+            scanMap.erase(found);
             XSDCompareObject::EXSDCompareObject compareResult = child->compareTo(targetChild, options);
             switch(compareResult) {
             default:
@@ -253,12 +394,16 @@ XSDCompareResult *XSchemaObject::compareUnordered(XSDCompareResult *result, QLis
             child->markCompareStateRecursive(XSDCompareState::COMPARE_ADDED);
             result->setDifferent(true);
         } // contains
-        scanMap.remove(key);
     }
-    // take all the non examined target elements and add them as deleted to the source collection
-    foreach(QString key, scanMap.keys()) {
-        scanMap[key]->addDeletedTarget(finalList, this, targetList);
-        result->setDifferent(true);
+    // take all the non examined target elements and add them as deleted to the source collection, in their order
+    if(!scanMap.isEmpty()) {
+        QList<XSchemaObject*> targets = targetList ;
+        foreach(XSchemaObject * targetChild, targets) {
+            if(scanMap.value(XSDCompareKey(targetChild)) == targetChild) {
+                targetChild->addDeletedTarget(finalList, this, targetList);
+                result->setDifferent(true);
+            }
+        }
     }
 
     // set the final children collection
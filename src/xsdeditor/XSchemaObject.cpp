@@ -277,18 +277,18 @@ void RestrictionFacets::addOtherFacets(QList<InfoFacet *> *list)
 
 //-----------------------------------------------------
 
-int XSchemaObject::instances = 0 ;
+QAtomicInt XSchemaObject::instances(0);
 
 XSchemaObject::XSchemaObject(XSchemaObject *newParent, XSchemaRoot *newRoot)
 {
-    instances ++;
-    _instanceId = instances ;
+    _instanceId = instances.fetchAndAddOrdered(1) + 1 ;
     _isRedefinition = false ;
     _parent = newParent;
     _root = newRoot;
     _annotation = NULL;
     _compareStatus = XSDCompareState::COMPARE_NOT_EXAMINED;
     _name_used = false ;
+    _fingerprint = 0 ;
 }
 
 XSchemaObject::~XSchemaObject()
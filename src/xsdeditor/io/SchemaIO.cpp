@@ -24,6 +24,7 @@
 #include "xsdeditor/xschema.h"
 #include "xsdeditor/io/xschemaloader.h"
 #include "modules/services/systemservices.h"
+#include "regola.h"
 #include "utils.h"
 
 
@@ -105,18 +106,7 @@ bool XSDSchema::readFromInputString(XSDLoadContext *loadContext, const QString &
                 isOk = true;
 
                 if(isRecursive) {
-                    XSchemaLoader loader;
-                    XSDLoadContext *theLoadContext;
-                    XSDLoadContext localLoadContext;
-                    if(NULL == loadContext) {
-                        theLoadContext = &localLoadContext;
-                    } else {
-                        theLoadContext = loadContext ;
-                    }
-                    XSchemaLoader::State state = loader.loadDependent(theLoadContext, this, filePath, networkAccessManager);
-                    if(XSchemaLoader::STATE_READY != state) {
-                        Utils::error(tr("Error loading schema depenendencies."));
-                    }
+                    loadDependentSchemas(loadContext, networkAccessManager, filePath);
                 }
 
             } else {
@@ -132,6 +122,50 @@ bool XSDSchema::readFromInputString(XSDLoadContext *loadContext, const QString &
     return isOk ;
 }
 
+void XSDSchema::loadDependentSchemas(XSDLoadContext *loadContext, QNetworkAccessManager *networkAccessManager, const QString &filePath)
+{
+    XSchemaLoader loader;
+    XSDLoadContext *theLoadContext;
+    XSDLoadContext localLoadContext;
+    if(NULL == loadContext) {
+        theLoadContext = &localLoadContext;
+    } else {
+        theLoadContext = loadContext ;
+    }
+    XSchemaLoader::State state = loader.loadDependent(theLoadContext, this, filePath, networkAccessManager);
+    if(XSchemaLoader::STATE_READY != state) {
+        Utils::error(tr("Error loading schema depenendencies."));
+    }
+}
+
+/*!
+ * \brief reads the schema from the document tree, as it is in the editor,
+ * building the DOM directly instead of writing the data as text and parsing them twice.
+ * \param map if not NULL, collects the keys of the elements as the load context does
+ */
+bool XSDSchema::readFromRegola(XSDLoadContext *loadContext, Regola *regola, const bool isRecursive, QNetworkAccessManager *networkAccessManager, const QString &filePath, ElementLoadInfoMap *map)
+{
+    reset(); // start from a known base
+    Element *rootElement = regola->root();
+    if((NULL == rootElement) || !scanSchemaNS(rootElement)) {
+        Utils::error(tr("Unable to load schema."));
+        return false;
+    }
+    bool isOk = false;
+    QDomDocument document;
+    if(regola->generateDomNS(document, map)) {
+        if(applyScan(loadContext, document)) {
+            isOk = true;
+            if(isRecursive) {
+                loadDependentSchemas(loadContext, networkAccessManager, filePath);
+            }
+        }
+    }
+    if(!isOk) {
+        Utils::error(tr("Unable to parse XML"));
+    }
+    return isOk ;
+}
 
 bool XSDSchema::readFromIoDevice(XSDLoadContext *loadContext, QIODevice *ioDevice)
 {
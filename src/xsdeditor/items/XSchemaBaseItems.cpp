@@ -169,6 +169,8 @@ XSDItem::XSDItem(XsdGraphicContext *newContext) : _menuBuilder(this), _iconInfo(
     _isBase = false;
     _isDiff = (NULL != newContext) ? newContext->contextType() == XsdGraphicContext::CONTEXT_DIFF : false ;
     _yToAdd = 0;
+    _isExpanded = (NULL == newContext) || !newContext->isLazyChildren() ;
+    _collapsedMarker = NULL ;
 }
 
 XSDItem::~XSDItem()
@@ -207,6 +209,10 @@ void XSDItem::afterPositionChange()
     if(NULL != theChain) {
         chain()->updatePosition();
     }
+    if(NULL != _collapsedMarker) {
+        const QRectF bounds = graphicItem()->boundingRect();
+        _collapsedMarker->setPos(bounds.right() + 4, bounds.top() + (bounds.height() - _collapsedMarker->boundingRect().height()) / 2);
+    }
     foreach(RChild * child, _children.children()) {
         child->item()->afterPositionChange();
     }
@@ -918,6 +924,71 @@ void XSDItem::remove(XSchemaObject *child)
     if(indexOfChild >= 0) {
         _children.deleteAt(indexOfChild);
     }
+    if(_collapsedChildren.removeAll(child) > 0) {
+        updateCollapsedMarker();
+    }
+}
+
+/*!
+ * \brief XSDItem::deferChild if the item is collapsed, the child is only recorded
+ * \return true if the item of the child must not be created now
+ */
+bool XSDItem::deferChild(XSchemaObject *child)
+{
+    if(_isExpanded) {
+        return false;
+    }
+    _collapsedChildren.append(child);
+    updateCollapsedMarker();
+    return true ;
+}
+
+void XSDItem::updateCollapsedMarker()
+{
+    if(_collapsedChildren.isEmpty()) {
+        if(NULL != _collapsedMarker) {
+            _collapsedMarker->hide();
+        }
+        return ;
+    }
+    if(NULL == _collapsedMarker) {
+        _collapsedMarker = new QGraphicsSimpleTextItem(graphicItem());
+        _collapsedMarker->setToolTip(tr("Use the context menu to expand the children."));
+    }
+    _collapsedMarker->setText(QString("+%1").arg(_collapsedChildren.size()));
+    _collapsedMarker->show();
+}
+
+bool XSDItem::hasCollapsedChildren() const
+{
+    return !_collapsedChildren.isEmpty();
+}
+
+/*!
+ * \brief XSDItem::expand creates the items of the children, the layout is up to the caller
+ * \return the number of children created
+ */
+int XSDItem::expand()
+{
+    _isExpanded = true ;
+    QList<XSchemaObject*> children = _collapsedChildren ;
+    _collapsedChildren.clear();
+    foreach(XSchemaObject * child, children) {
+        childAdded(child);
+    }
+    updateCollapsedMarker();
+    return children.size();
+}
+
+void XSDItem::expandLevels(const int levels)
+{
+    if(levels <= 0) {
+        return ;
+    }
+    expand();
+    foreach(RChild * rchild, _children.children()) {
+        rchild->item()->expandLevels(levels - 1);
+    }
 }
 
 
@@ -948,6 +1019,9 @@ void XSDItem::childAdded(XSchemaObject* newChild)
     if(NULL == newChild) {
         return ;
     }
+    if(deferChild(newChild)) {
+        return ;
+    }
     XSDItem *child = addChild(newChild);
     if(NULL == child) {
         Utils::error(tr("An error occurred inserting the graphic item corresponding to the object."));
@@ -1870,6 +1944,9 @@ void ElementItem::childAdded(XSchemaObject *newChild)
     if(NULL == newChild) {
         return ;
     }
+    if(deferChild(newChild)) {
+        return ;
+    }
     XSDItem *child = NULL ;
     /*ESchemaType type = newChild->getType()  ;
     if( SchemaTypeAttribute == type ) { TODO
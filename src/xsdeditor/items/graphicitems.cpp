@@ -24,6 +24,7 @@
 #include "xsdeditor/xsdwindow.h"
 #include "utils.h"
 #include <QGraphicsTextItem>
+#include <QStyleOptionGraphicsItem>
 
 GraphicsRectItem::GraphicsRectItem(ItemServiceExecutor *service, QGraphicsItem * parent) : QGraphicsRectItem(parent)
 {
@@ -179,12 +180,32 @@ void GraphicsRoundRectItem::drawShadow(QPainter *painter, QRectF &bounds)
     painter->drawRoundRect(bounds, 25, 25);
 }
 
+/*!
+ * \brief the scene decides the level of detail: it follows the zoom of the view,
+ * but prints and exports render all the details at any scale, see XSDScene::render
+ */
+bool GraphicsRoundRectItem::isLowDetail(QPainter *painter) const
+{
+    XSDScene *xsdScene = qobject_cast<XSDScene*>(scene());
+    if(NULL != xsdScene) {
+        return xsdScene->isLowDetail();
+    }
+    return QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform()) < XSD_LOW_DETAIL_LEVEL ;
+}
+
 void GraphicsRoundRectItem::paint(QPainter *painter, const QStyleOptionGraphicsItem * /*option*/, QWidget */*widget*/)
 {
     QRectF bounds = boundingRect();
 
     bounds.setWidth(bounds.width() - OffsetRectX);
     bounds.setHeight(bounds.height() - OffsetRectY);
+    if(isLowDetail(painter)) {
+        // too small to be read: a box only
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(QBrush(_isSingleColor ? _colorStart : _colorMiddle));
+        painter->drawRect(bounds);
+        return ;
+    }
     // First gradient: background
     QRectF shadowRect = bounds.translated(OffsetRectX, OffsetRectY);
     drawShadow(painter, shadowRect);
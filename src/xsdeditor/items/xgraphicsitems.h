@@ -41,6 +41,9 @@ enum {
     TypeRoundRectItem = QGraphicsItem::UserType + 138
 };
 
+// under this scale the diagram is drawn as boxes only
+#define XSD_LOW_DETAIL_LEVEL    (0.5)
+
 #define IS_TYPE(xtype)  enum { Type = xtype }; virtual int type() const { return Type; }
 
 
@@ -71,6 +74,8 @@ class GraphicsRoundRectItem : public QObject, public QGraphicsRectItem
         OffsetRectY = 5
     };
 
+    bool isLowDetail(QPainter *painter) const;
+
 protected:
     void contextMenuEvent(QGraphicsSceneContextMenuEvent *event);
     QVariant itemChange(GraphicsItemChange change, const QVariant &value);
@@ -69,13 +69,14 @@ qreal XSDItem::placeAllStrategyHorPyramidNew0(XSDItemContext *context)
         updateObjectPlacementNew0(this, context, currBounds, rendered, itemsRendered, chain, 0);
         QXMLEDIT_LAYOUT_DEBUG3(dtPlacement.stopAndPrintElapsed());
     }
-    QXMLEDIT_LAYOUT_DEBUG3(TimeLapse dtFinalPos("final pos"));
-    QRectF overallBounds(0, 0, 0, 0);
-    finalPos(overallBounds, true);
-    QXMLEDIT_LAYOUT_DEBUG3(dtFinalPos.stopAndPrintElapsed());
     QXMLEDIT_LAYOUT_DEBUG3(TimeLapse dtFinalOffset("final offset"));
+    QRectF overallBounds(0, 0, 0, 0);
+    finalBounds(overallBounds, true);
     finalOffset(overallBounds);
     QXMLEDIT_LAYOUT_DEBUG3(dtFinalOffset.stopAndPrintElapsed());
+    QXMLEDIT_LAYOUT_DEBUG3(TimeLapse dtFinalPos("final pos"));
+    finalPos();
+    QXMLEDIT_LAYOUT_DEBUG3(dtFinalPos.stopAndPrintElapsed());
     afterPositionChange();
     recalcDispose(context);
     drawChildrenPort(context);
@@ -86,11 +87,8 @@ qreal XSDItem::placeAllStrategyHorPyramidNew0(XSDItemContext *context)
     return overallFinalHeight ;
 }
 
-void XSDItem::finalPos(QRectF &bounds, const bool isFirst)
+void XSDItem::finalBounds(QRectF &bounds, const bool isFirst)
 {
-    QGraphicsItem * graphicsItem = graphicItem();
-    graphicsItem->setPos(_bounds.topLeft());
-    QXMLEDIT_LAYOUT_DEBUG(dump_layout_notice(" Final position ", this, _bounds, 0));
     if(isFirst) {
         bounds = _bounds;
     } else {
@@ -98,24 +96,40 @@ void XSDItem::finalPos(QRectF &bounds, const bool isFirst)
     }
     foreach(RChild * rchild, _children.children()) {
         XSDItem *xsdItem = rchild->item();
-        xsdItem->finalPos(bounds, false);
+        xsdItem->finalBounds(bounds, false);
     }
 }
 
+void XSDItem::finalPos()
+{
+    QGraphicsItem * graphicsItem = graphicItem();
+    graphicsItem->setPos(_bounds.topLeft());
+    QXMLEDIT_LAYOUT_DEBUG(dump_layout_notice(" Final position ", this, _bounds, 0));
+    foreach(RChild * rchild, _children.children()) {
+        XSDItem *xsdItem = rchild->item();
+        xsdItem->finalPos();
+    }
+}
+
+/*!
+ * \brief XSDItem::finalOffset moves the layout up to the top, the scene items are placed later
+ * and the lines are drawn from the same bounds, so there is no need to scan the whole scene.
+ */
 void XSDItem::finalOffset(const QRectF &bounds)
 {
     const qreal topElementPos = bounds.top();
     if(topElementPos > FinalOffsetFromTop) {
         const qreal delta = topElementPos - FinalOffsetFromTop;
-        foreach(QGraphicsItem * item, graphicItem()->scene()->items()) {
-            if(NULL != item->parentItem()) {
-                continue;
-            }
-            QRectF itemBounds = item->boundingRect();
-            if(!itemBounds.isEmpty() && item->isVisible()) {
-                item->setY(item->y() - delta);
-            }
-        }
+        moveBoundsBy(-delta);
+    }
+}
+
+void XSDItem::moveBoundsBy(const qreal deltaY)
+{
+    _bounds.moveTop(_bounds.top() + deltaY);
+    foreach(RChild * rchild, _children.children()) {
+        XSDItem *xsdItem = rchild->item();
+        xsdItem->moveBoundsBy(deltaY);
     }
 }
 
@@ -288,6 +288,9 @@ public:
 };
 
 class XSDSchema ;
+class Regola ;
+class Element ;
+class ElementLoadInfoMap ;
 
 class XSchemaRoot
 {
@@ -431,7 +434,8 @@ public:
 
 
 protected:
-    static int instances;
+    // the objects of the two schemas of a comparison are created by different threads
+    static QAtomicInt instances;
     int _instanceId;
     QString _id;
     QString _name;
@@ -444,6 +448,7 @@ protected:
     XSDCompareState::EXSDCompareState _compareStatus;
     bool _isRedefinition;
     QString _key;
+    quint64 _fingerprint;
 
     Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
 
@@ -491,11 +496,18 @@ public:
     //-------------------- region(compare) --------------------
 public:
     virtual XSDCompareObject::EXSDCompareObject compareTo(XSchemaObject* target, XSDCompareOptions &options);
+    XSDCompareResult *compareComponent(XSDCompareResult *result, XSchemaObject *target, XSDCompareOptions &options);
+    quint64 fingerprint();
+    void setFingerprint(const quint64 value);
     XSDCompareState::EXSDCompareState compareState();
     virtual void markCompareStateRecursive(const XSDCompareState::EXSDCompareState newState);
     virtual void getModifiedObjects(QList<XSchemaObject*> &added, QList<XSchemaObject*> &modified, QList<XSchemaObject*> &deleted);
     QString occurrencesDescrString(XOccurrence &minOccurs, XOccurrence &maxOccurs);
     static QList<XSchemaObject*> sortObjectsByName(const QList<XSchemaObject*> &objects);
+    virtual QList<XSchemaObject*> *compareAttributes();
+    void collectCompareNodes(QList<XSchemaObject*> &nodes);
+    void removeCompareNodes(const QSet<XSchemaObject*> &nodes);
+    void restoreCompareResult(const XSDCompareState::EXSDCompareState newState, const QList<XSchemaObject*> &children, const QList<XSchemaObject*> &attributes);
 
 protected:
     void setCompareState(const XSDCompareState::EXSDCompareState newState);
@@ -504,10 +516,11 @@ protected:
     virtual XSDCompareObject::EXSDCompareObject innerCompareTo(XSchemaObject *target, XSDCompareOptions &options) = 0; // abstract
     XSDCompareObject::EXSDCompareObject innerBaseCompareTo(XSchemaObject *target, XSDCompareOptions &options);
     bool baseInnerCompareTo(XSchemaObject *target, XSDCompareOptions &options);
-    XSDCompareResult *compareOrdered(XSDCompareResult *result, QList<XSchemaObject*> &referenceList, QList<XSchemaObject*> &targetList, XSDCompareOptions &options);
-    void compareDifferentObjects(XSDCompareResult *result, XSDCompareData &data, QList<XSchemaObject*> &targetList, XSDCompareOptions &options);
+    virtual void markChildrenUnchanged();
+    void compareChild(XSDCompareResult *result, XSchemaObject *reference, XSchemaObject *target, XSDCompareOptions &options, XSDCompareComponents *components);
+    XSDCompareResult *compareOrdered(XSDCompareResult *result, QList<XSchemaObject*> &referenceList, QList<XSchemaObject*> &targetList, XSDCompareOptions &options, XSDCompareComponents *components = NULL);
+    void compareDifferentObjects(XSDCompareResult *result, XSDCompareData &data, QList<XSchemaObject*> &targetList, XSDCompareOptions &options, XSDCompareComponents *components = NULL);
     void advanceChild(XSDCompareData &data, const XSDCompareState::EXSDCompareState newState);
-    QString hashNameOfObject(XSchemaObject* target);
     XSDCompareResult *compareUnordered(XSDCompareResult *result, QList<XSchemaObject*>&referenceList, QList<XSchemaObject*>&targetList, XSDCompareOptions &options);
     void addDeletedTarget(QList<XSchemaObject *> &finalCollection, XSchemaObject *referenceFather, QList<XSchemaObject *> &targetList);
     void insertElementFromOtherCollection(QList<XSchemaObject *> &finalCollection, XSchemaObject *referenceFather);
@@ -873,6 +886,8 @@ public:
     bool isSimpleRestiction();
 
     virtual XSDCompareResult *compare(XSDCompareResult *result, XSchemaObject *target, XSDCompareOptions &options);
+    virtual void markChildrenUnchanged();
+    virtual QList<XSchemaObject*> *compareAttributes();
 
     virtual bool findBaseObjects(XSchemaInquiryContext &context, QList<XSchemaObject*> &baseElements, QList<XSchemaObject*> & baseAttributes);
 
@@ -1766,6 +1781,7 @@ public:
 
     bool scanSchema(XSDLoadContext *loadContext, const QDomElement &schema);
     bool scanSchemaNS(const QDomElement &schema);
+    bool scanSchemaNS(Element *schema);
 
     QString elementsQualifiedString();
     QString attributesQualifiedString();
@@ -1804,6 +1820,7 @@ protected:
     }
 
     void addNamespace(QDomAttr &attr);
+    void addNamespace(const QString &nsPrefix, const QString &ns);
     void addDefaultNamespace(QDomAttr &attr);
     void addDefaultNamespace(const QString &ns);
 
@@ -1820,6 +1837,7 @@ protected:
     // -----------------------------------------------------------
     bool readFromInputString(XSDLoadContext *loadContext, const QString &inputText, const bool isRecursive, QNetworkAccessManager *newNetworkAccessManager, const QString &filePath);
     bool readFromIoDevice(XSDLoadContext *loadContext, QIODevice *file);
+    void loadDependentSchemas(XSDLoadContext *loadContext, QNetworkAccessManager *networkAccessManager, const QString &filePath);
     void regenerateInternalLists();
     void registerData();
     void scanForInnerElements(XSchemaObject *parent, QList<XSchemaObject *> &lst);
@@ -1848,6 +1866,7 @@ public:
     bool saveToClipboard() ;
     bool readFromClipboard();
     bool readFromString(XSDLoadContext *loadContext, const QString &inputText, const bool isRecursive = false, QNetworkAccessManager *newNetworkAccessManager = NULL, const QString &filePath = NULL);
+    bool readFromRegola(XSDLoadContext *loadContext, Regola *regola, const bool isRecursive = false, QNetworkAccessManager *newNetworkAccessManager = NULL, const QString &filePath = NULL, ElementLoadInfoMap *map = NULL);
 
     virtual bool canAddChild(const ESchemaType newType);
 
@@ -1898,6 +1917,7 @@ public:
     virtual bool findSchemaChildComponents(XValidationContext *context, XElementContent *content);
 
     XSDCompareResult *compare(XSDCompareResult *result, XSchemaObject *target, XSDCompareOptions &options);
+    XSDCompareResult *compareComponents(XSDCompareResult *result, XSDSchema *target, XSDCompareOptions &options, XSDCompareCache *cache);
 
     XSchemaElement *findSimpleType(const QString &name);
 
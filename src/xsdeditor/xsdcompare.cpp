@@ -44,6 +44,7 @@ XSDCompareResult::XSDCompareResult()
 {
     _error = false;
     _different = false;
+    _skippedComponents = 0 ;
     _schema = NULL ;
 }
 
@@ -72,11 +73,32 @@ bool XSDCompareResult::areDifferent()
     return _different;
 }
 
+int XSDCompareResult::skippedComponents()
+{
+    return _skippedComponents;
+}
+
+void XSDCompareResult::setSkippedComponents(const int value)
+{
+    _skippedComponents = value ;
+}
+
+QString XSDCompareResult::errorMessage()
+{
+    return _errorMessage ;
+}
+
+void XSDCompareResult::setErrorMessage(const QString &value)
+{
+    _errorMessage = value ;
+}
+
 //---------------------------------------------------------------------------------
 
 XSDCompareOptions::XSDCompareOptions()
 {
     _compareComment = false ;
+    _onlyChanged = false ;
 }
 
 XSDCompareOptions::~XSDCompareOptions()
@@ -94,6 +116,20 @@ void XSDCompareOptions::setCompareComment(const bool value)
     _compareComment = value ;
 }
 
+bool XSDCompareOptions::isOnlyChanged()
+{
+    return _onlyChanged ;
+}
+
+/*!
+ * \brief XSDCompareOptions::setOnlyChanged compares only the components that changed in one of the
+ * schemas since the last comparison with the same settings, the others take their last result
+ */
+void XSDCompareOptions::setOnlyChanged(const bool value)
+{
+    _onlyChanged = value ;
+}
+
 //---------------------------------------------------------------------------------
 
 XSDCompare::XSDCompare()
@@ -114,15 +150,13 @@ bool XSDCompare::compare(QWidget *parent, QXmlEditData *appData, Regola *data, c
         return false;
     }
 
-    QString xmlAsString = data->getAsText();
-
     try {
         XSDCompareOptions compareOptions;
         compareOptions.setCompareComment(isCompareAnnotationsPersistentOption());
 
-        XSDCompareResult *result = innerCompare(xmlAsString, _targetXSDFileName, compareOptions, false);
+        XSDCompareResult *result = innerCompare(data, _targetXSDFileName, compareOptions, false);
         if((NULL == result) || result->isError()) {
-            Utils::error(parent, tr("An error occurred comparing data"));
+            Utils::error(parent, errorMessage(result));
             delete result;
             return false ;
         }
@@ -191,10 +225,9 @@ XSDWindow *XSDCompare::getXSDWindow()
 
 void XSDCompare::evaluate(XSDWindow *window, XSDCompareOptions &options, const bool isSwap)
 {
-    QString xmlAsString = _regola->getAsText();
-    XSDCompareResult *result = innerCompare(xmlAsString, _targetXSDFileName, options, isSwap);
+    XSDCompareResult *result = innerCompare(_regola, _targetXSDFileName, options, isSwap);
     if((NULL == result) || result->isError()) {
-        Utils::error(tr("An error occurred comparing data"));
+        Utils::error(errorMessage(result));
         delete result;
         return  ;
     }
@@ -232,13 +265,64 @@ void XSDCompare::setUIData(XSDWindow *window, XSDSchema *schema, const QString &
 }
 
 XSDCompareResult *XSDCompare::innerCompare(const QString &referenceString, const QString &targetFileName, XSDCompareOptions &options, const bool isSwap)
+{
+    // the file is read in a worker thread while the reference is read in this one
+    QString referenceError;
+    QString targetError;
+    QFuture<XSDSchema*> targetLoad = QtConcurrent::run(this, &XSDCompare::loadXSDFromFile, targetFileName, &targetError);
+    XSDSchema *reference = loadXSDFromString(referenceString, &referenceError);
+    XSDSchema *target = targetLoad.result();
+    return loadError(innerCompare(reference, target, options, isSwap), referenceError, targetError);
+}
+
+XSDCompareResult *XSDCompare::innerCompare(Regola *referenceRegola, const QString &targetFileName, XSDCompareOptions &options, const bool isSwap)
+{
+    // the file is read in a worker thread while the data of the editor are read in this one
+    QString referenceError;
+    QString targetError;
+    QFuture<XSDSchema*> targetLoad = QtConcurrent::run(this, &XSDCompare::loadXSDFromFile, targetFileName, &targetError);
+    XSDSchema *reference = loadXSDFromRegola(referenceRegola, &referenceError);
+    XSDSchema *target = targetLoad.result();
+    return loadError(innerCompare(reference, target, options, isSwap), referenceError, targetError);
+}
+
+/*!
+ * \brief XSDCompare::loadError sets in the result the cause of the failure of the loading of the schemas,
+ * to show it in the GUI thread, since the target is loaded in a worker one.
+ */
+XSDCompareResult *XSDCompare::loadError(XSDCompareResult *result, const QString &referenceError, const QString &targetError)
+{
+    if((NULL != result) && result->isError()) {
+        if(!referenceError.isEmpty()) {
+            result->setErrorMessage(referenceError);
+        } else if(!targetError.isEmpty()) {
+            result->setErrorMessage(targetError);
+        }
+    }
+    return result ;
+}
+
+QString XSDCompare::errorMessage(XSDCompareResult *result)
+{
+    if((NULL != result) && !result->errorMessage().isEmpty()) {
+        return result->errorMessage();
+    }
+    return tr("An error occurred comparing data");
+}
+
+/**
+ * @brief XSDCompare::innerCompare
+ * @param reference the reference schema, owned by this method
+ * @param target the target schema, owned by this method
+ */
+XSDCompareResult *XSDCompare::innerCompare(XSDSchema *reference, XSDSchema *target, XSDCompareOptions &options, const bool isSwap)
 {
     XSDCompareResult *result = new XSDCompareResult();
     if(NULL == result) {
+        delete reference;
+        delete target;
         return result;
     }
-    XSDSchema *reference =  loadXSDFromString(referenceString);
-    XSDSchema *target =  loadXSDFromFile(targetFileName);
     if((NULL == reference) || (NULL == target)) {
         if(NULL != reference) {
             delete reference ;
@@ -249,6 +333,7 @@ XSDCompareResult *XSDCompare::innerCompare(const QString &referenceString, const
         result->setError(true);
         return result ;
     }
+    _cache.prepare(options);
     if(isSwap) {
         XSDSchema *temp =  reference ;
         reference = target  ;
@@ -269,8 +354,11 @@ XSDCompareResult *XSDCompare::innerCompare(const QString &referenceString, const
     return result;
 }
 
-
-XSDSchema *XSDCompare::loadXSDFromString(const QString &dataToLoad)
+/*!
+ * \brief XSDCompare::loadXSDFromString the loaders do not show the errors, since they can run in a worker thread
+ * \param errorMessage the cause of the failure
+ */
+XSDSchema *XSDCompare::loadXSDFromString(const QString &dataToLoad, QString *errorMessage)
 {
     try {
         XSDSchema *schema = new XSDSchema(NULL);
@@ -279,18 +367,36 @@ XSDSchema *XSDCompare::loadXSDFromString(const QString &dataToLoad)
             schema->readFromString(&loadContext, dataToLoad, false, NULL, NULL);
             return schema;
         } else {
-            Utils::error(tr("No root item"));
+            *errorMessage = tr("No root item");
         }
     } catch(XsdException *ex) {
-        Utils::error(tr("Error loading schema.\n%1").arg(ex->cause()));
+        *errorMessage = tr("Error loading schema.\n%1").arg(ex->cause());
     } catch(...) {
-        Utils::error(tr("Unknown exception."));
+        *errorMessage = tr("Unknown exception.");
     }
     return NULL;
 }
 
+XSDSchema *XSDCompare::loadXSDFromRegola(Regola *regola, QString *errorMessage)
+{
+    try {
+        XSDSchema *schema = new XSDSchema(NULL);
+        if(NULL != schema) {
+            XSDLoadContext loadContext;
+            schema->readFromRegola(&loadContext, regola, false, NULL, NULL);
+            return schema;
+        } else {
+            *errorMessage = tr("No root item");
+        }
+    } catch(XsdException *ex) {
+        *errorMessage = tr("Error loading schema.\n%1").arg(ex->cause());
+    } catch(...) {
+        *errorMessage = tr("Unknown exception.");
+    }
+    return NULL;
+}
 
-XSDSchema *XSDCompare::loadXSDFromFile(const QString &fileName)
+XSDSchema *XSDCompare::loadXSDFromFile(const QString &fileName, QString *errorMessage)
 {
     try {
         XSDSchema *schema = new XSDSchema(NULL);
@@ -299,16 +405,16 @@ XSDSchema *XSDCompare::loadXSDFromFile(const QString &fileName)
             if(schema->read(&loadContext, fileName)) {
                 return schema;
             } else {
-                Utils::error(tr("Error loading file"));
+                *errorMessage = tr("Error loading file");
                 delete schema ;
             }
         } else {
-            Utils::error(tr("No root item"));
+            *errorMessage = tr("No root item");
         }
     } catch(XsdException *ex) {
-        Utils::error(tr("Error loading schema.\n%1").arg(ex->cause()));
+        *errorMessage = tr("Error loading schema.\n%1").arg(ex->cause());
     } catch(...) {
-        Utils::error(tr("Unknown exception."));
+        *errorMessage = tr("Unknown exception.");
     }
     return NULL;
 }
@@ -321,7 +427,7 @@ XSDCompareResult *XSDCompare::compareSchema(XSDCompareResult *result, XSDSchema
     /**
      * @brief top level compare: the elements are unordered
      */
-    return reference->compare(result, target, compareOptions);
+    return reference->compareComponents(result, target, compareOptions, compareOptions.isOnlyChanged() ? &_cache : NULL);
 }
 
 
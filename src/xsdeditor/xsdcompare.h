@@ -41,6 +41,8 @@ class XSDCompare : public QObject, public IXSDController
     QString _targetXSDFileName;
     Regola *_regola;
     XSDWindow *_window;
+    // the results of the components in the last comparison
+    XSDCompareCache _cache;
 
     QString getTargetFile(QWidget *parent, const QString &folderPath);
 
@@ -58,9 +60,14 @@ public:
 
 private:
     XSDCompareResult *compareSchema(XSDCompareResult *result, XSDSchema *reference, XSDSchema *target, XSDCompareOptions &compareOptions);
-    XSDSchema *loadXSDFromString(const QString &dataToLoad);
-    XSDSchema *loadXSDFromFile(const QString &fileName);
+    XSDSchema *loadXSDFromString(const QString &dataToLoad, QString *errorMessage);
+    XSDSchema *loadXSDFromRegola(Regola *regola, QString *errorMessage);
+    XSDSchema *loadXSDFromFile(const QString &fileName, QString *errorMessage);
     XSDCompareResult *innerCompare(const QString &referenceString, const QString &targetFileName, XSDCompareOptions &options, const bool isSwap);
+    XSDCompareResult *innerCompare(Regola *referenceRegola, const QString &targetFileName, XSDCompareOptions &options, const bool isSwap);
+    XSDCompareResult *innerCompare(XSDSchema *reference, XSDSchema *target, XSDCompareOptions &options, const bool isSwap);
+    XSDCompareResult *loadError(XSDCompareResult *result, const QString &referenceError, const QString &targetError);
+    QString errorMessage(XSDCompareResult *result);
     void setUIData(XSDWindow *window, XSDSchema *schema, const QString &referencePath, const QString &targetPath, const bool isSwap);
     void setSummary(XSDWindow *window, XSDSchema *schema);
 };
@@ -21,6 +21,7 @@
  **************************************************************************/
 
 
+#include "xmlEdit.h"
 #include "xsdcomparedata.h"
 #include "xschema.h"
 #include "utils.h"
@@ -46,3 +47,356 @@ int XSDCompareData::nextIndexTarget(const int indexTarget)
 }
 
 
+//---------------------------------------------------------------------------------
+
+XSDCompareKey::XSDCompareKey(XSchemaObject *object)
+{
+    type = object->getType();
+    name = object->name();
+    reference = object->nameOrReference();
+}
+
+XSDCompareKey::~XSDCompareKey()
+{
+}
+
+bool XSDCompareKey::operator==(const XSDCompareKey &other) const
+{
+    return (type == other.type) && (name == other.name) && (reference == other.reference);
+}
+
+uint qHash(const XSDCompareKey &key)
+{
+    return (qHash(key.name) * 31 + qHash(key.reference)) * 31 + static_cast<uint>(key.type);
+}
+
+//---------------------------------------------------------------------------------
+
+/*!
+ * \brief XSDComponentRecord::XSDComponentRecord the record is valid only for components with the same sources
+ */
+XSDComponentRecord::XSDComponentRecord(XSchemaObject *reference, XSchemaObject *target)
+{
+    _referenceFingerprint = reference->fingerprint();
+    _targetFingerprint = target->fingerprint();
+    _referenceCount = 0 ;
+    _targetCount = 0 ;
+    _isDifferent = false ;
+}
+
+XSDComponentRecord::~XSDComponentRecord()
+{
+}
+
+bool XSDComponentRecord::isDifferent() const
+{
+    return _isDifferent ;
+}
+
+bool XSDComponentRecord::isFor(XSchemaObject *reference, XSchemaObject *target) const
+{
+    return (0 != _referenceFingerprint) && (0 != _targetFingerprint)
+           && (reference->fingerprint() == _referenceFingerprint)
+           && (target->fingerprint() == _targetFingerprint);
+}
+
+/*!
+ * \brief XSDComponentRecord::record describes the tree of the reference after the comparison
+ * \param referenceNodes the nodes of the reference, in preorder, before the comparison
+ * \param targetNodes the nodes of the target, in preorder, before the comparison
+ * \return false if a node of the result does not come from the components
+ */
+bool XSDComponentRecord::record(XSchemaObject *reference, const QList<XSchemaObject*> &referenceNodes, const QList<XSchemaObject*> &targetNodes, const bool isDifferent)
+{
+    QHash<XSchemaObject*, int> referenceIndexes;
+    QHash<XSchemaObject*, int> targetIndexes;
+    FORINT(index, referenceNodes.size()) {
+        referenceIndexes.insert(referenceNodes.at(index), index);
+    }
+    FORINT(index, targetNodes.size()) {
+        targetIndexes.insert(targetNodes.at(index), index);
+    }
+    QList<XSchemaObject*> resultNodes;
+    reference->collectCompareNodes(resultNodes);
+    _nodes.clear();
+    foreach(XSchemaObject * object, resultNodes) {
+        Node node;
+        if(referenceIndexes.contains(object)) {
+            node.isTarget = false ;
+            node.index = referenceIndexes.value(object);
+        } else if(targetIndexes.contains(object)) {
+            node.isTarget = true ;
+            node.index = targetIndexes.value(object);
+        } else {
+            return false;
+        }
+        QList<XSchemaObject*> *attributes = object->compareAttributes();
+        node.childrenCount = object->getChildren().size();
+        node.attributesCount = (NULL != attributes) ? attributes->size() : 0 ;
+        node.state = object->compareState();
+        _nodes.append(node);
+    }
+    _referenceCount = referenceNodes.size();
+    _targetCount = targetNodes.size();
+    _isDifferent = isDifferent ;
+    return true ;
+}
+
+/*!
+ * \brief XSDComponentRecord::apply gives to the reference the result recorded, as the comparison does:
+ * the nodes of the target not found in the reference are moved into it.
+ * The state of the reference is the one assigned by the match of the components.
+ */
+bool XSDComponentRecord::apply(XSchemaObject *reference, XSchemaObject *target)
+{
+    QList<XSchemaObject*> referenceNodes;
+    QList<XSchemaObject*> targetNodes;
+    reference->collectCompareNodes(referenceNodes);
+    target->collectCompareNodes(targetNodes);
+    if(_nodes.isEmpty() || (referenceNodes.size() != _referenceCount) || (targetNodes.size() != _targetCount)) {
+        return false;
+    }
+    QSet<XSchemaObject*> moved;
+    foreach(const Node & node, _nodes) {
+        if(node.isTarget) {
+            moved.insert(targetNodes.at(node.index));
+        }
+    }
+    if(!moved.isEmpty()) {
+        foreach(XSchemaObject * object, targetNodes) {
+            if(!moved.contains(object)) {
+                object->removeCompareNodes(moved);
+            }
+        }
+    }
+    int position = 0 ;
+    rebuild(position, referenceNodes, targetNodes);
+    return true ;
+}
+
+XSchemaObject *XSDComponentRecord::rebuild(int &position, QList<XSchemaObject*> &referenceNodes, QList<XSchemaObject*> &targetNodes)
+{
+    const Node &node = _nodes.at(position);
+    XSchemaObject *object = node.isTarget ? targetNodes.at(node.index) : referenceNodes.at(node.index);
+    const XSDCompareState::EXSDCompareState state = (0 == position) ? object->compareState() : static_cast<XSDCompareState::EXSDCompareState>(node.state);
+    position++;
+    QList<XSchemaObject*> children;
+    QList<XSchemaObject*> attributes;
+    FORINT(index, node.childrenCount) {
+        children.append(rebuild(position, referenceNodes, targetNodes));
+    }
+    FORINT(index, node.attributesCount) {
+        attributes.append(rebuild(position, referenceNodes, targetNodes));
+    }
+    object->restoreCompareResult(state, children, attributes);
+    return object;
+}
+
+//---------------------------------------------------------------------------------
+
+XSDCompareCache::XSDCompareCache()
+{
+    _isCompareComment = false ;
+}
+
+XSDCompareCache::~XSDCompareCache()
+{
+    clear();
+}
+
+void XSDCompareCache::clear()
+{
+    QSet<XSDComponentRecord*> records = QSet<XSDComponentRecord*>::fromList(_records.values());
+    qDeleteAll(records);
+    _records.clear();
+}
+
+int XSDCompareCache::count() const
+{
+    return _records.size();
+}
+
+/*!
+ * \brief XSDCompareCache::prepare discards the results if they were found with other options
+ */
+void XSDCompareCache::prepare(XSDCompareOptions &options)
+{
+    if(!options.isOnlyChanged() || (options.isCompareComment() != _isCompareComment)) {
+        clear();
+    }
+    _isCompareComment = options.isCompareComment();
+}
+
+XSDComponentRecord *XSDCompareCache::find(XSchemaObject *reference, XSchemaObject *target) const
+{
+    XSDComponentRecord *record = _records.value(XSDCompareKey(reference), NULL);
+    if((NULL != record) && record->isFor(reference, target)) {
+        return record ;
+    }
+    return NULL ;
+}
+
+/*!
+ * \brief XSDCompareCache::update keeps only the results of the last comparison
+ * \param references the components compared
+ * \param records the result of each component, if any
+ */
+void XSDCompareCache::update(const QList<XSchemaObject*> &references, const QVector<XSDComponentRecord*> &records)
+{
+    QSet<XSDComponentRecord*> all = QSet<XSDComponentRecord*>::fromList(_records.values());
+    QHash<XSDCompareKey, XSDComponentRecord*> newRecords;
+    FORINT(index, records.size()) {
+        XSDComponentRecord *record = records.at(index);
+        if(NULL != record) {
+            all.insert(record);
+            newRecords.insert(XSDCompareKey(references.at(index)), record);
+        }
+    }
+    const QSet<XSDComponentRecord*> kept = QSet<XSDComponentRecord*>::fromList(newRecords.values());
+    foreach(XSDComponentRecord * record, all) {
+        if(!kept.contains(record)) {
+            delete record;
+        }
+    }
+    _records = newRecords ;
+}
+
+//---------------------------------------------------------------------------------
+
+XSDCompareComponents::XSDCompareComponents()
+{
+    _options = NULL ;
+    _cache = NULL ;
+    _isException = false ;
+}
+
+XSDCompareComponents::~XSDCompareComponents()
+{
+}
+
+void XSDCompareComponents::add(XSchemaObject *reference, XSchemaObject *target)
+{
+    _references.append(reference);
+    _targets.append(target);
+}
+
+int XSDCompareComponents::count()
+{
+    return _references.size();
+}
+
+/*!
+ * \brief XSDCompareComponents::execute compares the components using this thread and
+ * some threads of the pool, the exceptions are raised again in this thread
+ * \param cache if given, the components whose sources are the same of the last comparison take
+ * its result without comparing them and the cache is updated
+ */
+void XSDCompareComponents::execute(XSDCompareResult *result, XSDCompareOptions &options, XSDCompareCache *cache)
+{
+    _options = &options ;
+    _cache = cache ;
+    _records.fill(NULL, count());
+    _nextComponent.fetchAndStoreOrdered(0);
+    _restored.fetchAndStoreOrdered(0);
+    _different.fetchAndStoreOrdered(0);
+    _error.fetchAndStoreOrdered(0);
+    const int workers = qMin(QThread::idealThreadCount(), count()) - 1 ;
+    QList<QFuture<void> > results;
+    FORINT(i, workers) {
+        results.append(QtConcurrent::run(this, &XSDCompareComponents::compareNextComponents));
+    }
+    compareNextComponents();
+    foreach(QFuture<void> future, results) {
+        future.waitForFinished();
+    }
+    if(0 != _different.fetchAndAddOrdered(0)) {
+        result->setDifferent(true);
+    }
+    if(0 != _error.fetchAndAddOrdered(0)) {
+        result->setError(true);
+    }
+    result->setSkippedComponents(_restored.fetchAndAddOrdered(0));
+    if(NULL != _cache) {
+        _cache->update(_references, _records);
+    }
+    if(_isException) {
+        throw new XsdException(_exceptionCause);
+    }
+}
+
+void XSDCompareComponents::compareNextComponents()
+{
+    forever {
+        const int index = _nextComponent.fetchAndAddOrdered(1);
+        if(index >= _references.size()) {
+            return ;
+        }
+        // every component has its own result, merged at the end
+        XSDCompareResult componentResult;
+        try {
+            if(!restoreComponent(index, &componentResult)) {
+                compareComponent(index, &componentResult);
+            }
+        } catch(XsdException *ex) {
+            QMutexLocker lock(&_exceptionMutex);
+            if(!_isException) {
+                _isException = true ;
+                _exceptionCause = ex->cause();
+            }
+            delete ex;
+        } catch(...) {
+            QMutexLocker lock(&_exceptionMutex);
+            if(!_isException) {
+                _isException = true ;
+                _exceptionCause = QObject::tr("Unknown exception.");
+            }
+        }
+        if(componentResult.areDifferent()) {
+            _different.fetchAndStoreOrdered(1);
+        }
+        if(componentResult.isError()) {
+            _error.fetchAndStoreOrdered(1);
+        }
+    }
+}
+
+bool XSDCompareComponents::restoreComponent(const int index, XSDCompareResult *componentResult)
+{
+    if(NULL == _cache) {
+        return false;
+    }
+    XSDComponentRecord *record = _cache->find(_references.at(index), _targets.at(index));
+    if((NULL == record) || !record->apply(_references.at(index), _targets.at(index))) {
+        return false;
+    }
+    componentResult->setDifferent(record->isDifferent());
+    _records[index] = record ;
+    _restored.fetchAndAddOrdered(1);
+    return true;
+}
+
+/*!
+ * \brief XSDCompareComponents::compareComponent compares a couple and records its result if there is a cache;
+ * the couples with the same source are not recorded, since they are not compared, as the ones without a source.
+ */
+void XSDCompareComponents::compareComponent(const int index, XSDCompareResult *componentResult)
+{
+    XSchemaObject *reference = _references.at(index);
+    XSchemaObject *target = _targets.at(index);
+    if((NULL == _cache) || (0 == reference->fingerprint()) || (0 == target->fingerprint())
+            || (reference->fingerprint() == target->fingerprint())) {
+        reference->compareComponent(componentResult, target, *_options);
+        return ;
+    }
+    QList<XSchemaObject*> referenceNodes;
+    QList<XSchemaObject*> targetNodes;
+    reference->collectCompareNodes(referenceNodes);
+    target->collectCompareNodes(targetNodes);
+    reference->compareComponent(componentResult, target, *_options);
+    XSDComponentRecord *record = new XSDComponentRecord(reference, target);
+    if(record->record(reference, referenceNodes, targetNodes, componentResult->areDifferent())) {
+        _records[index] = record ;
+    } else {
+        delete record;
+    }
+}
@@ -26,6 +26,11 @@
 
 #include <QList>
 #include <QSet>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <QAtomicInt>
+#include <QMutex>
 
 bool isCompareAnnotationsPersistentOption();
 void setCompareAnnotationsPersistentOption(bool value);
@@ -49,12 +54,32 @@ public:
     int nextIndexTarget(const int indexTarget);
 };
 
+/*!
+ * \brief XSDCompareKey identifies a component by type and names, as it is matched by the comparison
+ */
+class XSDCompareKey
+{
+public:
+    int type;
+    QString name;
+    QString reference;
+
+    XSDCompareKey(XSchemaObject *object);
+    ~XSDCompareKey();
+
+    bool operator==(const XSDCompareKey &other) const;
+};
+
+uint qHash(const XSDCompareKey &key);
+
 class XSDSchema ;
 
 class XSDCompareResult
 {
     bool _error;
     bool _different;
+    int _skippedComponents;
+    QString _errorMessage;
     // reference,
     // target
     // options
@@ -71,12 +96,17 @@ public:
     void setError(const bool value);
     void setDifferent(const bool value);
     bool areDifferent();
+    int skippedComponents();
+    void setSkippedComponents(const int value);
+    QString errorMessage();
+    void setErrorMessage(const QString &value);
 };
 
 
 class XSDCompareOptions
 {
     bool _compareComment;
+    bool _onlyChanged;
 
 public:
     explicit XSDCompareOptions();
@@ -84,6 +114,95 @@ public:
 
     bool isCompareComment();
     void setCompareComment(const bool value);
+    bool isOnlyChanged();
+    void setOnlyChanged(const bool value);
+};
+
+/*!
+ * \brief XSDComponentRecord keeps the result of the comparison of a couple of top level components:
+ * the final tree is described in preorder, each node by its origin and its state, to apply it
+ * again to a couple of components read from the same sources.
+ */
+class XSDComponentRecord
+{
+    class Node
+    {
+    public:
+        bool isTarget;
+        int index;
+        int childrenCount;
+        int attributesCount;
+        int state;
+    };
+
+    quint64 _referenceFingerprint;
+    quint64 _targetFingerprint;
+    int _referenceCount;
+    int _targetCount;
+    bool _isDifferent;
+    QList<Node> _nodes;
+
+    XSchemaObject *rebuild(int &position, QList<XSchemaObject*> &referenceNodes, QList<XSchemaObject*> &targetNodes);
+
+public:
+    XSDComponentRecord(XSchemaObject *reference, XSchemaObject *target);
+    ~XSDComponentRecord();
+
+    bool record(XSchemaObject *reference, const QList<XSchemaObject*> &referenceNodes, const QList<XSchemaObject*> &targetNodes, const bool isDifferent);
+    bool isFor(XSchemaObject *reference, XSchemaObject *target) const;
+    bool apply(XSchemaObject *reference, XSchemaObject *target);
+    bool isDifferent() const;
+};
+
+/*!
+ * \brief XSDCompareCache holds the results of the components of the last comparison,
+ * valid while the options of the comparison do not change.
+ */
+class XSDCompareCache
+{
+    bool _isCompareComment;
+    QHash<XSDCompareKey, XSDComponentRecord*> _records;
+
+public:
+    XSDCompareCache();
+    ~XSDCompareCache();
+
+    void prepare(XSDCompareOptions &options);
+    void clear();
+    int count() const;
+    XSDComponentRecord *find(XSchemaObject *reference, XSchemaObject *target) const;
+    void update(const QList<XSchemaObject*> &references, const QVector<XSDComponentRecord*> &records);
+};
+
+/*!
+ * \brief XSDCompareComponents compares in parallel the couples of top level components
+ * matched by the schema comparison; each couple is a separate branch of the trees.
+ */
+class XSDCompareComponents
+{
+    QList<XSchemaObject*> _references;
+    QList<XSchemaObject*> _targets;
+    XSDCompareOptions *_options;
+    XSDCompareCache *_cache;
+    QVector<XSDComponentRecord*> _records;
+    QAtomicInt _nextComponent;
+    QAtomicInt _restored;
+    QAtomicInt _different;
+    QAtomicInt _error;
+    QMutex _exceptionMutex;
+    bool _isException;
+    QString _exceptionCause;
+
+    void compareNextComponents();
+    bool restoreComponent(const int index, XSDCompareResult *componentResult);
+    void compareComponent(const int index, XSDCompareResult *componentResult);
+public:
+    XSDCompareComponents();
+    ~XSDCompareComponents();
+
+    void add(XSchemaObject *reference, XSchemaObject *target);
+    int count();
+    void execute(XSDCompareResult *result, XSDCompareOptions &options, XSDCompareCache *cache = NULL);
 };
 
 
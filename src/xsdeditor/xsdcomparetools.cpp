@@ -52,6 +52,11 @@ bool XSDCompareTools::isCompareAnnotations()
     return ui->compareAnnotationOption->isChecked();
 }
 
+bool XSDCompareTools::isCompareOnlyChanged()
+{
+    return ui->compareOnlyChangedOption->isChecked();
+}
+
 
 void XSDCompareTools::on_compareAnnotationOption_stateChanged(int state)
 {
@@ -65,3 +70,7 @@ void XSDCompareTools::on_compareSwapReferenceAction_triggered()
     emit swapReference();
 }
 
+void XSDCompareTools::on_compareAgainButton_clicked()
+{
+    emit compareAgain();
+}
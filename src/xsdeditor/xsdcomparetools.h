@@ -40,6 +40,7 @@ public:
     ~XSDCompareTools();
 
     bool isCompareAnnotations();
+    bool isCompareOnlyChanged();
 
 private:
     Ui::XSDCompareTools *ui;
@@ -47,10 +48,12 @@ private:
 signals:
     void compareAnnotationChanged(bool value);
     void swapReference();
+    void compareAgain();
 
 private slots:
     void on_compareAnnotationOption_stateChanged(int state) ;
     void on_compareSwapReferenceAction_triggered();
+    void on_compareAgainButton_clicked();
 };
 
 #endif // XSDCOMPARETOOLS_H
@@ -30,6 +30,7 @@ XsdGraphicContext::XsdGraphicContext(QObject *parent) :
 {
     _isDebug = false ;
     _hideAttributes = false ;
+    _isLazyChildren = false ;
     _rootItem = NULL ;
     _schema = NULL ;
     _scene = NULL ;
@@ -222,3 +223,16 @@ bool XsdGraphicContext::isOutline()
 {
     return CONTEXT_OUTLINE == _contextType ;
 }
+
+/*!
+ * \brief XsdGraphicContext::isLazyChildren if true, new items do not create the items of their children until expanded
+ */
+bool XsdGraphicContext::isLazyChildren() const
+{
+    return _isLazyChildren;
+}
+
+void XsdGraphicContext::setLazyChildren(const bool value)
+{
+    _isLazyChildren = value;
+}
@@ -69,6 +69,7 @@ private:
     bool _showAllSchema;
     bool _isDebug;
     bool _hideAttributes;
+    bool _isLazyChildren;
     // TODO QStack<XSDItem*> _navigation;
 
 public:
@@ -129,6 +130,9 @@ public:
 
     bool isOutline();
 
+    bool isLazyChildren() const;
+    void setLazyChildren(const bool value);
+
 signals:
 
 public slots:
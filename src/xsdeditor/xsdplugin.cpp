@@ -57,7 +57,6 @@ bool XsdPlugin::go(QWidget * parent, QXmlEditData *appData, Regola *data, Elemen
     XSDWindow xsdEditor(appData, parent) ;
 
     ElementLoadInfoMap loadMap;
-    QString xmlAsString = data->getAsText(&loadMap);
     QEventLoop eventLoop;
     xsdEditor.EVENTLOOP = &eventLoop ;
 
@@ -65,23 +64,12 @@ bool XsdPlugin::go(QWidget * parent, QXmlEditData *appData, Regola *data, Elemen
         *selectedOut = NULL ;
     }
     try {
-        // bad method to reverse scan a map
-        QString keySel;
-        if(NULL != selectedElement) {
-            foreach(QString key, loadMap.dataMap.keys()) {
-                Element *value = loadMap.dataMap[key];
-                if(value == selectedElement) {
-                    keySel = key ;
-                    break;
-                }
-            }
-            xsdEditor.setSelectedObjectKey(keySel);
-        }
         xsdEditor.setWindowModality(Qt::WindowModal);
         xsdEditor.show();
         xsdEditor.setFileName(data->fileName());
         xsdEditor.setTitle(data->fileName());
-        xsdEditor.loadString(xmlAsString);
+        // the schema is built from the document, the map and the selection are set while loading
+        xsdEditor.loadRegola(data, &loadMap, selectedElement);
         // TODO handle event loop inside the window.
         bool result = (eventLoop.exec() > 0) ;
         if(loadMap.dataMap.contains(xsdEditor.selectedExitKey())) {
@@ -32,6 +32,7 @@
 #include "xsdreport.h"
 #include "choosexsdreporttypedialog.h"
 #include "xmlutils.h"
+#include "element.h"
 
 
 #ifdef  QML
@@ -101,6 +102,9 @@ QMenu *MainItemMenuBuilder::buildMenu(XSchemaObject *target)
     if(target->hasAReference()) {
         contextMenu ->addAction(_parent->getGotoAction());
     }
+    if(_parent->canExpandObject(target)) {
+        contextMenu ->addAction(_parent->getExpandAction());
+    }
     //contextMenu ->addAction(_parent->getDeleteAction()); IN THE EDITOR ONLY
     return contextMenu;
 }
@@ -140,6 +144,9 @@ XSDWindow::XSDWindow(QXmlEditData *appData, QWidget *parent) :
 
     _context.setItemContext(&_itemContext);
     EVENTLOOP = NULL ;
+    _regolaToLoad = NULL ;
+    _loadMap = NULL ;
+    _elementToSelect = NULL ;
     _isInError = false ;
     _compareComments = false ;
     _compareShowOnlyDifferencesAction = false ;
@@ -147,6 +154,7 @@ XSDWindow::XSDWindow(QXmlEditData *appData, QWidget *parent) :
     _isSwap = false ;
     _context.setMenuBuilder(&_menuBuilder);
     _mainItem = NULL ;
+    _expandAction = NULL ;
 
     ui->setupUi(this);
     if(!completeUi()) {
@@ -213,6 +221,17 @@ QAction *XSDWindow::getCopyFacetsAction()
     return _copyFacetsAction;
 }
 
+QAction *XSDWindow::getExpandAction()
+{
+    return _expandAction;
+}
+
+bool XSDWindow::canExpandObject(XSchemaObject *target)
+{
+    XSDItem *item = _context.getItemOfObject(target);
+    return (NULL != item) && item->hasCollapsedChildren();
+}
+
 void XSDWindow::loadString(const QString &inputData)
 {
     _stringToLoad = inputData ;
@@ -225,6 +244,18 @@ void XSDWindow::loadStringImmediate(const QString &inputData)
     xon_loadFromString_triggered();
 }
 
+/*!
+ * \brief loads the schema from the document, the keys of its elements are collected in the map
+ * and the object corresponding to the selected element, if any, is selected.
+ */
+void XSDWindow::loadRegola(Regola *regola, ElementLoadInfoMap *map, Element *selectedElement)
+{
+    _regolaToLoad = regola ;
+    _loadMap = map ;
+    _elementToSelect = selectedElement ;
+    QTimer::singleShot(1, this, SLOT(xon_loadFromString_triggered()));
+}
+
 void XSDWindow::setTitle(const QString &newTitle)
 {
     _title = newTitle;
@@ -314,6 +345,7 @@ bool XSDWindow::completeUi()
     _copyNameAction = new QAction(tr("Copy Name to the Clipboard"), this);
     _copyElementAction = new QAction(tr("Copy element definition to the Clipboard"), this);
     _copyFacetsAction = new QAction(tr("Copy facets to the Clipboard"), this);
+    _expandAction = new QAction(tr("Expand Children"), this);
     addSequenceAction = createMenuAction(tr("Add Sequence"), SchemaTypeSequence);
     addChoiceAction = createMenuAction(tr("Add Choice"), SchemaTypeChoice);
     addRestrictionAction = new QAction(tr("Add Restriction"), this);//TODO
@@ -337,6 +369,7 @@ bool XSDWindow::completeUi()
         || (NULL == _copyNameAction)
         || (NULL == _copyElementAction)
         || (NULL == _copyFacetsAction)
+        || (NULL == _expandAction)
         /*|| (NULL == createMenuAction(tr("Add Include"), SchemaTypeInclude))
         || (NULL == createMenuAction(tr("Add Import"), SchemaTypeImport))
         || (NULL == createMenuAction(tr("Add Redefine"), SchemaTypeRedefine))
@@ -387,6 +420,7 @@ bool XSDWindow::completeUi()
     connect(_copyNameAction, SIGNAL(triggered()), this, SLOT(xon_copyNameAction_triggered()));
     connect(_copyElementAction, SIGNAL(triggered()), this, SLOT(xon_copyElementAction_triggered()));
     connect(_copyFacetsAction, SIGNAL(triggered()), this, SLOT(xon_copyFacetsAction_triggered()));
+    connect(_expandAction, SIGNAL(triggered()), this, SLOT(xon_expandAction_triggered()));
     //-------- editors ----
     addEditors();
 
@@ -449,6 +483,7 @@ bool XSDWindow::showRoot()
     _viewStack.clear();
     XSDItem::resetId();
     RootItem *newRootItem = NULL ;
+    _context.setLazyChildren(isLazySchema(_context.contextType(), _context.schema()));
     if(_context.isOutline()) {
         QString chosenRoot;
         if(NULL != _context.schema()) {
@@ -483,19 +518,22 @@ bool XSDWindow::showRoot()
     }
     _context.setRootItem(newRootItem);
     _context.setShowBaseObjects(false);
+    _scene->beginUpdate();
     if(NULL != _context.rootItem()) {
         _scene->addItem(_context.rootItem()->graphicItem());
     }
     _context.rootItem()->setItem(_context.schema());
+    _context.rootItem()->expandLevels(LazyExpandedLevels);
     _mainItem = _context.rootItem() ;
     if(NULL == _context.rootItem()) {
+        _scene->endUpdate();
         return false ;
     }
     setEnabled(false);
     Utils::showWaitCursor();
     setUpdatesEnabled(false);
-    _context.rootItem()->recalcChildrenPos(&_itemContext);
-    _scene->updateBounds();
+    layoutDiagram();
+    _scene->endUpdate();
     ui->navigation->emptyNavigationBox();
     ui->navigation->loadNavigationBox(_context.schema());
     _viewStack.push(_context.schema());
@@ -534,18 +572,119 @@ XSDItem * XSDWindow::setZoomObject(XSchemaObject *subject)
         return _context.rootItem();
     } else {
         _context.resetRoot();
+        _scene->beginUpdate();
         XSDItem *newItem = XSDItem::createItem(&_context, subject, NULL);
         _scene->addItem(newItem->graphicItem());
-        newItem->recalcChildrenPos(&_itemContext);
-        newItem->afterPositionChange();
-        _scene->updateBounds();
-        ui->navigation->emptyNavigationBox();
+        newItem->expandLevels(LazyExpandedLevels);
         _mainItem = newItem ;
+        layoutDiagram();
+        _scene->endUpdate();
+        ui->navigation->emptyNavigationBox();
         return newItem ;
     }
 }
 
 
+/*!
+ * \brief countSchemaObjects counts the objects of the schema, stopping when the budget is over
+ * \return true if the budget is over
+ */
+static bool countSchemaObjects(XSchemaObject *object, int &budget)
+{
+    foreach(XSchemaObject * child, object->getChildren()) {
+        budget -- ;
+        if((budget <= 0) || countSchemaObjects(child, budget)) {
+            return true ;
+        }
+    }
+    return false ;
+}
+
+/*!
+ * \brief XSDWindow::isLazySchema big schemas show only the first levels, the other items are created when expanded
+ */
+bool XSDWindow::isLazySchema(const XsdGraphicContext::EContextType contextType, XSDSchema *schema)
+{
+    if((XsdGraphicContext::CONTEXT_GRAPHICS != contextType) || (NULL == schema)) {
+        return false;
+    }
+    int budget = LazyItemsThreshold ;
+    return countSchemaObjects(schema, budget);
+}
+
+/*!
+ * \brief XSDWindow::layoutDiagram the layout of the items created, which are the expanded ones only
+ */
+void XSDWindow::layoutDiagram()
+{
+    if(NULL == _mainItem) {
+        return ;
+    }
+    _mainItem->recalcChildrenPos(&_itemContext);
+    _mainItem->afterPositionChange();
+    _scene->applyLevelOfDetail();
+    _scene->updateBounds();
+}
+
+void XSDWindow::expandItem(XSDItem *item)
+{
+    if((NULL == item) || !item->hasCollapsedChildren()) {
+        return ;
+    }
+    Utils::showWaitCursor();
+    setUpdatesEnabled(false);
+    _scene->beginUpdate();
+    item->expand();
+    layoutDiagram();
+    _scene->endUpdate();
+    setUpdatesEnabled(true);
+    Utils::restoreCursor();
+    _scene->gotoItem(item->graphicItem());
+}
+
+/*!
+ * \brief XSDWindow::revealObject expands the collapsed items that contain the object
+ * \return the item of the object, if any
+ */
+XSDItem *XSDWindow::revealObject(XSchemaObject *target)
+{
+    XSDItem *item = _context.getItemOfObject(target);
+    if((NULL != item) || !_context.isLazyChildren()) {
+        return item;
+    }
+    QList<XSchemaObject*> ancestors;
+    XSchemaObject *ancestor = target->xsdParent();
+    while(NULL != ancestor) {
+        ancestors.prepend(ancestor);
+        ancestor = ancestor->xsdParent();
+    }
+    bool isChanged = false;
+    Utils::showWaitCursor();
+    setUpdatesEnabled(false);
+    _scene->beginUpdate();
+    foreach(XSchemaObject * object, ancestors) {
+        XSDItem *ancestorItem = _context.getItemOfObject(object);
+        if((NULL != ancestorItem) && ancestorItem->hasCollapsedChildren()) {
+            ancestorItem->expand();
+            isChanged = true ;
+        }
+    }
+    if(isChanged) {
+        layoutDiagram();
+    }
+    _scene->endUpdate();
+    setUpdatesEnabled(true);
+    Utils::restoreCursor();
+    return _context.getItemOfObject(target);
+}
+
+void XSDWindow::updateLevelOfDetail()
+{
+    if((NULL != _view) && (NULL != _scene)) {
+        _scene->setViewScale(_view->transform().m11());
+    }
+}
+
 void XSDWindow::setupSplitter()
 {
     if(oldSizeFirstWidget == -1) {
@@ -961,6 +1100,11 @@ XSchemaObject * XSDWindow::resolveName(const XReferenceType referenceType, const
     return target ;
 }
 
+void XSDWindow::xon_expandAction_triggered()
+{
+    expandItem(getSelectedItem());
+}
+
 void XSDWindow::xon_copyNameAction_triggered()
 {
     XSchemaObject *object = getSelectedSchemaObject();
@@ -1059,7 +1203,14 @@ void XSDWindow::xon_loadFromString_triggered()
             }
             XSDLoadContext loadContext;
             loadContext.setLoadKeys(true);
-            _context.schema()->readFromString(&loadContext, _stringToLoad, true, _appData->xsdNetworkAccessManager(), folder);
+            if(NULL != _regolaToLoad) {
+                _context.schema()->readFromRegola(&loadContext, _regolaToLoad, true, _appData->xsdNetworkAccessManager(), folder, _loadMap);
+                if((NULL != _elementToSelect) && (NULL != _loadMap)) {
+                    _selectedElementKey = _loadMap->dataMap.key(_elementToSelect);
+                }
+            } else {
+                _context.schema()->readFromString(&loadContext, _stringToLoad, true, _appData->xsdNetworkAccessManager(), folder);
+            }
             showRoot();
             if(!_selectedElementKey.isEmpty()) {
                 //select the element
@@ -1155,6 +1306,7 @@ void XSDWindow::on_cmdZoomIn_clicked()
 {
     if(NULL != _view) {
         _view->scale(1.1, 1.1);
+        updateLevelOfDetail();
     }
 }
 
@@ -1162,6 +1314,7 @@ void XSDWindow::on_cmdZoomOut_clicked()
 {
     if(NULL != _view) {
         _view->scale(0.9, 0.9);
+        updateLevelOfDetail();
     }
 }
 
@@ -1169,6 +1322,7 @@ void XSDWindow::on_cmdZoom1_clicked()
 {
     if(NULL != _view) {
         _view->resetTransform();
+        updateLevelOfDetail();
     }
 }
 
@@ -1203,7 +1357,7 @@ void XSDWindow::enableHistory()
 void XSDWindow::on_backButton_clicked()
 {
     if((currentHistoryPosition > 0) && (history.count() > currentHistoryPosition)) {
-        XSDItem *item = _context.getItemOfObject(history.at(currentHistoryPosition - 1));
+        XSDItem *item = revealObject(history.at(currentHistoryPosition - 1));
         if(NULL != item) {
             currentHistoryPosition -- ;
             enableHistory();
@@ -1215,7 +1369,7 @@ void XSDWindow::on_backButton_clicked()
 void XSDWindow::on_forwardButton_clicked()
 {
     if((currentHistoryPosition >= 0) && ((history.count() - 2) >= currentHistoryPosition)) {
-        XSDItem *item = _context.getItemOfObject(history.at(currentHistoryPosition + 1));
+        XSDItem *item = revealObject(history.at(currentHistoryPosition + 1));
         if(NULL != item) {
             currentHistoryPosition ++ ;
             enableHistory();
@@ -1242,7 +1396,7 @@ void XSDWindow::historyNewTarget(XSchemaObject *target)
 
 void XSDWindow::jumpToObject(XSchemaObject *target)
 {
-    XSDItem *item = _context.getItemOfObject(target);
+    XSDItem *item = revealObject(target);
     if(NULL != item) {
         truncateHistory();
         historyNewTarget(target);
@@ -1397,6 +1551,7 @@ void XSDWindow::callController()
     if(NULL != controller() && (contextType() == XsdGraphicContext::CONTEXT_DIFF)) {
         XSDCompareOptions options;
         options.setCompareComment(ui->xsdCompareTools->isCompareAnnotations());
+        options.setOnlyChanged(ui->xsdCompareTools->isCompareOnlyChanged());
         controller()->evaluate(this, options, _isSwap);
     }
 }
@@ -1413,6 +1568,11 @@ void XSDWindow::on_xsdCompareTools_swapReference()
     callController();
 }
 
+void XSDWindow::on_xsdCompareTools_compareAgain()
+{
+    callController();
+}
+
 void XSDWindow::on_actionSwapReferenceAndTarget_triggered()
 {
     on_xsdCompareTools_swapReference();
@@ -46,6 +46,9 @@ class XSDScene : public QGraphicsScene
 {
     Q_OBJECT
     XSDGraphicsBackgroundConfiguration _bkConfig;
+    bool _isLowDetail;
+    bool _areDetailsHidden;
+    int _updatesNesting;
 
     void configureAndSetGradient(XSDGraphicsBackgroundConfiguration *bkgConfig, QGradient &gradient);
     void applyBackground(XSDGraphicsBackgroundConfiguration *bkgConfig);
@@ -58,6 +61,13 @@ public:
     void updateBounds();
     void gotoItem(QGraphicsItem *item);
     void setBackgroundCfg(XSDGraphicsBackgroundConfiguration *bkgConfig);
+    void beginUpdate();
+    void endUpdate();
+    bool isLowDetail() const;
+    void setViewScale(const qreal scale);
+    void applyLevelOfDetail();
+    void render(QPainter *painter, const QRectF &target = QRectF(), const QRectF &source = QRectF(),
+                Qt::AspectRatioMode aspectRatioMode = Qt::KeepAspectRatio);
 };
 
 
@@ -229,6 +239,11 @@ protected:
     qreal _yToAdd;
     int _id ;
     static int _instances;
+    /** \brief if false, the items of the children are not created yet
+      */
+    bool _isExpanded;
+    QList<XSchemaObject*> _collapsedChildren;
+    QGraphicsSimpleTextItem *_collapsedMarker;
 
     enum EIntersectType {
         IntersectNoneBefore,
@@ -278,12 +293,16 @@ protected:
     qreal updateAnObjectPlacementNew0(XSDItem *target, QVector<QRectF> &currBounds, const qreal thisGap, const qreal gapValue, const int index);
     qreal calcOverallHeight(QList<QGraphicsItem*> &rendered);
     void finalOffset(const QRectF &bounds);
-    void finalPos(QRectF &bounds, const bool isFirst);
+    void moveBoundsBy(const qreal deltaY);
+    void finalBounds(QRectF &bounds, const bool isFirst);
+    void finalPos();
     void finalOffset__old();
     void finalOffset__old1();
     //-- endregion(New0)
     qreal recalcChildrenPosStrategyUnder(XSDItemContext *context);
     void preAddChildren(XSchemaObject *object);
+    bool deferChild(XSchemaObject *child);
+    void updateCollapsedMarker();
     virtual void afterDispose();
     virtual void afterDisposeAllChildren();
     QRectF calcDependentBounds();
@@ -352,6 +371,9 @@ public:
     virtual QString itemClassName() = 0 ;
     QString dumpAsString(const int indent);
     static void resetId();
+    bool hasCollapsedChildren() const;
+    int expand();
+    void expandLevels(const int levels);
 
 public slots:
     virtual void childAdded(XSchemaObject *newChild);
@@ -1680,6 +1702,9 @@ protected:
 
     static const int InitialWidth = 100;
     static const int InitialHeight = 100;
+    // over this number of objects, the items are created only for the expanded branches
+    static const int LazyItemsThreshold = 2000;
+    static const int LazyExpandedLevels = 3;
 
     QAction *addAttributeAction;
     QAction *addSequenceAction;
@@ -1693,6 +1718,7 @@ protected:
     QAction *_copyNameAction;
     QAction *_copyElementAction;
     QAction *_copyFacetsAction;
+    QAction *_expandAction;
     QAction *compareCommentsAction;
     QAction *compareShowOnlyDifferencesAction ;
     QAction *compareSwapReferenceAction;
@@ -1733,8 +1759,11 @@ public:
     QAction *getCopyNameAction();
     QAction *getCopyElementAction();
     QAction *getCopyFacetsAction();
+    QAction *getExpandAction();
+    bool canExpandObject(XSchemaObject *target);
     void loadString(const QString &inputData);
     void loadStringImmediate(const QString &inputData);
+    void loadRegola(Regola *regola, ElementLoadInfoMap *map, Element *selectedElement);
     void setTitle(const QString &newTitle);
     void setFileName(const QString &newFileName);
     XsdGraphicContext::EContextType contextType();
@@ -1774,6 +1803,11 @@ protected:
     virtual QString chooseRoot(QWidget *parent, QList<XSchemaElement*> elements);
     bool askIfSimpleReport();
     XSchemaObject * resolveName(const XReferenceType referenceType, const QString &name);
+    static bool isLazySchema(const XsdGraphicContext::EContextType contextType, XSDSchema *schema);
+    void layoutDiagram();
+    void expandItem(XSDItem *item);
+    XSDItem *revealObject(XSchemaObject *target);
+    void updateLevelOfDetail();
 
 protected:
     Ui::XSDWindow *ui;
@@ -1781,6 +1815,10 @@ protected:
     QGraphicsView *_view;
     XSDScene *_scene;
     QString _stringToLoad;
+    // when set, the schema is read from the document instead of the string
+    Regola *_regolaToLoad;
+    ElementLoadInfoMap *_loadMap;
+    Element *_elementToSelect;
     XsdGraphicContext _context;
     IXSDController *_controller;
     QString _fileName;
@@ -1845,6 +1883,7 @@ protected slots:
     void xon_copyNameAction_triggered();
     void xon_copyElementAction_triggered();
     void xon_copyFacetsAction_triggered();
+    void xon_expandAction_triggered();
 
     void selectionChanged();
     void xon_loadFromString_triggered();
@@ -1871,6 +1910,7 @@ protected slots:
 
     void onCompareAnnotationAction(bool newState);
     void on_xsdCompareTools_swapReference();
+    void on_xsdCompareTools_compareAgain();
     void on_compareSummary_objectDoubleClicked(XSchemaObject* target);
     void on_actionSwapReferenceAndTarget_triggered();
     void on_actionConfigureAspect_triggered();
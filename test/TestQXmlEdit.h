@@ -106,6 +106,8 @@
 #include "testhelp.h"
 #include "testtestxmlfile.h"
 #include "testloadsample.h"
+#include "testxmlscanner.h"
+#include "testincrementalsave.h"
 
 class TestQXmlEdit : public QObject
 {
@@ -137,6 +139,7 @@ private Q_SLOTS:
     void testCompareXml();
     void testExportCSV();
     void testXSDDiff12();
+    void testXSDDiff13();
     void testXSDDiff2();
     void testXSDDiff3();
     void testXSDDiff4();
@@ -221,6 +224,8 @@ private Q_SLOTS:
     void testHelp();
     void testTestXMLFile();
     void testLoadSample();
+    void testXmlScanner();
+    void testIncrementalSave();
 };
 
 
@@ -43,6 +43,12 @@ bool TestSplit::unitTestFilterEventElement()
     if(!unitTestFilterEventElementMultipleEvents()) {
         return false;
     }
+    if(!unitTestFilterEventElementReuse()) {
+        return false;
+    }
+    if(!unitTestFilterEventWrappers()) {
+        return false;
+    }
     return true ;
 }
 
@@ -1224,6 +1230,97 @@ bool TestSplit::unitTestOperationBase()
     return true ;
 }
 
+bool TestSplit::unitTestFilterEventElementReuse()
+{
+    _subTestName = "unitTestScriptingBase/unitTestFilterEventElementReuse";
+    ExtractionScriptElementEvent elementEvent;
+    {
+        QXmlStreamAttributes inputAttributes;
+        inputAttributes.append(QXmlStreamAttribute("a", "1"));
+        inputAttributes.append(QXmlStreamAttribute("b", "2"));
+        elementEvent.reset();
+        elementEvent.setElementName("root");
+        elementEvent.setAttributes(inputAttributes);
+        elementEvent.resetModifed();
+        // read only access must not change the event
+        if(elementEvent.attributesCount() != 2) {
+            return error(QString("first: count expected 2, found %1").arg(elementEvent.attributesCount()));
+        }
+        if(elementEvent.attributeValueByName("b") != "2") {
+            return error(QString("first: value of b expected 2, found '%1'").arg(elementEvent.attributeValueByName("b")));
+        }
+        if(elementEvent.attributeNameByIndex(1) != "b") {
+            return error(QString("first: name at 1 expected b, found '%1'").arg(elementEvent.attributeNameByIndex(1)));
+        }
+        if(elementEvent.isModified()) {
+            return error("first: modified after reading");
+        }
+        elementEvent.setAttributeValueByName("a", "x");
+        if(!elementEvent.isModified()) {
+            return error("first: not modified after writing");
+        }
+        if((elementEvent.attributeValueByIndex(0) != "x") || (elementEvent.attributesCount() != 2)) {
+            return error(QString("first: after write value expected x, found '%1'").arg(elementEvent.attributeValueByIndex(0)));
+        }
+    }
+    {
+        QXmlStreamAttributes inputAttributes;
+        inputAttributes.append(QXmlStreamAttribute("c", "3"));
+        elementEvent.reset();
+        elementEvent.setElementName("child");
+        elementEvent.setAttributes(inputAttributes);
+        elementEvent.resetModifed();
+        if(elementEvent.isModified()) {
+            return error("second: modified after reuse");
+        }
+        if(elementEvent.attributesCount() != 1) {
+            return error(QString("second: count expected 1, found %1").arg(elementEvent.attributesCount()));
+        }
+        if(!elementEvent.attributeValueByName("a").isEmpty()) {
+            return error("second: stale attribute found");
+        }
+        QList<QPair<QString,QString> > expectedList ;
+        expectedList << QPair<QString, QString>("c", "3");
+        if(!checkElementEventBase(0, &elementEvent, expectedList, false)) {
+            return false;
+        }
+    }
+    return true ;
+}
+
+bool TestSplit::unitTestFilterEventWrappers()
+{
+    _subTestName = "unitTestScriptingBase/unitTestFilterEventWrappers";
+    ExtractionScriptFilter filter;
+    ExtractionScriptTextEvent textEvent;
+    ExtractionScriptElementEvent elementEvent;
+    filter.registerEvent(&textEvent);
+    const QJSValue textValue = filter._eventValue ;
+    filter.registerEvent(&elementEvent);
+    const QJSValue elementValue = filter._eventValue ;
+    // alternating the events must not make new wrappers
+    FORINT(index, 3) {
+        filter.registerEvent(&textEvent);
+        if(!filter._eventValue.strictlyEquals(textValue)) {
+            return error(QString("text wrapper changed at %1").arg(index));
+        }
+        if(filter._engine.globalObject().property(ExtractionScriptFilter::EventName).toQObject() != &textEvent) {
+            return error(QString("global event is not the text at %1").arg(index));
+        }
+        filter.registerEvent(&elementEvent);
+        if(!filter._eventValue.strictlyEquals(elementValue)) {
+            return error(QString("element wrapper changed at %1").arg(index));
+        }
+        if(filter._engine.globalObject().property(ExtractionScriptFilter::EventName).toQObject() != &elementEvent) {
+            return error(QString("global event is not the element at %1").arg(index));
+        }
+    }
+    if(filter._eventValues.size() != 2) {
+        return error(QString("wrappers expected 2, found %1").arg(filter._eventValues.size()));
+    }
+    return true ;
+}
+
 bool TestSplit::unitTestFilterEventElementMultipleEvents()
 {
     // mod, mod: 0
@@ -24,6 +24,7 @@
 #ifdef  QXMLEDIT_JS_SCRIPT
 #include "utils.h"
 #include "extraction/scripting/model/extractionscriptfiltermodel.h"
+#include "extraction/scripting/extractionscriptparallel.h"
 #include "extraction/extractionadavancedoptionsdialog.h"
 #include "modules/services/systemservices.h"
 #include "comparexml.h"
@@ -686,9 +687,116 @@ bool TestSplit::testScriptWithPredefinedScripting()
     if(!testScriptWithPredefinedScriptingFilterAll()) {
         return false;
     }
+    if(!testScriptWithPredefinedScriptingParallel()) {
+        return false;
+    }
+    if(!testScriptParallelGlobals()) {
+        return false;
+    }
+    return true ;
+}
+
+/*!
+ * \brief evaluates a script that counts the text events in global variables
+ * on some fragments and on the runs between them, a run is split in two chunks;
+ * the texts of the chunks are the values of the counters
+ */
+bool TestSplit::runScriptParallelGlobals(const int threads, QStringList &results)
+{
+    ExtractionScriptManager scriptManager;
+    scriptManager.addScriptingFilter(TestSplitScriptingHelper::filterForModel(
+                                         TestSplitScriptingHelper::baseEventModel(ExtractionEventText, true, "countText",
+                                                 "var counter = 0;\n"
+                                                 "var seen = [];\n"
+                                                 "function countText(context, event) {\n"
+                                                 "  counter++;\n"
+                                                 "  seen.push(counter);\n"
+                                                 "  event.text = \"\" + counter + \".\" + seen.length;\n"
+                                                 "}\n")));
+    ExtractionScriptParallel parallel;
+    if(!parallel.start(threads, &scriptManager)) {
+        return error(QString("Starting %1 threads: %2").arg(threads).arg(parallel.errorMessage()));
+    }
+    ExtractionScriptToken textToken;
+    textToken.action = ExtractionScriptToken::ActionScript ;
+    textToken.tokenType = QXmlStreamReader::Characters ;
+    textToken.text = "x" ;
+    FORINT(fragment, 6) {
+        parallel.setInFragment(true);
+        FORINT(index, fragment + 2) {
+            parallel.addToken(textToken);
+        }
+        parallel.submitChunk();
+        parallel.setInFragment(false);
+        if(fragment < 5) {
+            FORINT(index, 2) {
+                parallel.addToken(textToken);
+                parallel.submitChunk();
+            }
+        }
+    }
+    ExtractionScriptChunk *chunk = NULL ;
+    while(NULL != (chunk = parallel.takeCompleted(true))) {
+        if(chunk->isError) {
+            const QString message = chunk->errorMessage;
+            delete chunk;
+            return error(QString("Script error with %1 threads: %2").arg(threads).arg(message));
+        }
+        QStringList texts;
+        foreach(const ExtractionScriptToken &token, chunk->tokens) {
+            texts.append(token.text);
+        }
+        results.append(texts.join(","));
+        delete chunk;
+    }
     return true ;
 }
 
+// the script globals do not pass from a fragment to another one, whatever the threads
+// and are kept along a run of tokens outside the fragments
+bool TestSplit::testScriptParallelGlobals()
+{
+    _testName = "testScriptParallelGlobals" ;
+    QStringList expected;
+    FORINT(fragment, 6) {
+        QStringList texts;
+        FORINT(index, fragment + 2) {
+            texts.append(QString("%1.%1").arg(index + 1));
+        }
+        expected.append(texts.join(","));
+        if(fragment < 5) {
+            expected.append("1.1");
+            expected.append("2.2");
+        }
+    }
+    QStringList resultsOneThread;
+    if(!runScriptParallelGlobals(1, resultsOneThread)) {
+        return false;
+    }
+    if(resultsOneThread != expected) {
+        return error(QString("One thread, expected:\n%1\nfound:\n%2").arg(expected.join("\n")).arg(resultsOneThread.join("\n")));
+    }
+    QStringList resultsMoreThreads;
+    if(!runScriptParallelGlobals(3, resultsMoreThreads)) {
+        return false;
+    }
+    if(resultsMoreThreads != resultsOneThread) {
+        return error(QString("Three threads, expected:\n%1\nfound:\n%2").arg(resultsOneThread.join("\n")).arg(resultsMoreThreads.join("\n")));
+    }
+    return true ;
+}
+
+// the same results evaluating the scripts in more threads
+bool TestSplit::testScriptWithPredefinedScriptingParallel()
+{
+    _scriptingThreads = 3 ;
+    bool isOk = testScriptWithPredefinedScriptingFilter()
+                && testScriptWithPredefinedScriptingSplit()
+                && testScriptWithPredefinedScriptingFilterAll();
+    _scriptingThreads = 1 ;
+    return isOk ;
+}
+
 bool TestSplit::testScriptWithPredefinedScriptingFilter()
 {
     _testName = "testScriptWithPredefinedScriptingFilter" ;
@@ -859,6 +967,7 @@ bool TestSplit::testPredefinedScriptExecute(const bool useNamespaces, const bool
         filters.append(QString("%1").arg(script));
     }
     op.setFiltersId(filters.join(","));
+    op.setScriptingThreads(_scriptingThreads);
 
     op.performExtraction();
     if(op.isError()) {
@@ -918,6 +1027,7 @@ bool TestSplit::testPredefinedScriptExecuteList(const bool useNamespaces, const
         filters.append(QString("%1").arg(script));
     }
     op.setFiltersId(filters.join(","));
+    op.setScriptingThreads(_scriptingThreads);
 
     op.performExtraction();
     if(op.isError()) {
@@ -186,7 +186,9 @@ SOURCES += \
     extraction/scriptextractioneventtext.cpp \
     extraction/scriptextraction.cpp \
     extraction/scriptetractioneventelement.cpp \
-    testloadsample.cpp
+    testloadsample.cpp \
+    testxmlscanner.cpp \
+    testincrementalsave.cpp
 
 DEFINES += SRCDIR=\\\"$$PWD/\\\"
 
@@ -310,7 +312,9 @@ HEADERS += \
     helpers/testsplitscriptingoperationhelper.h \
     helpers/testextractionexecutorhelper.h \
     helpers/testwritableextractionoperationscriptcontext.h \
-    testloadsample.h
+    testloadsample.h \
+    testxmlscanner.h \
+    testincrementalsave.h
 
 #OTHER_FILES += \
 
@@ -42,6 +42,8 @@
 #include "modules/anonymize/anonsettingwidget.h"
 #include "modules/anonymize/anonattrexcdialog.h"
 #include "modules/anonymize/anonymizebatch.h"
+#include "modules/anonymize/anonfolderbatch.h"
+#include <QTemporaryDir>
 
 #define FILE_START_ALGALL_SEQALL            "../test/data/anon/algall_seqall_start.xml"
 #define FILE_START_ALGALL_SEQALL2           "../test/data/anon/algall_seqall_start2.xml"
@@ -1498,6 +1500,9 @@ bool TestAnonymize::testBatch()
     if(!testBatchBase()) {
         return false;
     }
+    if(!testBatchFolder()) {
+        return false;
+    }
     return true;
 }
 
@@ -1530,6 +1535,90 @@ bool TestAnonymize::testBatchBase()
 }
 
 
+/*!
+ * \brief TestAnonymize::testBatchFolder each file anonymized by the folder batch must be equal
+ * to the file anonymized alone
+ */
+bool TestAnonymize::testBatchFolder()
+{
+    _testName = "testBatchFolder";
+    QTemporaryDir baseDir;
+    if(!baseDir.isValid()) {
+        return error("unable to create the temporary folder");
+    }
+    const QString inputFolder = QDir(baseDir.path()).absoluteFilePath("in");
+    const QString outputFolder = QDir(baseDir.path()).absoluteFilePath("out");
+    if(!QDir().mkpath(inputFolder + "/sub")) {
+        return error(QString("unable to create the input folder: '%1'").arg(inputFolder));
+    }
+    QStringList sources;
+    sources << ANON_BATCH_CL_START << FILE_START_ALGSTART << FILE_START_ALGCODE << EXC_EL_FILE ;
+    QStringList relativePaths;
+    relativePaths << "a.xml" << "b.xml" << "sub/c.xml" << "sub/d.xml" ;
+    FORINT(i, sources.size()) {
+        if(!QFile::copy(sources.at(i), inputFolder + "/" + relativePaths.at(i))) {
+            return error(QString("unable to copy: '%1'").arg(sources.at(i)));
+        }
+    }
+    AnonProfile profile;
+    AnonFolderBatch batch;
+    batch.setThreads(3);
+    QStringList nameFilters;
+    nameFilters << "*.xml" ;
+    if(!batch.addFolder(inputFolder, outputFolder, nameFilters)) {
+        return error(QString("adding the folder: '%1'").arg(batch.result()->message()));
+    }
+    if(batch.filesCount() != sources.size()) {
+        return error(QString("files expected %1, found %2").arg(sources.size()).arg(batch.filesCount()));
+    }
+    const AnonOperationResult *res = batch.perform(&profile);
+    if(res->isError()) {
+        return error(QString("folder batch error: '%1'").arg(res->message()));
+    }
+    if(batch.filesDone() != sources.size()) {
+        return error(QString("files done expected %1, found %2").arg(sources.size()).arg(batch.filesDone()));
+    }
+    FORINT(i, sources.size()) {
+        AnonFolderBatchItem *item = batch.items().at(i);
+        const QString expectedOutput = QDir(outputFolder).absoluteFilePath(relativePaths.at(i));
+        if(item->outputPath != expectedOutput) {
+            return error(QString("output name expected '%1', found '%2'").arg(expectedOutput).arg(item->outputPath));
+        }
+        QBuffer single;
+        single.open(QIODevice::ReadWrite);
+        QFile input(item->inputPath);
+        if(!input.open(QIODevice::ReadOnly)) {
+            return error(QString("unable to open: '%1'").arg(item->inputPath));
+        }
+        AnonContext context(NULL, "");
+        context.setAlg(profile.params());
+        context.setProfile(profile.clone());
+        AnonOperationBatch operation;
+        operation.execute(&input, &single, &context);
+        input.close();
+        single.close();
+        CompareXML compare;
+        if(!compare.compareBufferWithFile(&single, item->outputPath)) {
+            return error(QString("comparing '%1': %2").arg(item->outputPath).arg(compare.errorString()));
+        }
+    }
+    // an abort requested before the start is kept
+    AnonFolderBatch abortedBatch;
+    if(!abortedBatch.addFolder(inputFolder, QDir(baseDir.path()).absoluteFilePath("aborted"), nameFilters)) {
+        return error(QString("adding the folder to abort: '%1'").arg(abortedBatch.result()->message()));
+    }
+    abortedBatch.setAborted();
+    res = abortedBatch.perform(&profile);
+    if(res->code() != AnonOperationResult::RES_ERR_USERABORTED) {
+        return error(QString("abort expected, found: %1 '%2'").arg(res->code()).arg(res->message()));
+    }
+    if(abortedBatch.filesDone() != 0) {
+        return error(QString("files done after the abort expected 0, found %1").arg(abortedBatch.filesDone()));
+    }
+    return true;
+}
+
+
 //----
 
 bool TestAnonymize::testUnitPathBase(const QString &testToken, const QString &fileStart, const QString &spec, QList<int> selection, const QString &expected, const Resolution resolution)
@@ -110,6 +110,7 @@ private:
     bool compareProfilesParamsInverse(AnonProfile *profile);
     //---
     bool testBatchBase();
+    bool testBatchFolder();
     bool testBatchBaseSkeleton(const QString &sourceFilePath, const QString &fileResult, AnonContext *context);
     //--
     bool testUnitPath();
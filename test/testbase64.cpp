@@ -284,6 +284,12 @@ bool TestBase64::testUnits()
     if(!testUnitUtilsColumnLimit()) {
         return false;
     }
+    if(!testUnitStreaming()) {
+        return false;
+    }
+    if(!testUnitDecodedPrefix()) {
+        return false;
+    }
     return true;
 }
 
@@ -375,6 +381,88 @@ bool TestBase64::testUnitUtilsColumnLimit()
     return true ;
 }
 
+bool TestBase64::testUnitStreaming()
+{
+    _testName = "testUnitStreaming";
+    // sizes around the chunk used to read the devices
+    const int chunk = 3 * 64 * 1024 ;
+    if(!testUnitStreamingSize(0, 0)) {
+        return false;
+    }
+    if(!testUnitStreamingSize(chunk - 1, 0)) {
+        return false;
+    }
+    if(!testUnitStreamingSize(chunk + 1, 0)) {
+        return false;
+    }
+    if(!testUnitStreamingSize(2 * chunk + 2, 76)) {
+        return false;
+    }
+    if(!testUnitStreamingSize(chunk + 1, 7)) {
+        return false;
+    }
+    return true;
+}
+
+bool TestBase64::testUnitStreamingSize(const int size, const int columns)
+{
+    QByteArray data ;
+    data.resize(size);
+    FORINT(i, size) {
+        data[i] = static_cast<char>((i * 7) + (i >> 8));
+    }
+    Base64Utils base64;
+    QBuffer buffer(&data);
+    if(!buffer.open(QIODevice::ReadOnly)) {
+        return error("opening read buffer");
+    }
+    QString encoded;
+    if(!base64.loadFromBinaryDevice(Base64Utils::RFC4648Standard, &buffer, encoded, columns > 0, columns)) {
+        return error(QString("encoding, size:%1").arg(size));
+    }
+    buffer.close();
+    const QString expected = base64.doLimitColumns(QString::fromLatin1(data.toBase64()), columns > 0, columns);
+    if(expected != encoded) {
+        return error(QString("encoding differs, size:%1, columns:%2").arg(size).arg(columns));
+    }
+    QByteArray decoded ;
+    QBuffer outBuffer(&decoded);
+    if(!outBuffer.open(QIODevice::WriteOnly)) {
+        return error("opening write buffer");
+    }
+    if(!base64.saveToBinaryDevice(Base64Utils::RFC4648Standard, &outBuffer, encoded)) {
+        return error(QString("decoding, size:%1").arg(size));
+    }
+    outBuffer.close();
+    if(decoded != data) {
+        return error(QString("decoding differs, size:%1, columns:%2").arg(size).arg(columns));
+    }
+    return true ;
+}
+
+bool TestBase64::testUnitDecodedPrefix()
+{
+    _testName = "testUnitDecodedPrefix";
+    const QString text = QString::fromUtf8("abc\u0444\u0438\u0441");
+    const QString encoded = Utils::toBase64(text);
+    QString result = Base64Utils::decodedTextPrefix(encoded, 100);
+    if(result != text) {
+        return error(QString("full prefix, expected '%1', found '%2'").arg(text).arg(result));
+    }
+    result = Base64Utils::decodedTextPrefix(encoded, 3);
+    if(result != "abc") {
+        return error(QString("short prefix, found '%1'").arg(result));
+    }
+    QString longText;
+    FORINT(i, 5000) {
+        longText.append(QChar('a' + (i % 26)));
+    }
+    result = Base64Utils::decodedTextPrefix(Utils::toBase64(longText), 4001);
+    if(result != longText.left(4001)) {
+        return error(QString("long prefix, length:%1").arg(result.length()));
+    }
+    return true ;
+}
 
 bool TestBase64::testUnitUtilsDecode(const Base64Utils::EBase64 type )
 {
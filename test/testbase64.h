@@ -41,6 +41,9 @@ class TestBase64 : public TestBase
     bool testIO(const Base64Utils::EBase64 type, const bool useLimit);
     bool testUnitUtilsColumnLimit();
     bool lowLevelColumnLimit( const bool limit, const int columns, const QString &expected);
+    bool testUnitStreaming();
+    bool testUnitStreamingSize(const int size, const int columns);
+    bool testUnitDecodedPrefix();
 public:
     TestBase64();
 
@@ -24,6 +24,8 @@
 #include "testhelpers/testbvd.h"
 #include <QBuffer>
 #include <QTableView>
+#include <QSignalSpy>
+#include "modules/binaryviewer/binarysearch.h"
 
 #define SEARCH_LEMMA    "abcdx"
 
@@ -319,6 +321,53 @@ bool TestBinaryViewer::testSearch()
     return true;
 }
 
+bool TestBinaryViewer::testFindAll()
+{
+    _testName = QString("testModel/findAll");
+    BinaryViewerModel model;
+    QByteArray data = buildSearchBuffer();
+    QBuffer *ioBuffer = new QBuffer(&data);
+    BinaryViewerModel::ErrCodes code = model.setFile(ioBuffer);
+    if( BinaryViewerModel::EC_NOERROR != code ) {
+        return error(QString("Setting the buffer data, expecting:%1, found:%2").arg(BinaryViewerModel::EC_NOERROR).arg(code));
+    }
+    if(!model.setCodecByName("ISO-8859-1")) {
+        return error("Unable to set the codec for the string");
+    }
+    QList<qint64> expected;
+    expected << BinaryBlock::SizeOfRow << 2 * BinaryBlock::SizeOfRow << BinaryViewerModel::SizeOfPage ;
+    QByteArray reference = QString(SEARCH_LEMMA).toLatin1();
+    if(BinarySearch::indexOf(data.constData(), data.length(), reference, expected.at(0) + 1) != expected.at(1)) {
+        return error("Binary search forward");
+    }
+    if(BinarySearch::lastIndexOf(data.constData(), data.length(), reference, expected.at(1) - 1) != expected.at(0)) {
+        return error("Binary search backward");
+    }
+    QSignalSpy spyOccurrences(&model, SIGNAL(occurrencesFound(int, QList<qint64>)));
+    QSignalSpy spyFinished(&model, SIGNAL(findAllFinished(int, qint64, bool)));
+    int findId = model.startFindAll(SEARCH_LEMMA);
+    model.waitFindAll();
+    QList<qint64> found;
+    for(int i = 0 ; i < spyOccurrences.count() ; i ++) {
+        QList<QVariant> arguments = spyOccurrences.at(i);
+        if(arguments.at(0).toInt() != findId) {
+            return error(QString("Find all, id expected %1, found %2").arg(findId).arg(arguments.at(0).toInt()));
+        }
+        found.append(arguments.at(1).value<QList<qint64> >());
+    }
+    if(found != expected) {
+        return error(QString("Find all, expected %1 occurrences, found %2").arg(expected.size()).arg(found.size()));
+    }
+    if(spyFinished.count() != 1) {
+        return error(QString("Find all, finished emitted %1 times").arg(spyFinished.count()));
+    }
+    QList<QVariant> finished = spyFinished.at(0);
+    if((finished.at(1).toLongLong() != expected.size()) || finished.at(2).toBool()) {
+        return error(QString("Find all, finished with %1 occurrences, aborted:%2").arg(finished.at(1).toLongLong()).arg(finished.at(2).toBool()));
+    }
+    return true;
+}
+
 void TestBinaryViewer::insertSearchInBufferLatin1(QByteArray *data, const int page, const int row)
 {
     char *charArray = data->data();
@@ -398,6 +447,9 @@ bool TestBinaryViewer::unitTests()
     if(!testSearch()) {
         return false;
     }
+    if(!testFindAll()) {
+        return false;
+    }
     if(!testPageOffset()) {
         return false;
     }
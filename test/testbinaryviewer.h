@@ -93,6 +93,7 @@ class TestBinaryViewer : public TestBase
 
     bool testRows(BinaryViewerModel *model);
     bool testSearch();
+    bool testFindAll();
     bool testPageOffset();
 
     bool testFunctionalPages();
@@ -22,6 +22,15 @@
 
 #include "testcommandline.h"
 #include "StartParams.h"
+#include "modules/services/batchrunner.h"
+#include "modules/services/batchjob.h"
+#include "app.h"
+#include <QProcess>
+#include <QTemporaryFile>
+
+#define BATCH_COMPARE_EQUAL "../test/data/compare/attreq1.xml"
+#define BATCH_COMPARE_DIFFERENT "../test/data/compare/attradd2.xml"
+#define BATCH_MISSING_FILE "../test/data/compare/nonexistent.xml"
 
 TestCommandLine::TestCommandLine()
 {
@@ -36,6 +45,12 @@ bool TestCommandLine::testFast()
     if(!testUnit()){
         return false;
     }
+    if(!testBatch()){
+        return false;
+    }
+    if(!testBatchHeadless()){
+        return false;
+    }
     return true ;
 }
 
@@ -122,6 +137,33 @@ bool TestCommandLine::testUnit()
     }
 
 
+    // batch: no job list
+    {
+        QStringList args;
+        args << "pgm" << "-batch" ;
+        if(!checkArgs("batch 0", args, false, StartParams::Batch )) {
+            return false;
+        }
+    }
+
+    // batch: bad threads count
+    {
+        QStringList args;
+        args << "pgm" << "-batch" << "-threads=0" << "jobs" ;
+        if(!checkArgs("batch threads 0", args, false, StartParams::Batch )) {
+            return false;
+        }
+    }
+
+    // batch: ok
+    {
+        QStringList args;
+        args << "pgm" << "-batch" << "-threads=4" << "jobs" ;
+        if(!checkArgs("batch 1", args, true, StartParams::Batch )) {
+            return false;
+        }
+    }
+
     // anon: 1 arg error
     {
         QStringList args;
@@ -151,3 +193,131 @@ bool TestCommandLine::testUnit()
 
     return true ;
 }
+
+bool TestCommandLine::checkBatchJob(BatchJob *job, const bool expectedError, const QString &expectedMessage)
+{
+    if(!job->isExecuted()) {
+        return error(QString("Job at line %1 not executed").arg(job->lineNumber()));
+    }
+    if(job->isError() != expectedError) {
+        return error(QString("Job at line %1, error expected %2, found %3 (%4)").arg(job->lineNumber()).arg(expectedError).arg(job->isError()).arg(job->message()));
+    }
+    if(!expectedMessage.isEmpty() && (job->message() != expectedMessage)) {
+        return error(QString("Job at line %1, message expected '%2', found '%3'").arg(job->lineNumber()).arg(expectedMessage).arg(job->message()));
+    }
+    return true ;
+}
+
+bool TestCommandLine::testBatch()
+{
+    _testName = "testBatch";
+    App app;
+    if(!app.init()) {
+        return error("init app");
+    }
+    {
+        QString jobs = "compare\t" BATCH_COMPARE_EQUAL "\t" BATCH_COMPARE_EQUAL "\nunknown a b\n";
+        QTextStream stream(&jobs);
+        BatchRunner runner(app.data());
+        if(runner.readJobList(stream)) {
+            return error("unknown operation accepted");
+        }
+    }
+    QString jobs = "# comment\n"
+                   "compare\t" BATCH_COMPARE_EQUAL "\t" BATCH_COMPARE_EQUAL "\n"
+                   "\n"
+                   "compare " BATCH_COMPARE_EQUAL " " BATCH_COMPARE_DIFFERENT "\n"
+                   "compare\t" BATCH_MISSING_FILE "\t" BATCH_COMPARE_EQUAL "\n";
+    QTextStream stream(&jobs);
+    BatchRunner runner(app.data());
+    runner.setThreads(2);
+    if(!runner.readJobList(stream)) {
+        return error(QString("reading jobs: %1").arg(runner.errorMessage()));
+    }
+    if(runner.jobs().size() != 3) {
+        return error(QString("jobs count expected 3, found %1").arg(runner.jobs().size()));
+    }
+    if(runner.run()) {
+        return error("run should fail");
+    }
+    if(runner.errorsCount() != 1) {
+        return error(QString("errors expected 1, found %1").arg(runner.errorsCount()));
+    }
+    if(!checkBatchJob(runner.jobs().at(0), false, QObject::tr("The files are equal."))) {
+        return false;
+    }
+    if(!checkBatchJob(runner.jobs().at(1), false, QObject::tr("The files are different."))) {
+        return false;
+    }
+    if(!checkBatchJob(runner.jobs().at(2), true, "")) {
+        return false;
+    }
+    if(runner.jobs().at(0)->bytes() <= 0) {
+        return error("bytes not counted");
+    }
+    return true ;
+}
+
+/*!
+ * \brief the path of the program built with the tests, empty if not found
+ */
+QString TestCommandLine::programPath()
+{
+    QDir dir(QCoreApplication::applicationDirPath());
+    QStringList candidates;
+    candidates << "QXmlEdit" << "qxmledit" << "QXmlEdit.exe" << "qxmledit.exe" << "QXmlEdit.app/Contents/MacOS/QXmlEdit" ;
+    foreach(const QString &candidate, candidates) {
+        QFileInfo info(dir.absoluteFilePath(candidate));
+        if(info.exists() && info.isExecutable()) {
+            return info.absoluteFilePath();
+        }
+    }
+    return "" ;
+}
+
+/*!
+ * \brief the batch mode starts the program without a display and without a QApplication
+ */
+bool TestCommandLine::testBatchHeadless()
+{
+    _testName = "testBatchHeadless";
+    const QString program = programPath();
+    if(program.isEmpty()) {
+        return error(QString("program not found in '%1'").arg(QCoreApplication::applicationDirPath()));
+    }
+    QTemporaryFile jobList;
+    if(!jobList.open()) {
+        return error("unable to create the job list");
+    }
+    const QString equalFile = QFileInfo(BATCH_COMPARE_EQUAL).absoluteFilePath();
+    const QString differentFile = QFileInfo(BATCH_COMPARE_DIFFERENT).absoluteFilePath();
+    QTextStream stream(&jobList);
+    stream << "compare\t" << equalFile << "\t" << equalFile << "\n" ;
+    stream << "compare\t" << equalFile << "\t" << differentFile << "\n" ;
+    stream.flush();
+    jobList.close();
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.remove("DISPLAY");
+    environment.remove("WAYLAND_DISPLAY");
+    environment.insert("QT_QPA_PLATFORM", "offscreen");
+    QProcess process;
+    process.setProcessEnvironment(environment);
+    process.start(program, QStringList() << "-batch" << "-threads=2" << jobList.fileName());
+    if(!process.waitForStarted()) {
+        return error(QString("unable to start '%1'").arg(program));
+    }
+    if(!process.waitForFinished(60000)) {
+        process.kill();
+        return error("the batch did not end");
+    }
+    const QString output = QString::fromLocal8Bit(process.readAllStandardOutput());
+    const QString errors = QString::fromLocal8Bit(process.readAllStandardError());
+    if((process.exitStatus() != QProcess::NormalExit) || (process.exitCode() != 0)) {
+        return error(QString("exit status %1, code %2\noutput:\n%3\nerrors:\n%4")
+                     .arg(process.exitStatus()).arg(process.exitCode()).arg(output).arg(errors));
+    }
+    if(!output.contains(QObject::tr("The files are equal.")) || !output.contains(QObject::tr("The files are different."))) {
+        return error(QString("unexpected output:\n%1").arg(output));
+    }
+    return true ;
+}
@@ -26,14 +26,20 @@
 
 #include "testbase.h"
 
+class BatchJob;
+
 class TestCommandLine : public TestBase
 {
     bool checkArgs(const QString &id, QStringList args, const bool expectedResult, const int expectedTypeInt );
+    bool checkBatchJob(BatchJob *job, const bool expectedError, const QString &expectedMessage);
 public:
     TestCommandLine();
     ~TestCommandLine();
     bool testFast();
     bool testUnit();
+    bool testBatch();
+    bool testBatchHeadless();
+    QString programPath();
 };
 
 #endif // TESTCOMMANDLINE_H
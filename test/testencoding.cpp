@@ -29,6 +29,7 @@
 #include "charencodingdialog.h"
 #include "xmlsavecontext.h"
 #include <QByteArray>
+#include <QTemporaryFile>
 
 #define DEFAULT_ENCODING    "UTF-8"
 
@@ -81,6 +82,9 @@ bool TestEncoding::testUnitTests()
     if(!testFileMode()) {
         return false;
     }
+    if(!testSaveReplace()) {
+        return false;
+    }
     return true;
 }
 
@@ -142,6 +146,48 @@ bool TestEncoding::testRecognizeEncoding(const QString &file, const QString &exp
 
 //---------------------------------------------------------
 
+bool TestEncoding::testSaveReplace()
+{
+    _testName = "testSaveReplace";
+    App app;
+    if(!app.init(true)) {
+        return error("init app");
+    }
+    if(!app.mainWindow()->loadFile(INPUT_FILE_UTF8)) {
+        return error(QString("error reading file open:'%1'").arg(INPUT_FILE_UTF8));
+    }
+    Regola *regola = app.mainWindow()->getRegola();
+    regola->setIndentation(0);
+    QBuffer buffer;
+    if(!regola->write(&buffer, false)) {
+        return error("error writing buffer");
+    }
+    QTemporaryFile tempFile;
+    tempFile.setAutoRemove(true);
+    if(!tempFile.open()) {
+        return error("Unable to open temp file");
+    }
+    // the previous content is longer than the document
+    tempFile.write(QByteArray(64 * 1024, 'x'));
+    tempFile.close();
+    const QString filePath = QFileInfo(tempFile).absoluteFilePath();
+    if(!regola->write(filePath, false)) {
+        return error(QString("error writing file:'%1'").arg(filePath));
+    }
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly)) {
+        return error(QString("error opening saved file:'%1'").arg(filePath));
+    }
+    const QByteArray savedData = file.readAll();
+    file.close();
+    if(savedData != buffer.data()) {
+        return error(QString("saved file differs from the buffer, file:%1 bytes, buffer:%2 bytes").arg(savedData.size()).arg(buffer.data().size()));
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+
 
 bool TestEncoding::testReadAndWriteEncoding()
 {
@@ -39,6 +39,7 @@ class TestEncoding : public TestBase
     bool is8BitEncodingHonoredForStreamWriter(const QString &encoding, bool &isError);
     bool testWriteStreamQtBug();
     bool testFileMode();
+    bool testSaveReplace();
     bool testRecognizeEncoding(const QString &file, const QString &expectedEncoding);
     bool testReadAndWriteEncoding();
     bool testReadAndWriteAnEncoding(const QString &fileInput, const QString &encoding);
@@ -0,0 +1,254 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+#include "testincrementalsave.h"
+#include "app.h"
+#include "regola.h"
+#include "modules/xml/xmlsourcemap.h"
+#include "qxmleditconfig.h"
+#include <QTemporaryFile>
+#include <QDir>
+#include <QFileInfo>
+
+#define BASE_PATH "../test/data/xml/incremental/"
+#define FILE_SOURCE     BASE_PATH "source.xml"
+#define FILE_EDITED     BASE_PATH "edited.xml"
+#define FILE_ADDED      BASE_PATH "added.xml"
+
+TestIncrementalSave::TestIncrementalSave()
+{
+}
+
+TestIncrementalSave::~TestIncrementalSave()
+{
+}
+
+bool TestIncrementalSave::testUnitTests()
+{
+    if(!testEditAndSave()) {
+        return false;
+    }
+    if(!testSameSizeRewrite()) {
+        return false;
+    }
+    if(!testDisabled()) {
+        return false;
+    }
+    return true;
+}
+
+bool TestIncrementalSave::copyToTemp(const QString &source, QTemporaryFile *tempFile)
+{
+    QFile sourceFile(source);
+    if(!sourceFile.open(QIODevice::ReadOnly)) {
+        return error(QString("Unable to read file '%1'").arg(source));
+    }
+    const QByteArray data = sourceFile.readAll();
+    sourceFile.close();
+    tempFile->setFileTemplate(QDir::tempPath() + "/qxmledit_incremental_XXXXXX.xml");
+    if(!tempFile->open()) {
+        return error("Unable to open temp file");
+    }
+    tempFile->write(data);
+    tempFile->close();
+    return true ;
+}
+
+bool TestIncrementalSave::loadTemp(App *app, const QString &filePath)
+{
+    if(!app->mainWindow()->loadFile(filePath)) {
+        return error(QString("Opening file '%1'").arg(filePath));
+    }
+    return true ;
+}
+
+bool TestIncrementalSave::compareBytes(const QString &filePath, const QString &reference)
+{
+    QFile file(filePath);
+    QFile referenceFile(reference);
+    if(!file.open(QIODevice::ReadOnly) || !referenceFile.open(QIODevice::ReadOnly)) {
+        return error(QString("Unable to read files '%1', '%2'").arg(filePath).arg(reference));
+    }
+    const QByteArray data = file.readAll();
+    const QByteArray referenceData = referenceFile.readAll();
+    if(data != referenceData) {
+        return error(QString("Saved data differ from '%1'\n document is:\n%2\n reference is:\n%3\n---end\n")
+                     .arg(reference).arg(QString::fromUtf8(data)).arg(QString::fromUtf8(referenceData)));
+    }
+    return true ;
+}
+
+/*!
+ * \brief an edited element is serialized, the rest of the file is copied as it was written
+ */
+bool TestIncrementalSave::testEditAndSave()
+{
+    _testName = "testEditAndSave";
+    App app;
+    if(!app.init(true)) {
+        return error("init app");
+    }
+    Config::saveBool(Config::KEY_XML_SAVE_INCREMENTAL, true);
+    QTemporaryFile tempFile;
+    if(!copyToTemp(FILE_SOURCE, &tempFile)) {
+        return false;
+    }
+    const QString filePath = tempFile.fileName();
+    if(!loadTemp(&app, filePath)) {
+        return false;
+    }
+    Regola *regola = app.mainWindow()->getRegola();
+    regola->setIndentation(4);
+    if(NULL == regola->sourceMap()) {
+        return error("No source map after loading");
+    }
+    Element *root = regola->root();
+    if((NULL == root) || (root->getChildItemsRef().size() != 3)) {
+        return error("Unexpected document structure");
+    }
+    Element *third = root->getChildItemsRef().at(2);
+    if(!regola->sourceMap()->hasRange(third)) {
+        return error("No range for an element read");
+    }
+    third->setAttribute("y", "new");
+    if(!regola->write(filePath, true)) {
+        return error("Error writing the edited element");
+    }
+    if(NULL == regola->sourceMap()) {
+        return error("The save was not incremental");
+    }
+    if(!compareBytes(filePath, FILE_EDITED)) {
+        return false;
+    }
+    // nothing changed: the file is copied
+    if(!regola->write(filePath, true)) {
+        return error("Error writing without changes");
+    }
+    // the hash taken while writing is the one of the file
+    if(NULL == regola->sourceMap()) {
+        return error("The save after a save was not incremental");
+    }
+    if(!compareBytes(filePath, FILE_EDITED)) {
+        return false;
+    }
+    root->addChild(new Element("fourth", "", regola, root));
+    if(!regola->write(filePath, true)) {
+        return error("Error writing the added element");
+    }
+    if(NULL == regola->sourceMap()) {
+        return error("The save after an addition was not incremental");
+    }
+    if(!compareBytes(filePath, FILE_ADDED)) {
+        return false;
+    }
+    // the file changed by someone else: a complete save
+    QFile otherFile(filePath);
+    if(!otherFile.open(QIODevice::Append)) {
+        return error("Unable to modify the file");
+    }
+    otherFile.write("\n");
+    otherFile.close();
+    if(!regola->write(filePath, true)) {
+        return error("Error writing the changed file");
+    }
+    if(NULL != regola->sourceMap()) {
+        return error("The save of a file changed outside was incremental");
+    }
+    return true ;
+}
+
+/*!
+ * \brief a file rewritten outside with the same size and the same modification time is not reused
+ */
+bool TestIncrementalSave::testSameSizeRewrite()
+{
+    _testName = "testSameSizeRewrite";
+    App app;
+    if(!app.init(true)) {
+        return error("init app");
+    }
+    Config::saveBool(Config::KEY_XML_SAVE_INCREMENTAL, true);
+    QTemporaryFile tempFile;
+    if(!copyToTemp(FILE_SOURCE, &tempFile)) {
+        return false;
+    }
+    const QString filePath = tempFile.fileName();
+    if(!loadTemp(&app, filePath)) {
+        return false;
+    }
+    Regola *regola = app.mainWindow()->getRegola();
+    if(NULL == regola->sourceMap()) {
+        return error("No source map after loading");
+    }
+    const QDateTime modified = QFileInfo(filePath).lastModified();
+    QFile otherFile(filePath);
+    if(!otherFile.open(QIODevice::ReadWrite)) {
+        return error("Unable to modify the file");
+    }
+    QByteArray data = otherFile.readAll();
+    const int index = data.indexOf("'old'");
+    if(index < 0) {
+        otherFile.close();
+        return error("Unexpected source data");
+    }
+    data.replace(index, 5, "'OLD'");
+    otherFile.seek(0);
+    otherFile.write(data);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    otherFile.setFileTime(modified, QFileDevice::FileModificationTime);
+#endif
+    otherFile.close();
+    if(QFileInfo(filePath).size() != data.size()) {
+        return error("The size of the file changed");
+    }
+    Element *root = regola->root();
+    root->getChildItemsRef().at(2)->setAttribute("y", "new");
+    if(!regola->write(filePath, true)) {
+        return error("Error writing the rewritten file");
+    }
+    if(NULL != regola->sourceMap()) {
+        return error("The save of a file rewritten with the same size was incremental");
+    }
+    return true ;
+}
+
+bool TestIncrementalSave::testDisabled()
+{
+    _testName = "testDisabled";
+    App app;
+    if(!app.init(true)) {
+        return error("init app");
+    }
+    Config::saveBool(Config::KEY_XML_SAVE_INCREMENTAL, false);
+    QTemporaryFile tempFile;
+    if(!copyToTemp(FILE_SOURCE, &tempFile)) {
+        return false;
+    }
+    if(!loadTemp(&app, tempFile.fileName())) {
+        return false;
+    }
+    if(NULL != app.mainWindow()->getRegola()->sourceMap()) {
+        return error("Source map present with the option disabled");
+    }
+    return true ;
+}
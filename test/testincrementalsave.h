@@ -0,0 +1,49 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+
+#ifndef TESTINCREMENTALSAVE_H
+#define TESTINCREMENTALSAVE_H
+
+#include "testbase.h"
+
+class App;
+class QTemporaryFile;
+
+class TestIncrementalSave : public TestBase
+{
+    bool copyToTemp(const QString &source, QTemporaryFile *tempFile);
+    bool loadTemp(App *app, const QString &filePath);
+    bool compareBytes(const QString &filePath, const QString &reference);
+    bool testEditAndSave();
+    bool testSameSizeRewrite();
+    bool testDisabled();
+
+public:
+    TestIncrementalSave();
+    ~TestIncrementalSave();
+
+    bool testUnitTests();
+};
+
+#endif // TESTINCREMENTALSAVE_H
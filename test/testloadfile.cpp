@@ -26,6 +26,7 @@
 #include "testhelpers/testmainwindow.h"
 #include "modules/xml/xmlerrormanagerdialog.h"
 #include "modules/xml/xmlloadcontext.h"
+#include "modules/xml/xmlbackgroundloader.h"
 
 #define TEST_DATA TEST_BASE_DATA "/xml/loading/"
 
@@ -60,6 +61,9 @@ bool TestLoadFile::testUnit()
     if(!testLoadWithModifications()) {
         return false;
     }
+    if(!testBackgroundLoad()) {
+        return false;
+    }
 #if QT_VERSION >= QT_VERSION_CHECK(5,7,1)
     if(!testVerifyLoad1()) {
         return false;
@@ -109,6 +113,63 @@ bool TestLoadFile::loadFileKO()
     return true ;
 }
 
+/** \brief the model built in the worker thread is complete, an aborted load keeps the first part of the document
+  */
+bool TestLoadFile::testBackgroundLoad()
+{
+    _testName = "testBackgroundLoad";
+    const int items = 3 * XMLLoadContext::ProgressTokens ;
+    QByteArray data("<?xml version='1.0' encoding='UTF-8'?>\n<root>");
+    for(int i = 0 ; i < items ; i ++) {
+        data.append(QString("<item a='%1'>text %1</item>").arg(i).toUtf8());
+    }
+    data.append("</root>");
+    {
+        QBuffer buffer(&data);
+        if(!buffer.open(QIODevice::ReadOnly)) {
+            return error("opening data");
+        }
+        QXmlStreamReader reader(&buffer);
+        if(!XMLBackgroundLoader::isBackgroundLoad(&reader, data.size()) || XMLBackgroundLoader::isBackgroundLoad(&reader, data.size() + 1)) {
+            return error("threshold");
+        }
+        XMLLoadContext context;
+        Regola regola("background");
+        XMLBackgroundLoader loader(&regola, &context, &reader);
+        if(!loader.load(NULL, "background")) {
+            return error(QString("background load: %1").arg(context.errorMessage()));
+        }
+        Element *root = regola.root();
+        if((NULL == root) || (root->getChildItemsCount() != items)) {
+            return error("background load: wrong model");
+        }
+        if(root->getChildAt(items - 1)->getAttributeValue("a") != QString::number(items - 1)) {
+            return error("background load: wrong last item");
+        }
+    }
+    {
+        QBuffer buffer(&data);
+        if(!buffer.open(QIODevice::ReadOnly)) {
+            return error("opening data");
+        }
+        QXmlStreamReader reader(&buffer);
+        XMLLoadContext context;
+        context.setAborted();
+        Regola regola("aborted");
+        if(regola.readFromStream(&context, &reader)) {
+            return error("aborted load succeeded");
+        }
+        if(!context.isAborted() || !context.isError()) {
+            return error("abort not reported");
+        }
+        Element *root = regola.root();
+        if((NULL == root) || (root->getChildItemsCount() <= 0) || (root->getChildItemsCount() >= items)) {
+            return error("aborted load: partial model not kept");
+        }
+    }
+    return true ;
+}
+
 bool TestLoadFile::testVerifyLoad1()
 {
     _testName = "testVerifyLoad1";
@@ -42,6 +42,7 @@ class TestLoadFile : public TestBase, XMLLoadErrorHandler
     bool testVerifyLoad1();
     bool testVerifyLoad2();
     bool testLoadWithModifications();
+    bool testBackgroundLoad();
     bool loadDrop();
     bool loadReload();
     bool loadSession();
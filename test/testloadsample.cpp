@@ -22,6 +22,7 @@
 
 #include "testloadsample.h"
 #include "app.h"
+#include "modules/xml/xmlloadcontext.h"
 
 #define BASE_PATH "../test/data/xml/loadsample/"
 #define FILE_ERROR  BASE_PATH "error.xml"
@@ -106,6 +107,9 @@ bool TestLoadSample::testUnit()
     if(!testLoadSumAllNS()) {
         return false;
     }
+    if(!testLoadStopUnchanged()) {
+        return false;
+    }
     return true;
 }
 
@@ -285,3 +289,57 @@ bool TestLoadSample::testLoadSumAllNS()
     }
     return true;
 }
+
+bool TestLoadSample::loadSampleStop(const int stopUnchanged, const QString &expectedTags, const QString &expectedAttributes)
+{
+    QByteArray data("<root><a x='1'><c/></a><a><c/></a><a y='2'/><a/><a/><b/></root>");
+    QBuffer buffer(&data);
+    if(!buffer.open(QIODevice::ReadOnly)) {
+        return error("opening data");
+    }
+    QXmlStreamReader reader(&buffer);
+    XMLLoadContext context;
+    context.setSample(true);
+    context.setSampleStopUnchanged(stopUnchanged);
+    Regola regola("sample");
+    if(!regola.readFromStream(&context, &reader)) {
+        return error(QString("stop:%1 load: %2").arg(stopUnchanged).arg(context.errorMessage()));
+    }
+    Element *root = regola.root();
+    if(NULL == root) {
+        return error(QString("stop:%1 no root").arg(stopUnchanged));
+    }
+    QStringList tags;
+    foreach(Element * child, *root->getChildItems()) {
+        tags.append(child->tag());
+    }
+    if(tags.join(",") != expectedTags) {
+        return error(QString("stop:%1 tags expected '%2' found '%3'").arg(stopUnchanged).arg(expectedTags).arg(tags.join(",")));
+    }
+    QStringList attributes;
+    foreach(Attribute * attribute, root->getChildAt(0)->attributes) {
+        attributes.append(attribute->name);
+    }
+    if(attributes.join(",") != expectedAttributes) {
+        return error(QString("stop:%1 attributes expected '%2' found '%3'").arg(stopUnchanged).arg(expectedAttributes).arg(attributes.join(",")));
+    }
+    return true;
+}
+
+bool TestLoadSample::testLoadStopUnchanged()
+{
+    _subTestName = "testLoadStopUnchanged";
+    // all the file
+    if(!loadSampleStop(0, "a,b", "x,y")) {
+        return false;
+    }
+    // the attribute y restarts the count
+    if(!loadSampleStop(3, "a,b", "x,y")) {
+        return false;
+    }
+    // stops before the attribute y
+    if(!loadSampleStop(2, "a", "x")) {
+        return false;
+    }
+    return true;
+}
@@ -39,6 +39,8 @@ class TestLoadSample : public TestBase
     bool testLoadProcessingInstruction();
     bool testLoadSumAll();
     bool testLoadSumAllNS();
+    bool testLoadStopUnchanged();
+    bool loadSampleStop(const int stopUnchanged, const QString &expectedTags, const QString &expectedAttributes);
 
     //
     bool testAFile(const bool isLoad,
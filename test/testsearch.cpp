@@ -25,6 +25,7 @@
 #include "app.h"
 #include "findtextparams.h"
 #include "modules/search/searchxquery.h"
+#include "modules/search/textsearchindex.h"
 
 #define FILE_SEARCH "../test/data/search/base.xml"
 #define FILE_SEARCH_XQUERY "../test/data/search/base_xquery.xml"
@@ -503,6 +504,201 @@ bool TestSearch::literalSearchInTextBase64()
     return checkResultsByPath(helper, 2, 2, results);
 }
 
+/** \brief the search examining the subtrees in parallel must find what the sequential one finds, in the same order
+  */
+class SequentialFindTextParams : public FindTextParams
+{
+public:
+    virtual bool canSearchInParallel() const
+    {
+        return false;
+    }
+};
+
+bool TestSearch::literalSearchParallel()
+{
+    TestSearchHelper helper;
+    if(!testAStdSearchWithParamsInit("literalSearchParallel", helper)) {
+        return error("init");
+    }
+    if(!literalSearchParallelCompare(helper, "a", FindTextParams::FIND_ALL)) {
+        return false;
+    }
+    if(!literalSearchParallelCompare(helper, "TEXT", FindTextParams::FIND_TEXT)) {
+        return false;
+    }
+    if(!literalSearchParallelCompare(helper, "text not exact", FindTextParams::FIND_TEXT_BASE64)) {
+        return false;
+    }
+    // the second time the decoded texts come from the cache
+    if(!literalSearchParallelCompare(helper, "text not exact", FindTextParams::FIND_TEXT_BASE64)) {
+        return false;
+    }
+    return true;
+}
+
+bool TestSearch::literalSearchParallelCompare(TestSearchHelper &helper, const QString &textToSearch, const FindTextParams::EFindTarget target)
+{
+    Regola *regola = helper.app.mainWindow()->getRegola();
+    QList<Element*> parallelSelection;
+    FindTextParams parallelArgs;
+    parallelArgs.init(FindTextParams::FindAllOccurrences, textToSearch, false, false, false, false, target,
+                      false, true, true, "", false, false, &parallelSelection);
+    regola->findText(parallelArgs, NULL);
+    QList<Element*> sequentialSelection;
+    SequentialFindTextParams sequentialArgs;
+    sequentialArgs.init(FindTextParams::FindAllOccurrences, textToSearch, false, false, false, false, target,
+                        false, true, true, "", false, false, &sequentialSelection);
+    regola->findText(sequentialArgs, NULL);
+    if((parallelArgs.getOccurrences() == 0) || (parallelArgs.getOccurrences() != sequentialArgs.getOccurrences())
+            || (parallelArgs.size() != sequentialArgs.size())) {
+        return error(QString("search '%1': occurrences %2 vs %3").arg(textToSearch)
+                     .arg(parallelArgs.getOccurrences()).arg(sequentialArgs.getOccurrences()));
+    }
+    if(parallelSelection != sequentialSelection) {
+        return error(QString("search '%1': selection differs").arg(textToSearch));
+    }
+    return true;
+}
+
+bool TestSearch::literalSearchIndexed()
+{
+    TestSearchHelper helper;
+    if(!testAStdSearchWithParamsInit("literalSearchIndexed", helper)) {
+        return error("init");
+    }
+    Regola *regola = helper.app.mainWindow()->getRegola();
+    regola->setTextIndexEnabled(true);
+    TextSearchIndex *index = regola->textIndex();
+    index->rebuild();
+    if(!index->isReady()) {
+        return error("index not ready");
+    }
+    if(!literalSearchIndexedCompare(helper, "hzz", false, FindTextParams::FIND_ALL, true)) {
+        return false;
+    }
+    if(!literalSearchIndexedCompare(helper, "PPP", true, FindTextParams::FIND_TAG, true)) {
+        return false;
+    }
+    if(!literalSearchIndexedCompare(helper, "data aaaabc", false, FindTextParams::FIND_TEXT, true)) {
+        return false;
+    }
+    // base 64 texts are not indexed
+    if(!literalSearchIndexedCompare(helper, "text not exact", false, FindTextParams::FIND_TEXT_BASE64, false)) {
+        return false;
+    }
+    Element *three = NULL ;
+    foreach(Element * element, *regola->root()->getChildItems()) {
+        if(element->tag() == "three") {
+            three = element ;
+        }
+    }
+    if(NULL == three) {
+        return error("element not found");
+    }
+    // every modification invalidates the index and the search is done by a scan until it is built again
+    Element *edited = three->getChildItems()->last();
+    edited->getAttribute("a")->value = "qqqwww";
+    edited->markEdited();
+    regola->setModified(true);
+    if(!literalSearchIndexedCompare(helper, "qqqw", false, FindTextParams::FIND_ATTRIBUTE_VALUE, false)) {
+        return false;
+    }
+    index->rebuild();
+    if(!literalSearchIndexedCompare(helper, "qqqw", false, FindTextParams::FIND_ATTRIBUTE_VALUE, true)) {
+        return false;
+    }
+    // a modification of several elements at once, as a paste: a new subtree and an edit
+    Element *pasted = new Element("sssttt", "", regola, NULL);
+    pasted->addAttribute("a", "sssuuu");
+    Element *pastedChild = new Element("sssvvv", "", regola, NULL);
+    pastedChild->addAttribute("a", "sssuuu");
+    pasted->addChild(pastedChild);
+    three->addChild(pasted);
+    edited->getAttribute("a")->value = "rrrsss";
+    regola->setModified(true);
+    if(!literalSearchIndexedCompare(helper, "sssu", false, FindTextParams::FIND_ATTRIBUTE_VALUE, false)) {
+        return false;
+    }
+    if(!literalSearchIndexedCompare(helper, "rrrs", false, FindTextParams::FIND_ATTRIBUTE_VALUE, false)) {
+        return false;
+    }
+    index->rebuild();
+    if(!literalSearchIndexedCompare(helper, "sssu", false, FindTextParams::FIND_ATTRIBUTE_VALUE, true)) {
+        return false;
+    }
+    if(!literalSearchIndexedCompare(helper, "sssv", false, FindTextParams::FIND_TAG, true)) {
+        return false;
+    }
+    // the edit of the attribute is not returned anymore, the new value is
+    if(!literalSearchIndexedCompare(helper, "rrrs", false, FindTextParams::FIND_ATTRIBUTE_VALUE, true)) {
+        return false;
+    }
+    pasted->autoDelete(true);
+    // an undoable delete invalidates the index, as the undo does
+    edited = three->getChildItems()->last();
+    if(!regola->deleteElement(edited)) {
+        return error("delete");
+    }
+    if(!literalSearchIndexedCompare(helper, "ppp", true, FindTextParams::FIND_ATTRIBUTE_VALUE, false)) {
+        return false;
+    }
+    index->rebuild();
+    if(!literalSearchIndexedCompare(helper, "ppp", true, FindTextParams::FIND_ATTRIBUTE_VALUE, true)) {
+        return false;
+    }
+    regola->undo();
+    if(!literalSearchIndexedCompare(helper, "rrrs", false, FindTextParams::FIND_ATTRIBUTE_VALUE, false)) {
+        return false;
+    }
+    index->rebuild();
+    if(!literalSearchIndexedCompare(helper, "rrrs", false, FindTextParams::FIND_ATTRIBUTE_VALUE, true)) {
+        return false;
+    }
+    edited = three->getChildItems()->last();
+    if(edited->getAttributeValue("a") != "rrrsss") {
+        return error("undo not restored the element");
+    }
+    // an element removed is not returned anymore
+    edited->autoDelete(true);
+    index->rebuild();
+    if(!literalSearchIndexedCompare(helper, "ppp", true, FindTextParams::FIND_ATTRIBUTE_VALUE, true)) {
+        return false;
+    }
+    return true;
+}
+
+bool TestSearch::literalSearchIndexedCompare(TestSearchHelper &helper, const QString &textToSearch, const bool isExact,
+        const FindTextParams::EFindTarget target, const bool isAnsweredByIndex)
+{
+    Regola *regola = helper.app.mainWindow()->getRegola();
+    TextSearchIndex *index = regola->textIndex();
+    const int answeredBefore = index->answeredQueries();
+    QList<Element*> indexedSelection;
+    FindTextParams indexedArgs;
+    indexedArgs.init(FindTextParams::FindAllOccurrences, textToSearch, false, isExact, false, false, target,
+                     false, true, true, "", false, false, &indexedSelection);
+    regola->findText(indexedArgs, NULL);
+    if((index->answeredQueries() > answeredBefore) != isAnsweredByIndex) {
+        return error(QString("search '%1': answered by index %2, expected %3").arg(textToSearch)
+                     .arg(index->answeredQueries() > answeredBefore).arg(isAnsweredByIndex));
+    }
+    QList<Element*> sequentialSelection;
+    SequentialFindTextParams sequentialArgs;
+    sequentialArgs.init(FindTextParams::FindAllOccurrences, textToSearch, false, isExact, false, false, target,
+                        false, true, true, "", false, false, &sequentialSelection);
+    regola->findText(sequentialArgs, NULL);
+    if((indexedArgs.getOccurrences() == 0) || (indexedArgs.getOccurrences() != sequentialArgs.getOccurrences())
+            || (indexedArgs.size() != sequentialArgs.size())) {
+        return error(QString("search '%1': occurrences %2 vs %3").arg(textToSearch)
+                     .arg(indexedArgs.getOccurrences()).arg(sequentialArgs.getOccurrences()));
+    }
+    if(indexedSelection != sequentialSelection) {
+        return error(QString("search '%1': selection differs").arg(textToSearch));
+    }
+    return true;
+}
+
 bool TestSearch::literalSearchInScopedPath()
 {
     TestSearchHelper helper;
@@ -980,6 +1176,12 @@ bool TestSearch::testLiteralSearch()
     if(!literalSearchInTextBase64()) {
         return false;
     }
+    if(!literalSearchParallel()) {
+        return false;
+    }
+    if(!literalSearchIndexed()) {
+        return false;
+    }
 
     //----------------------------------------
     if(!literalSearchNext()) {
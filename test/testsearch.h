@@ -25,6 +25,7 @@
 #define TESTSEARCH_H
 
 #include "testbase.h"
+#include "findtextparams.h"
 
 class TestSearchHelper ;
 
@@ -47,6 +48,11 @@ class TestSearch : public TestBase
     bool literalSearchInText();
     bool literalSearchInComment();
     bool literalSearchInTextBase64();
+    bool literalSearchParallel();
+    bool literalSearchParallelCompare(TestSearchHelper &helper, const QString &textToSearch, const FindTextParams::EFindTarget target);
+    bool literalSearchIndexed();
+    bool literalSearchIndexedCompare(TestSearchHelper &helper, const QString &textToSearch, const bool isExact,
+                                     const FindTextParams::EFindTarget target, const bool isAnsweredByIndex);
 
     //-----------------------------------------------------------
     bool xquerySearchPathExact();
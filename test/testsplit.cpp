@@ -81,6 +81,7 @@
 TestSplit::TestSplit()
 {
     _showXML = false ;
+    _scriptingThreads = 1 ;
 }
 
 TestSplit::~TestSplit()
@@ -52,6 +52,7 @@ class TestSplit : public TestBase
 {
     QString _lastTimeStamp;
     bool _showXML;
+    int _scriptingThreads;
 
     //---------
     bool testUnitOperation();
@@ -105,6 +106,8 @@ class TestSplit : public TestBase
     bool unitTestFilterEventElement();
     bool unitTestFilterEventElementAccessibility();
     bool unitTestFilterEventElementMultipleEvents();
+    bool unitTestFilterEventElementReuse();
+    bool unitTestFilterEventWrappers();
     bool unitTestOperationBase();
     bool checkElementEventBase(const int code, ExtractionScriptElementEvent *elementEvent, QList<QPair<QString,QString> > inputAttributes, const bool expectedModified);
     bool checkElementEventWithEngine(const int code, QJSEngine &engine, ExtractionScriptElementEvent *elementEvent, QList<QPair<QString,QString> > inputAttributes, const bool expectedModified, const QString &expectedVariableValue);
@@ -126,6 +129,9 @@ class TestSplit : public TestBase
     bool testScriptWithPredefinedScripting();
     bool testScriptWithPredefinedScriptingSplit();
     bool testScriptWithPredefinedScriptingFilter();
+    bool testScriptWithPredefinedScriptingParallel();
+    bool testScriptParallelGlobals();
+    bool runScriptParallelGlobals(const int threads, QStringList &results);
     bool testPredefinedScriptTrimAttributesNoNsSplit();
     bool testPredefinedScriptTrimAttributesNsSplit();
     bool testPredefinedScriptRemoveEmptyAttributesNoNsSplit();
@@ -26,6 +26,7 @@
 #include "modules/graph/nodesrelationsdialog.h"
 #include "modules/graph/tagnodes.h"
 #include "modules/graph/tagmarker.h"
+#include "modules/graph/tagforces.h"
 #include "utils.h"
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -310,6 +311,54 @@ bool TestSpringAndForces::testUnitForces()
     if( !testLoadSampleData()) {
         return false;
     }
+    if( !testForcesApproximation()) {
+        return false;
+    }
 
     return true;
 }
+
+/**
+  \brief the quadtree and the parallel computation must give the same forces
+   of the pairwise one, within the error of the approximation
+  */
+bool TestSpringAndForces::testForcesApproximation()
+{
+    _testName = "testForcesApproximation";
+    const int count = 3000 ;
+    QVector<TagForces::Body> exact(count);
+    uint seed = 17;
+    for(int i = 0 ; i < count ; i ++) {
+        seed = seed * 1103515245U + 12345U;
+        exact[i].x = (seed >> 8) % 2000 ;
+        seed = seed * 1103515245U + 12345U;
+        exact[i].y = (seed >> 8) % 1200 ;
+    }
+    QVector<TagForces::Body> serial = exact;
+    QVector<TagForces::Body> approx = exact;
+
+    TagForces forces;
+    forces.setParallel(true);
+    forces.computeExact(exact);
+    forces.setParallel(false);
+    forces.computeExact(serial);
+    for(int i = 0 ; i < count ; i ++) {
+        if((exact[i].fx != serial[i].fx) || (exact[i].fy != serial[i].fy)) {
+            return error(QString("parallel differs from serial at %1").arg(i));
+        }
+    }
+    forces.setParallel(true);
+    forces.compute(approx);
+    double totalError = 0 ;
+    double totalForce = 0 ;
+    for(int i = 0 ; i < count ; i ++) {
+        const double ex = approx[i].fx - exact[i].fx ;
+        const double ey = approx[i].fy - exact[i].fy ;
+        totalError += sqrt(ex * ex + ey * ey);
+        totalForce += sqrt(exact[i].fx * exact[i].fx + exact[i].fy * exact[i].fy);
+    }
+    if(totalError > (totalForce * 0.05)) {
+        return error(QString("approximation error too big: %1 over %2").arg(totalError).arg(totalForce));
+    }
+    return true ;
+}
@@ -36,6 +36,7 @@ class TestSpringAndForces : public TestBase
     bool checkTestUnitForces2(TagMarker *tag, const double expected, const int number, int x0, int y0);
     bool likeAngle( const double angle, const double expected );
     bool testLoadSampleData();
+    bool testForcesApproximation();
 
     bool rowIs(QTableWidget *table, const int row, const QString &name);
     bool checkRow(QTableWidget *table, const int row, const QString &countCol, const QString &percentCol, const QString &incomingLinksCol,
@@ -710,3 +710,54 @@ bool TestSQLAccess::deleteByDateIntervalInternal(const QString &sqlTimeData, con
 
     return isOk;
 }
+
+//--------------------------------------------------------------------------------
+
+/** \brief 10 files, 10 accesses each, written by the database thread
+  */
+bool TestSQLAccess::testWriteBehind()
+{
+    SQLLiteTestAccess access;
+    if(!access.init()) {
+        return error("init");
+    }
+    if(!access.access->isWriteBehind()) {
+        return error("write behind not active");
+    }
+    SessionOperationStatus status;
+    SessionModel sessionModel;
+    sessionModel.name = "test1";
+    sessionModel.description = "testdescr1";
+    if(!access.access->newSession(status, &sessionModel)) {
+        return error("new session");
+    }
+    SessionOperationStatus context;
+    for(int i = 0 ; i < 100 ; i ++) {
+        if(!access.access->enrollFile(context, &sessionModel, QString("/wb/%1").arg(i % 10))) {
+            return error(QString("enroll %1").arg(i));
+        }
+    }
+    SessionModel wrongSession;
+    wrongSession.id = sessionModel.id + 1000 ;
+    if(access.access->enrollFile(context, &wrongSession, "/wb/wrong")) {
+        return error("enroll with wrong session");
+    }
+    if(!access.access->flushPendingWrites()) {
+        return error("flush");
+    }
+    if(!access.access->readSessionData(context, &sessionModel)) {
+        return error("read");
+    }
+    if(sessionModel.accesses.size() != 100) {
+        return error(QString("accesses expected 100, found %1").arg(sessionModel.accesses.size()));
+    }
+    if(sessionModel.files.size() != 10) {
+        return error(QString("files expected 10, found %1").arg(sessionModel.files.size()));
+    }
+    foreach(FileModel * file, sessionModel.files) {
+        if(file->accesses.size() != 10) {
+            return error(QString("file %1 accesses %2").arg(file->path).arg(file->accesses.size()));
+        }
+    }
+    return true;
+}
@@ -58,6 +58,8 @@ public:
     bool deleteByDate1MonthFiles();
     bool deleteByDate6MonthsFiles();
     bool deleteByGivenDateFiles();
+    //--------------------
+    bool testWriteBehind();
 
 };
 
@@ -24,6 +24,7 @@
 #include "style.h"
 #include "stylepersistence.h"
 #include "app.h"
+#include <QDir>
 
 //----------------------------------------
 #define TEST_FILE_STYLE "../test/data/style/test_load_style.style"
@@ -820,3 +821,42 @@ bool TestStyle::testCalcStyle()
 
 }
 
+bool TestStyle::testLazyStyles()
+{
+    _testName = "testLazyStyles";
+    QDir dir(FILE_STYLE_BASE);
+    dir.setFilter(QDir::Files);
+    dir.setNameFilters(QStringList() << "*.style");
+    const int expectedCount = dir.entryList().size();
+
+    StylePersistence persistence;
+    QVector<VStyle*> styles;
+    bool isOk = true ;
+    if(!persistence.scanDirectory(FILE_STYLE_BASE, &styles)) {
+        isOk = error(QString("error scanning style directory %1").arg(FILE_STYLE_BASE));
+    } else if(styles.size() != expectedCount) {
+        isOk = error(QString("Expecting %1 styles, found %2").arg(expectedCount).arg(styles.size()));
+    }
+    bool rulesFound = false;
+    foreach(VStyle * style, styles) {
+        if(!isOk) {
+            break;
+        }
+        if(style->name() != "Log") {
+            isOk = error(QString("Header not read, name is '%1'").arg(style->name()));
+        } else if(!style->ruleSets().isEmpty()) {
+            isOk = error(QString("Rules read before the first use"));
+        } else if(!style->initFromResources()) {
+            isOk = error(QString("Style not read on first use"));
+        } else if(!style->ruleSets().isEmpty()) {
+            rulesFound = true ;
+        }
+    }
+    if(isOk && !rulesFound) {
+        isOk = error(QString("No rules read on first use"));
+    }
+    foreach(VStyle * style, styles) {
+        delete style;
+    }
+    return isOk;
+}
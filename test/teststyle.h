@@ -57,6 +57,7 @@ public:
 
     bool testLoadCalcStyle();
     bool testCalcStyle();
+    bool testLazyStyles();
 };
 
 #endif // TESTSTYLE_H
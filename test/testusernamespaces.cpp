@@ -356,6 +356,106 @@ bool TestUserNamespaces::testVisibility()
             return false;
         }
     }
+    if(!testVisibilityAfterEdit()) {
+        return false;
+    }
+    if(!testVisibilityAfterMove()) {
+        return false;
+    }
+    return true;
+}
+
+/*!
+ * \brief an element moved to another document resolves the namespaces of the new one,
+ * even when the generations of the scopes of the two documents are the same
+ */
+bool TestUserNamespaces::testVisibilityAfterMove()
+{
+    _testName = "testVisibility/AfterMove";
+    App app;
+    if(!app.init() ) {
+        return error("init app failed");
+    }
+    QDomDocument documentFrom;
+    QDomDocument documentTo;
+    if(!documentFrom.setContent(QString("<a xmlns:p='urn:from'><p:x/></a>"))
+            || !documentTo.setContent(QString("<b xmlns:p='urn:to'><c/></b>"))) {
+        return error("unable to parse the documents");
+    }
+    Regola *regolaFrom = new Regola(documentFrom, "");
+    Regola regolaTo(documentTo, "");
+    // the scope of the element is taken with a generation reachable by the other document
+    for(int i = 0 ; i < 100 ; i ++) {
+        regolaFrom->namespaceScopes()->invalidate();
+    }
+    Element *element = regolaFrom->root()->getChildAt(0);
+    if(element->namespaceForPrefix("p") != "urn:from") {
+        delete regolaFrom;
+        return error(QString("before the move, found:'%1'").arg(element->namespaceForPrefix("p")));
+    }
+    const int generation = regolaFrom->namespaceScopes()->generation();
+    QVector<Element*> &items = regolaFrom->root()->getChildItemsRef();
+    items.remove(items.indexOf(element));
+    element->setRegola(&regolaTo, true);
+    regolaTo.root()->addChild(element);
+    // the scopes of the old document are freed
+    delete regolaFrom;
+    while(regolaTo.namespaceScopes()->generation() < generation) {
+        regolaTo.namespaceScopes()->invalidate();
+    }
+    if(regolaTo.namespaceScopes()->generation() != generation) {
+        return error(QString("unexpected generation %1, expected %2").arg(regolaTo.namespaceScopes()->generation()).arg(generation));
+    }
+    if(element->namespaceForPrefix("p") != "urn:to") {
+        return error(QString("after the move, found:'%1'").arg(element->namespaceForPrefix("p")));
+    }
+    return true;
+}
 
+// the shared scopes follow the changes of the declarations
+bool TestUserNamespaces::testVisibilityAfterEdit()
+{
+    _testName = "testVisibility/AfterEdit";
+    App app;
+    if(!app.init() ) {
+        return error("init app failed");
+    }
+    if( !app.mainWindow()->loadFile(NS_FILE_SHADOWED) ) {
+        return error(QString("unable to load input file: '%1' ").arg(NS_FILE_SHADOWED));
+    }
+    QList<int> sel;
+    sel << 1 << 0 << 0 ;
+    Element *selectedElement = app.mainWindow()->getRegola()->findElementByArray(sel);
+    if(NULL == selectedElement) {
+        return error("no selected element");
+    }
+    if(selectedElement->namespaceForPrefix("a") != "bbb") {
+        return error(QString("prefix a, found:'%1'").arg(selectedElement->namespaceForPrefix("a")));
+    }
+    QString prefix ;
+    if(selectedElement->findPrefixForNamespace("xyx", prefix)) {
+        return error(QString("shadowed namespace found with prefix:'%1'").arg(prefix));
+    }
+    if(!selectedElement->findPrefixForNamespace("123", prefix) || (prefix != "b")) {
+        return error(QString("prefix for namespace 123, found:'%1'").arg(prefix));
+    }
+    Element *child = selectedElement->getChildAt(0);
+    if(NULL == child) {
+        return error("no child");
+    }
+    if(child->namespaceScope() == selectedElement->namespaceScope()) {
+        return error("the declaring child shares the scope of the parent");
+    }
+    selectedElement->addAttribute("xmlns:z", "zzz");
+    QHash<QString,QString> expected;
+    expected.insert("", "abc");
+    expected.insert("a", "bbb");
+    expected.insert("b", "123");
+    expected.insert("z", "zzz");
+    expected.insert("k", "kk");
+    QHash<QString,QString> found = child->findVisibleNamespaces();
+    if(!testHash(expected, found)) {
+        return false;
+    }
     return true;
 }
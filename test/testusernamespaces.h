@@ -45,6 +45,8 @@ public:
     bool testFast();
     bool testSerialization();
     bool testVisibility();
+    bool testVisibilityAfterEdit();
+    bool testVisibilityAfterMove();
 };
 
 #endif // TESTUSERNAMESPACES_H
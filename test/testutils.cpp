@@ -22,6 +22,12 @@
 
 #include "testutils.h"
 #include "utils.h"
+#include "modules/utils/perftrace.h"
+#if QT_VERSION >= QT_VERSION_CHECK(5,0,0)
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#endif
 
 TestUtils::TestUtils()
 {
@@ -47,6 +53,9 @@ bool TestUtils::testUnit()
     if(!testNormalizeFileName()) {
         return false;
     }
+    if(!testPerfTrace()) {
+        return false;
+    }
     return true ;
 }
 
@@ -101,3 +110,45 @@ bool TestUtils::testRFC4288()
     }
     return true ;
 }
+
+bool TestUtils::testPerfTrace()
+{
+    _testName = "testPerfTrace" ;
+    const bool wasEnabled = PerfTrace::isEnabled();
+    PerfTrace::setEnabled(false);
+    PerfTrace::clear();
+    {
+        QXMLEDIT_TRACE_ZONE("test", "disabled");
+        QXMLEDIT_TRACE_COUNTER("test.disabled", 1);
+    }
+    if((0 != PerfTrace::eventsCount()) || !PerfTrace::counters().isEmpty()) {
+        PerfTrace::setEnabled(wasEnabled);
+        return error("events recorded with the trace disabled");
+    }
+    PerfTrace::setEnabled(true);
+    for(int i = 0 ; i < 3 ; i ++) {
+        QXMLEDIT_TRACE_ZONE("test", "zone");
+        QXMLEDIT_TRACE_COUNTER("test.counter", 2);
+    }
+    PerfTrace::setEnabled(wasEnabled);
+    QList<PerfTraceSummary> summary = PerfTrace::summary();
+    if((1 != summary.size()) || (3 != summary.first().count) || (summary.first().name != "zone")) {
+        return error(QString("summary: found %1 items").arg(summary.size()));
+    }
+    if(6 != PerfTrace::counters().value("test.counter")) {
+        return error(QString("counter: found %1").arg(PerfTrace::counters().value("test.counter")));
+    }
+#if QT_VERSION >= QT_VERSION_CHECK(5,0,0)
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(PerfTrace::toChromeTrace(), &parseError);
+    if(QJsonParseError::NoError != parseError.error) {
+        return error(QString("trace JSON: %1").arg(parseError.errorString()));
+    }
+    const int traceEvents = document.object().value("traceEvents").toArray().size();
+    if(4 != traceEvents) {
+        return error(QString("trace JSON events: expected 4, found %1").arg(traceEvents));
+    }
+#endif
+    PerfTrace::clear();
+    return true ;
+}
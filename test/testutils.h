@@ -32,6 +32,7 @@ class TestUtils : public TestBase
     bool testNormalizeFileName(const QString &src, const QString &expected);
     bool testNormalizeFileName();
     bool iTestRFC4288(const QString &name, const bool expected);
+    bool testPerfTrace();
 public:
     TestUtils();
     ~TestUtils();
@@ -25,6 +25,9 @@
 #include "visualization/vismapdialog.h"
 #include "modules/graph/nodesrelationsdialog.h"
 #include "visualization/datawidget.h"
+#include "visualization/vismapgrid.h"
+#include "visualization/fileanalysiscache.h"
+#include <QTemporaryFile>
 
 #define BASE_PATH_ATTR "../test/data/vis/attributes/"
 
@@ -281,6 +284,235 @@ bool TestVis::testVisData()
     if( ! testDataThreading(false) ) {
         return false;
     }
+    if( ! testDataTables() ) {
+        return false;
+    }
+    if( ! testStreamingMap() ) {
+        return false;
+    }
+    if( ! testFileAnalysisCache() ) {
+        return false;
+    }
+    return true;
+}
+
+/** \brief a file scanned by the map is shown again and by the graph without a new scan,
+  * until it changes
+  */
+bool TestVis::testFileAnalysisCache()
+{
+    _testName = "testFileAnalysisCache" ;
+    App app;
+    if(!app.init() ) {
+        return error("init");
+    }
+    QFile source(DATA_FILE_1);
+    if(!source.open(QFile::ReadOnly)) {
+        return error("reading source");
+    }
+    QByteArray data = source.readAll();
+    source.close();
+    QTemporaryFile file;
+    if(!file.open() || (file.write(data) != data.size()) || !file.flush()) {
+        return error("writing file");
+    }
+    file.close();
+    const QString filePath = file.fileName();
+    FileAnalysisCache::clear();
+
+    VisMapDialog first(app.data(), app.mainWindow(), app.mainWindow(), "");
+    first.loadFile(filePath);
+    QSharedPointer<FileAnalysis> analysis = FileAnalysisCache::find(filePath);
+    if(analysis.isNull() || (NULL == analysis->map()) || !analysis->hasTagNodes()) {
+        return error("analysis not cached");
+    }
+    VisMapDialog second(app.data(), app.mainWindow(), app.mainWindow(), "");
+    second.loadFile(filePath);
+    if((second._analysis != analysis) || (second._dataRoot != first._dataRoot)) {
+        return error("file scanned again");
+    }
+    if((first._summary.totalElements != second._summary.totalElements) || (first._summary.totalSize != second._summary.totalSize)
+            || (first._dataMap.rows.size() != second._dataMap.rows.size()) || (first._tagNodes.count() != second._tagNodes.count())) {
+        return error("cached map differs");
+    }
+    QString reason;
+    if(!first.attributesSummaryData()->compareTo(second.attributesSummaryData(), reason)) {
+        return error(QString("cached attributes differ: %1").arg(reason));
+    }
+    QList<TagNode*> nodesList ;
+    NodesRelationsDialog graph(false, nodesList, NULL);
+    if(!graph.loadFile(filePath)) {
+        return error("graph load");
+    }
+    if(graph.nodes.count() != first._tagNodes.count()) {
+        return error(QString("graph nodes: %1 vs %2").arg(graph.nodes.count()).arg(first._tagNodes.count()));
+    }
+    if(!first.attributesSummaryData()->compareTo(graph.attributesSummaryData(), reason)) {
+        return error(QString("graph attributes differ: %1").arg(reason));
+    }
+    // the graph adds its tags to a map only analysis without changing the cached object
+    QSharedPointer<FileAnalysis> mapOnly(new FileAnalysis());
+    mapOnly->shareMapOf(*analysis);
+    FileAnalysisCache::insert(filePath, mapOnly);
+    NodesRelationsDialog secondGraph(false, nodesList, NULL);
+    if(!secondGraph.loadFile(filePath)) {
+        return error("second graph load");
+    }
+    if(mapOnly->hasTagNodes()) {
+        return error("cached analysis modified");
+    }
+    QSharedPointer<FileAnalysis> completed = FileAnalysisCache::find(filePath);
+    if(completed.isNull() || (completed == mapOnly) || !completed->hasTagNodes() || (completed->map() != analysis->map())) {
+        return error("graph analysis not cached with the map");
+    }
+
+    if(!file.open() || !file.seek(file.size()) || (file.write("<!-- changed -->\n") <= 0)) {
+        return error("changing file");
+    }
+    file.close();
+    if(!FileAnalysisCache::find(filePath).isNull()) {
+        return error("changed file still cached");
+    }
+    VisMapDialog third(app.data(), app.mainWindow(), app.mainWindow(), "");
+    third.loadFile(filePath);
+    if(third._analysis == analysis) {
+        return error("changed file not scanned");
+    }
+    FileAnalysisCache::clear();
+    return true;
+}
+
+bool TestVis::testStreamingMap()
+{
+    _testName = "testStreamingMap" ;
+    if( ! testStreamingGridBuckets() ) {
+        return false;
+    }
+    if( ! testStreamingMapCompare(DATA_FILE_1) ) {
+        return false;
+    }
+    if( ! testStreamingMapCompare(DATA_FILE_2) ) {
+        return false;
+    }
+    return true;
+}
+
+/** \brief the map aggregated while scanning must be equal to the one built from the tree
+  * when the resolution is bigger than the number of rows
+  */
+bool TestVis::testStreamingMapCompare(const QString &fileName)
+{
+    App app;
+    if(!app.init() ) {
+        return error("init");
+    }
+    VisMapDialog treeDialog(app.data(), app.mainWindow(), app.mainWindow(), "");
+    treeDialog.loadFile(fileName);
+    if(treeDialog.isStreamingMap()) {
+        return error(QString("tree expected for %1").arg(fileName));
+    }
+    VisMapDialog gridDialog(app.data(), app.mainWindow(), app.mainWindow(), "");
+    gridDialog.setStreamingThreshold(0);
+    gridDialog.loadFile(fileName);
+    if(!gridDialog.isStreamingMap()) {
+        return error(QString("grid expected for %1").arg(fileName));
+    }
+    if(NULL != gridDialog._dataRoot) {
+        return error(QString("element tree built for %1").arg(fileName));
+    }
+    SummaryData &s1 = treeDialog._summary;
+    SummaryData &s2 = gridDialog._summary;
+    if((s1.totalSize != s2.totalSize) || (s1.totalElements != s2.totalElements)
+            || (s1.totalAttributes != s2.totalAttributes) || (s1.totalAttributesSize != s2.totalAttributesSize)
+            || (s1.totalText != s2.totalText) || (s1.levels != s2.levels)
+            || (s1.maxAttributes != s2.maxAttributes) || (s1.maxChildren != s2.maxChildren)
+            || (s1.maxSize != s2.maxSize) || (s1.maxText != s2.maxText)
+            || (s1.maxAttributeSizePerElement != s2.maxAttributeSizePerElement)) {
+        return error(QString("summary differs for %1").arg(fileName));
+    }
+    for(int slice = 0 ; slice < s1.levels ; slice ++) {
+        treeDialog.calcSlice(slice);
+        gridDialog.calcSlice(slice);
+        if(s1.totalFragments != s2.totalFragments) {
+            return error(QString("fragments differ for %1 at slice %2: %3 vs %4").arg(fileName).arg(slice).arg(s1.totalFragments).arg(s2.totalFragments));
+        }
+    }
+    VisDataMap &m1 = treeDialog._dataMap;
+    VisDataMap &m2 = gridDialog._dataMap;
+    if((m1.rows.size() != m2.rows.size()) || (m1.numColumns != m2.numColumns)) {
+        return error(QString("map size differs for %1: rows %2 vs %3, columns %4 vs %5")
+                     .arg(fileName).arg(m1.rows.size()).arg(m2.rows.size()).arg(m1.numColumns).arg(m2.numColumns));
+    }
+    const int rows = m1.rows.size();
+    for(int row = 0 ; row < rows ; row ++) {
+        VisDataRow *r1 = m1.rows.at(row);
+        VisDataRow *r2 = m2.rows.at(row);
+        if(r1->_numColumns != r2->_numColumns) {
+            return error(QString("columns differ for %1 at row %2").arg(fileName).arg(row));
+        }
+        for(int column = 0 ; column < r1->_numColumns ; column ++) {
+            ElementBase *e1 = r1->_columns[column];
+            ElementBase *e2 = r2->_columns[column];
+            if((e1->name != e2->name) || (e1->size != e2->size) || (e1->totalSize != e2->totalSize)
+                    || (e1->childrenCount != e2->childrenCount) || (e1->totalChildrenCount != e2->totalChildrenCount)
+                    || (e1->text != e2->text) || (e1->totalText != e2->totalText)
+                    || (e1->attributesCount != e2->attributesCount) || (e1->totalAttributesCount != e2->totalAttributesCount)) {
+                return error(QString("element differs for %1 at row %2, column %3").arg(fileName).arg(row).arg(column));
+            }
+        }
+    }
+    return true;
+}
+
+/** \brief checks the merge of the buckets and the window of rows
+  * root with 10 leaves each one of size 10
+  */
+bool TestVis::testStreamingGridBuckets()
+{
+    const QString rootName("root");
+    const QString leafName("leaf");
+    VisMapGrid grid(4);
+    grid.startElement(rootName, 0, 0, 0);
+    for(int i = 0 ; i < 10 ; i ++) {
+        grid.startElement(leafName, 10, 0, 0);
+        grid.endElement();
+    }
+    grid.endElement();
+    if((grid.rowsCount() != 10) || (grid.rowsPerBucket() != 4) || (grid.bucketsCount() != 3)) {
+        return error(QString("buckets: rows %1, rows per bucket %2, buckets %3").arg(grid.rowsCount()).arg(grid.rowsPerBucket()).arg(grid.bucketsCount()));
+    }
+    qint64 rows = 0 ;
+    double leavesSize = 0 ;
+    for(int bucket = 0 ; bucket < grid.bucketsCount() ; bucket ++) {
+        rows += grid.cell(0, bucket).rows ;
+        leavesSize += grid.cell(1, bucket).size ;
+        if(grid.cell(0, bucket).totalSize != (100.0 * grid.cell(0, bucket).rows)) {
+            return error(QString("root total size in bucket %1").arg(bucket));
+        }
+    }
+    if((rows != 10) || (leavesSize != 100)) {
+        return error(QString("rows %1, size %2").arg(rows).arg(leavesSize));
+    }
+    if((grid.cell(1, 2).firstElement != 8) || (grid.cell(1, 2).rows != 2)) {
+        return error("last bucket");
+    }
+    if((grid.numElements() != 11) || (grid.maxChildrenCount() != 10) || (grid.rootTotalSize() != 100) || (grid.rootTotalChildrenCount() != 10)) {
+        return error("totals");
+    }
+
+    grid.setRowWindow(2, 5);
+    grid.startElement(rootName, 0, 0, 0);
+    for(int i = 0 ; i < 10 ; i ++) {
+        grid.startElement(leafName, 10, 0, 0);
+        grid.endElement();
+    }
+    grid.endElement();
+    if((grid.rowsPerBucket() != 1) || (grid.bucketsCount() != 3) || (grid.cell(1, 0).firstElement != 2)) {
+        return error(QString("window: rows per bucket %1, buckets %2").arg(grid.rowsPerBucket()).arg(grid.bucketsCount()));
+    }
+    if(grid.numElements() != 11) {
+        return error("window totals");
+    }
     return true;
 }
 
@@ -344,6 +576,75 @@ ElementBase *TestVis::buildElm(ElementBase *parent, const int level)
     return elem ;
 }
 
+/** \brief when a pixel covers many elements, the values read from the tables
+  * are the same computed reading every element
+  */
+bool TestVis::testDataTables()
+{
+    _testName = "testVisData/tables" ;
+    if(!testDataTablesCompare(DataWidget::NoLoudness, false, 4, 40)) {
+        return false;
+    }
+    if(!testDataTablesCompare(DataWidget::NoLoudness, true, 3, 17)) {
+        return false;
+    }
+    if(!testDataTablesCompare(DataWidget::LoudnessMax, false, 4, 40)) {
+        return false;
+    }
+    if(!testDataTablesCompare(DataWidget::LoudnessMax, true, 3, 17)) {
+        return false;
+    }
+    if(!testDataTablesCompare(DataWidget::LoudnessDilate, true, 5, 40)) {
+        return false;
+    }
+    return true;
+}
+
+bool TestVis::testDataTablesCompare(const DataWidget::ELoudness loudness, const bool isMt, const int width, const int height)
+{
+    _testName = QString("testVisData/tables/%1/%2/%3x%4").arg(loudness).arg(isMt).arg(width).arg(height);
+    StdColorMap colorMap("a map");
+    VisDataMap dataMap;
+    ElementBase *e = buildElm(NULL, 6);
+    _eb.add(e);
+    VisMapDialog::calcSize(e, dataMap);
+    dataMap.calculate(e);
+    DataWidget dwReference;
+    DataWidget dwTest;
+    DataWidget *widgets[2] = { &dwReference, &dwTest };
+    FORINT(index, 2) {
+        DataWidget *dw = widgets[index];
+        dw->setMtEnabled(isMt);
+        dw->setColorMap(&colorMap);
+        dw->setVisType(DataWidget::Elements);
+        dw->setLoudness(loudness);
+        dw->setGeometry(0, 0, width, height);
+        dw->setData(e);
+        dw->setDataMap(&dataMap);
+        dw->setCumulative(true);
+        dw->recalc();
+    }
+    dwReference.generateImage(true);
+    dwTest.generateImage();
+    if(dwReference._sizeOfPoints != dwTest._sizeOfPoints) {
+        return error(QString("Size: reference:%1, candidate:%2").arg(dwReference._sizeOfPoints).arg(dwTest._sizeOfPoints));
+    }
+    if(dwTest._dataWindow.height() <= height) {
+        return error(QString("The rows of the data should be more than the pixels: %1").arg(dwTest._dataWindow.height()));
+    }
+    FORINT(index, (int)dwTest._sizeOfPoints) {
+        const float reference = dwReference._dataPoints[index];
+        const float candidate = dwTest._dataPoints[index];
+        if(dwReference._dataPointsMask[index] != dwTest._dataPointsMask[index]) {
+            return error(QString("Mask differs at:%1").arg(index));
+        }
+        if(qAbs(reference - candidate) > (qMax(qAbs(reference), 1.0f) * 1e-4f)) {
+            return error(QString("At:%1 ref:%2, candidate:%3").arg(index).arg(reference).arg(candidate));
+        }
+    }
+    return true;
+}
+
 bool TestVis::testDataThreading(const bool useStandard)
 {
     _testName = "testVisData" ;
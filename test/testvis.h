@@ -26,6 +26,7 @@
 
 #include "testbase.h"
 #include "visualization/elementbase.h"
+#include "visualization/datawidget.h"
 
 class AttributesSummaryData;
 class AttributesSummaryTotal;
@@ -39,7 +40,13 @@ class TestVis : public TestBase
     bool testBaseElement();
     bool testDialog();
     bool testDataThreading(const bool useStandard);
+    bool testDataTables();
+    bool testDataTablesCompare(const DataWidget::ELoudness loudness, const bool isMt, const int width, const int height);
     bool testSliceElements();
+    bool testStreamingMap();
+    bool testStreamingMapCompare(const QString &fileName);
+    bool testStreamingGridBuckets();
+    bool testFileAnalysisCache();
     //----
     bool testAttributeCountUnit();
     bool testAttributeCountNoNo(const bool isLoad);
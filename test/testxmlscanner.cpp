@@ -0,0 +1,260 @@
+/**************************************************************************
+ *  This file is part of QXmlEdit                                         *
+ *  Copyright (C) 2019 by Luca Bellonda and individual contributors       *
+ *    as indicated in the AUTHORS file                                    *
+ *  lbellonda _at_ gmail.com                                              *
+ *                                                                        *
+ * This library is free software; you can redistribute it and/or          *
+ * modify it under the terms of the GNU Library General Public            *
+ * License as published by the Free Software Foundation; either           *
+ * version 2 of the License, or (at your option) any later version.       *
+ *                                                                        *
+ * This library is distributed in the hope that it will be useful,        *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU      *
+ * Library General Public License for more details.                       *
+ *                                                                        *
+ * You should have received a copy of the GNU Library General Public      *
+ * License along with this library; if not, write to the                  *
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,       *
+ * Boston, MA  02110-1301  USA                                            *
+ **************************************************************************/
+
+
+#include "testxmlscanner.h"
+#include "modules/xml/xmlstreamscanner.h"
+#include <QBuffer>
+#include <QXmlSimpleReader>
+#include <QXmlDefaultHandler>
+
+#define DATA_FILE_VIS "../test/data/vis/testvis.xml"
+#define DATA_FILE_VIS_COUNT "../test/data/vis/testvis_count.xml"
+#define DATA_FILE_NAMESPACE "../test/data/namespace/base_ns.xml"
+
+class TestScanCounter : public XmlScanHandler
+{
+public:
+    int elements;
+    int attributes;
+    int maxDepth;
+    qint64 textSize;
+    int stopAt;
+    bool isParseError;
+    QStringList names;
+
+    TestScanCounter()
+    {
+        elements = 0 ;
+        attributes = 0 ;
+        maxDepth = 0 ;
+        textSize = 0 ;
+        stopAt = -1 ;
+        isParseError = false ;
+    }
+
+    bool startElement(XmlStreamScanner *scanner, const int nameId, const QXmlStreamAttributes &attributesList)
+    {
+        elements ++ ;
+        attributes += attributesList.count();
+        maxDepth = qMax(maxDepth, scanner->depth());
+        names.append(scanner->name(nameId));
+        return elements != stopAt ;
+    }
+
+    bool characters(XmlStreamScanner * /*scanner*/, const QStringRef &text)
+    {
+        textSize += text.length();
+        return true ;
+    }
+
+    void parseError(const QString & /*message*/)
+    {
+        isParseError = true ;
+    }
+};
+
+class TestSaxCounter : public QXmlDefaultHandler
+{
+public:
+    int elements;
+    int attributes;
+    qint64 textSize;
+    QStringList names;
+
+    TestSaxCounter()
+    {
+        elements = 0 ;
+        attributes = 0 ;
+        textSize = 0 ;
+    }
+
+    bool startElement(const QString & /*namespaceURI*/, const QString & /*localName*/,
+                      const QString &qName, const QXmlAttributes &attributesList)
+    {
+        elements ++ ;
+        attributes += attributesList.count();
+        names.append(qName);
+        return true ;
+    }
+
+    bool characters(const QString &text)
+    {
+        textSize += text.length();
+        return true ;
+    }
+};
+
+TestXmlScanner::TestXmlScanner()
+{
+}
+
+TestXmlScanner::~TestXmlScanner()
+{
+}
+
+bool TestXmlScanner::testUnit()
+{
+    _testName = "testUnit";
+    if(!testNames()) {
+        return false;
+    }
+    if(!testEvents()) {
+        return false;
+    }
+    if(!testStop()) {
+        return false;
+    }
+    if(!testError()) {
+        return false;
+    }
+    if(!testCompareWithSax(DATA_FILE_VIS)) {
+        return false;
+    }
+    if(!testCompareWithSax(DATA_FILE_VIS_COUNT)) {
+        return false;
+    }
+    if(!testCompareWithSax(DATA_FILE_NAMESPACE)) {
+        return false;
+    }
+    return true;
+}
+
+bool TestXmlScanner::testNames()
+{
+    _subTestName = "testNames";
+    XmlStreamScanner scanner;
+    const QString data("a b a:b a");
+    const int idA = scanner.internName(QString("a"));
+    const int idB = scanner.internName(data.midRef(2, 1));
+    const int idAB = scanner.internName(data.midRef(4, 3));
+    if((idA == idB) || (idA == idAB) || (idB == idAB)) {
+        return error(QString("ids not unique %1 %2 %3").arg(idA).arg(idB).arg(idAB));
+    }
+    if((scanner.internName(data.midRef(8, 1)) != idA) || (scanner.internName(QString("a:b")) != idAB)) {
+        return error("same name, different id");
+    }
+    if((scanner.namesCount() != 3) || (scanner.name(idAB) != "a:b") || !scanner.name(100).isEmpty()) {
+        return error("names table");
+    }
+    return true;
+}
+
+bool TestXmlScanner::testEvents()
+{
+    _subTestName = "testEvents";
+    QByteArray data("<?xml version=\"1.0\"?><r a=\"1\" xmlns:p=\"urn:p\"><p:x b=\"2\">text</p:x><y/><p:x/></r>");
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    XmlStreamScanner scanner;
+    TestScanCounter counter;
+    if(!scanner.scan(&buffer, &counter)) {
+        return error(QString("scan failed: %1").arg(scanner.errorMessage()));
+    }
+    if((counter.elements != 4) || (counter.attributes != 3) || (counter.textSize != 4) || (counter.maxDepth != 2)) {
+        return error(QString("counts: elements %1, attributes %2, text %3, depth %4")
+                     .arg(counter.elements).arg(counter.attributes).arg(counter.textSize).arg(counter.maxDepth));
+    }
+    QStringList expected;
+    expected << "r" << "p:x" << "y" << "p:x" ;
+    if(!compareStringList("names", expected, counter.names)) {
+        return false;
+    }
+    if(scanner.namesCount() != 3) {
+        return error(QString("names count %1").arg(scanner.namesCount()));
+    }
+    return true;
+}
+
+bool TestXmlScanner::testStop()
+{
+    _subTestName = "testStop";
+    QByteArray data("<r><a/><b/><c/></r>");
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    XmlStreamScanner scanner;
+    TestScanCounter counter;
+    counter.stopAt = 2 ;
+    if(scanner.scan(&buffer, &counter)) {
+        return error("not stopped");
+    }
+    if(!scanner.isStopped() || scanner.isError() || counter.isParseError || (counter.elements != 2)) {
+        return error("stop state");
+    }
+    return true;
+}
+
+bool TestXmlScanner::testError()
+{
+    _subTestName = "testError";
+    QByteArray data("<r>\n<a></b></r>");
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    XmlStreamScanner scanner;
+    TestScanCounter counter;
+    if(scanner.scan(&buffer, &counter)) {
+        return error("error not detected");
+    }
+    if(!scanner.isError() || scanner.isStopped() || !counter.isParseError || (scanner.lineNumber() != 2)) {
+        return error(QString("error state, line %1").arg(scanner.lineNumber()));
+    }
+    return true;
+}
+
+/** \brief the scanner must report the same elements, attributes and text of the SAX reader
+  */
+bool TestXmlScanner::testCompareWithSax(const QString &fileName)
+{
+    _subTestName = QString("testCompareWithSax %1").arg(fileName);
+    TestSaxCounter saxCounter;
+    {
+        QXmlSimpleReader reader;
+        reader.setFeature("http://xml.org/sax/features/namespaces", false);
+        reader.setFeature("http://xml.org/sax/features/namespace-prefixes", true);
+        reader.setContentHandler(&saxCounter);
+        QFile file(fileName);
+        if(!file.open(QFile::ReadOnly | QFile::Text)) {
+            return error("opening file");
+        }
+        QXmlInputSource xmlInput(&file);
+        if(!reader.parse(xmlInput)) {
+            return error("sax parse");
+        }
+        file.close();
+    }
+    TestScanCounter counter;
+    XmlStreamScanner scanner;
+    if(!scanner.scanFile(fileName, &counter)) {
+        return error(QString("scan failed: %1").arg(scanner.errorMessage()));
+    }
+    if((counter.elements != saxCounter.elements) || (counter.attributes != saxCounter.attributes)
+            || (counter.textSize != saxCounter.textSize)) {
+        return error(QString("differences: elements %1/%2, attributes %3/%4, text %5/%6")
+                     .arg(counter.elements).arg(saxCounter.elements)
+                     .arg(counter.attributes).arg(saxCounter.attributes)
+                     .arg(counter.textSize).arg(saxCounter.textSize));
+    }
+    if(!compareStringList("names", saxCounter.names, counter.names)) {
+        return false;
+    }
+    return true;
+}
@@ -60,6 +60,8 @@ strategy: test ordered, unordered, attributes only mixed based on the outcome of
 
 #include "testxsddiff.h"
 #include "xsdeditor/xsdcompare.h"
+#include "xsdeditor/xsdloadcontext.h"
+#include "element.h"
 
 class Test1{
     public:
@@ -98,6 +100,7 @@ TestXSDDiff::TestXSDDiff()
 {
     one = false ;
     _isError = false;
+    _isFromRegola = false;
 }
 
 TestXSDDiff::~TestXSDDiff()
@@ -276,7 +279,12 @@ bool TestXSDDiff::doTest( const ETTType type, const QString &testName, const QSt
     XSDCompare compare;
     XSDCompareOptions options;
     options.setCompareComment(true);
-    XSDCompareResult *result = compare.innerCompare(regola->getAsText(), fileNameOut, options, false);
+    XSDCompareResult *result = NULL ;
+    if(_isFromRegola) {
+        result = compare.innerCompare(regola, fileNameOut, options, false);
+    } else {
+        result = compare.innerCompare(regola->getAsText(), fileNameOut, options, false);
+    }
     if(NULL == result) {
         return error(testName, "null result");
     }
@@ -332,7 +340,12 @@ bool TestXSDDiff::doCompare( const QString &testName, const QString &fileNameIn,
     XSDCompare compare;
     XSDCompareOptions options;
     options.setCompareComment(true);
-    XSDCompareResult *result = compare.innerCompare(regola->getAsText(), fileNameOut, options, false);
+    XSDCompareResult *result = NULL ;
+    if(_isFromRegola) {
+        result = compare.innerCompare(regola, fileNameOut, options, false);
+    } else {
+        result = compare.innerCompare(regola->getAsText(), fileNameOut, options, false);
+    }
     if(NULL == result) {
         return error(testName, "null result");
     }
@@ -406,6 +419,236 @@ bool TestXSDDiff::testEqualsUnordered()
     return goUnordered( "testEquals", INPUT_U, INPUT_U, expected, false );
 }
 
+/**
+ * @brief TestXSDDiff::compareStates compares the editor data to OUT_ADDMIDDLE
+ * @param states the type, the name and the state of every object of the result, in preorder
+ */
+bool TestXSDDiff::compareStates(XSDCompare &compare, Regola *regola, XSDCompareOptions &options, const bool isSwap, QStringList &states, bool &isDifferent, int &skipped)
+{
+    XSDCompareResult *result = compare.innerCompare(regola, OUT_ADDMIDDLE, options, isSwap);
+    if(NULL == result) {
+        return false;
+    }
+    XSDSchema *schema = result->_schema;
+    const bool isError = result->isError();
+    isDifferent = result->areDifferent();
+    skipped = result->skippedComponents();
+    delete result;
+    if(NULL != schema) {
+        QList<XSchemaObject*> nodes;
+        schema->collectCompareNodes(nodes);
+        foreach(XSchemaObject * node, nodes) {
+            states.append(QString("%1:%2:%3").arg(node->getType()).arg(node->name()).arg(node->compareState()));
+        }
+        delete schema ;
+    }
+    return !isError && (NULL != schema);
+}
+
+/**
+ * @brief TestXSDDiff::testCompareOnlyChanged
+ * the comparison of the components not changed since the last one must give the results of a full comparison,
+ * both for added objects and for deleted ones, that are moved from the target
+ */
+bool TestXSDDiff::testCompareOnlyChanged()
+{
+    const QString testName = "testCompareOnlyChanged" ;
+    App app;
+    if(!app.init() ) {
+        return error(testName, "init app failed");
+    }
+    if( !app.mainWindow()->loadFile(INPUT_1) ) {
+        return error(testName, QString("unable to load file: '%1' ").arg(INPUT_1));
+    }
+    Regola *regola = app.mainWindow()->getRegola();
+    XSDCompare compare;
+    XSDCompareOptions options;
+    options.setCompareComment(true);
+    const int Steps = 5 ;
+    const bool isSwap[Steps] = {false, false, true, true, true};
+    const bool isOnlyChanged[Steps] = {true, true, true, true, false};
+    const int expectedSkipped[Steps] = {0, 1, 0, 1, 0};
+    for( int step = 0 ; step < Steps ; step ++ ) {
+        XSDCompare fullCompare;
+        XSDCompareOptions fullOptions;
+        fullOptions.setCompareComment(true);
+        QStringList expectedStates;
+        bool expectedDifferent = false;
+        int fullSkipped = 0 ;
+        if(!compareStates(fullCompare, regola, fullOptions, isSwap[step], expectedStates, expectedDifferent, fullSkipped)) {
+            return error(testName, QString("error in full comparison at step %1").arg(step));
+        }
+        options.setOnlyChanged(isOnlyChanged[step]);
+        QStringList states;
+        bool isDifferent = false;
+        int skipped = 0 ;
+        if(!compareStates(compare, regola, options, isSwap[step], states, isDifferent, skipped)) {
+            return error(testName, QString("error in operation at step %1").arg(step));
+        }
+        if(!expectedDifferent || (isDifferent != expectedDifferent)) {
+            return error(testName, QString("different flag at step %1 expected:%2 found:%3").arg(step).arg(expectedDifferent).arg(isDifferent));
+        }
+        if(skipped != expectedSkipped[step]) {
+            return error(testName, QString("skipped at step %1 expected:%2 found:%3").arg(step).arg(expectedSkipped[step]).arg(skipped));
+        }
+        if(states != expectedStates) {
+            return error(testName, QString("states at step %1 expected:\n%2\nfound:\n%3").arg(step).arg(expectedStates.join("\n")).arg(states.join("\n")));
+        }
+    }
+    return true;
+}
+
+//------------------- region(regola) ------------------------
+
+/**
+ * @brief TestXSDDiff::testFromRegola
+ * the schema read from the document tree gives the same results of the one read from its text
+ */
+bool TestXSDDiff::testFromRegola()
+{
+    if(!testGenerateDomNS()) {
+        return false;
+    }
+    if(!testReadFromRegolaKeys()) {
+        return false;
+    }
+    _isFromRegola = true ;
+    const bool isOk = testEqual() && testAdd() && testDel() && testMixed()
+                      && testEqualUnordered() && testMixedUnordered() && testDiffOpAttributes();
+    _isFromRegola = false ;
+    return isOk ;
+}
+
+bool TestXSDDiff::checkNodeNS(const QString &testName, const QDomElement &element, const QString &expectedName, const QString &expectedNamespace)
+{
+    if(element.isNull()) {
+        return error(testName, QString("element '%1' not found").arg(expectedName));
+    }
+    if((element.tagName() != expectedName) || (element.namespaceURI() != expectedNamespace)) {
+        return error(testName, QString("element expected '%1' in '%2', found '%3' in '%4'")
+                     .arg(expectedName).arg(expectedNamespace).arg(element.tagName()).arg(element.namespaceURI()));
+    }
+    QDomNamedNodeMap attributes = element.attributes();
+    for(int i = 0 ; i < attributes.length() ; i++) {
+        const QString name = attributes.item(i).nodeName();
+        if((name == "xmlns") || name.startsWith("xmlns:")) {
+            return error(testName, QString("namespace declaration '%1' in element '%2'").arg(name).arg(expectedName));
+        }
+    }
+    return true ;
+}
+
+bool TestXSDDiff::checkAttributeNS(const QString &testName, const QDomElement &element, const QString &name, const QString &expectedNamespace)
+{
+    QDomAttr attribute = element.attributeNode(name);
+    if(attribute.isNull()) {
+        return error(testName, QString("attribute '%1' not found in '%2'").arg(name).arg(element.tagName()));
+    }
+    if(attribute.namespaceURI() != expectedNamespace) {
+        return error(testName, QString("attribute '%1' expected in '%2', found in '%3'")
+                     .arg(name).arg(expectedNamespace).arg(attribute.namespaceURI()));
+    }
+    return true ;
+}
+
+/**
+ * @brief TestXSDDiff::testGenerateDomNS
+ * prefixed and default namespaces declared in inner elements are resolved in their scope
+ */
+bool TestXSDDiff::testGenerateDomNS()
+{
+    const QString testName = "testGenerateDomNS" ;
+    const QString source = "<root xmlns='urn:default' xmlns:a='urn:a'>"
+                           "<a:one a:x='1' y='2'>"
+                           "<two xmlns='urn:inner'><b:three xmlns:b='urn:b' b:z='3'/></two>"
+                           "<four/>"
+                           "</a:one>"
+                           "<b:five xmlns:b='urn:b2'/>"
+                           "</root>";
+    QDomDocument input;
+    if(!input.setContent(source)) {
+        return error(testName, "unable to parse the source");
+    }
+    Regola regola(input, "");
+    QDomDocument document;
+    if(!regola.generateDomNS(document)) {
+        return error(testName, "unable to generate the DOM");
+    }
+    QDomElement root = document.documentElement();
+    if(!checkNodeNS(testName, root, "root", "urn:default")) {
+        return false;
+    }
+    QDomElement one = root.firstChildElement();
+    if(!checkNodeNS(testName, one, "a:one", "urn:a")
+            || !checkAttributeNS(testName, one, "a:x", "urn:a")
+            || !checkAttributeNS(testName, one, "y", "")) {
+        return false;
+    }
+    QDomElement two = one.firstChildElement();
+    if(!checkNodeNS(testName, two, "two", "urn:inner")) {
+        return false;
+    }
+    QDomElement three = two.firstChildElement();
+    if(!checkNodeNS(testName, three, "b:three", "urn:b")
+            || !checkAttributeNS(testName, three, "b:z", "urn:b")) {
+        return false;
+    }
+    // the declarations of the siblings are out of scope
+    if(!checkNodeNS(testName, two.nextSiblingElement(), "four", "urn:default")) {
+        return false;
+    }
+    if(!checkNodeNS(testName, one.nextSiblingElement(), "b:five", "urn:b2")) {
+        return false;
+    }
+    return true ;
+}
+
+/**
+ * @brief TestXSDDiff::testReadFromRegolaKeys
+ * the keys collected reading the schema from the document refer to the objects built from the same elements
+ */
+bool TestXSDDiff::testReadFromRegolaKeys()
+{
+    const QString testName = "testReadFromRegolaKeys" ;
+    App app;
+    if(!app.init() ) {
+        return error(testName, "init app failed");
+    }
+    if( !app.mainWindow()->loadFile(INPUT_1) ) {
+        return error(testName, QString("unable to load file: '%1' ").arg(INPUT_1));
+    }
+    Regola *regola = app.mainWindow()->getRegola();
+    XSDSchema schema(NULL);
+    XSDLoadContext loadContext;
+    loadContext.setLoadKeys(true);
+    ElementLoadInfoMap map;
+    if(!schema.readFromRegola(&loadContext, regola, false, NULL, "", &map)) {
+        return error(testName, "unable to read the schema");
+    }
+    if(map.dataMap.key(regola->root()).isEmpty()) {
+        return error(testName, "no key for the root");
+    }
+    int found = 0 ;
+    foreach(const QString &key, map.dataMap.keys()) {
+        Element *element = map.dataMap.value(key);
+        if((element->tag() != "xs:complexType") && (element->tag() != "xs:element")) {
+            continue;
+        }
+        XSchemaObject *object = loadContext.findObjectForKey(key);
+        if(NULL == object) {
+            return error(testName, QString("no object for the key '%1' of '%2'").arg(key).arg(element->tag()));
+        }
+        if(object->name() != element->getAttributeValue("name")) {
+            return error(testName, QString("the key '%1' refers to '%2', expected '%3'")
+                         .arg(key).arg(object->name()).arg(element->getAttributeValue("name")));
+        }
+        found++;
+    }
+    if(0 == found) {
+        return error(testName, "no object found by key");
+    }
+    return true ;
+}
 
 //------------------- region(add) ------------------------
 
@@ -930,6 +1173,9 @@ bool TestXSDDiff::testEqual()
     if( !testEquals()) {
         return false;
     }
+    if( !testCompareOnlyChanged()) {
+        return false;
+    }
     return true;
 }
 
@@ -37,12 +37,16 @@ class TestXSDDiff
     QMap<QString, QVariant> _configBackend;
 
     bool one;
+    // reads the reference schema from the document tree instead of its text
+    bool _isFromRegola;
 
     bool testForChildren( const QString &testName, QList<XSchemaObject*> &children, QList<XSDCompareState::EXSDCompareState>expected);
     QString _errorString;
     bool _isError ;
 
     bool testEquals();
+    bool testCompareOnlyChanged();
+    bool compareStates(XSDCompare &compare, Regola *regola, XSDCompareOptions &options, const bool isSwap, QStringList &states, bool &isDifferent, int &skipped);
     bool testEqualsUnordered();
     bool testAddBefore();
     bool testAddMiddle();
@@ -99,6 +103,10 @@ class TestXSDDiff
     bool testDiffSequence();
     bool testDiffAttributes();
     bool testObjects();
+    bool testGenerateDomNS();
+    bool testReadFromRegolaKeys();
+    bool checkNodeNS(const QString &testName, const QDomElement &element, const QString &expectedName, const QString &expectedNamespace);
+    bool checkAttributeNS(const QString &testName, const QDomElement &element, const QString &name, const QString &expectedNamespace);
 
 public:
     TestXSDDiff();
@@ -116,6 +124,7 @@ public:
     bool testMixedUnordered();
     bool testDiffObjects();
     bool testDiffOpAttributes();
+    bool testFromRegola();
 };
 
 #endif // TESTXSDDIFF_H
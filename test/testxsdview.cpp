@@ -26,6 +26,8 @@
 #include "xsdeditor/xsdwindow.h"
 #include "modules/services/systemservices.h"
 #include <QGraphicsItem>
+#include <QImage>
+#include <QPainter>
 
 TestXSDView::TestXSDView()
 {
@@ -1053,6 +1055,12 @@ bool TestXSDView::testUnit()
     if(!testViewItems()) {
         return false;
     }
+    if(!testLazyItems()) {
+        return false;
+    }
+    if(!testRenderDetails()) {
+        return false;
+    }
     return true;
 }
 
@@ -1216,3 +1224,125 @@ bool TestXSDView::testViewItems()
     }
     return true;
 }
+
+QString TestXSDView::buildBigSchema(const int count)
+{
+    QString xsd = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                  "<xs:schema xmlns:xs=\"http://www.w3.org/2001/XMLSchema\">\n";
+    xsd += "<xs:element name=\"root\"><xs:complexType><xs:sequence>\n";
+    FORINT(index, count) {
+        xsd += QString("<xs:element name=\"e%1\"><xs:complexType><xs:sequence>"
+                       "<xs:element name=\"a%1\" type=\"xs:string\"/>"
+                       "<xs:element name=\"b%1\" type=\"xs:string\"/>"
+                       "</xs:sequence></xs:complexType></xs:element>\n").arg(index);
+    }
+    xsd += "</xs:sequence></xs:complexType></xs:element>\n</xs:schema>\n";
+    return xsd ;
+}
+
+int TestXSDView::countItems(XSDItem *item, XSDItem **collapsed)
+{
+    if((NULL == *collapsed) && item->hasCollapsedChildren()) {
+        *collapsed = item ;
+    }
+    int count = 1 ;
+    foreach(RChild *child, item->rChildren()->children()) {
+        count += countItems(child->item(), collapsed);
+    }
+    return count;
+}
+
+bool TestXSDView::testLazyItems()
+{
+    _testName = "testLazyItems";
+    const int Elements = 1000 ;
+    App app;
+    if(!app.init()) {
+        return error("init app");
+    }
+    {
+        XSDWindow xsdEditor(app.data(), app.mainWindow());
+        xsdEditor.loadStringImmediate(buildBigSchema(Elements));
+        if(NULL == xsdEditor.root()) {
+            return error("no root for the big schema");
+        }
+        XSDItem *collapsed = NULL ;
+        const int itemsBefore = countItems(xsdEditor.root(), &collapsed);
+        if(NULL == collapsed) {
+            return error("no collapsed item in the big schema");
+        }
+        if(itemsBefore >= (Elements * 4)) {
+            return error(QString("too many items created: %1").arg(itemsBefore));
+        }
+        const int childrenBefore = collapsed->rChildren()->childrenSize();
+        const int expanded = collapsed->expand();
+        if(expanded <= 0) {
+            return error("no children expanded");
+        }
+        if(collapsed->hasCollapsedChildren()) {
+            return error("collapsed children after the expand");
+        }
+        if(collapsed->rChildren()->childrenSize() != (childrenBefore + expanded)) {
+            return error(QString("children after the expand: expected %1, found %2")
+                         .arg(childrenBefore + expanded).arg(collapsed->rChildren()->childrenSize()));
+        }
+    }
+    {
+        if( !app.mainWindow()->loadFile(FILE_BASE_INPUT) ) {
+            return error(QString("unable to load input file: '%1' ").arg(FILE_BASE_INPUT));
+        }
+        XSDWindow xsdEditor(app.data(), app.mainWindow());
+        xsdEditor.loadStringImmediate(app.mainWindow()->getRegola()->getAsText());
+        if(NULL == xsdEditor.root()) {
+            return error("no root for the small schema");
+        }
+        XSDItem *collapsed = NULL ;
+        countItems(xsdEditor.root(), &collapsed);
+        if(NULL != collapsed) {
+            return error("collapsed item in a small schema");
+        }
+    }
+    return true;
+}
+
+/*!
+ * \brief a view zoomed out paints only the boxes, a print or an export at the same scale has all the details
+ */
+bool TestXSDView::testRenderDetails()
+{
+    _testName = "testRenderDetails";
+    App app;
+    if(!app.init()) {
+        return error("init app");
+    }
+    XSDScene scene;
+    GraphicsRoundRectItem *item = new GraphicsRoundRectItem(NULL);
+    item->setRect(0, 0, 400, 200);
+    scene.addItem(item);
+    scene.setViewScale(0.25);
+    if(!scene.isLowDetail()) {
+        return error("the scene is not at low detail when zoomed out");
+    }
+    const QRectF source(0, 0, 400, 200);
+    const QRectF target(0, 0, 100, 50);
+    QImage viewImage(100, 50, QImage::Format_ARGB32);
+    viewImage.fill(Qt::white);
+    {
+        QPainter painter(&viewImage);
+        // as the view paints the scene
+        static_cast<QGraphicsScene&>(scene).render(&painter, target, source);
+    }
+    QImage printImage(100, 50, QImage::Format_ARGB32);
+    printImage.fill(Qt::white);
+    {
+        QPainter painter(&printImage);
+        scene.render(&painter, target, source);
+    }
+    if(viewImage == printImage) {
+        return error("the print at a low scale has no details");
+    }
+    if(!scene.isLowDetail()) {
+        return error("the scene lost the low detail after the print");
+    }
+    return true;
+}
@@ -77,6 +77,10 @@ class TestXSDView : public TestBase
     bool testItemBaseline();
     bool testItemDisposition();
     bool checkItem(QList<ItemInfoDimensions*> infos, const int index, const qreal posY);
+    bool testLazyItems();
+    bool testRenderDetails();
+    QString buildBigSchema(const int count);
+    int countItems(XSDItem *item, XSDItem **collapsed);
     //void debugFile(const QString &data);
 
     QList <QGraphicsItem*> _gi;
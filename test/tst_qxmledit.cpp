@@ -363,6 +363,8 @@ void TestQXmlEdit::testSql()
     QVERIFY2(result, "deleteByDate6MonthsFiles");
     result = tsa.deleteByGivenDateFiles();
     QVERIFY2(result, "deleteByGivenDateFiles");
+    result = tsa.testWriteBehind();
+    QVERIFY2(result, QString("testWriteBehind %1").arg(tsa.msg()).toLatin1().data());
 }
 
 void TestQXmlEdit::testEditing()
@@ -552,6 +554,14 @@ void TestQXmlEdit::testXSDDiff12()
     QVERIFY2(result, QString("xsd diff: %1").arg(test.errorString()).toLatin1().data());
 }
 
+void TestQXmlEdit::testXSDDiff13()
+{
+    bool result ;
+    TestXSDDiff test;
+    result = test.testFromRegola();
+    QVERIFY2(result, QString("xsd diff: %1").arg(test.errorString()).toLatin1().data());
+}
+
 void TestQXmlEdit::testExportCSV()
 {
     bool result ;
@@ -748,6 +758,9 @@ void TestQXmlEdit::testStyle()
     TestStyle  test2;
     result = test2.testCalcStyle();
     QVERIFY2(result, (QString("test Style: testCalcStyle '%1'").arg(test2.errorString())).toLatin1().data());
+    TestStyle  test3;
+    result = test3.testLazyStyles();
+    QVERIFY2(result, (QString("test Style: testLazyStyles '%1'").arg(test3.errorString())).toLatin1().data());
 }
 
 void TestQXmlEdit::testXSDCopy()
@@ -1642,6 +1655,20 @@ void TestQXmlEdit::testLoadSample()
 }
 
 
+void TestQXmlEdit::testXmlScanner()
+{
+    TestXmlScanner test;
+    const bool result = test.testUnit();
+    QVERIFY2(result, (QString("test xml scanner: testUnit() '%1'").arg(test.errorString())).toLatin1().data());
+}
+
+void TestQXmlEdit::testIncrementalSave()
+{
+    TestIncrementalSave test;
+    const bool result = test.testUnitTests();
+    QVERIFY2(result, (QString("test incremental save: testUnitTests() '%1'").arg(test.errorString())).toLatin1().data());
+}
+
 #if QT_VERSION >= QT_VERSION_CHECK(5,0,0)
 // This function enabled for debug purposes. DO NOT REMOVE
 //static void msgHandler(QtMsgType type, const char *msg)